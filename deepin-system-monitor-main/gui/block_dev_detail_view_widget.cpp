@@ -6,6 +6,7 @@
 #include "block_dev_detail_view_widget.h"
 #include "block_dev_stat_view_widget.h"
 #include "block_dev_summary_view_widget.h"
+#include "pressure_view_widget.h"
 
 #include <DApplication>
 
@@ -17,7 +18,9 @@ BlockDevDetailViewWidget::BlockDevDetailViewWidget(QWidget *parent)
     setTitle(DApplication::translate("Process.Graph.View", "Disks"));
     m_blockStatWidget = new BlockStatViewWidget(this);
     m_blocksummaryWidget = new BlockDevSummaryViewWidget(this);
+    m_pressureWidget = new PressureViewWidget(core::system::PressureInfo::kIOPressure, this);
     m_centralLayout->addWidget(m_blockStatWidget);
+    m_centralLayout->addWidget(m_pressureWidget);
     m_centralLayout->addWidget(m_blocksummaryWidget);
     connect(m_blockStatWidget, &BlockStatViewWidget::changeInfo, m_blocksummaryWidget, &BlockDevSummaryViewWidget::chageSummaryInfo);
 
@@ -33,4 +36,5 @@ void BlockDevDetailViewWidget::detailFontChanged(const QFont &font)
     BaseDetailViewWidget::detailFontChanged(font);
     m_blockStatWidget->fontChanged(font);
     m_blocksummaryWidget->fontChanged(font);
+    m_pressureWidget->fontChanged(font);
 }
@@ -13,6 +13,7 @@
  */
 class BlockStatViewWidget;
 class BlockDevSummaryViewWidget;
+class PressureViewWidget;
 class BlockDevDetailViewWidget : public BaseDetailViewWidget
 {
     Q_OBJECT
@@ -26,6 +27,7 @@ public slots:
 private:
     BlockStatViewWidget *m_blockStatWidget;
     BlockDevSummaryViewWidget *m_blocksummaryWidget;
+    PressureViewWidget *m_pressureWidget;
 
 };
 
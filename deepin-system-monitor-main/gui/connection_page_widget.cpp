@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "connection_page_widget.h"
+
+#include "application.h"
+#include "main_window.h"
+#include "connection_table_view.h"
+#include "toolbar.h"
+
+#include <DApplicationHelper>
+
+#include <QHBoxLayout>
+#include <QPainter>
+#include <QPainterPath>
+
+// constructor
+ConnectionPageWidget::ConnectionPageWidget(DWidget *parent)
+    : DFrame(parent)
+{
+    // content margin
+    int margin = 10;
+
+    auto *layout = new QHBoxLayout(this);
+    // connection table view instance, all processes
+    m_connectionTableView = new ConnectionTableView(-1, this);
+    layout->addWidget(m_connectionTableView);
+    layout->setContentsMargins(margin, margin, margin, margin);
+    setLayout(layout);
+
+    connect(gApp->mainWindow()->toolbar(), &Toolbar::search, m_connectionTableView, &ConnectionTableView::search);
+}
+
+// paint event handler
+void ConnectionPageWidget::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+
+    QPainterPath path;
+    path.addRect(QRectF(rect()));
+    painter.setOpacity(1);
+
+    auto *dAppHelper = DApplicationHelper::instance();
+    auto palette = dAppHelper->applicationPalette();
+    auto bgColor = palette.color(DPalette::Background);
+
+    // paint frame background
+    painter.fillPath(path, bgColor);
+}
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONNECTION_PAGE_WIDGET_H
+#define CONNECTION_PAGE_WIDGET_H
+
+#include <DFrame>
+#include <DWidget>
+
+DWIDGET_USE_NAMESPACE
+
+class ConnectionTableView;
+
+/**
+ * @brief Connection background frame widget
+ */
+class ConnectionPageWidget : public DFrame
+{
+public:
+    /**
+     * @brief Constrcutor
+     * @param parent Parent object
+     */
+    explicit ConnectionPageWidget(DWidget *parent = nullptr);
+
+protected:
+    /**
+     * @brief paintEvent Paint event handler
+     * @param event Paint event
+     */
+    void paintEvent(QPaintEvent *event);
+
+private:
+    // Connection table view instance
+    ConnectionTableView *m_connectionTableView {};
+};
+
+#endif // CONNECTION_PAGE_WIDGET_H
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "connection_table_view.h"
+
+#include "model/connection_table_model.h"
+
+#include <DHeaderView>
+
+#include <QSortFilterProxyModel>
+
+DWIDGET_USE_NAMESPACE
+
+ConnectionTableView::ConnectionTableView(pid_t pid, DWidget *parent)
+    : BaseTableView(parent)
+{
+    setAccessibleName("ConnectionTableView");
+
+    m_model = new ConnectionTableModel(pid, this);
+    m_proxyModel = new QSortFilterProxyModel(this);
+    m_proxyModel->setSourceModel(m_model);
+    // sort on raw values, filter on displayed text of any column
+    m_proxyModel->setSortRole(Qt::UserRole);
+    m_proxyModel->setFilterKeyColumn(-1);
+    m_proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
+    setModel(m_proxyModel);
+
+    // all rows have the same height, saves measuring every row of large tables
+    setUniformRowHeights(true);
+
+    auto *hdr = header();
+    hdr->setSectionsMovable(true);
+    hdr->setSectionsClickable(true);
+    hdr->setSectionResizeMode(DHeaderView::Interactive);
+    hdr->setStretchLastSection(true);
+    hdr->setSortIndicatorShown(true);
+    hdr->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+    setSortingEnabled(true);
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    setColumnWidth(ConnectionTableModel::kConnectionProcessColumn, 160);
+    setColumnWidth(ConnectionTableModel::kConnectionPIDColumn, 70);
+    setColumnWidth(ConnectionTableModel::kConnectionProtocolColumn, 70);
+    setColumnWidth(ConnectionTableModel::kConnectionLocalAddressColumn, 200);
+    setColumnWidth(ConnectionTableModel::kConnectionRemoteAddressColumn, 200);
+    setColumnWidth(ConnectionTableModel::kConnectionStateColumn, 90);
+    setColumnWidth(ConnectionTableModel::kConnectionDownloadColumn, 90);
+    // process columns are redundant when showing sockets of one process
+    setColumnHidden(ConnectionTableModel::kConnectionProcessColumn, pid >= 0);
+    setColumnHidden(ConnectionTableModel::kConnectionPIDColumn, pid >= 0);
+    sortByColumn(ConnectionTableModel::kConnectionDownloadColumn, Qt::DescendingOrder);
+}
+
+void ConnectionTableView::search(const QString &pattern)
+{
+    m_proxyModel->setFilterRegExp(QRegExp(pattern, Qt::CaseInsensitive, QRegExp::FixedString));
+}
+
+void ConnectionTableView::showEvent(QShowEvent *event)
+{
+    // table is built on next refresh, shown from then on
+    m_model->setActive(true);
+    BaseTableView::showEvent(event);
+}
+
+void ConnectionTableView::hideEvent(QHideEvent *event)
+{
+    m_model->setActive(false);
+    BaseTableView::hideEvent(event);
+}
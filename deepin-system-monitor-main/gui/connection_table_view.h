@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONNECTION_TABLE_VIEW_H
+#define CONNECTION_TABLE_VIEW_H
+
+#include "base/base_table_view.h"
+
+#include <sys/types.h>
+
+class ConnectionTableModel;
+class QSortFilterProxyModel;
+
+/**
+ * @brief Connection table view, sockets of all processes or of one process
+ *
+ * The connection table is only built while a view is shown.
+ */
+class ConnectionTableView : public BaseTableView
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param pid Only show sockets of this process, -1 to show all sockets
+     * @param parent Parent object
+     */
+    explicit ConnectionTableView(pid_t pid = -1, DWidget *parent = nullptr);
+
+public Q_SLOTS:
+    /**
+     * @brief Filter connections on specific pattern
+     * @param pattern Pattern matched against all columns
+     */
+    void search(const QString &pattern);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    ConnectionTableModel *m_model {};
+    QSortFilterProxyModel *m_proxyModel {};
+};
+
+#endif // CONNECTION_TABLE_VIEW_H
@@ -13,6 +13,9 @@
 #include "model/cpu_list_model.h"
 #include "system/cpu_set.h"
 #include "cpu_summary_view_widget.h"
+#include "cpu_heatmap_widget.h"
+#include "pressure_view_widget.h"
+#include "settings.h"
 
 #include <DApplication>
 #include <DApplicationHelper>
@@ -37,6 +40,9 @@ DWIDGET_USE_NAMESPACE
 
 using namespace common;
 
+// default cpu count above which multi core view switches to heatmap
+const int kDefaultCPUHeatmapThreshold = 32;
+
 CPUDetailGrapTableItem::CPUDetailGrapTableItem(CPUInfoModel *model, int index, QWidget *parent): QWidget(parent), m_cpuInfomodel(model), m_index(index)
 {
     m_cpuInfomodel = CPUInfoModel::instance();
@@ -73,24 +79,36 @@ void CPUDetailGrapTableItem::setColor(QColor color)
 
 void CPUDetailGrapTableItem::updateStat()
 {
-    // 多核模式时保留原来逻辑
-    if (m_isMutliCoreMode) {
-        if (std::isnan(m_cpuInfomodel->cpuPercentList().value(m_index)))
-            m_cpuPercents.insert(0, 0);
-        else
-            m_cpuPercents.insert(0, m_cpuInfomodel->cpuPercentList().value(m_index) / 100.0);
-    } else {
+    // 多核模式时直接读取模型中对应CPU的历史数据
+    if (!m_isMutliCoreMode) {
         if (std::isnan(m_cpuInfomodel->cpuAllPercent()))
             m_cpuPercents.insert(0, 0);
         else
             m_cpuPercents.insert(0, m_cpuInfomodel->cpuAllPercent() / 100.0);
+        while (m_cpuPercents.count() > 31)
+            m_cpuPercents.pop_back();
     }
-    while (m_cpuPercents.count() > 31)
-        m_cpuPercents.pop_back();
 
     update();
 }
 
+int CPUDetailGrapTableItem::historySize() const
+{
+    if (m_isMutliCoreMode)
+        return m_cpuInfomodel->cpuUsageHistory().size();
+    return m_cpuPercents.count();
+}
+
+qreal CPUDetailGrapTableItem::percentAt(int age) const
+{
+    if (m_isMutliCoreMode) {
+        // row of this cpu, unknown values are drawn as 0
+        float pc = m_cpuInfomodel->cpuUsageHistory().value(m_index, age);
+        return std::isnan(pc) ? 0 : pc / 100.0;
+    }
+    return m_cpuPercents.value(age);
+}
+
 void CPUDetailGrapTableItem::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
@@ -149,18 +167,18 @@ void CPUDetailGrapTableItem::drawNormalMode(QPainter &painter)
 
     // draw cpu
     painter.setClipRect(graphicRect);
-    if (m_cpuPercents.count() > 0) {
+    if (historySize() > 0) {
         painter.setPen(QPen(m_color, 1.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         painter.setBrush(Qt::NoBrush);
 
         QPainterPath Painterpath;
 
-        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - m_cpuPercents.value(0)) * graphicRect.height() + graphicRect.y());
+        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - percentAt(0)) * graphicRect.height() + graphicRect.y());
         Painterpath.moveTo(sp);
 
         for (int i = 0; i < 30; ++i) {
-            if (m_cpuPercents.count() > i) {
-                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(i + 1))) + graphicRect.x(), (1.0 - m_cpuPercents.value(i + 1)) * graphicRect.height() + graphicRect.y());
+            if (historySize() > i) {
+                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(i + 1))) + graphicRect.x(), (1.0 - percentAt(i + 1)) * graphicRect.height() + graphicRect.y());
                 QPointF c1 = QPointF((sp.x() + ep.x()) / 2, sp.y());
                 QPointF c2 = QPointF((sp.x() + ep.x()) / 2, ep.y());
                 Painterpath.cubicTo(c1, c2, ep);
@@ -183,18 +201,18 @@ void CPUDetailGrapTableItem::drawSimpleMode(QPainter &painter)
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setClipRect(graphicRect);
 
-    if (m_cpuPercents.count() > 0) {
+    if (historySize() > 0) {
         painter.setPen(QPen(m_color, 1.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         painter.setBrush(Qt::NoBrush);
 
         QPainterPath Painterpath;
 
-        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - m_cpuPercents.value(0)) * graphicRect.height() + graphicRect.y());
+        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - percentAt(0)) * graphicRect.height() + graphicRect.y());
         Painterpath.moveTo(sp);
 
         for (int i = 0; i < 30; ++i) {
-            if (m_cpuPercents.count() > i) {
-                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(i + 1))) + graphicRect.x(), (1.0 - m_cpuPercents.value(i + 1)) * graphicRect.height() + graphicRect.y());
+            if (historySize() > i) {
+                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(i + 1))) + graphicRect.x(), (1.0 - percentAt(i + 1)) * graphicRect.height() + graphicRect.y());
                 QPointF c1 = QPointF((sp.x() + ep.x()) / 2, sp.y());
                 QPointF c2 = QPointF((sp.x() + ep.x()) / 2, ep.y());
                 Painterpath.cubicTo(c1, c2, ep);
@@ -219,7 +237,7 @@ void CPUDetailGrapTableItem::drawTextMode(QPainter &painter)
     painter.drawRect(rect);
 
     painter.setPen(m_color);
-    painter.drawText(rect, Qt::AlignCenter, QString::number(m_cpuPercents.value(m_index) * 100, 'f', 1) + "%");
+    painter.drawText(rect, Qt::AlignCenter, QString::number(percentAt(0) * 100, 'f', 1) + "%");
 }
 
 void CPUDetailGrapTableItem::drawSingleCoreMode(QPainter &painter)
@@ -254,18 +272,18 @@ void CPUDetailGrapTableItem::drawSingleCoreMode(QPainter &painter)
 
     // draw cpu
     painter.setClipRect(graphicRect);
-    if (m_cpuPercents.count() > 0) {
+    if (historySize() > 0) {
         painter.setPen(QPen(m_color, 1.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         painter.setBrush(Qt::NoBrush);
 
         QPainterPath Painterpath;
 
-        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - m_cpuPercents.value(0)) * graphicRect.height() + graphicRect.y());
+        QPointF sp = QPointF(graphicRect.width() + graphicRect.x(), (1.0 - percentAt(0)) * graphicRect.height() + graphicRect.y());
         Painterpath.moveTo(sp);
 
         for (int i = 0; i < 30; ++i) {
-            if (m_cpuPercents.count() > 0) {
-                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(1))) + graphicRect.x(), (1.0 - m_cpuPercents.value(1)) * graphicRect.height() + graphicRect.y());
+            if (historySize() > 0) {
+                QPointF ep = QPointF((graphicRect.width() - static_cast<double>(graphicRect.width()) / (30.0 / static_cast<double>(1))) + graphicRect.x(), (1.0 - percentAt(1)) * graphicRect.height() + graphicRect.y());
                 QPointF c1 = QPointF((sp.x() + ep.x()) / 2, sp.y());
                 QPointF c2 = QPointF((sp.x() + ep.x()) / 2, ep.y());
                 Painterpath.cubicTo(c1, c2, ep);
@@ -323,8 +341,10 @@ CPUDetailWidget::CPUDetailWidget(QWidget *parent) : BaseDetailViewWidget(parent)
 
     m_graphicsTable = new CPUDetailGrapTable(cpuInfomodel, this);
     m_summary  = new  CPUDetailSummaryTable(cpuInfomodel, this);
+    m_pressure = new PressureViewWidget(core::system::PressureInfo::kCPUPressure, this);
 
     m_centralLayout->addWidget(m_graphicsTable);
+    m_centralLayout->addWidget(m_pressure);
     m_centralLayout->addWidget(m_summary);
 
     setTitle(DApplication::translate("Process.Graph.View", "CPU"));
@@ -344,6 +364,7 @@ void CPUDetailWidget::detailFontChanged(const QFont &font)
 {
     BaseDetailViewWidget::detailFontChanged(font);
     m_summary->fontChanged(font);
+    m_pressure->fontChanged(font);
 }
 
 CPUDetailGrapTable::CPUDetailGrapTable(CPUInfoModel *model, QWidget *parent): QWidget(parent)
@@ -403,6 +424,16 @@ void CPUDetailGrapTable::setMultiModeLayout(CPUInfoModel *model)
 
     int cpuCount = int(sysconf(_SC_NPROCESSORS_ONLN));
 
+    // 核数较多时一个控件绘制所有CPU的热力图，代替每个CPU一个曲线控件
+    int heatmapThreshold = Settings::instance()->getOption(kSettingKeyCPUHeatmapThreshold, kDefaultCPUHeatmapThreshold).toInt();
+    if (heatmapThreshold > 0 && cpuCount > heatmapThreshold) {
+        CPUHeatmapWidget *heatmap = new CPUHeatmapWidget(model, this);
+        heatmap->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+        graphicsLayout->addWidget(heatmap, 0, 0);
+        setLayout(graphicsLayout);
+        return;
+    }
+
     QList<QColor> cpuColors;
     cpuColors << "#1094D8"
               << "#F7B300"
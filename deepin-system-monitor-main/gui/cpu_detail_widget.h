@@ -60,7 +60,17 @@ protected:
     void drawBackground(QPainter &painter, const QRect &graphicRect);
 
 private:
-    QList<qreal>  m_cpuPercents;
+    //!
+    //! \brief historySize 可绘制的历史数据个数
+    //!
+    int historySize() const;
+    //!
+    //! \brief percentAt 第age个历史数据（0为最新），范围0~1
+    //!
+    qreal percentAt(int age) const;
+
+private:
+    QList<qreal>  m_cpuPercents;    // 总CPU占用历史，多核模式下不使用
     CPUInfoModel *m_cpuInfomodel = nullptr;
     QColor m_color;
     int m_mode  = 1;        //1:normal 2:simple 3:text
@@ -100,6 +110,7 @@ private:
 };
 
 class CPUDetailSummaryTable;
+class PressureViewWidget;
 class CPUDetailWidget : public BaseDetailViewWidget
 {
     Q_OBJECT
@@ -113,6 +124,7 @@ private slots:
 private:
     CPUDetailGrapTable *m_graphicsTable = nullptr;
     CPUDetailSummaryTable *m_summary = nullptr;
+    PressureViewWidget *m_pressure = nullptr;
 };
 
 #endif // CPU_DETAIL_WIDGET_H
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cpu_heatmap_widget.h"
+#include "model/cpu_info_model.h"
+#include "system/cpu_set.h"
+
+#include <DApplication>
+#include <DApplicationHelper>
+#include <DPalette>
+
+#include <QHelpEvent>
+#include <QPainter>
+#include <QToolTip>
+
+#include <cmath>
+#include <string.h>
+
+DWIDGET_USE_NAMESPACE
+
+using namespace core::system;
+
+// busy colors, low to high
+static const QColor kLowColor("#1094D8");
+static const QColor kHighColor("#FB1818");
+// width of socket labels left of heatmap
+static const int kLabelWidth = 56;
+
+static QRgb blend(const QColor &from, const QColor &to, qreal t)
+{
+    return qRgb(int(from.red() + (to.red() - from.red()) * t),
+                int(from.green() + (to.green() - from.green()) * t),
+                int(from.blue() + (to.blue() - from.blue()) * t));
+}
+
+CPUHeatmapWidget::CPUHeatmapWidget(CPUInfoModel *model, QWidget *parent)
+    : QWidget(parent)
+    , m_model(model)
+    , m_unknownColor(0)
+{
+    setMouseTracking(true);
+    loadColors();
+    loadTopology();
+    redraw();
+
+    connect(m_model, &CPUInfoModel::modelUpdated, this, &CPUHeatmapWidget::updateStat);
+    connect(DApplicationHelper::instance(), &DApplicationHelper::themeTypeChanged, this, &CPUHeatmapWidget::changeTheme);
+}
+
+void CPUHeatmapWidget::updateStat()
+{
+    // cpus went on/off line, rows changed
+    if (loadTopology())
+        redraw();
+    else
+        scroll();
+
+    update();
+}
+
+void CPUHeatmapWidget::changeTheme()
+{
+    loadColors();
+    redraw();
+    update();
+}
+
+bool CPUHeatmapWidget::loadTopology()
+{
+    QVector<cpu_topology_t> rows = m_model->cpuSet()->topology();
+    if (rows.isEmpty()) {
+        // topology unknown, cpus in id order
+        std::shared_ptr<const proc_stat_t> stat = m_model->cpuSet()->procStat();
+        for (int cpu : stat->online)
+            rows << cpu_topology_t {cpu, -1, -1};
+    }
+
+    bool changed = rows.size() != m_rows.size();
+    for (int i = 0; !changed && i < rows.size(); ++i)
+        changed = rows[i].cpu != m_rows[i].cpu || rows[i].socket != m_rows[i].socket;
+    if (!changed)
+        return false;
+
+    m_rows = rows;
+    m_socketStarts.clear();
+    for (int i = 1; i < m_rows.size(); ++i) {
+        if (m_rows[i].socket != m_rows[i - 1].socket)
+            m_socketStarts << i;
+    }
+    return true;
+}
+
+void CPUHeatmapWidget::redraw()
+{
+    const CPUUsageHistory &history = m_model->cpuUsageHistory();
+    int columns = history.capacity();
+    if (m_image.width() != columns || m_image.height() != m_rows.size())
+        m_image = QImage(columns, m_rows.size(), QImage::Format_RGB32);
+
+    for (int y = 0; y < m_image.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(m_image.scanLine(y));
+        for (int x = 0; x < columns; ++x)
+            line[x] = colorOf(history.value(m_rows[y].cpu, columns - 1 - x));
+    }
+}
+
+void CPUHeatmapWidget::scroll()
+{
+    const CPUUsageHistory &history = m_model->cpuUsageHistory();
+    int columns = m_image.width();
+    if (columns <= 0)
+        return;
+
+    for (int y = 0; y < m_image.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(m_image.scanLine(y));
+        memmove(line, line + 1, size_t(columns - 1) * sizeof(QRgb));
+        line[columns - 1] = colorOf(history.latest(m_rows[y].cpu));
+    }
+}
+
+void CPUHeatmapWidget::loadColors()
+{
+    auto palette = DApplicationHelper::instance()->applicationPalette();
+    QColor base = palette.color(QPalette::Base);
+    m_unknownColor = base.rgb();
+
+    // base to blue for the lower half, blue to red for the upper half
+    m_colors.resize(101);
+    for (int pc = 0; pc <= 100; ++pc) {
+        m_colors[pc] = pc <= 50 ? blend(base, kLowColor, pc / 50.) : blend(kLowColor, kHighColor, (pc - 50) / 50.);
+    }
+}
+
+QRgb CPUHeatmapWidget::colorOf(float percent) const
+{
+    if (std::isnan(percent))
+        return m_unknownColor;
+    return m_colors[qBound(0, int(percent + .5f), 100)];
+}
+
+QRect CPUHeatmapWidget::heatmapRect() const
+{
+    int textHeight = fontMetrics().height();
+    return QRect(kLabelWidth, textHeight, width() - kLabelWidth - 1, height() - 2 * textHeight - 1);
+}
+
+void CPUHeatmapWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    QRect rect = heatmapRect();
+    if (rect.width() <= 0 || rect.height() <= 0 || m_image.isNull())
+        return;
+
+    auto palette = DApplicationHelper::instance()->applicationPalette();
+    QColor frameColor = palette.color(DPalette::TextTips);
+    frameColor.setAlphaF(0.3);
+    int textHeight = fontMetrics().height();
+
+    // title & scale
+    painter.setPen(palette.color(DPalette::TextTips));
+    painter.drawText(QRect(0, 0, width(), textHeight), Qt::AlignLeft | Qt::AlignTop,
+                     QString("CPU (%1)").arg(m_rows.size()));
+
+    QRect legend(width() - 101, 2, 100, textHeight - 4);
+    for (int pc = 0; pc <= 100; ++pc) {
+        painter.setPen(QColor(m_colors[pc]));
+        painter.drawLine(legend.x() + pc, legend.top(), legend.x() + pc, legend.bottom());
+    }
+    painter.setPen(palette.color(DPalette::TextTips));
+    painter.drawText(QRect(0, 0, legend.x() - 4, textHeight), Qt::AlignRight | Qt::AlignVCenter, "0%");
+    painter.drawText(QRect(legend.right() - 40, 0, 40, textHeight), Qt::AlignRight | Qt::AlignVCenter, "100%");
+
+    painter.drawText(QRect(rect.x(), rect.bottom() + 1, rect.width(), textHeight), Qt::AlignLeft | Qt::AlignVCenter,
+                     DApplication::translate("CPUDetailGrapTableItem", "60 seconds"));
+    painter.drawText(QRect(rect.x(), rect.bottom() + 1, rect.width(), textHeight), Qt::AlignRight | Qt::AlignVCenter, "0");
+
+    // one pixel per cpu & sample, scaled without smoothing so cells stay sharp
+    painter.drawImage(rect, m_image);
+
+    painter.setPen(QPen(frameColor, 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(rect);
+
+    // socket boundaries & labels
+    qreal rowHeight = qreal(rect.height()) / m_rows.size();
+    QVector<int> starts = m_socketStarts;
+    starts.prepend(0);
+    starts << m_rows.size();
+    for (int i = 0; i + 1 < starts.size(); ++i) {
+        int top = rect.y() + int(starts[i] * rowHeight);
+        int bottom = rect.y() + int(starts[i + 1] * rowHeight);
+        if (i > 0) {
+            painter.setPen(QPen(palette.color(QPalette::Base), 2));
+            painter.drawLine(rect.x(), top, rect.right(), top);
+        }
+        int socket = m_rows[starts[i]].socket;
+        if (socket >= 0 && bottom - top >= textHeight) {
+            painter.setPen(palette.color(DPalette::TextTips));
+            painter.drawText(QRect(0, top, kLabelWidth - 4, bottom - top), Qt::AlignRight | Qt::AlignVCenter,
+                             tr("Socket %1").arg(socket));
+        }
+    }
+}
+
+bool CPUHeatmapWidget::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+
+    auto *helpEvent = static_cast<QHelpEvent *>(event);
+    QRect rect = heatmapRect();
+    if (!rect.contains(helpEvent->pos()) || m_rows.isEmpty() || m_image.isNull()) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    int row = qBound(0, (helpEvent->pos().y() - rect.y()) * m_rows.size() / rect.height(), m_rows.size() - 1);
+    int column = qBound(0, (helpEvent->pos().x() - rect.x()) * m_image.width() / rect.width(), m_image.width() - 1);
+    const cpu_topology_t &topo = m_rows[row];
+    float percent = m_model->cpuUsageHistory().value(topo.cpu, m_image.width() - 1 - column);
+
+    QString text = "CPU" + QString::number(topo.cpu);
+    if (topo.socket >= 0 && topo.core >= 0)
+        text += " " + tr("(socket %1, core %2)").arg(topo.socket).arg(topo.core);
+    text += ": " + (std::isnan(percent) ? QString("-") : QString::number(double(percent), 'f', 1) + "%");
+    QToolTip::showText(helpEvent->globalPos(), text, this);
+    return true;
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPU_HEATMAP_WIDGET_H
+#define CPU_HEATMAP_WIDGET_H
+
+#include "system/cpu.h"
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+
+class CPUInfoModel;
+
+/**
+ * @brief Usage of many cpus as one time x cpu heatmap
+ *
+ * Each row is an online cpu, ordered by socket & core so smt siblings sit next to each other,
+ * each column a sample with the newest on the right. Pixels are kept in a cached image of one
+ * pixel per cpu & sample, which is scrolled by one column per update; painting only scales it.
+ */
+class CPUHeatmapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CPUHeatmapWidget(CPUInfoModel *model, QWidget *parent = nullptr);
+
+public slots:
+    void updateStat();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool event(QEvent *event) override;
+
+private slots:
+    void changeTheme();
+
+private:
+    /**
+     * @brief loadTopology Load rows from cpu topology
+     * @return false if rows did not change
+     */
+    bool loadTopology();
+    // draw whole image from usage history
+    void redraw();
+    // shift image by one column, latest sample goes to the last column
+    void scroll();
+    void loadColors();
+    QRgb colorOf(float percent) const;
+
+    QRect heatmapRect() const;
+
+private:
+    CPUInfoModel *m_model;
+
+    QVector<core::system::cpu_topology_t> m_rows; // cpu of each row
+    QVector<int> m_socketStarts; // first row of each socket but the first
+    QImage m_image; // history capacity x rows
+
+    QVector<QRgb> m_colors; // color of 0~100%
+    QRgb m_unknownColor;
+};
+
+#endif // CPU_HEATMAP_WIDGET_H
@@ -7,6 +7,7 @@
 #include "application.h"
 #include "process_page_widget.h"
 #include "system_service_page_widget.h"
+#include "connection_page_widget.h"
 #include "toolbar.h"
 #include "common/common.h"
 #include "settings.h"
@@ -180,11 +181,13 @@ void MainWindow::initUI()
     m_procPage = new ProcessPageWidget(m_pages);
     m_svcPage = new SystemServicePageWidget(m_pages);
     m_accountProcPage = new UserPageWidget(m_pages);
+    m_connectionPage = new ConnectionPageWidget(m_pages);
 
     m_pages->setContentsMargins(0, 0, 0, 0);
     m_pages->addWidget(m_procPage);
     m_pages->addWidget(m_svcPage);
     m_pages->addWidget(m_accountProcPage);
+    m_pages->addWidget(m_connectionPage);
     m_tbShadow->raise();
 
     installEventFilter(this);
@@ -221,6 +224,13 @@ void MainWindow::initConnections()
         m_tbShadow->show();
         PERF_PRINT_END("POINT-05");
     });
+    connect(m_toolbar, &Toolbar::connectionTabButtonClicked, this, [ = ]() {
+        m_toolbar->clearSearchText();
+        m_pages->setCurrentWidget(m_connectionPage);
+
+        m_tbShadow->raise();
+        m_tbShadow->show();
+    });
     connect(gApp, &Application::backgroundTaskStateChanged, this, [ = ](Application::TaskState state) {
         if (state == Application::kTaskStarted) {
             // save last focused widget inside main window
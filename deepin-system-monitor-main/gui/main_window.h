@@ -18,6 +18,7 @@ class SystemServicePageWidget;
 class ProcessPageWidget;
 class Settings;
 class UserPageWidget;
+class ConnectionPageWidget;
 class MainWindow : public DMainWindow
 {
     Q_OBJECT
@@ -127,6 +128,7 @@ private:
     ProcessPageWidget *m_procPage = nullptr;
     SystemServicePageWidget *m_svcPage = nullptr;
     UserPageWidget *m_accountProcPage = nullptr;
+    ConnectionPageWidget *m_connectionPage = nullptr;
     bool m_initLoad = false;
     DShadowLine *m_tbShadow  = nullptr;
     QWidget *m_focusedWidget = nullptr;
@@ -6,6 +6,7 @@
 #include "mem_detail_view_widget.h"
 #include "mem_stat_view_widget.h"
 #include "mem_summary_view_widget.h"
+#include "pressure_view_widget.h"
 #include "system/system_monitor.h"
 
 #include <DApplicationHelper>
@@ -19,9 +20,11 @@ MemDetailViewWidget::MemDetailViewWidget(QWidget *parent)
     this->setObjectName("MemDetailViewWidget");
     m_memstatWIdget = new MemStatViewWidget(this);
     m_memsummaryWidget = new MemSummaryViewWidget(this);
+    m_pressureWidget = new PressureViewWidget(PressureInfo::kMemoryPressure, this);
 
     setTitle(DApplication::translate("Process.Graph.Title", "Memory"));
     m_centralLayout->addWidget(m_memstatWIdget);
+    m_centralLayout->addWidget(m_pressureWidget);
     m_centralLayout->addWidget(m_memsummaryWidget);
 
     detailFontChanged(DApplication::font());
@@ -44,4 +47,5 @@ void MemDetailViewWidget::detailFontChanged(const QFont &font)
     BaseDetailViewWidget::detailFontChanged(font);
     m_memstatWIdget->fontChanged(font);
     m_memsummaryWidget->fontChanged(font);
+    m_pressureWidget->fontChanged(font);
 }
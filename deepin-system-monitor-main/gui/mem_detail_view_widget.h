@@ -13,6 +13,7 @@
  */
 class MemStatViewWidget;
 class MemSummaryViewWidget;
+class PressureViewWidget;
 class MemDetailViewWidget : public BaseDetailViewWidget
 {
     Q_OBJECT
@@ -27,6 +28,7 @@ public slots:
 private:
     MemStatViewWidget *m_memstatWIdget;
     MemSummaryViewWidget *m_memsummaryWidget;
+    PressureViewWidget *m_pressureWidget;
 };
 
 #endif // MEM_DETAIL_VIEW_WIDGET_H
@@ -25,6 +25,7 @@
 #include "common/thread_manager.h"
 #include "system/system_monitor_thread.h"
 #include "system/netif_info_db.h"
+#include "system/netif_monitor.h"
 
 using namespace core::system;
 using namespace common::format;
@@ -266,13 +267,27 @@ public:
 
                 // 信号强度
                 stInfo.strKey = QApplication::translate("NetInfoModel", "Signal strength");
-                stInfo.strValue = QString("%1 dBm").arg(stNetifInfo->signalLevel());
+                stInfo.strValue = QString("%1 dBm").arg(stNetifInfo->signalDbm());
                 m_listInfo << stInfo;
 
                 // 底噪
                 stInfo.strKey = QApplication::translate("NetInfoModel", "Noise level");
                 stInfo.strValue = QString("%1 dB").arg(stNetifInfo->noiseLevel());
                 m_listInfo << stInfo;
+
+                // 接收速率, 发送速率取自带宽
+                if (stNetifInfo->rxBitrate() > 0) {
+                    stInfo.strKey = QApplication::translate("NetInfoModel", "RX bitrate");
+                    stInfo.strValue = formatUnit_net(stNetifInfo->rxBitrate() / 1000, MB, 0, true);
+                    m_listInfo << stInfo;
+                }
+
+                // 调制编码方案
+                if (stNetifInfo->txMcs() >= 0) {
+                    stInfo.strKey = QApplication::translate("NetInfoModel", "MCS");
+                    stInfo.strValue = QString("%1").arg(stNetifInfo->txMcs());
+                    m_listInfo << stInfo;
+                }
             }
 
             // Mac地址
@@ -344,6 +359,14 @@ public:
             stInfo.strKey = QApplication::translate("NetInfoModel", "TX carrier");
             stInfo.strValue = QString("%1").arg(stNetifInfo->txCarrier());
             m_listInfo << stInfo;
+
+            // 抓包内核丢包数, 仅限正在抓包的网卡
+            capture_stat_t captureStat;
+            if (NetifMonitor::instance()->captureStat(QString(stNetifInfo->ifname()), captureStat)) {
+                stInfo.strKey = QApplication::translate("NetInfoModel", "Capture dropped");
+                stInfo.strValue = QString("%1").arg(captureStat.dropped_packets);
+                m_listInfo << stInfo;
+            }
         }
         endResetModel();
     }
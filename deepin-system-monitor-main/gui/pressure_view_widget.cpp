@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "pressure_view_widget.h"
+#include "chart_view_widget.h"
+#include "system/device_db.h"
+#include "system/system_monitor.h"
+
+#include <QPainter>
+#include <QtMath>
+
+#include <DApplication>
+#include <DApplicationHelper>
+
+DWIDGET_USE_NAMESPACE
+
+using namespace core::system;
+
+// chart height, without title
+const int kPressureChartHeight = 60;
+
+PressureViewWidget::PressureViewWidget(PressureInfo::Resource res, QWidget *parent)
+    : QWidget(parent)
+    , m_res(res)
+{
+    m_chartWidget = new ChartViewWidget(ChartViewWidget::ChartViewTypes::MEM_CHART, this);
+    m_chartWidget->setData1Color(someColor);
+    m_chartWidget->setData2Color(fullColor);
+
+    m_pressureInfo = DeviceDB::instance()->pressureInfo();
+
+    fontChanged(DApplication::font());
+    onModelUpdate();
+    connect(SystemMonitor::instance(), &SystemMonitor::statInfoUpdated, this, &PressureViewWidget::onModelUpdate);
+}
+
+void PressureViewWidget::fontChanged(const QFont &font)
+{
+    m_font = font;
+    setFixedHeight(QFontMetrics(m_font).height() * 2 + kPressureChartHeight);
+    updateWidgetGeometry();
+}
+
+void PressureViewWidget::onModelUpdate()
+{
+    // no psi support (CONFIG_PSI=n or psi=0)
+    if (!m_pressureInfo->available(m_res)) {
+        setVisible(false);
+        return;
+    }
+
+    // stall share between updates, 0~1 like memory usage
+    m_chartWidget->addData1(m_pressureInfo->someStall(m_res));
+    if (m_pressureInfo->stat(m_res).hasFull)
+        m_chartWidget->addData2(m_pressureInfo->fullStall(m_res));
+    update();
+}
+
+void PressureViewWidget::updateWidgetGeometry()
+{
+    int fontHeight = QFontMetrics(m_font).height();
+    m_chartWidget->setGeometry(0, fontHeight, this->width(), this->height() - fontHeight);
+}
+
+void PressureViewWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    updateWidgetGeometry();
+}
+
+void PressureViewWidget::paintEvent(QPaintEvent *event)
+{
+    QWidget::paintEvent(event);
+    QPainter painter(this);
+    QFont font = m_font;
+    font.setPointSizeF(font.pointSizeF() - 1);
+    painter.setFont(font);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    auto *dAppHelper = DApplicationHelper::instance();
+    auto palette = dAppHelper->applicationPalette();
+
+    int spacing = 10;
+    int sectionSize = 6;
+    int textHeight = painter.fontMetrics().height();
+    const psi_stat_t &stat = m_pressureInfo->stat(m_res);
+
+    // legend: some, full
+    int x = 0;
+    auto drawLegend = [&](const QColor & color, const QString & text) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(color);
+        painter.drawEllipse(x, qCeil((textHeight - sectionSize) / 2.0), sectionSize, sectionSize);
+        x += sectionSize + spacing;
+
+        QRect rect(x, 0, painter.fontMetrics().width(text), textHeight);
+        painter.setPen(palette.color(DPalette::TextTips));
+        painter.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, text);
+        x = rect.right() + spacing;
+    };
+    drawLegend(someColor, tr("Some stalled"));
+    if (stat.hasFull)
+        drawLegend(fullColor, tr("Full stalled"));
+
+    // kernel averages of some
+    QString avg = tr("Pressure %1% / %2% / %3% (10s / 60s / 300s)")
+                  .arg(double(stat.some.avg10), 0, 'f', 2)
+                  .arg(double(stat.some.avg60), 0, 'f', 2)
+                  .arg(double(stat.some.avg300), 0, 'f', 2);
+    painter.setPen(palette.color(DPalette::TextTips));
+    painter.drawText(QRect(x, 0, width() - x, textHeight), Qt::AlignRight | Qt::AlignVCenter, avg);
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PRESSURE_VIEW_WIDGET_H
+#define PRESSURE_VIEW_WIDGET_H
+
+#include "system/pressure.h"
+
+#include <QWidget>
+
+class ChartViewWidget;
+
+/**
+ * @brief Pressure stall chart of one resource
+ *
+ * Plots the share of time tasks stalled on the resource between two updates, some & full,
+ * with the kernel's 10s/60s/300s averages as text. Hidden if the resource has no pressure info.
+ */
+class PressureViewWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PressureViewWidget(core::system::PressureInfo::Resource res, QWidget *parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
+
+public slots:
+    void fontChanged(const QFont &font);
+    void onModelUpdate();
+
+private:
+    void updateWidgetGeometry();
+
+private:
+    QColor someColor {"#F7B300"};
+    QColor fullColor {"#FB1818"};
+
+    ChartViewWidget *m_chartWidget;
+
+    core::system::PressureInfo *m_pressureInfo;
+    core::system::PressureInfo::Resource m_res;
+
+    QFont m_font;
+};
+
+#endif // PRESSURE_VIEW_WIDGET_H
@@ -6,6 +6,9 @@
 #include "process_attribute_dialog.h"
 
 #include "settings.h"
+#include "connection_table_view.h"
+#include "system/pressure.h"
+#include "system/system_monitor.h"
 #include "common/common.h"
 
 #include <DApplication>
@@ -58,6 +61,14 @@ ProcessAttributeDialog::ProcessAttributeDialog(pid_t pid,
     m_procNameText->viewport()->installEventFilter(this);
     m_procCmdText->viewport()->installEventFilter(this);
     m_procStartText->viewport()->installEventFilter(this);
+
+    updatePressure();
+    connect(core::system::SystemMonitor::instance(), &core::system::SystemMonitor::statInfoUpdated,
+            this, &ProcessAttributeDialog::updatePressure);
+}
+
+ProcessAttributeDialog::~ProcessAttributeDialog()
+{
 }
 
 // initialize ui components
@@ -179,8 +190,22 @@ void ProcessAttributeDialog::initUI()
     wnd->setLayout(grid);
     vlayout->addWidget(wnd, 0, Qt::AlignCenter);
 
-    // spacing
-    vlayout->addStretch(1);
+    // sockets of the process, takes the remaining space
+    m_connectionLabel = new DLabel(DApplication::translate("Process.Attributes.Dialog", "Connections"), m_frame);
+    DFontSizeManager::instance()->bind(m_connectionLabel, DFontSizeManager::T6, QFont::Medium);
+    vlayout->addWidget(m_connectionLabel, 0, Qt::AlignLeft);
+    m_connectionView = new ConnectionTableView(m_pid, m_frame);
+    vlayout->addWidget(m_connectionView, 2);
+
+    // pressure of the cgroup the process runs in, cgroup v2 only
+    QByteArray cgroup = core::system::PressureInfo::cgroupOf(m_pid);
+    m_pressureInfo.reset(new core::system::PressureInfo(cgroup));
+    m_pressureLabel = new DLabel(DApplication::translate("Process.Attributes.Dialog", "Cgroup pressure"), m_frame);
+    DFontSizeManager::instance()->bind(m_pressureLabel, DFontSizeManager::T6, QFont::Medium);
+    m_pressureLabel->setToolTip(QString(cgroup));
+    vlayout->addWidget(m_pressureLabel, 0, Qt::AlignLeft);
+    m_pressureText = new DLabel(m_frame);
+    vlayout->addWidget(m_pressureText, 0, Qt::AlignLeft);
 
     // fill icon & text content
     appIcon->setFixedSize(kAppIconSize, kAppIconSize);
@@ -235,6 +260,34 @@ void ProcessAttributeDialog::resizeItemWidget()
     m_procCmdText->verticalScrollBar()->setValue(0);
 }
 
+// refresh cgroup pressure, some avg10 of each resource
+void ProcessAttributeDialog::updatePressure()
+{
+    using core::system::PressureInfo;
+
+    m_pressureInfo->update();
+    // no cgroup v2 or psi support, or process gone
+    if (!m_pressureInfo->available()) {
+        m_pressureLabel->hide();
+        m_pressureText->hide();
+        return;
+    }
+
+    const QString names[PressureInfo::kPressureResourceCount] = {
+        DApplication::translate("Process.Graph.View", "CPU"),
+        DApplication::translate("Process.Graph.Title", "Memory"),
+        DApplication::translate("Process.Attributes.Dialog", "IO")
+    };
+    QStringList items;
+    for (int i = 0; i < PressureInfo::kPressureResourceCount; ++i) {
+        auto res = PressureInfo::Resource(i);
+        if (!m_pressureInfo->available(res))
+            continue;
+        items << QString("%1 %2%").arg(names[i]).arg(double(m_pressureInfo->stat(res).some.avg10), 0, 'f', 2);
+    }
+    m_pressureText->setText(items.join("    "));
+}
+
 // close event handler
 void ProcessAttributeDialog::closeEvent(QCloseEvent *event)
 {
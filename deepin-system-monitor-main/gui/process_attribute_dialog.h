@@ -13,12 +13,21 @@
 #include <DTextBrowser>
 #include <DWidget>
 
+#include <memory>
+
 DWIDGET_USE_NAMESPACE
 
 class Settings;
 class QHBoxLayout;
 class QVBoxLayout;
 class QGridLayout;
+class ConnectionTableView;
+
+namespace core {
+namespace system {
+class PressureInfo;
+}
+}
 
 /**
  * @brief Dialog shown to user when process attribute requested by user
@@ -45,6 +54,7 @@ public:
                                     const QIcon &icon,
                                     time_t startTime,
                                     QWidget *parent = nullptr);
+    ~ProcessAttributeDialog() override;
 
 private:
     /**
@@ -72,6 +82,12 @@ protected:
      */
     bool eventFilter(QObject *obj, QEvent *event);
 
+private slots:
+    /**
+     * @brief updatePressure Refresh pressure of process cgroup
+     */
+    void updatePressure();
+
 private:
     // Global settings instance
     Settings *m_settings;
@@ -106,6 +122,16 @@ private:
     DLabel *m_procStartLabel {};
     // Process start time text
     DTextBrowser *m_procStartText {};
+    // Process connections label
+    DLabel *m_connectionLabel {};
+    // Sockets of the process
+    ConnectionTableView *m_connectionView {};
+    // Process cgroup pressure label
+    DLabel *m_pressureLabel {};
+    // Process cgroup pressure text
+    DLabel *m_pressureText {};
+    // Pressure info of process cgroup
+    std::unique_ptr<core::system::PressureInfo> m_pressureInfo;
 
     // Max label width
     int m_maxLabelWidth {0};
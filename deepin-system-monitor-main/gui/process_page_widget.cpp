@@ -39,6 +39,8 @@
 #include <QTimer>
 #include <QPainterPath>
 #include <QSizePolicy>
+
+#include <algorithm>
 //loading显示时间（ms）
 #define NORMAL_PERFORMANCE_CPU_LOADING_TIME 100
 #define CPU_FREQUENCY_STANDARD "2.30GHz"
@@ -413,16 +415,10 @@ void ProcessPageWidget::onStatInfoUpdated()
     QApplication::processEvents();
     const QString &buf = DApplication::translate("Process.Summary", kProcSummaryTemplateText);
 
-    ProcessSet *processSet = ProcessDB::instance()->processSet();
+    ProcessSnapshotPtr snapshot = ProcessDB::instance()->snapshot();
     //记录所有进程数量
-    const QList<pid_t> &newpidlst = processSet->getPIDList();
-    m_iallProcNum = newpidlst.size();
-    int appCount = 0;
-    for (const auto &pid : newpidlst) {
-        auto process = processSet->getProcessById(pid);
-        if (process.appType() == kFilterApps)
-            appCount++;
-    }
+    m_iallProcNum = snapshot->size();
+    int appCount = int(std::count(snapshot->appType().cbegin(), snapshot->appType().cend(), int(kFilterApps)));
     m_procViewModeSummary->setText(buf.arg(appCount).arg(m_iallProcNum));
     m_model = CPUInfoModel::instance();
 
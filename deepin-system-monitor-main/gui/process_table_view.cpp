@@ -110,7 +110,9 @@ void ProcessTableView::onThemeTypeChanged()
 
 QString ProcessTableView::getProcessName(int pid)
 {
-    return m_model->getProcess(qvariant_cast<pid_t>(pid)).name();
+    const ProcessSnapshot &snapshot = m_model->snapshot();
+    int row = snapshot.indexOf(qvariant_cast<pid_t>(pid));
+    return row >= 0 ? snapshot.name(row) : QString();
 }
 
 // event filter
@@ -163,11 +165,10 @@ void ProcessTableView::endProcess()
                      DDialog::ButtonWarning);
     dialog.exec();
     if (dialog.result() == QMessageBox::Ok) {
-        Process proc = m_model->getProcess(qvariant_cast<pid_t>(m_selectedPID));
         QJsonObject obj{
             {"tid", EventLogUtils::ProcessKilled},
             {"version", QCoreApplication::applicationVersion()},
-            {"process_name", proc.name()}
+            {"process_name", getProcessName(qvariant_cast<pid_t>(m_selectedPID))}
         };
         EventLogUtils::get().writeLogs(obj);
 
@@ -206,19 +207,21 @@ void ProcessTableView::openExecDirWithFM()
     // selection check needed
     if (m_selectedPID.isValid()) {
         pid_t pid = qvariant_cast<pid_t>(m_selectedPID);
-        const Process &proc = ProcessDB::instance()->processSet()->getProcessById(pid);
-        QString cmdline =  proc.cmdlineString();
+        // hold one published snapshot for the whole lookup, including the parent walk below
+        ProcessSnapshotPtr snapshot = ProcessDB::instance()->snapshot();
+        int row = snapshot->indexOf(pid);
+        QString cmdline = row >= 0 ? snapshot->cmdline(row) : QString();
 
         if (cmdline.size() > 0) {
             // Found wine program location if cmdline starts with c://.
             if (cmdline.startsWith("c:")) {
-                QString winePrefix =  proc.environ().value("WINEPREFIX");
+                QString winePrefix =  snapshot->environ(row).value("WINEPREFIX");
                 cmdline = cmdline.replace("\\", "/").replace("c:/", "/drive_c/");
 
                 const QString &path = QString(winePrefix + cmdline).trimmed();
                 common::openFilePathItem(path);
             } else {
-                QString flatpakAppidEnv = proc.environ().value("FLATPAK_APPID");
+                QString flatpakAppidEnv = snapshot->environ(row).value("FLATPAK_APPID");
                 // Else find program location through 'which' command.
                 if (flatpakAppidEnv == "") {
                     QProcess whichProcess;
@@ -240,16 +243,16 @@ void ProcessTableView::openExecDirWithFM()
                         if (nsSize > 0 && nsSelfSize > 0) {
                             QString nsPathStr(nsPath), nsSelfPathStr(nsSelfPath);
                             if (nsPathStr != nsSelfPathStr) {
-                                Process preProc = proc, curProc = proc;
+                                int preRow = row, curRow = row;
                                 int count = 0;
                                 // 100次循环
-                                while (curProc.name() != "ll-box" && curProc.pid() != 0 && count != 100) {
-                                    preProc = curProc;
-                                    curProc = ProcessDB::instance()->processSet()->getProcessById(preProc.ppid());
+                                while (curRow >= 0 && snapshot->name(curRow) != "ll-box" && count != 100) {
+                                    preRow = curRow;
+                                    curRow = snapshot->indexOf(snapshot->ppid()[preRow]);
                                     count++;
                                 }
-                                if (curProc.pid() != 0 || count != 100) {
-                                    pid = preProc.pid();
+                                if (curRow >= 0 || count != 100) {
+                                    pid = snapshot->pid()[preRow];
                                 }
                                 char exePath[PATH_MAX] = {0};
                                 auto exeSize = readlink(QString("/proc/%1/exe").arg(pid).toStdString().c_str(), exePath, PATH_MAX);
@@ -310,13 +313,16 @@ void ProcessTableView::showProperties()
     if (m_selectedPID.isValid()) {
         pid_t pid = qvariant_cast<pid_t>(m_selectedPID);
         // get process entry item from model
-        auto proc = m_model->getProcess(pid);
+        const ProcessSnapshot &snapshot = m_model->snapshot();
+        int row = snapshot.indexOf(pid);
+        if (row < 0)
+            return;
         auto *attr = new ProcessAttributeDialog(pid,
-                                                proc.name(),
-                                                proc.displayName(),
-                                                proc.cmdlineString(),
-                                                proc.icon(),
-                                                proc.startTime(),
+                                                snapshot.name(row),
+                                                snapshot.displayName(row),
+                                                snapshot.cmdline(row),
+                                                snapshot.icon(row),
+                                                snapshot.startTime(row),
                                                 this);
         attr->show();
     }
@@ -344,11 +350,10 @@ void ProcessTableView::killProcess()
                      DDialog::ButtonWarning);
     dialog.exec();
     if (dialog.result() == QMessageBox::Ok) {
-        Process proc = m_model->getProcess(qvariant_cast<pid_t>(m_selectedPID));
         QJsonObject obj{
             {"tid", EventLogUtils::ProcessKilled},
             {"version", QCoreApplication::applicationVersion()},
-            {"process_name", proc.name()}
+            {"process_name", getProcessName(qvariant_cast<pid_t>(m_selectedPID))}
         };
         EventLogUtils::get().writeLogs(obj);
         ProcessDB::instance()->killProcess(qvariant_cast<pid_t>(m_selectedPID));
@@ -990,12 +995,6 @@ void ProcessTableView::customizeProcessPriority()
     if (m_selectedPID.isValid()) {
         pid_t pid = qvariant_cast<pid_t>(m_selectedPID);
         slider->setValue(m_model->getProcessPriorityValue(pid));
-        Process selectedProcess = m_model->getProcess(pid);
-        int selectedPriority = kNormalPriority;
-        if (selectedProcess.isValid()) {
-            selectedPriority = ProcessDB::instance()->processSet()->getProcessById(pid).priority();
-        }
-        slider->setValue(selectedPriority);
         prio = QString("%1").arg(slider->value());
         slider->setTipValue(prio);
     }
@@ -37,7 +37,7 @@ Toolbar::Toolbar(QWidget *parent)
 
     // tab button group
     m_switchFuncTabBtnGrp = new CustomButtonBox(this);
-    m_switchFuncTabBtnGrp->setFixedWidth(240);
+    m_switchFuncTabBtnGrp->setFixedWidth(360);
     // process tab button instance
     m_procBtn = new DButtonBoxButton(
         DApplication::translate("Title.Bar.Switch", "Processes"), m_switchFuncTabBtnGrp);
@@ -60,8 +60,15 @@ Toolbar::Toolbar(QWidget *parent)
     m_accountProcBtn->setFocusPolicy(Qt::TabFocus);
 
     DFontSizeManager::instance()->bind(m_accountProcBtn, DFontSizeManager::T7, QFont::Medium);
+    // connection tab button instance
+    m_connectionBtn = new DButtonBoxButton(
+        DApplication::translate("Title.Bar.Switch", "Connections"), m_switchFuncTabBtnGrp);
+    m_connectionBtn->setCheckable(true);
+    m_connectionBtn->setFocusPolicy(Qt::TabFocus);
+
+    DFontSizeManager::instance()->bind(m_connectionBtn, DFontSizeManager::T7, QFont::Medium);
     QList<DButtonBoxButton *> list;
-    list << m_procBtn << m_svcBtn << m_accountProcBtn;
+    list << m_procBtn << m_svcBtn << m_accountProcBtn << m_connectionBtn;
     m_switchFuncTabBtnGrp->setButtonList(list, true);
 
     // move focus to process tab button when toolbar got focus
@@ -71,11 +78,13 @@ Toolbar::Toolbar(QWidget *parent)
     m_procBtn->installEventFilter(this);
     m_svcBtn->installEventFilter(this);
     m_accountProcBtn->installEventFilter(this);
+    m_connectionBtn->installEventFilter(this);
 
     // emit button clicked signal when process or service tab button toggled
     connect(m_procBtn, &DButtonBoxButton::toggled, this, [ = ](bool) { Q_EMIT procTabButtonClicked(); });
     connect(m_svcBtn, &DButtonBoxButton::toggled, this, [ = ](bool) { Q_EMIT serviceTabButtonClicked(); });
     connect(m_accountProcBtn, &DButtonBoxButton::toggled, this, [ = ](bool) { Q_EMIT accountProcTabButtonClicked(); });
+    connect(m_connectionBtn, &DButtonBoxButton::toggled, this, [ = ](bool) { Q_EMIT connectionTabButtonClicked(); });
     // search text editor instance
     searchEdit = new DSearchEdit(this);
     // set the search edit text max length
@@ -104,11 +113,13 @@ Toolbar::Toolbar(QWidget *parent)
             m_procBtn->setEnabled(false);
             m_svcBtn->setEnabled(false);
             m_accountProcBtn->setEnabled(false);
+            m_connectionBtn->setEnabled(false);
             searchEdit->setEnabled(false);
         } else {
             m_procBtn->setEnabled(true);
             m_svcBtn->setEnabled(true);
             m_accountProcBtn->setEnabled(true);
+            m_connectionBtn->setEnabled(true);
             searchEdit->setEnabled(true);
         }
     });
@@ -157,6 +168,13 @@ bool Toolbar::eventFilter(QObject *obj, QEvent *event)
                 m_accountProcBtn->setFocus();
                 return true;
             }
+        } else if (obj == m_connectionBtn) {
+            // set focus to user tab button when left key pressed
+            auto *kev = dynamic_cast<QKeyEvent *>(event);
+            if (kev->key() == Qt::Key_Left) {
+                m_accountProcBtn->setFocus();
+                return true;
+            }
         }
     }  
 
@@ -109,6 +109,10 @@ Q_SIGNALS:
      * @brief User Procss tab button triggered signal
      */
     void accountProcTabButtonClicked();
+    /**
+     * @brief Connection tab button triggered signal
+     */
+    void connectionTabButtonClicked();
 
 private:
     // Button group
@@ -119,6 +123,8 @@ private:
     DButtonBoxButton *m_svcBtn {nullptr};
     // User Process tab button
     DButtonBoxButton *m_accountProcBtn {nullptr};
+    // Connection tab button
+    DButtonBoxButton *m_connectionBtn {nullptr};
     // Search text input
     DSearchEdit *searchEdit {nullptr};
 
@@ -0,0 +1,287 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "connection_table_model.h"
+#include "process/process_db.h"
+#include "system/system_monitor.h"
+#include "common/common.h"
+
+#include <QApplication>
+#include <QHash>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+using namespace common;
+using namespace common::format;
+using namespace core::system;
+
+ConnectionTableModel::ConnectionTableModel(pid_t pid, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_pid(pid)
+    , m_snapshot(std::make_shared<const ConnectionSnapshot>())
+{
+    connect(SystemMonitor::instance(), &SystemMonitor::statInfoUpdated, this, &ConnectionTableModel::updateModel);
+}
+
+ConnectionTableModel::~ConnectionTableModel()
+{
+    setActive(false);
+}
+
+void ConnectionTableModel::setActive(bool active)
+{
+    if (m_active == active)
+        return;
+
+    m_active = active;
+    ProcessDB::instance()->watchConnections(active);
+}
+
+void ConnectionTableModel::updateModel()
+{
+    if (!m_active)
+        return;
+
+    // hold the published table, monitor thread may publish a newer one meanwhile
+    m_snapshot = ProcessDB::instance()->connections();
+    const ConnectionSnapshot &snapshot = *m_snapshot;
+
+    // remap existing rows first, rows of closed sockets map to -1
+    QHash<QPair<pid_t, ino_t>, int> oldRows;
+    oldRows.reserve(m_keys.size());
+    for (int row = 0; row < m_keys.size(); ++row) {
+        oldRows.insert(m_keys[row], row);
+        m_rows[row] = snapshot.indexOf(m_keys[row].first, m_keys[row].second);
+    }
+
+    // remove closed sockets, one contiguous run at a time from the last row so earlier rows keep their index
+    int last = m_keys.size() - 1;
+    while (last >= 0) {
+        if (m_rows[last] >= 0) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && m_rows[first - 1] < 0)
+            --first;
+
+        beginRemoveRows({}, first, last);
+        m_keys.remove(first, last - first + 1);
+        m_rows.remove(first, last - first + 1);
+        m_values.remove(first, last - first + 1);
+        endRemoveRows();
+        last = first - 1;
+    }
+
+    // states & rates of remaining rows, one dataChanged per run of changed rows; most sockets are idle,
+    // so a sorting proxy only re-places the few rows with traffic instead of the whole table
+    int changedFirst = -1;
+    for (int row = 0; row <= m_keys.size(); ++row) {
+        bool changed = false;
+        if (row < m_keys.size()) {
+            row_value_t value = valueOf(snapshot.at(m_rows[row]));
+            const row_value_t &last = m_values[row];
+            changed = value.state != last.state || value.recvBps != last.recvBps || value.sentBps != last.sentBps;
+            m_values[row] = value;
+        }
+
+        if (changed && changedFirst < 0) {
+            changedFirst = row;
+        } else if (!changed && changedFirst >= 0) {
+            Q_EMIT dataChanged(index(changedFirst, kConnectionStateColumn), index(row - 1, kConnectionUploadColumn));
+            changedFirst = -1;
+        }
+    }
+
+    // append new sockets at once
+    QVector<int> born;
+    for (int srow = 0; srow < snapshot.size(); ++srow) {
+        const connection_t &conn = snapshot.at(srow);
+        if (m_pid >= 0 && conn.pid != m_pid)
+            continue;
+        if (!oldRows.contains(qMakePair(conn.pid, conn.sock->ino)))
+            born << srow;
+    }
+    if (!born.isEmpty()) {
+        int first = m_keys.size();
+        beginInsertRows({}, first, first + born.size() - 1);
+        for (int srow : born) {
+            const connection_t &conn = snapshot.at(srow);
+            m_keys << qMakePair(conn.pid, conn.sock->ino);
+            m_rows << srow;
+            m_values << valueOf(conn);
+        }
+        endInsertRows();
+    }
+}
+
+int ConnectionTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_keys.size();
+}
+
+int ConnectionTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : kConnectionColumnCount;
+}
+
+QVariant ConnectionTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size())
+        return {};
+
+    int srow = m_rows[index.row()];
+    if (srow < 0 || srow >= m_snapshot->size())
+        return {};
+
+    const connection_t &conn = m_snapshot->at(srow);
+    const sock_stat_t &sock = *conn.sock;
+
+    if (role == Qt::DisplayRole || role == Qt::AccessibleTextRole) {
+        switch (index.column()) {
+        case kConnectionProcessColumn:
+            return conn.pid > 0 ? conn.name : QStringLiteral("-");
+        case kConnectionPIDColumn:
+            return conn.pid > 0 ? QString::number(conn.pid) : QStringLiteral("-");
+        case kConnectionProtocolColumn: {
+            QString proto = (sock.proto == IPPROTO_TCP) ? QStringLiteral("tcp") : QStringLiteral("udp");
+            return (sock.sa_family == AF_INET6) ? proto + '6' : proto;
+        }
+        case kConnectionLocalAddressColumn:
+            return formatAddress(sock.sa_family, &sock.s_addr, sock.s_port);
+        case kConnectionRemoteAddressColumn:
+            return formatAddress(sock.sa_family, &sock.d_addr, sock.d_port);
+        case kConnectionStateColumn:
+            return stateName(sock.state);
+        case kConnectionDownloadColumn:
+            return formatUnit_net(8 * conn.recvBps, B, 1, true);
+        case kConnectionUploadColumn:
+            return formatUnit_net(8 * conn.sentBps, B, 1, true);
+        default:
+            break;
+        }
+    } else if (role == Qt::UserRole) {
+        // raw data to sort on
+        switch (index.column()) {
+        case kConnectionProcessColumn:
+            return conn.name;
+        case kConnectionPIDColumn:
+            return conn.pid;
+        case kConnectionLocalAddressColumn:
+            return sock.s_port;
+        case kConnectionRemoteAddressColumn:
+            return sock.d_port;
+        case kConnectionStateColumn:
+            return sock.state;
+        case kConnectionDownloadColumn:
+            return conn.recvBps;
+        case kConnectionUploadColumn:
+            return conn.sentBps;
+        default:
+            return data(index, Qt::DisplayRole);
+        }
+    } else if (role == Qt::TextAlignmentRole) {
+        return QVariant(Qt::AlignLeft | Qt::AlignVCenter);
+    }
+
+    return {};
+}
+
+QVariant ConnectionTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::DisplayRole || role == Qt::AccessibleTextRole) {
+        switch (section) {
+        case kConnectionProcessColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionProcess);
+        case kConnectionPIDColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionPID);
+        case kConnectionProtocolColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionProtocol);
+        case kConnectionLocalAddressColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionLocalAddress);
+        case kConnectionRemoteAddressColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionRemoteAddress);
+        case kConnectionStateColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionState);
+        case kConnectionDownloadColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionDownload);
+        case kConnectionUploadColumn:
+            return QApplication::translate("Connection.Table.Header", kConnectionUpload);
+        default:
+            break;
+        }
+    } else if (role == Qt::TextAlignmentRole) {
+        return QVariant(Qt::AlignLeft | Qt::AlignVCenter);
+    } else if (role == Qt::InitialSortOrderRole) {
+        return QVariant::fromValue(Qt::DescendingOrder);
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags ConnectionTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemNeverHasChildren;
+}
+
+QString ConnectionTableModel::stateName(uint state)
+{
+    switch (state) {
+    case TCP_ESTABLISHED:
+        return QStringLiteral("ESTAB");
+    case TCP_SYN_SENT:
+        return QStringLiteral("SYN-SENT");
+    case TCP_SYN_RECV:
+        return QStringLiteral("SYN-RECV");
+    case TCP_FIN_WAIT1:
+        return QStringLiteral("FIN-WAIT-1");
+    case TCP_FIN_WAIT2:
+        return QStringLiteral("FIN-WAIT-2");
+    case TCP_TIME_WAIT:
+        return QStringLiteral("TIME-WAIT");
+    case TCP_CLOSE:
+        // unconnected udp sockets are in this state as well
+        return QStringLiteral("UNCONN");
+    case TCP_CLOSE_WAIT:
+        return QStringLiteral("CLOSE-WAIT");
+    case TCP_LAST_ACK:
+        return QStringLiteral("LAST-ACK");
+    case TCP_LISTEN:
+        return QStringLiteral("LISTEN");
+    case TCP_CLOSING:
+        return QStringLiteral("CLOSING");
+    default:
+        return QStringLiteral("UNKNOWN");
+    }
+}
+
+QString ConnectionTableModel::formatAddress(int family, const void *addr, uint port)
+{
+    QString host;
+    if (family == AF_INET6) {
+        auto *in6 = reinterpret_cast<const in6_addr *>(addr);
+        if (IN6_IS_ADDR_UNSPECIFIED(in6)) {
+            host = QStringLiteral("*");
+        } else {
+            char buf[INET6_ADDRSTRLEN] {};
+            inet_ntop(AF_INET6, in6, buf, sizeof(buf));
+            host = QString("[%1]").arg(buf);
+        }
+    } else {
+        auto *in4 = reinterpret_cast<const in_addr *>(addr);
+        if (in4->s_addr == htonl(INADDR_ANY)) {
+            host = QStringLiteral("*");
+        } else {
+            char buf[INET_ADDRSTRLEN] {};
+            inet_ntop(AF_INET, in4, buf, sizeof(buf));
+            host = QString(buf);
+        }
+    }
+
+    return port ? QString("%1:%2").arg(host).arg(port) : QString("%1:*").arg(host);
+}
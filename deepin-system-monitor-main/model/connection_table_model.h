@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONNECTION_TABLE_MODEL_H
+#define CONNECTION_TABLE_MODEL_H
+
+#include "process/connection_snapshot.h"
+
+#include <QAbstractTableModel>
+#include <QPair>
+#include <QVector>
+
+// process name column display
+constexpr const char *kConnectionProcess = QT_TRANSLATE_NOOP("Connection.Table.Header", "Process");
+// pid column display
+constexpr const char *kConnectionPID = QT_TRANSLATE_NOOP("Connection.Table.Header", "PID");
+// protocol column display
+constexpr const char *kConnectionProtocol = QT_TRANSLATE_NOOP("Connection.Table.Header", "Protocol");
+// local address column display
+constexpr const char *kConnectionLocalAddress = QT_TRANSLATE_NOOP("Connection.Table.Header", "Local address");
+// remote address column display
+constexpr const char *kConnectionRemoteAddress = QT_TRANSLATE_NOOP("Connection.Table.Header", "Remote address");
+// state column display
+constexpr const char *kConnectionState = QT_TRANSLATE_NOOP("Connection.Table.Header", "State");
+// download column display
+constexpr const char *kConnectionDownload = QT_TRANSLATE_NOOP("Connection.Table.Header", "Download");
+// upload column display
+constexpr const char *kConnectionUpload = QT_TRANSLATE_NOOP("Connection.Table.Header", "Upload");
+
+using namespace core::process;
+
+/**
+ * @brief Connection table model class, one row per socket per owning process
+ *
+ * Rows are keyed by (pid, socket inode) and kept in place across updates, each update
+ * changes the model with at most a few batched row removals, one insertion & dataChanged of
+ * rows whose state or rates changed only, so a sorting proxy re-places just those rows and
+ * views stay responsive with tens of thousands of sockets. Addresses & rates are formatted
+ * on demand in data(), only for visible rows.
+ */
+class ConnectionTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Connection table column index
+     */
+    enum Column {
+        kConnectionProcessColumn = 0, // process name column index
+        kConnectionPIDColumn, // pid column index
+        kConnectionProtocolColumn, // protocol column index
+        kConnectionLocalAddressColumn, // local address column index
+        kConnectionRemoteAddressColumn, // remote address column index
+        kConnectionStateColumn, // state column index
+        kConnectionDownloadColumn, // download column index
+        kConnectionUploadColumn, // upload column index
+
+        kConnectionColumnCount // total number of columns
+    };
+
+    /**
+     * @brief Model constructor
+     * @param pid Only show sockets of this process, -1 to show all sockets
+     * @param parent Parent object
+     */
+    explicit ConnectionTableModel(pid_t pid = -1, QObject *parent = nullptr);
+    ~ConnectionTableModel() override;
+
+    /**
+     * @brief setActive Follow connection table updates, ProcessDB only builds the table while watched
+     */
+    void setActive(bool active);
+    inline bool isActive() const
+    {
+        return m_active;
+    }
+
+    int rowCount(const QModelIndex &parent = {}) const override;
+    int columnCount(const QModelIndex &parent = {}) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /**
+     * @brief stateName Socket state name as shown by ss
+     * @param state Kernel socket state, TCP_ESTABLISHED...
+     */
+    static QString stateName(uint state);
+    /**
+     * @brief formatAddress Address & port text, ipv6 address is bracketed, wildcards shown as *
+     */
+    static QString formatAddress(int family, const void *addr, uint port);
+
+public Q_SLOTS:
+    /**
+     * @brief Apply the connection table latest published by ProcessDB
+     */
+    void updateModel();
+
+private:
+    // columns that may change while a row lives
+    struct row_value_t {
+        uint state;
+        qreal recvBps;
+        qreal sentBps;
+    };
+    static inline row_value_t valueOf(const connection_t &conn)
+    {
+        return {conn.sock->state, conn.recvBps, conn.sentBps};
+    }
+
+private:
+    pid_t m_pid; // process filter, -1 if none
+    bool m_active {false};
+    ConnectionSnapshotPtr m_snapshot;
+    QVector<QPair<pid_t, ino_t>> m_keys; // model row to (pid, inode)
+    QVector<int> m_rows; // model row to snapshot row
+    QVector<row_value_t> m_values; // model row to state & rates last reported
+};
+
+#endif // CONNECTION_TABLE_MODEL_H
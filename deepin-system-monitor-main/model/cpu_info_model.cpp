@@ -13,6 +13,9 @@
 
 #include <QApplication>
 
+// samples kept per cpu, as many as the per cpu graphs show
+const int kCPUUsageHistorySize = 31;
+
 Q_GLOBAL_STATIC(CPUInfoModel, theInstance)
 CPUInfoModel::CPUInfoModel() : QObject(nullptr)
 {
@@ -20,6 +23,7 @@ CPUInfoModel::CPUInfoModel() : QObject(nullptr)
     m_overallStatSample.reset(new CPUStatSample(m_period));
     m_overallUsageSample.reset(new CPUUsageSample(m_period));
     m_loadAvgSampleDB.reset(new LoadAvgSample(m_period));
+    m_usageHistory.reset(new CPUUsageHistory(kCPUUsageHistorySize));
 
     m_sysInfo = SysInfo::instance();
     m_cpuSet = DeviceDB::instance()->cpuSet();
@@ -65,39 +69,26 @@ void CPUInfoModel::updateModel()
 
     m_loadAvgSampleDB->addSample(new LoadAvgSampleFrame(m_sysInfo->uptime(), std::make_shared<struct load_avg_t>(*m_sysInfo->loadAvg())));
 
-    for (auto &cpuname : m_cpuSet->cpuLogicName()) {
-        if (m_singleUsageSample.contains(cpuname)) {
-            m_singleUsageSample[cpuname]->addSample(new CPUUsageSampleFrame(m_sysInfo->uptime(), std::make_shared<struct cpu_usage_t>(*m_cpuSet->usageDB(cpuname))));
-        } else {
-            auto smaple = std::make_shared<Sample<cpu_usage_t>>(m_period);
-            smaple->addSample(new CPUUsageSampleFrame(m_sysInfo->uptime(), std::make_shared<struct cpu_usage_t>(*m_cpuSet->usageDB(cpuname))));
-            m_singleUsageSample.insert(cpuname, smaple);
-        }
-
-//        auto model = std::make_shared<CPUStatModel>(m_period, this);
-//        if (model && model->m_statSampleDB)
-//            model->m_statSampleDB->addSample(new CPUStatSampleFrame(m_sysInfo->uptime(), std::make_shared<struct cpu_stat_t>(*m_cpuSet->statDB(cpuname))));
-
-//        if (model && model->m_usageSampleDB)
-//            model->m_usageSampleDB->addSample(new CPUUsageSampleFrame(m_sysInfo->uptime(), std::make_shared<struct cpu_usage_t>(*m_cpuSet->usageDB(cpuname))));
-
-//        m_cpuListModel->m_statModelDB[info.logicalName()] = model;
-    } // ::for
+    m_usageHistory->update(*m_cpuSet->procStat());
 
     emit modelUpdated();
 } // ::updateModel
 
 QList<qreal> CPUInfoModel::cpuPercentList() const
 {
+    // indexed by cpu id, NaN for offline cpus
     QList<qreal> percentList;
-    const auto &usageSampleList = m_singleUsageSample.values();
-    for (const auto &sample : usageSampleList) {
-        const auto &pair = sample->recentSamplePair();
-        percentList << CPUUsageSampleFrame::cpupc(pair.first, pair.second);
-    }
+    percentList.reserve(m_usageHistory->rows());
+    for (int cpu = 0; cpu < m_usageHistory->rows(); ++cpu)
+        percentList << qreal(m_usageHistory->latest(cpu));
     return percentList;
 }
 
+const CPUUsageHistory &CPUInfoModel::cpuUsageHistory() const
+{
+    return *m_usageHistory;
+}
+
 qreal CPUInfoModel::cpuAllPercent() const
 {
     auto pair = m_overallUsageSample->recentSamplePair();
@@ -10,6 +10,7 @@
 #include "common/common.h"
 #include "system/sys_info.h"
 #include "cpu_stat_model.h"
+#include "cpu_usage_history.h"
 
 #include <QObject>
 #include <QMap>
@@ -62,6 +63,10 @@ public:
 
     QList<qreal> cpuPercentList() const;
     qreal cpuAllPercent() const;
+    /**
+     * @brief cpuUsageHistory Usage history of each cpu, rows indexed by cpu id
+     */
+    const CPUUsageHistory &cpuUsageHistory() const;
 
     QString loadavg() const;
     uint nProcesses() const;
@@ -87,7 +92,7 @@ private:
     std::unique_ptr<Sample<cpu_usage_t>> m_overallUsageSample;
     std::unique_ptr<Sample<load_avg_t>> m_loadAvgSampleDB; // for loadavg monitoring extends
 
-    QMap<QByteArray, std::shared_ptr<Sample<cpu_usage_t>>> m_singleUsageSample;
+    std::unique_ptr<CPUUsageHistory> m_usageHistory; // per cpu usage
 
     SysInfo *m_sysInfo;
     CPUSet *m_cpuSet;
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cpu_usage_history.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace core::system;
+
+static const float kUnknown = std::numeric_limits<float>::quiet_NaN();
+
+CPUUsageHistory::CPUUsageHistory(int capacity)
+    : m_capacity(qMax(capacity, 1))
+{
+}
+
+void CPUUsageHistory::update(const proc_stat_t &stat)
+{
+    if (stat.cpus.size() > m_rows)
+        resizeRows(stat.cpus.size());
+
+    m_head = (m_head + 1) % m_capacity;
+    if (m_size < m_capacity)
+        ++m_size;
+
+    const proc_stat_cpu_t *cpus = stat.cpus.constData();
+    const bool *listed = stat.listed.constData();
+    unsigned long long *lastTotal = m_lastTotal.data();
+    unsigned long long *lastIdle = m_lastIdle.data();
+    float *column = m_data.data() + m_head * m_rows;
+    int ncpus = stat.cpus.size();
+
+    for (int cpu = 0; cpu < m_rows; ++cpu) {
+        float pc = kUnknown;
+        if (cpu < ncpus && listed[cpu]) {
+            // first sample of a cpu is its average since boot
+            unsigned long long total = cpus[cpu].total();
+            unsigned long long idle = cpus[cpu].idleTotal();
+            unsigned long long totald = total > lastTotal[cpu] ? total - lastTotal[cpu] : 0;
+            unsigned long long idled = idle > lastIdle[cpu] ? idle - lastIdle[cpu] : 0;
+            if (totald > 0)
+                pc = float(totald - qMin(idled, totald)) * 100.f / float(totald);
+            lastTotal[cpu] = total;
+            lastIdle[cpu] = idle;
+        }
+        column[cpu] = pc;
+    }
+}
+
+float CPUUsageHistory::value(int cpu, int age) const
+{
+    if (cpu < 0 || cpu >= m_rows || age < 0 || age >= m_size)
+        return kUnknown;
+
+    int slot = (m_head - age + m_capacity) % m_capacity;
+    return m_data[slot * m_rows + cpu];
+}
+
+void CPUUsageHistory::resizeRows(int rows)
+{
+    // slots get longer, move the samples of existing rows to their new slot offsets
+    QVector<float> data(rows * m_capacity, kUnknown);
+    for (int slot = 0; slot < m_capacity && m_rows > 0; ++slot)
+        std::copy_n(m_data.constData() + slot * m_rows, m_rows, data.data() + slot * rows);
+    m_data.swap(data);
+    m_lastTotal.resize(rows);
+    m_lastIdle.resize(rows);
+    m_rows = rows;
+}
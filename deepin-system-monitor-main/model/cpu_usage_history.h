@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPU_USAGE_HISTORY_H
+#define CPU_USAGE_HISTORY_H
+
+#include "system/proc_stat.h"
+
+#include <QVector>
+
+/**
+ * @brief Usage history of each cpu, as a ring of capacity samples of all cpus
+ *
+ * Rows are indexed by cpu id & hold the last capacity samples of that cpu, newest at the
+ * ring head shared by all rows. Samples are stored slot major, so one update computes the
+ * percents of all cpus in a single pass writing one contiguous column; nothing is allocated
+ * unless a higher cpu id shows up.
+ * Percent is NaN where it is unknown, e.g. cpu offline or no time elapsed.
+ */
+class CPUUsageHistory
+{
+public:
+    explicit CPUUsageHistory(int capacity);
+
+    /**
+     * @brief update Add one sample of all cpus from a /proc/stat read
+     */
+    void update(const core::system::proc_stat_t &stat);
+
+    /**
+     * @brief rows Number of rows, i.e. highest cpu id seen + 1
+     */
+    inline int rows() const
+    {
+        return m_rows;
+    }
+    inline int capacity() const
+    {
+        return m_capacity;
+    }
+    /**
+     * @brief size Number of samples held in each row
+     */
+    inline int size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief latest Percent of cpu in the last sample
+     */
+    inline float latest(int cpu) const
+    {
+        return value(cpu, 0);
+    }
+    /**
+     * @brief value Percent of cpu, age samples before the last one
+     */
+    float value(int cpu, int age) const;
+
+private:
+    void resizeRows(int rows);
+
+    int m_capacity;
+    int m_rows {0};
+    int m_size {0};
+    int m_head {-1}; // slot of the last sample
+
+    QVector<float> m_data; // m_capacity slots x m_rows cpus, slot major
+    QVector<unsigned long long> m_lastTotal; // per cpu jiffies of the last sample
+    QVector<unsigned long long> m_lastIdle;
+};
+
+#endif // CPU_USAGE_HISTORY_H
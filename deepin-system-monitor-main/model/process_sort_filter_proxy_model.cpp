@@ -44,7 +44,9 @@ bool ProcessSortFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &p
 {
     bool filter = false;
     const QModelIndex &pid = sourceModel()->index(row, ProcessTableModel::kProcessPIDColumn, parent);
-    int apptype = pid.data(Qt::UserRole + 3).toInt();
+    auto *model = qobject_cast<ProcessTableModel *>(sourceModel());
+    int srow = model ? model->snapshotRow(row) : -1;
+    int apptype = srow >= 0 ? model->snapshot().appType()[srow] : pid.data(Qt::UserRole + 3).toInt();
     if (m_fileterType == kNoFilter)
         filter = true;
     else if (m_fileterType == kFilterCurrentUser && (apptype == kFilterApps || apptype == kFilterCurrentUser))
@@ -87,6 +89,15 @@ bool ProcessSortFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &p
 // compare two items with the specified index
 bool ProcessSortFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
+    // compare on snapshot columns directly, no QVariant round trip
+    auto *model = qobject_cast<ProcessTableModel *>(sourceModel());
+    if (model) {
+        int lrow = model->snapshotRow(left.row());
+        int rrow = model->snapshotRow(right.row());
+        if (lrow >= 0 && rrow >= 0)
+            return lessThan(model->snapshot(), lrow, rrow);
+    }
+
     int sortcolumn = sortColumn();
     switch (sortcolumn) {
     case ProcessTableModel::kProcessNameColumn: {
@@ -195,3 +206,67 @@ bool ProcessSortFilterProxyModel::lessThan(const QModelIndex &left, const QModel
 
     return QSortFilterProxyModel::lessThan(left, right);
 }
+
+bool ProcessSortFilterProxyModel::lessThan(const core::process::ProcessSnapshot &snapshot, int left, int right) const
+{
+    switch (sortColumn()) {
+    case ProcessTableModel::kProcessNameColumn: {
+        const QString &lhs = snapshot.displayName(left);
+        const QString &rhs = snapshot.displayName(right);
+
+        bool lstartHz = common::startWithHanzi(lhs);
+        bool rstartHz = common::startWithHanzi(rhs);
+        if (!lstartHz && rstartHz)
+            return true;
+
+        if (lstartHz && !rstartHz)
+            return false;
+
+        int rc = lhs.localeAwareCompare(rhs);
+        if (rc == 0)
+            return snapshot.cpu()[left] < snapshot.cpu()[right];
+        else
+            return rc < 0;
+    }
+    case ProcessTableModel::kProcessUserColumn:
+        return snapshot.userName(left).localeAwareCompare(snapshot.userName(right)) < 0;
+    case ProcessTableModel::kProcessMemoryColumn:
+    case ProcessTableModel::kProcessShareMemoryColumn:
+    case ProcessTableModel::kProcessVTRMemoryColumn: {
+        const QVector<qulonglong> &mem = sortColumn() == ProcessTableModel::kProcessMemoryColumn ? snapshot.memory()
+                                         : sortColumn() == ProcessTableModel::kProcessShareMemoryColumn ? snapshot.shareMemory()
+                                         : snapshot.vtrMemory();
+
+        // compare memory usage first, then by cpu time
+        if (mem[left] == mem[right])
+            return snapshot.cpu()[left] < snapshot.cpu()[right];
+        else
+            return mem[left] < mem[right];
+    }
+    case ProcessTableModel::kProcessCPUColumn: {
+        // compare cpu time first, then by memory usage
+        if (qFuzzyCompare(snapshot.cpu()[left], snapshot.cpu()[right]))
+            return snapshot.memory()[left] < snapshot.memory()[right];
+        else
+            return snapshot.cpu()[left] < snapshot.cpu()[right];
+    }
+    case ProcessTableModel::kProcessUploadColumn:
+        return snapshot.sentBps()[left] < snapshot.sentBps()[right];
+    case ProcessTableModel::kProcessDownloadColumn:
+        return snapshot.recvBps()[left] < snapshot.recvBps()[right];
+    case ProcessTableModel::kProcessPIDColumn:
+        return snapshot.pid()[left] < snapshot.pid()[right];
+    case ProcessTableModel::kProcessDiskReadColumn:
+        return snapshot.readBps()[left] < snapshot.readBps()[right];
+    case ProcessTableModel::kProcessDiskWriteColumn:
+        return snapshot.writeBps()[left] < snapshot.writeBps()[right];
+    case ProcessTableModel::kProcessNiceColumn:
+    case ProcessTableModel::kProcessPriorityColumn:
+        // higher priority has negative number
+        return !(snapshot.priority()[left] < snapshot.priority()[right]);
+    default:
+        break;
+    }
+
+    return false;
+}
@@ -6,6 +6,8 @@
 #ifndef PROCESS_SORT_FILTER_PROXY_MODEL_H
 #define PROCESS_SORT_FILTER_PROXY_MODEL_H
 
+#include "process/process_snapshot.h"
+
 #include <QSortFilterProxyModel>
 
 /**
@@ -48,6 +50,14 @@ protected:
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 
 private:
+    /**
+     * @brief Compare two rows of the process snapshot on current sort column
+     * @param snapshot Columnar data of the source model
+     * @param left Snapshot row on left side
+     * @param right Snapshot row on right side
+     */
+    bool lessThan(const core::process::ProcessSnapshot &snapshot, int left, int right) const;
+
     // Search pattern
     QString m_search {};
     // Pinyin represented as ascii string converted from chinese hanzi
@@ -8,6 +8,7 @@
 #include "common/common.h"
 
 #include <QDebug>
+#include <QHash>
 #include <QTimer>
 #include <DApplication>
 #include <DGuiApplicationHelper>
@@ -55,22 +56,14 @@ ProcessTableModel::ProcessTableModel(QObject *parent, const QString &username)
 
 char ProcessTableModel::getProcessState(pid_t pid) const
 {
-    if (m_procIdList.contains(pid)) {
-        return ProcessDB::instance()->processSet()->getProcessById(pid).state();
+    int row = m_snapshot.indexOf(pid);
+    if (row >= 0 && m_procIdList.contains(pid)) {
+        return m_snapshot.state()[row];
     }
 
     return 0;
 }
 
-Process ProcessTableModel::getProcess(pid_t pid) const
-{
-    if (m_procIdList.contains(pid)) {
-        return ProcessDB::instance()->processSet()->getProcessById(pid);
-    }
-
-    return Process();
-}
-
 // update process model with the data provided by list
 void ProcessTableModel::updateProcessList()
 {
@@ -83,24 +76,31 @@ void ProcessTableModel::updateProcessList()
 
 void ProcessTableModel::updateProcessListWithUserSpecified()
 {
-
-    ProcessSet *processSet = ProcessDB::instance()->processSet();
-    const QList<pid_t> &newpidlst = processSet->getPIDList();
+    // hold the published snapshot while filtering, monitor thread may publish a newer one meanwhile
+    ProcessSnapshotPtr published = ProcessDB::instance()->snapshot();
+    const ProcessSnapshot &snapshot = *published;
 
     beginRemoveRows({}, 0, m_procIdList.size());
     endRemoveRows();
     m_procIdList.clear();
-    m_processList.clear();
+    m_snapshotRows.clear();
+
+    QVector<int> rows;
+    for (int i = 0; i < snapshot.size(); ++i) {
+        if (snapshot.userName(i) == m_userModeName)
+            rows << i;
+    }
+    // keep only this user's processes, so totals are sums over whole columns
+    m_snapshot = snapshot.select(rows);
+
     int raw;
-    for (const auto &pid : newpidlst) {
-        Process changedProc = processSet->getProcessById(pid);
-        if (changedProc.userName() == m_userModeName) {
-            raw = m_procIdList.size();
-            beginInsertRows({}, raw, raw);
-            m_procIdList << pid;
-            m_processList << changedProc;
-            endInsertRows();
-        }
+    for (int i = 0; i < m_snapshot.size(); ++i) {
+        pid_t pid = m_snapshot.pid()[i];
+        raw = m_procIdList.size();
+        beginInsertRows({}, raw, raw);
+        m_procIdList << pid;
+        m_snapshotRows << i;
+        endInsertRows();
     }
 
     Q_EMIT modelUpdated();
@@ -108,33 +108,40 @@ void ProcessTableModel::updateProcessListWithUserSpecified()
 
 void ProcessTableModel::updateProcessListDelay()
 {
-    ProcessSet *processSet = ProcessDB::instance()->processSet();
-    const QList<pid_t> &newpidlst = processSet->getPIDList();
-    QList<pid_t> oldpidlst = m_procIdList;
+    // our copy shares columns with the published snapshot, nothing here touches monitor thread data
+    m_snapshot = *ProcessDB::instance()->snapshot();
+
+    // remap existing rows before any row is touched, rows of ended processes map to -1
+    QHash<pid_t, int> oldRows;
+    oldRows.reserve(m_procIdList.size());
+    m_snapshotRows.resize(m_procIdList.size());
+    for (int row = 0; row < m_procIdList.size(); ++row) {
+        oldRows.insert(m_procIdList[row], row);
+        m_snapshotRows[row] = m_snapshot.indexOf(m_procIdList[row]);
+    }
 
-    for (const auto &pid : newpidlst) {
-        int row = m_procIdList.indexOf(pid);
+    for (int srow = 0; srow < m_snapshot.size(); ++srow) {
+        pid_t pid = m_snapshot.pid()[srow];
+        int row = oldRows.value(pid, -1);
         if (row >= 0) {
             // update
-            m_processList[row] = processSet->getProcessById(pid);
             Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
         } else {
             // insert
             row = m_procIdList.size();
             beginInsertRows({}, row, row);
             m_procIdList << pid;
-            m_processList << processSet->getProcessById(pid);
+            m_snapshotRows << srow;
             endInsertRows();
         }
     }
 
-    // remove
-    for (const auto &pid : oldpidlst) {
-        if (!newpidlst.contains(pid)) {
-            int row = m_procIdList.indexOf(pid);
+    // remove, from the last row so that earlier rows keep their index
+    for (int row = m_procIdList.size() - 1; row >= 0; --row) {
+        if (m_snapshotRows[row] < 0) {
             beginRemoveRows({}, row, row);
             m_procIdList.removeAt(row);
-            m_processList.removeAt(row);
+            m_snapshotRows.removeAt(row);
             endRemoveRows();
         }
     }
@@ -220,21 +227,22 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         return {};
 
     // validate index
-    if (index.row() < 0 || index.row() >= m_processList.size())
+    if (index.row() < 0 || index.row() >= m_procIdList.size())
         return {};
 
-    int row = index.row();
-    const Process &proc = m_processList[row];
-    if (!proc.isValid())
+    int srow = snapshotRow(index.row());
+    if (srow < 0)
         return {};
 
+    const ProcessSnapshot &snap = m_snapshot;
+
     if (role == Qt::DisplayRole || role == Qt::AccessibleTextRole) {
         QString name;
         switch (index.column()) {
         case kProcessNameColumn: {
             // prepended tag based on process state
-            name = proc.displayName();
-            switch (proc.state()) {
+            name = snap.displayName(srow);
+            switch (snap.state()[srow]) {
             case 'Z':
                 name = QString("(%1) %2")
                        .arg(QApplication::translate("Process.Table", "No response"))
@@ -250,42 +258,42 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         }
         case kProcessCPUColumn:
             // formated cpu percent utilization
-            return QString("%1%").arg(proc.cpu(), 0, 'f', 1);
+            return QString("%1%").arg(snap.cpu()[srow], 0, 'f', 1);
         case kProcessUserColumn:
             // process's user name
-            return proc.userName();
+            return snap.userName(srow);
         case kProcessMemoryColumn:
             // formatted memory usage
-            return formatUnit_memory_disk(proc.memory(), KB);
+            return formatUnit_memory_disk(snap.memory()[srow], KB);
         case kProcessShareMemoryColumn:
             // formatted memory usage
-            return formatUnit_memory_disk(proc.sharememory(), KB);
+            return formatUnit_memory_disk(snap.shareMemory()[srow], KB);
         case kProcessVTRMemoryColumn:
             // formatted memory usage
-            return formatUnit_memory_disk(proc.vtrmemory(), KB);
+            return formatUnit_memory_disk(snap.vtrMemory()[srow], KB);
         case kProcessUploadColumn:
             // formatted upload speed text
-            return formatUnit_net(8 * proc.sentBps(), B, 1, true);
+            return formatUnit_net(8 * snap.sentBps()[srow], B, 1, true);
         case kProcessDownloadColumn:
             // formated download speed text
-            return formatUnit_net(8 * proc.recvBps(), B, 1, true);
+            return formatUnit_net(8 * snap.recvBps()[srow], B, 1, true);
         case kProcessDiskReadColumn:
             // formatted disk read speed text
-            return formatUnit_memory_disk(proc.readBps(), B, 1, true);
+            return formatUnit_memory_disk(snap.readBps()[srow], B, 1, true);
         case kProcessDiskWriteColumn:
             // formatted disk write speed text
-            return formatUnit_memory_disk(proc.writeBps(), B, 1, true);
+            return formatUnit_memory_disk(snap.writeBps()[srow], B, 1, true);
         case kProcessPIDColumn: {
             // process pid text
-            return QString("%1").arg(proc.pid());
+            return QString("%1").arg(snap.pid()[srow]);
         }
         case kProcessNiceColumn: {
             // process priority text
-            return QString("%1").arg(proc.priority());
+            return QString("%1").arg(snap.priority()[srow]);
         }
         case kProcessPriorityColumn: {
             // process priority enum text representation
-            return getPriorityName(proc.priority());
+            return getPriorityName(snap.priority()[srow]);
         }
         default:
             break;
@@ -294,7 +302,7 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         switch (index.column()) {
         case kProcessNameColumn:
             // process icon
-            return proc.icon();
+            return snap.icon(srow);
         default:
             return {};
         }
@@ -302,27 +310,27 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         // get process's raw data
         switch (index.column()) {
         case kProcessNameColumn:
-            return proc.name();
+            return snap.name(srow);
         case kProcessMemoryColumn:
-            return proc.memory();
+            return snap.memory()[srow];
         case kProcessShareMemoryColumn:
-            return proc.sharememory();
+            return snap.shareMemory()[srow];
         case kProcessVTRMemoryColumn:
-            return proc.vtrmemory();
+            return snap.vtrMemory()[srow];
         case kProcessCPUColumn:
-            return proc.cpu();
+            return snap.cpu()[srow];
         case kProcessUploadColumn:
-            return proc.sentBps();
+            return snap.sentBps()[srow];
         case kProcessDownloadColumn:
-            return proc.recvBps();
+            return snap.recvBps()[srow];
         case kProcessPIDColumn:
-            return proc.pid();
+            return snap.pid()[srow];
         case kProcessDiskReadColumn:
-            return proc.readBps();
+            return snap.readBps()[srow];
         case kProcessDiskWriteColumn:
-            return proc.writeBps();
+            return snap.writeBps()[srow];
         case kProcessNiceColumn:
-            return proc.priority();
+            return snap.priority()[srow];
         default:
             return {};
         }
@@ -330,9 +338,9 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         // get process's extra data
         switch (index.column()) {
         case kProcessUploadColumn:
-            return proc.sentBps();
+            return snap.sentBps()[srow];
         case kProcessDownloadColumn:
-            return proc.recvBps();
+            return snap.recvBps()[srow];
         default:
             return {};
         }
@@ -342,16 +350,16 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
     } else if (role == Qt::UserRole + 2) {
         // text color role based on process's state
         if (index.column() == kProcessNameColumn) {
-            char state = proc.state();
+            char state = snap.state()[srow];
             if (state == 'Z' || state == 'T') {
                 return QVariant(int(Dtk::Gui::DPalette::TextWarning));
             }
         }
         return {};
     } else if (role == Qt::UserRole + 3) {
-        return proc.appType();
+        return snap.appType()[srow];
     } else if (role == Qt::UserRole + 4) {
-        return QString("%1").arg(proc.pid());
+        return QString("%1").arg(snap.pid()[srow]);
     }
     return {};
 }
@@ -368,9 +376,9 @@ Qt::ItemFlags ProcessTableModel::flags(const QModelIndex &index) const
 // get process priority enum type
 ProcessPriority ProcessTableModel::getProcessPriority(pid_t pid) const
 {
-    int row = m_procIdList.indexOf(pid);
+    int row = snapshotRow(m_procIdList.indexOf(pid));
     if (row >= 0) {
-        int prio = ProcessDB::instance()->processSet()->getProcessById(pid).priority();
+        int prio = m_snapshot.priority()[row];
         return getProcessPriorityStub(prio);
     }
 
@@ -379,8 +387,8 @@ ProcessPriority ProcessTableModel::getProcessPriority(pid_t pid) const
 
 int ProcessTableModel::getProcessPriorityValue(pid_t pid) const
 {
-    int row = m_procIdList.indexOf(pid);
-    return row >= 0 ? ProcessDB::instance()->processSet()->getProcessById(pid).priority() : kNormalPriority;
+    int row = snapshotRow(m_procIdList.indexOf(pid));
+    return row >= 0 ? m_snapshot.priority()[row] : kNormalPriority;
 }
 
 // remove process entry from model with specified pid
@@ -390,7 +398,8 @@ void ProcessTableModel::removeProcess(pid_t pid)
     if (row >= 0) {
         beginRemoveRows(QModelIndex(), row, row);
         m_procIdList.removeAt(row);
-        m_processList.removeAt(row);
+        if (row < m_snapshotRows.size())
+            m_snapshotRows.removeAt(row);
         endRemoveRows();
     }
 }
@@ -400,7 +409,7 @@ void ProcessTableModel::updateProcessState(pid_t pid, char state)
 {
     int row = m_procIdList.indexOf(pid);
     if (row >= 0) {
-        m_processList[row].setState(state);
+        m_snapshot.setState(snapshotRow(row), state);
         Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
     }
 }
@@ -410,7 +419,7 @@ void ProcessTableModel::updateProcessPriority(pid_t pid, int priority)
 {
     int row = m_procIdList.indexOf(pid);
     if (row >= 0) {
-        m_processList[row].setPriority(priority);
+        m_snapshot.setPriority(snapshotRow(row), priority);
         Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
     }
 }
@@ -424,70 +433,39 @@ void ProcessTableModel::setUserModeName(const QString &userName)
     }
 }
 
+// totals are sums over whole snapshot columns, m_snapshot holds exactly the processes of this model
 qreal ProcessTableModel::getTotalCPUUsage()
 {
-    qreal cpuUsage = 0;
-    for (const auto &proc : m_processList) {
-        cpuUsage += proc.cpu();
-    }
-    return cpuUsage;
+    return ProcessSnapshot::sum(m_snapshot.cpu());
 }
 qreal ProcessTableModel::getTotalMemoryUsage()
 {
-    qreal memUsage = 0;
-    for (const auto &proc : m_processList) {
-        memUsage += proc.memory();
-    }
-    return memUsage;
+    return ProcessSnapshot::sum(m_snapshot.memory());
 }
 qreal ProcessTableModel::getTotalDownload()
 {
-    qreal download = 0;
-    for (const auto &proc : m_processList) {
-        download += proc.recvBps();
-    }
-    return download;
+    return ProcessSnapshot::sum(m_snapshot.recvBps());
 }
 qreal ProcessTableModel::getTotalUpload()
 {
-    qlonglong upload = 0;
-    for (const auto &proc : m_processList) {
-        upload += proc.sentBps();
-    }
-    return upload;
+    return ProcessSnapshot::sum(m_snapshot.sentBps());
 }
 
 
 
 qreal ProcessTableModel::getTotalVirtualMemoryUsage()
 {
-    qlonglong vtmem = 0;
-    for (const auto &proc : m_processList) {
-        vtmem += proc.vtrmemory();
-    }
-    return vtmem;
+    return ProcessSnapshot::sum(m_snapshot.vtrMemory());
 }
 qreal ProcessTableModel::getTotalSharedMemoryUsage()
 {
-    qlonglong smem = 0;
-    for (const auto &proc : m_processList) {
-        smem += proc.sharememory();
-    }
-    return smem;
+    return ProcessSnapshot::sum(m_snapshot.shareMemory());
 }
 qreal ProcessTableModel::getTotalDiskRead()
 {
-    qlonglong diskread = 0;
-    for (const auto &proc : m_processList) {
-        diskread += proc.readBps();
-    }
-    return diskread;
+    return ProcessSnapshot::sum(m_snapshot.readBps());
 }
 qreal ProcessTableModel::getTotalDiskWrite()
 {
-    qlonglong diskwrite = 0;
-    for (const auto &proc : m_processList) {
-        diskwrite += proc.writeBps();
-    }
-    return diskwrite;
+    return ProcessSnapshot::sum(m_snapshot.writeBps());
 }
@@ -136,11 +136,21 @@ public:
     int getProcessPriorityValue(pid_t pid) const;
 
     /**
-     * @brief Get process entry from list with specified pid
-     * @param pid Process id
-     * @return Process entry item
+     * @brief Columnar process data shown by this model, copied from the snapshot published by ProcessDB
+     */
+    inline const ProcessSnapshot &snapshot() const
+    {
+        return m_snapshot;
+    }
+    /**
+     * @brief Row of snapshot shown at model row
+     * @param row Model row
+     * @return Snapshot row, -1 if not found
      */
-    Process getProcess(pid_t pid) const;
+    inline int snapshotRow(int row) const
+    {
+        return (row >= 0 && row < m_snapshotRows.size()) ? m_snapshotRows[row] : -1;
+    }
    void setUserModeName(const QString &userName);
     qreal getTotalCPUUsage();
     qreal getTotalMemoryUsage();
@@ -181,7 +191,8 @@ private Q_SLOTS:
     void updateProcessListWithUserSpecified();
 private:
     QList<pid_t> m_procIdList; // pid list
-    QList<Process> m_processList; // pid list
+    ProcessSnapshot m_snapshot; // all processes shown, filtered by user in user mode
+    QVector<int> m_snapshotRows; // model row to snapshot row
 
     QString m_userModeName {};
 };
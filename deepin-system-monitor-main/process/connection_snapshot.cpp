@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "connection_snapshot.h"
+
+#include <QSet>
+
+namespace core {
+namespace process {
+
+ConnectionSnapshot::ConnectionSnapshot()
+{
+}
+
+void ConnectionSnapshot::build(const QMap<pid_t, Process> &set, const SockStatMap &socks)
+{
+    clear();
+
+    // TCP sockets are in the table twice, index each socket once by inode
+    QHash<ino_t, SockStat> sockOfInode;
+    sockOfInode.reserve(socks.size());
+    for (const SockStat &stat : socks) {
+        // sockets in TIME_WAIT have no inode, nobody holds them anymore
+        if (stat->ino != 0)
+            sockOfInode.insert(stat->ino, stat);
+    }
+
+    m_conns.reserve(sockOfInode.size());
+    m_rowOfConn.reserve(sockOfInode.size());
+
+    QSet<ino_t> owned;
+    owned.reserve(sockOfInode.size());
+    for (const Process &proc : set) {
+        const QList<ino_t> inodes = proc.sockInodes();
+        if (inodes.isEmpty())
+            continue;
+
+        const QHash<ino_t, IOPS> bps = proc.sockIOBps();
+        for (ino_t ino : inodes) {
+            auto it = sockOfInode.constFind(ino);
+            if (it == sockOfInode.constEnd())
+                continue; // unix, netlink or raw socket
+
+            const IOPS iops = bps.value(ino, {.0, .0});
+            m_rowOfConn.insert(qMakePair(proc.pid(), ino), m_conns.size());
+            m_conns << connection_t {proc.pid(), proc.displayName(), it.value(), iops.inBps, iops.outBps};
+            owned.insert(ino);
+        }
+    }
+
+    // sockets of processes we can not inspect, still listed like ss does
+    for (auto it = sockOfInode.constBegin(); it != sockOfInode.constEnd(); ++it) {
+        if (owned.contains(it.key()))
+            continue;
+        m_rowOfConn.insert(qMakePair(pid_t(0), it.key()), m_conns.size());
+        m_conns << connection_t {0, {}, it.value(), .0, .0};
+    }
+}
+
+void ConnectionSnapshot::clear()
+{
+    m_conns.clear();
+    m_rowOfConn.clear();
+}
+
+} // namespace process
+} // namespace core
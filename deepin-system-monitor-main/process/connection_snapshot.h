@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONNECTION_SNAPSHOT_H
+#define CONNECTION_SNAPSHOT_H
+
+#include "process.h"
+#include "system/packet.h"
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+#include <sys/types.h>
+
+using namespace core::system;
+
+namespace core {
+namespace process {
+
+/**
+ * @brief One socket owned by one process
+ */
+struct connection_t {
+    pid_t pid; // owner, 0 if no scanned process holds the socket (e.g. owned by another user)
+    QString name; // owner's display name
+    SockStat sock; // socket table entry, shared with the table it came from
+    qreal recvBps; // bytes received per second
+    qreal sentBps; // bytes sent per second
+};
+
+/**
+ * @brief Sockets of all processes joined with their throughput, built once per refresh
+ *
+ * Sockets come from the table the packet capture job already keeps (keyed by flow), owners
+ * from the socket inodes the process scan already read, so building takes no extra /proc walk.
+ * A socket held by several processes (forked servers) is listed once per holder.
+ *
+ * Like ProcessSnapshot, a published snapshot never changes and can be read from any thread.
+ */
+class ConnectionSnapshot
+{
+public:
+    explicit ConnectionSnapshot();
+
+    /**
+     * @brief build Rebuild from process set & socket table
+     * @param set Processes keyed by pid
+     * @param socks Sockets keyed by flow, TCP sockets are keyed by both directions
+     */
+    void build(const QMap<pid_t, Process> &set, const SockStatMap &socks);
+    void clear();
+
+    inline int size() const
+    {
+        return m_conns.size();
+    }
+    inline const connection_t &at(int row) const
+    {
+        return m_conns[row];
+    }
+    /**
+     * @brief indexOf Row of the socket held by pid, -1 if not found
+     */
+    inline int indexOf(pid_t pid, ino_t ino) const
+    {
+        return m_rowOfConn.value(qMakePair(pid, ino), -1);
+    }
+
+private:
+    QVector<connection_t> m_conns;
+    QHash<QPair<pid_t, ino_t>, int> m_rowOfConn;
+};
+
+// published snapshot, shared by all readers until the last one drops it
+using ConnectionSnapshotPtr = std::shared_ptr<const ConnectionSnapshot>;
+
+} // namespace process
+} // namespace core
+
+#endif // CONNECTION_SNAPSHOT_H
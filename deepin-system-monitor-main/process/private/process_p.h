@@ -62,6 +62,8 @@ public:
         , cutime {0}
         , cstime {0}
         , start_time {0}
+        , statusTicks {0}
+        , identityChanged {false}
         , vmsize {0}
         , rss {0}
         , shm {0}
@@ -72,6 +74,7 @@ public:
         , write_bytes {0}
         , cancelled_write_bytes {0}
         , usrerName {}
+        , comm {}
         , name {}
         , proc_name{}
         , proc_icon{}
@@ -79,6 +82,7 @@ public:
         , environ {}
         , uptime {timeval {0, 0}}
         , sockInodes {}
+        , sockIOBps {}
         , cpuTimeSample(new CPUTimeSample(TimePeriod(TimePeriod::kNoPeriod, default_interval())))
         , cpuUsageSample(new CPUUsageSample(TimePeriod(TimePeriod::kNoPeriod, default_interval())))
         , networkIOSample(new IOSample(TimePeriod(TimePeriod::kNoPeriod, default_interval())))
@@ -114,6 +118,8 @@ public:
         , cutime(other.cutime)
         , cstime(other.cstime)
         , start_time(other.start_time)
+        , statusTicks(other.statusTicks)
+        , identityChanged(other.identityChanged)
         , vmsize(other.vmsize)
         , rss(other.rss)
         , shm(other.shm)
@@ -124,6 +130,7 @@ public:
         , write_bytes(other.write_bytes)
         , cancelled_write_bytes(other.cancelled_write_bytes)
         , usrerName(other.name)
+        , comm(other.comm)
         , name(other.name)
         , proc_name(other.proc_name)
         , proc_icon(other.proc_icon)
@@ -131,6 +138,7 @@ public:
         , environ(other.environ)
         , uptime {other.uptime}
         , sockInodes(other.sockInodes)
+        , sockIOBps(other.sockIOBps)
         , cpuTimeSample(std::unique_ptr<CPUTimeSample>(new CPUTimeSample(*(other.cpuTimeSample))))
         , cpuUsageSample(std::unique_ptr<CPUUsageSample>(new CPUUsageSample(*(other.cpuUsageSample))))
         , networkIOSample(std::unique_ptr<IOSample>(new IOSample(*(other.networkIOSample))))
@@ -174,6 +182,8 @@ private:
     long long cutime; // user time on waiting children
     long long cstime; // kernel time on waiting children
     unsigned long long start_time; // start time since system boot in clock ticks
+    int statusTicks; // ticks since status was read last time
+    bool identityChanged; // exec or setuid seen, identity must be resolved again
     unsigned long long vmsize; // vm size in kB
     unsigned long long rss; // resident set size in kB
     unsigned long long shm; // resident shared size in kB
@@ -189,6 +199,7 @@ private:
 
     QString usrerName;
 
+    QByteArray comm; // comm field in stat
     QString name; // raw name
     ProcessName proc_name; // process name object
     ProcessIcon proc_icon; // process icon object
@@ -198,6 +209,7 @@ private:
     struct timeval uptime;
 
     QList<ino_t> sockInodes; // socket inodes opened by this process
+    QHash<ino_t, IOPS> sockIOBps; // rate of sockets with traffic in last interval
 
     // only 2 samples are kept here for each process, to avoid too much memory
     // consumption if there're too many processes
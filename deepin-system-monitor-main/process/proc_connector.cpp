@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "proc_connector.h"
+#include "common/common.h"
+
+#include <QDebug>
+
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+// kernel socket buffer for queued events between two refreshes
+#define PROC_CN_RCVBUF_SIZE (1 << 20)
+// max time waiting for the subscription ack
+#define PROC_CN_ACK_TIMEOUT 100 // ms
+
+using namespace common::error;
+
+namespace core {
+namespace process {
+
+ProcConnector::ProcConnector()
+    : m_fd(-1)
+{
+    errno = 0;
+    m_fd = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (m_fd < 0) {
+        print_errno(errno, "create proc connector socket failed");
+        return;
+    }
+
+    int rcvbuf = PROC_CN_RCVBUF_SIZE;
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_nl addr {};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0;
+    if (bind(m_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+        // joining the proc group needs CAP_NET_ADMIN
+        qDebug() << "proc connector not available:" << strerror(errno);
+        closeSocket();
+        return;
+    }
+
+    if (!subscribe(true) || !waitAck()) {
+        qDebug() << "proc connector subscription refused";
+        closeSocket();
+    }
+}
+
+ProcConnector::~ProcConnector()
+{
+    if (m_fd >= 0) {
+        subscribe(false);
+        closeSocket();
+    }
+}
+
+bool ProcConnector::readEvents(QVector<ProcEvent> &events)
+{
+    if (m_fd < 0)
+        return false;
+
+    bool ok = true;
+    alignas(struct nlmsghdr) char buf[8192];
+    struct sockaddr_nl from {};
+    socklen_t fromlen;
+
+    for (;;) {
+        fromlen = sizeof(from);
+        ssize_t len = recvfrom(m_fd, buf, sizeof(buf), 0, reinterpret_cast<struct sockaddr *>(&from), &fromlen);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == ENOBUFS) {
+                // receive buffer overrun, events dropped by kernel
+                ok = false;
+                continue;
+            }
+
+            print_errno(errno, "read proc connector events failed");
+            return false;
+        }
+        // only trust messages sent by kernel
+        if (from.nl_pid != 0)
+            continue;
+
+        for (auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf); NLMSG_OK(nlh, size_t(len)); nlh = NLMSG_NEXT(nlh, len)) {
+            if (nlh->nlmsg_type == NLMSG_NOOP)
+                continue;
+            if (nlh->nlmsg_type == NLMSG_ERROR || nlh->nlmsg_type == NLMSG_OVERRUN) {
+                ok = false;
+                continue;
+            }
+
+            auto *msg = reinterpret_cast<struct cn_msg *>(NLMSG_DATA(nlh));
+            if (msg->id.idx != CN_IDX_PROC || msg->id.val != CN_VAL_PROC)
+                continue;
+
+            auto *ev = reinterpret_cast<struct proc_event *>(msg->data);
+            switch (ev->what) {
+            case proc_event::PROC_EVENT_FORK:
+                // child_pid != child_tgid means a new thread
+                if (ev->event_data.fork.child_pid == ev->event_data.fork.child_tgid)
+                    events << ProcEvent {ProcEvent::kFork, ev->event_data.fork.child_tgid, ev->event_data.fork.parent_tgid};
+                break;
+            case proc_event::PROC_EVENT_EXEC:
+                events << ProcEvent {ProcEvent::kExec, ev->event_data.exec.process_tgid, 0};
+                break;
+            case proc_event::PROC_EVENT_EXIT:
+                if (ev->event_data.exit.process_pid == ev->event_data.exit.process_tgid)
+                    events << ProcEvent {ProcEvent::kExit, ev->event_data.exit.process_tgid, 0};
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    return ok;
+}
+
+bool ProcConnector::subscribe(bool listen)
+{
+    alignas(struct nlmsghdr) char buf[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))] {};
+
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf);
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    nlh->nlmsg_type = NLMSG_DONE;
+    nlh->nlmsg_pid = 0;
+
+    auto *msg = reinterpret_cast<struct cn_msg *>(NLMSG_DATA(nlh));
+    msg->id.idx = CN_IDX_PROC;
+    msg->id.val = CN_VAL_PROC;
+    msg->len = sizeof(enum proc_cn_mcast_op);
+
+    enum proc_cn_mcast_op op = listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    memcpy(msg->data, &op, sizeof(op));
+
+    errno = 0;
+    if (send(m_fd, nlh, nlh->nlmsg_len, 0) < 0) {
+        print_errno(errno, "send proc connector subscription failed");
+        return false;
+    }
+    return true;
+}
+
+bool ProcConnector::waitAck()
+{
+    alignas(struct nlmsghdr) char buf[1024];
+    struct pollfd pfd {m_fd, POLLIN, 0};
+
+    while (poll(&pfd, 1, PROC_CN_ACK_TIMEOUT) > 0) {
+        ssize_t len = recv(m_fd, buf, sizeof(buf), 0);
+        if (len < 0)
+            return false;
+
+        auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf);
+        if (!NLMSG_OK(nlh, size_t(len)) || nlh->nlmsg_type == NLMSG_ERROR)
+            return false;
+
+        auto *msg = reinterpret_cast<struct cn_msg *>(NLMSG_DATA(nlh));
+        auto *ev = reinterpret_cast<struct proc_event *>(msg->data);
+        // the ack is a PROC_EVENT_NONE carrying the subscription result, skip real events before it
+        if (ev->what == proc_event::PROC_EVENT_NONE)
+            return ev->event_data.ack.err == 0;
+    }
+
+    return false;
+}
+
+void ProcConnector::closeSocket()
+{
+    close(m_fd);
+    m_fd = -1;
+}
+
+} // namespace process
+} // namespace core
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROC_CONNECTOR_H
+#define PROC_CONNECTOR_H
+
+#include <QVector>
+
+#include <sys/types.h>
+
+namespace core {
+namespace process {
+
+/**
+ * @brief Process lifecycle event reported by the proc connector
+ */
+struct ProcEvent {
+    enum Type {
+        kFork, // new process created, ppid is the parent
+        kExec, // process image replaced
+        kExit // process exited
+    };
+
+    Type type;
+    pid_t pid;
+    pid_t ppid;
+};
+
+/**
+ * @brief Subscriber of NETLINK_CONNECTOR/CN_IDX_PROC fork/exec/exit events
+ *
+ * Events are queued in the socket receive buffer by the kernel and drained without
+ * blocking on each refresh. Subscribing needs CAP_NET_ADMIN, isValid returns false
+ * if the socket can't be opened or the kernel refused the subscription.
+ */
+class ProcConnector
+{
+public:
+    explicit ProcConnector();
+    ~ProcConnector();
+
+    ProcConnector(const ProcConnector &) = delete;
+    ProcConnector &operator=(const ProcConnector &) = delete;
+
+    inline bool isValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief readEvents Drain all pending events (threads are filtered out)
+     * @param events Events appended in the order the kernel reported them
+     * @return false if events were lost (receive buffer overrun) or the socket failed
+     */
+    bool readEvents(QVector<ProcEvent> &events);
+
+private:
+    bool subscribe(bool listen);
+    bool waitAck();
+    void closeSocket();
+
+private:
+    int m_fd;
+};
+
+} // namespace process
+} // namespace core
+
+#endif // PROC_CONNECTOR_H
@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "proc_reader.h"
+#include "common/common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define PROC_PID_PATH "/proc/%u"
+
+using namespace common::error;
+
+namespace core {
+namespace process {
+
+namespace {
+
+const size_t kScratchInitSize = 4096;
+
+/**
+ * @brief Per-thread growable buffer, reused by every ProcReader::read call on this thread
+ */
+struct ScratchBuffer {
+    ~ScratchBuffer()
+    {
+        free(data);
+    }
+
+    bool reserve(size_t size)
+    {
+        if (size <= capacity)
+            return true;
+
+        size_t ncap = capacity ? capacity : kScratchInitSize;
+        while (ncap < size)
+            ncap <<= 1;
+
+        char *ndata = static_cast<char *>(realloc(data, ncap));
+        if (!ndata)
+            return false;
+
+        data = ndata;
+        capacity = ncap;
+        ProcReader::stats().allocs++;
+        return true;
+    }
+
+    char *data {};
+    size_t capacity {};
+};
+
+thread_local ScratchBuffer scratch;
+
+ProcReader::Stats globalStats;
+
+} // namespace
+
+ProcReader::ProcReader(pid_t pid)
+    : m_pid(pid)
+    , m_dirfd(-1)
+    , m_gone(false)
+    , m_files(0)
+    , m_bytes(0)
+{
+    char path[32];
+    snprintf(path, sizeof(path), PROC_PID_PATH, pid);
+
+    errno = 0;
+    m_dirfd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    globalStats.opens++;
+    if (m_dirfd < 0)
+        handleError(errno, "");
+}
+
+ProcReader::~ProcReader()
+{
+    if (m_dirfd >= 0)
+        close(m_dirfd);
+}
+
+char *ProcReader::read(const char *name, size_t *len, size_t limit)
+{
+    if (m_dirfd < 0 || m_gone)
+        return nullptr;
+
+    errno = 0;
+    int fd = openat(m_dirfd, name, O_RDONLY | O_CLOEXEC);
+    globalStats.opens++;
+    if (fd < 0) {
+        handleError(errno, name);
+        return nullptr;
+    }
+
+    size_t total = 0;
+    for (;;) {
+        if (total + 1 >= scratch.capacity && !scratch.reserve(scratch.capacity + 1)) {
+            close(fd);
+            return nullptr;
+        }
+
+        size_t want = scratch.capacity - total - 1;
+        if (limit > 0 && total + want > limit)
+            want = limit - total;
+        if (want == 0)
+            break;
+
+        ssize_t nr = ::read(fd, scratch.data + total, want);
+        globalStats.reads++;
+        if (nr < 0) {
+            if (errno == EINTR)
+                continue;
+
+            auto err = errno;
+            close(fd);
+            handleError(err, name);
+            return nullptr;
+        }
+        total += size_t(nr);
+
+        // procfs generates the content of a read call in one go, a short read means eof
+        if (size_t(nr) < want)
+            break;
+    }
+    close(fd);
+
+    globalStats.bytes += total;
+    m_files++;
+    m_bytes += total;
+    scratch.data[total] = '\0';
+    if (len)
+        *len = total;
+
+    return scratch.data;
+}
+
+int ProcReader::openDir(const char *name)
+{
+    if (m_dirfd < 0 || m_gone)
+        return -1;
+
+    errno = 0;
+    int fd = openat(m_dirfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    globalStats.opens++;
+    if (fd < 0)
+        handleError(errno, name);
+
+    return fd;
+}
+
+ProcReader::Stats &ProcReader::stats()
+{
+    return globalStats;
+}
+
+void ProcReader::resetStats()
+{
+    globalStats.opens = 0;
+    globalStats.reads = 0;
+    globalStats.bytes = 0;
+    globalStats.allocs = 0;
+}
+
+void ProcReader::handleError(int err, const char *name)
+{
+    switch (err) {
+    case ENOENT:
+        // file may be missing on this kernel (e.g. io without task io accounting),
+        // the process is gone only if its stat entry is gone as well
+        if (m_dirfd < 0 || faccessat(m_dirfd, "stat", F_OK, 0) != 0)
+            m_gone = true;
+        break;
+    case ESRCH:
+        // process exited in between
+        m_gone = true;
+        break;
+    case EACCES:
+    case EPERM:
+        // files of other user's process (environ, io, fd) are not readable, not an error
+        break;
+    default:
+        print_errno(err, QString("read /proc/%1/%2 failed").arg(m_pid).arg(name));
+        break;
+    }
+}
+
+} // namespace process
+} // namespace core
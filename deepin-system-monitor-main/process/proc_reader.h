@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROC_READER_H
+#define PROC_READER_H
+
+#include <QtGlobal>
+
+#include <atomic>
+
+#include <sys/types.h>
+
+namespace core {
+namespace process {
+
+/**
+ * @brief Reader for the files under /proc/[pid]
+ *
+ * /proc/[pid] is opened once as a directory fd, every file below it is opened
+ * with openat() relative to that fd and read into a per-thread scratch buffer,
+ * so no path formatting, access() preflight or heap allocation is needed per file.
+ */
+class ProcReader
+{
+public:
+    /**
+     * @brief Syscall & allocation counters, accumulated by all readers on all threads
+     */
+    struct Stats {
+        std::atomic<qulonglong> opens {0}; // open/openat calls
+        std::atomic<qulonglong> reads {0}; // read calls on files, directory listings (readdir) are not counted
+        std::atomic<qulonglong> bytes {0}; // bytes read
+        std::atomic<qulonglong> allocs {0}; // scratch buffer (re)allocations
+    };
+
+    explicit ProcReader(pid_t pid);
+    ~ProcReader();
+
+    ProcReader(const ProcReader &) = delete;
+    ProcReader &operator=(const ProcReader &) = delete;
+
+    /**
+     * @brief isOpen Check if /proc/[pid] was opened successfully
+     */
+    inline bool isOpen() const
+    {
+        return m_dirfd >= 0;
+    }
+    /**
+     * @brief isGone Check if the process has exited (ENOENT/ESRCH seen)
+     */
+    inline bool isGone() const
+    {
+        return m_gone;
+    }
+    /**
+     * @brief dirfd File descriptor of /proc/[pid]
+     */
+    inline int dirfd() const
+    {
+        return m_dirfd;
+    }
+
+    /**
+     * @brief filesRead Number of files read by this reader
+     */
+    inline size_t filesRead() const
+    {
+        return m_files;
+    }
+    /**
+     * @brief bytesRead Number of bytes read by this reader
+     */
+    inline size_t bytesRead() const
+    {
+        return m_bytes;
+    }
+
+    /**
+     * @brief read Read /proc/[pid]/[name] into the per-thread scratch buffer
+     * @param name File name relative to /proc/[pid]
+     * @param len Number of bytes read, not counting the terminating null character
+     * @param limit Max number of bytes to read, 0 means the whole file
+     * @return Null terminated content, valid until the next read on this thread; nullptr on failure
+     */
+    char *read(const char *name, size_t *len = nullptr, size_t limit = 0);
+
+    /**
+     * @brief openDir Open sub directory /proc/[pid]/[name]
+     * @return Directory fd, or -1 on failure
+     */
+    int openDir(const char *name);
+
+    /**
+     * @brief stats Counters accumulated since last resetStats call
+     */
+    static Stats &stats();
+    static void resetStats();
+
+private:
+    void handleError(int err, const char *name);
+
+private:
+    pid_t m_pid;
+    int m_dirfd;
+    bool m_gone;
+    size_t m_files;
+    size_t m_bytes;
+};
+
+} // namespace process
+} // namespace core
+
+#endif // PROC_READER_H
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "process.h"
+#include "proc_reader.h"
 #include "private/process_p.h"
 #include "system/device_db.h"
 #include "process/process_db.h"
@@ -26,26 +27,31 @@
 #include <string.h>
 #include <fcntl.h>
 
-#define PROC_PATH "/proc"
-#define PROC_STAT_PATH "/proc/%u/stat"
-#define PROC_STATUS_PATH "/proc/%u/status"
-#define PROC_STATM_PATH "/proc/%u/statm"
-#define PROC_CMDLINE_PATH "/proc/%u/cmdline"
-#define PROC_ENVIRON_PATH "/proc/%u/environ"
-#define PROC_IO_PATH "/proc/%u/io"
-#define PROC_FD_PATH "/proc/%u/fd"
-#define PROC_FD_NAME_PATH "/proc/%u/fd/%s"
-#define PROC_SCHEDSTAT_PATH "/proc/%u/schedstat"
-
 using namespace common::alloc;
 using namespace common::init;
 using namespace common::core;
 using namespace common::error;
 using namespace core::system;
 
+// ticks between two reads of /proc/[pid]/status in variable info refresh
+#define STATUS_REFRESH_TICKS 5
+
 namespace core {
 namespace process {
 
+namespace {
+
+RefreshTierStats tierStatsTable[kRefreshTierCount];
+
+inline void countTier(RefreshTier tier, size_t files, size_t bytes)
+{
+    tierStatsTable[tier].refreshes++;
+    tierStatsTable[tier].files += files;
+    tierStatsTable[tier].bytes += bytes;
+}
+
+} // namespace
+
 QString getPriorityName(int prio)
 {
     const static QMap<ProcessPriority, QString> priorityMap = {
@@ -121,18 +127,56 @@ timeval Process::procuptime() const
 
 void Process::readProcessVariableInfo()
 {
-    d->valid = true;
+    readVariableFiles();
+    updateVariableInfo();
+}
 
-    bool ok = true;
-    ok = ok && readStat();
-//    readEnviron();
-    readSchedStat();
-    ok = ok && readStatm();
+void Process::readVariableFiles()
+{
+    ProcReader reader(d->pid);
+    bool ok = reader.isOpen();
+    ok = ok && readStat(reader);
+    readSchedStat(reader);
+    ok = ok && readStatm(reader);
 
-    readIO();
-    readSockInodes();
+    readIO(reader);
+    readSockInodes(reader);
+    size_t files = reader.filesRead();
+    size_t bytes = reader.bytesRead();
+    countTier(kHotTier, files, bytes);
 
-    d->proc_name.refreashProcessName(this);
+    // credentials may be changed by setuid without exec
+    if (ok && (d->identityChanged || ++d->statusTicks >= STATUS_REFRESH_TICKS)) {
+        uid_t uid = d->uid;
+        ok = readStatus(reader);
+        d->statusTicks = 0;
+        if (uid != d->uid)
+            d->identityChanged = true;
+
+        countTier(kStatusTier, reader.filesRead() - files, reader.bytesRead() - bytes);
+        files = reader.filesRead();
+        bytes = reader.bytesRead();
+    }
+
+    // cmdline & environ only change on exec
+    if (ok && d->identityChanged) {
+        ok = readCmdline(reader);
+        readEnviron(reader);
+        countTier(kIdentityTier, reader.filesRead() - files, reader.bytesRead() - bytes);
+    }
+    d->valid = ok && !reader.isGone();
+}
+
+void Process::updateVariableInfo()
+{
+    if (d->identityChanged) {
+        // resolve user, name, icon & app type of the new identity
+        updateSimpleInfo();
+        d->identityChanged = false;
+    } else if (d->statusTicks == 0) {
+        // display name of tray apps follows window title, no need to catch up every tick
+        d->proc_name.refreashProcessName(this);
+    }
     d->uptime = SysInfo::instance()->uptime();
 
     CPUSet *cpuset = DeviceDB::instance()->cpuSet();
@@ -157,35 +201,50 @@ void Process::readProcessVariableInfo()
     struct IOPS iops = DISKIOSampleFrame::diskiops(pair.first, pair.second);
     d->diskIOSpeedSample->addSample(new IOPSSampleFrame(iops));
 
-    qulonglong sum_recv = 0;
-    qulonglong sum_send = 0;
-
-    for (int i = 0; i < d->sockInodes.size(); ++i) {
-        SockIOStat sockIOStat;
-        bool result = NetifMonitor::instance()->getSockIOStatByInode(d->sockInodes[i], sockIOStat);
-        if (result) {
-            sum_recv += sockIOStat->rx_bytes;
-            sum_send += sockIOStat->tx_bytes;
-        }
-    }
-    d->networkIOSample->addSample(new IOSampleFrame(d->uptime, {sum_recv, sum_send}));
+    updateNetworkIO();
+}
 
-    auto netpair = d->networkIOSample->recentSamplePair();
-    struct IOPS netiops = IOSampleFrame::iops(netpair.first, netpair.second);
-    d->networkBandwidthSample->addSample(new IOPSSampleFrame(netiops));
+void Process::readProcessSimpleInfo()
+{
+    readSimpleFiles();
+    updateSimpleInfo();
+}
 
-    d->valid = d->valid && ok;
+void Process::readSimpleFiles()
+{
+    ProcReader reader(d->pid);
+    bool ok = reader.isOpen();
+    readEnviron(reader);
+    ok = ok && readStat(reader);
+    ok = ok && readStatus(reader);
+    ok = ok && readCmdline(reader);
+    d->valid = ok && !reader.isGone();
+    d->statusTicks = 0;
+    d->identityChanged = false;
 }
 
-void Process::readProcessSimpleInfo()
+void Process::inheritSimpleFiles(const Process &parent)
 {
-    d->valid = true;
-    bool ok = true;
-readEnviron();
-    ok = ok && readStat();
-    ok = ok && readStatus();
-    ok = ok && readCmdline();
+    d->valid = parent.d->valid;
+    d->ppid = parent.d->pid;
+    d->comm = parent.d->comm;
+    d->name = parent.d->name;
+    d->cmdline = parent.d->cmdline;
+    d->environ = parent.d->environ;
+    d->state = parent.d->state;
+    d->mask = parent.d->mask;
+    d->uid = parent.d->uid;
+    d->euid = parent.d->euid;
+    d->suid = parent.d->suid;
+    d->fuid = parent.d->fuid;
+    d->gid = parent.d->gid;
+    d->egid = parent.d->egid;
+    d->sgid = parent.d->sgid;
+    d->fgid = parent.d->fgid;
+}
 
+void Process::updateSimpleInfo()
+{
     d->usrerName = SysInfo::userName(d->uid);
     d->proc_name.refreashProcessName(this);
     d->proc_icon.refreashProcessIcon(this);
@@ -201,24 +260,23 @@ readEnviron();
     } else if (euid == d->uid) {
         d->apptype = kFilterCurrentUser;
     }
-
-    d->valid = d->valid && ok;
 }
 
 void Process::readProcessInfo()
 {
     d->valid = true;
 
-    bool ok = true;
-
-    ok = ok && readStat();
-    ok = ok && readCmdline();
-    readEnviron();
-    readSchedStat();
-    ok = ok && readStatus();
-    ok = ok && readStatm();
-    readIO();
-    readSockInodes();
+    ProcReader reader(d->pid);
+    bool ok = reader.isOpen();
+    ok = ok && readStat(reader);
+    ok = ok && readCmdline(reader);
+    readEnviron(reader);
+    readSchedStat(reader);
+    ok = ok && readStatus(reader);
+    ok = ok && readStatm(reader);
+    readIO(reader);
+    readSockInodes(reader);
+    ok = ok && !reader.isGone();
 
     d->usrerName = SysInfo::userName(d->uid);
     d->proc_name.refreashProcessName(this);
@@ -259,69 +317,52 @@ void Process::readProcessInfo()
         d->apptype = kFilterCurrentUser;
     }
 
-    qulonglong sum_recv = 0;
-    qulonglong sum_send = 0;
+    updateNetworkIO();
 
-    for (int i = 0; i < d->sockInodes.size(); ++i) {
-        SockIOStat sockIOStat;
-        bool result = NetifMonitor::instance()->getSockIOStatByInode(d->sockInodes[i], sockIOStat);
-        if (result) {
-            sum_recv += sockIOStat->rx_bytes;
-            sum_send += sockIOStat->tx_bytes;
-        }
-    }
-    d->networkIOSample->addSample(new IOSampleFrame(d->uptime, {sum_recv, sum_send}));
+    d->valid = d->valid && ok;
+}
 
-    auto netpair = d->networkIOSample->recentSamplePair();
-    struct IOPS netiops = IOSampleFrame::iops(netpair.first, netpair.second);
-    d->networkBandwidthSample->addSample(new IOPSSampleFrame(netiops));
+RefreshTierStats &Process::tierStats(RefreshTier tier)
+{
+    return tierStatsTable[tier];
+}
 
-    d->valid = d->valid && ok;
+void Process::resetTierStats()
+{
+    for (RefreshTierStats &stats : tierStatsTable) {
+        stats.refreshes = 0;
+        stats.files = 0;
+        stats.bytes = 0;
+    }
 }
 
 // read /proc/[pid]/stat
-bool Process::readStat()
+bool Process::readStat(ProcReader &reader)
 {
     bool ok {true};
-    char path[256];
-    QByteArray buf;
-    int fd, rc;
-    ssize_t sz;
-    char *pos, *begin;
-
-    buf.reserve(1025);
-
-    errno = 0;
-    sprintf(path, PROC_STAT_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return !ok;     /* no such dirent (anymore) */
-        
-    // open /proc/[pid]/stat
-    if ((fd = open(path, O_RDONLY)) < 0) {
-        print_errno(errno, QString("open %1 failed").arg(path));
-        return !ok;
-    }
+    int rc;
+    char *buf, *pos, *begin;
 
-    // read data
-    sz = read(fd, buf.data(), 1024);
-    close(fd);
-    if (sz < 0) {
-        print_errno(errno, QString("read %1 failed").arg(path));
+    buf = reader.read("stat");
+    if (!buf)
         return !ok;
-    }
-    buf.data()[sz] = '\0';
 
     // get process name between (...)
-    begin = strchr(buf.data(), '(');
-    begin += 1;
-
-    pos = strrchr(buf.data(), ')');
-    if (!pos) {
+    begin = strchr(buf, '(');
+    pos = strrchr(buf, ')');
+    if (!begin || !pos) {
         return !ok;
     }
+    begin += 1;
 
     *pos = '\0';
-    // process name (may be truncated by kernel if it's too long)
-    d->name = QByteArray(begin);
+    // process name (may be truncated by kernel if it's too long), keep the resolved name until comm changes
+    bool commChanged = qstrcmp(d->comm.constData(), begin) != 0;
+    if (commChanged) {
+        d->comm = QByteArray(begin);
+        d->name = d->comm;
+    }
+    unsigned long long start_time = d->start_time;
 
     pos += 2;
 
@@ -353,222 +394,144 @@ bool Process::readStat()
     if (rc < 17) {
         d->guest_time = d->cguest_time = 0;
     }
+    // exec changes comm, a reused pid changes start_time
+    if (start_time != 0 && (commChanged || d->start_time != start_time)) {
+        d->identityChanged = true;
+    }
 
     return ok;
 }
 
 // read /proc/[pid]/cmdline
-bool Process::readCmdline()
+bool Process::readCmdline(ProcReader &reader)
 {
     bool ok = true;
-    char path[128] {};
     const size_t bsiz = 4096;
-    QByteArray cmd;
-    cmd.reserve(bsiz);
     size_t nb;
-    char *begin, *cur, *end;
-
-    sprintf(path, PROC_CMDLINE_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return !ok;     /* no such dirent (anymore) */
+    char *buf, *begin, *cur, *end;
 
-    errno = 0;
-    // open /proc/[pid]/cmdline
-    uFile fp(fopen(path, "r"));
-    if (!fp) {
-        print_errno(errno, QString("open %1 failed").arg(path));
+    buf = reader.read("cmdline", &nb, bsiz - 1);
+    if (!buf)
         return !ok;
-    }
-
-    nb = fread(cmd.data(), 1, bsiz - 1, fp.get());
-    if (ferror(fp.get())) {
-        print_errno(errno, QString("read %1 failed").arg(path));
-        return !ok;
-    }
-
-    cmd.data()[nb] = '\0';
 
-    begin = cur = cmd.data();
-    end = cmd.data() + nb;
+    d->cmdline.clear();
+    begin = cur = buf;
+    end = buf + nb;
     while (cur < end) {
         // cmdline may sperarted by null character
         if (*cur == '\0') {
-            QByteArray buf(begin);
-            d->cmdline << buf;
+            d->cmdline << QByteArray(begin);
             begin = cur + 1;
         }
         ++cur;
     }
     if (begin < end) {
-        QByteArray buf(begin);
-        d->cmdline << buf;
+        d->cmdline << QByteArray(begin);
     }
 
     return ok;
 }
 
 // read /proc/[pid]/environ
-void Process::readEnviron()
-{
-    const size_t sz = 1024;
-    char path[128] {};
-    ssize_t nb;
-    QByteArray sbuf {};
-    char buf[sz + 1] {};
-    int fd;
-
-    sprintf(path, PROC_ENVIRON_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return;     /* no such dirent (anymore) */
-
-    errno = 0;
-    // open /proc/[pid]/environ
-    fd = open(path, O_RDONLY);
-    if (fd < 0) {
-        print_errno(errno, QString("open %1 failed").arg(path));
-        return;
-    }
-
-    while ((nb = read(fd, buf, sz))) {
-        buf[nb] = '\0';
-        sbuf.append(buf, int(nb));
-    }
-    close(fd);
+void Process::readEnviron(ProcReader &reader)
+{
+    size_t nb;
+    char *buf, *begin, *cur, *end, *sep;
 
-    if (nb == 0 && errno != 0) {
-        print_errno(errno, QString("read %1 failed").arg(path));
+    buf = reader.read("environ", &nb);
+    if (!buf)
         return;
-    }
 
-    if (sbuf.size() > 0) {
-        auto elist = sbuf.split('\0');
-        for (auto it : elist) {
-            // it: name=value pair
-            auto kvp = it.split('=');
-            if (kvp.size() == 2) {
-                d->environ[kvp[0]] = kvp[1];
+    d->environ.clear();
+
+    begin = cur = buf;
+    end = buf + nb;
+    while (cur <= end) {
+        // each entry is a name=value pair terminated by null character
+        if (cur == end || *cur == '\0') {
+            sep = static_cast<char *>(memchr(begin, '=', size_t(cur - begin)));
+            if (sep && !memchr(sep + 1, '=', size_t(cur - sep - 1))) {
+                d->environ[QString::fromUtf8(begin, int(sep - begin))] = QString::fromUtf8(sep + 1, int(cur - sep - 1));
             }
+            begin = cur + 1;
         }
-    } // ::if(sbuf)
+        ++cur;
+    }
 }
 
 // read /proc/[pid]/schedstat
-void Process::readSchedStat()
+void Process::readSchedStat(ProcReader &reader)
 {
-    const size_t bsiz = 1024;
-    QByteArray buf;
-    char path[128];
-    int fd, rc;
-    ssize_t n;
+    int rc;
     unsigned long long wtime = 0;
 
-    buf.reserve(bsiz);
-    sprintf(path, PROC_SCHEDSTAT_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return;     /* no such dirent (anymore) */
-
-    errno = 0;
-    // open /proc/[pid]/schedstat
-    if ((fd = open(path, O_RDONLY)) < 0) {
-        print_errno(errno, QString("open %1 failed").arg(path));
-        return;
-    }
-
-    n = read(fd, buf.data(), bsiz - 1);
-    close(fd);
-
-    if (n < 0) {
-        print_errno(errno, QString("read %1 failed").arg(path));
+    char *buf = reader.read("schedstat");
+    if (!buf)
         return;
-    }
 
-    buf.data()[n] = '\0';
-    rc = sscanf(buf.data(), "%*u %llu %*d", &wtime);
+    rc = sscanf(buf, "%*u %llu %*d", &wtime);
     if (rc == 1) {
         d->wtime = wtime * HZ / 1000000000;
     }
 }
 
 // read /proc/[pid]/status
-bool Process::readStatus()
+bool Process::readStatus(ProcReader &reader)
 {
     bool ok {true};
-    const size_t bsiz = 256;
-    QByteArray buf;
-    char path[128];
-
-    buf.reserve(bsiz);
-    sprintf(path, PROC_STATUS_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return !ok;     /* no such dirent (anymore) */
-
-    errno = 0;
-    uFile fp(fopen(path, "r"));
-    // open /proc/[pid]/status
-    if (!fp) {
-        print_errno(errno, QString("open %1 failed").arg(path));
+    char *line, *next;
+
+    char *buf = reader.read("status");
+    if (!buf)
         return !ok;
-    }
 
     // scan each line
-    while (fgets(buf.data(), bsiz, fp.get())) {
-        if (!strncmp(buf.data(), "Umask:", 6)) {
-            sscanf(buf.data() + 7, "%u", &d->mask);
-        } else if (!strncmp(buf.data(), "State:", 6)) {
-            sscanf(buf.data() + 7, "%c %*s", &d->state);
-        } else if (!strncmp(buf.data(), "Uid:", 4)) {
-            sscanf(buf.data() + 5, "%u %u %u %u",
+    for (line = buf; line && *line; line = next) {
+        next = strchr(line, '\n');
+        if (next)
+            *next++ = '\0';
+
+        if (!strncmp(line, "Umask:", 6)) {
+            sscanf(line + 7, "%u", &d->mask);
+        } else if (!strncmp(line, "State:", 6)) {
+            sscanf(line + 7, "%c %*s", &d->state);
+        } else if (!strncmp(line, "Uid:", 4)) {
+            sscanf(line + 5, "%u %u %u %u",
                    &d->uid,
                    &d->euid,
                    &d->suid,
                    &d->fuid);
-        } else if (!strncmp(buf.data(), "Gid:", 4)) {
-            sscanf(buf.data() + 5, "%u %u %u %u",
+        } else if (!strncmp(line, "Gid:", 4)) {
+            sscanf(line + 5, "%u %u %u %u",
                    &d->gid,
                    &d->egid,
                    &d->sgid,
                    &d->fgid);
+            // nothing we need after Gid
+            break;
         }
-    } // ::while(fgets)
-
-    if (ferror(fp.get())) {
-        print_errno(errno, QString("read %1 failed").arg(path));
-        return !ok;
-    }
+    } // ::for(line)
 
     return ok;
 }
 
 // read /proc/[pid]/statm
-bool Process::readStatm()
+bool Process::readStatm(ProcReader &reader)
 {
     bool ok {true};
-    int fd;
-    const size_t bsiz = 1024;
-    char path[128] {}, buf[bsiz + 1] {};
-    ssize_t nr;
-
-    sprintf(path, PROC_STATM_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return !ok;     /* no such dirent (anymore) */
-
-    errno = 0;
-    // open /proc/[pid]/statm
-    if ((fd = open(path, O_RDONLY)) < 0) {
-        print_errno(errno, QString("open %1 failed").arg(path));
-        return !ok;
-    }
+    int nr;
 
-    nr = read(fd, buf, bsiz);
-    close(fd);
-    if (nr < 0) {
-        print_errno(errno, QString("read %1 failed").arg(path));
+    char *buf = reader.read("statm");
+    if (!buf)
         return !ok;
-    }
 
-    buf[nr] = '\0';
     // get resident set size & resident shared size in pages
     nr = sscanf(buf, "%llu %llu %llu", &d->vmsize, &d->rss, &d->shm);
     if (nr != 3) {
         d->vmsize = 0;
         d->rss = 0;
         d->shm = 0;
-        print_errno(errno, QString("read %1 failed").arg(path));
+        qWarning() << QString("parse /proc/%1/statm failed").arg(d->pid);
     } else {
         // convert to kB
         d->vmsize <<= kb_shift;
@@ -579,52 +542,46 @@ bool Process::readStatm()
 }
 
 // read /proc/[pid]/io
-void Process::readIO()
+void Process::readIO(ProcReader &reader)
 {
-    const size_t bsiz = 128;
-    char path[128], buf[bsiz];
+    char *line, *next;
 
-    sprintf(path, PROC_IO_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return;     /* no such dirent (anymore) */
-
-    errno = 0;
-    // open /proc/[pid]/io
-    uFile fp(fopen(path, "r"));
-    if (!fp) {
-        print_errno(errno, QString("open %1 failed").arg(path));
+    char *buf = reader.read("io");
+    if (!buf)
         return;
-    }
 
     // scan each line
-    while (fgets(buf, bsiz, fp.get())) {
-        if (!strncmp(buf, "read_bytes", 10)) {
-            sscanf(buf + 12, "%llu", &d->read_bytes);
-        } else if (!strncmp(buf, "write_bytes", 11)) {
-            sscanf(buf + 13, "%llu", &d->write_bytes);
-        } else if (!strncmp(buf, "cancelled_write_bytes", 21)) {
-            sscanf(buf + 23, "%llu", &d->cancelled_write_bytes);
+    for (line = buf; line && *line; line = next) {
+        next = strchr(line, '\n');
+        if (next)
+            *next++ = '\0';
+
+        if (!strncmp(line, "read_bytes", 10)) {
+            sscanf(line + 12, "%llu", &d->read_bytes);
+        } else if (!strncmp(line, "write_bytes", 11)) {
+            sscanf(line + 13, "%llu", &d->write_bytes);
+        } else if (!strncmp(line, "cancelled_write_bytes", 21)) {
+            sscanf(line + 23, "%llu", &d->cancelled_write_bytes);
         }
-    } // ::while(fgets)
-    if (ferror(fp.get())) {
-        print_errno(errno, QString("read %1 failed").arg(path));
-    }
+    } // ::for(line)
 }
 
 // read /proc/[pid]/fd
-void Process::readSockInodes()
+void Process::readSockInodes(ProcReader &reader)
 {
     struct dirent *dp;
-    char path[128], fdp[256 + 32];
     struct stat sbuf;
 
-    sprintf(path, PROC_FD_PATH, d->pid);
-    if(access(path, R_OK) != 0)    return;     /* no such dirent (anymore) */
+    d->sockInodes.clear();
 
-    errno = 0;
     // open /proc/[pid]/fd dir
-    uDir dir(opendir(path));
+    int fdfd = reader.openDir("fd");
+    if (fdfd < 0)
+        return;
+
+    uDir dir(fdopendir(fdfd));
     if (!dir) {
-        print_errno(errno, QString("open %1 failed").arg(path));
+        close(fdfd);
         return;
     }
 
@@ -632,20 +589,44 @@ void Process::readSockInodes()
     while ((dp = readdir(dir.get()))) {
         // only if entry name starts with a digit
         if (isdigit(dp->d_name[0])) {
-            // open /proc/[pid]/fd/[fd]
-            sprintf(fdp, PROC_FD_NAME_PATH, d->pid, dp->d_name);
-            memset(&sbuf, 0, sizeof(struct stat));
-            if (!stat(fdp, &sbuf)) {
+            // stat /proc/[pid]/fd/[fd]
+            if (!fstatat(fdfd, dp->d_name, &sbuf, 0)) {
                 // get inode if it's a socket descriptor
                 if (S_ISSOCK(sbuf.st_mode)) {
                     d->sockInodes << sbuf.st_ino;
                 }
-            } // ::if(stat)
+            } // ::if(fstatat)
         } // ::if(isdigit)
     } // ::while(readdir)
-    // if (errno) {
-    //     print_errno(errno, QString("read %1 failed").arg(path));
-    // }
+}
+
+void Process::updateNetworkIO()
+{
+    qulonglong sum_recv = 0;
+    qulonglong sum_send = 0;
+    QHash<ino_t, IO> sockIO;
+
+    for (int i = 0; i < d->sockInodes.size(); ++i) {
+        SockIOStat sockIOStat;
+        bool result = NetifMonitor::instance()->getSockIOStatByInode(d->sockInodes[i], sockIOStat);
+        if (result) {
+            sum_recv += sockIOStat->rx_bytes;
+            sum_send += sockIOStat->tx_bytes;
+            sockIO.insert(d->sockInodes[i], {sockIOStat->rx_bytes, sockIOStat->tx_bytes});
+        }
+    }
+    d->networkIOSample->addSample(new IOSampleFrame(d->uptime, {sum_recv, sum_send}));
+
+    auto netpair = d->networkIOSample->recentSamplePair();
+    struct IOPS netiops = IOSampleFrame::iops(netpair.first, netpair.second);
+    d->networkBandwidthSample->addSample(new IOPSSampleFrame(netiops));
+
+    // sockets share the interval of the process sample
+    d->sockIOBps.clear();
+    for (auto it = sockIO.constBegin(); it != sockIO.constEnd(); ++it) {
+        IOSampleFrame frame(d->uptime, it.value());
+        d->sockIOBps.insert(it.key(), IOSampleFrame::iops(netpair.first, &frame));
+    }
 }
 
 bool Process::isValid() const
@@ -810,6 +791,16 @@ qulonglong Process::cancelledWriteBytes() const
     return d->cancelled_write_bytes;
 }
 
+QList<ino_t> Process::sockInodes() const
+{
+    return d->sockInodes;
+}
+
+QHash<ino_t, IOPS> Process::sockIOBps() const
+{
+    return d->sockIOBps;
+}
+
 qreal Process::recvBps() const
 {
     auto *sample = d->networkBandwidthSample->recentSample();
@@ -7,6 +7,7 @@
 #define PROCESS_H
 
 #include "system/sys_info.h"
+#include "common/sample.h"
 
 #include <QByteArray>
 #include <QString>
@@ -14,6 +15,8 @@
 #include <QSharedDataPointer>
 #include <QUrl>
 
+#include <atomic>
+
 #include <sys/types.h>
 
 using namespace core::system;
@@ -40,6 +43,25 @@ static const int kLowPriorityMin = 10;
 static const int kVeryLowPriorityMax = 11;
 static const int kVeryLowPriorityMin = 19;
 
+/**
+ * @brief Refresh tiers of /proc files read by readVariableFiles
+ */
+enum RefreshTier {
+    kHotTier, // stat, statm, schedstat, io & fd, every tick
+    kStatusTier, // status (credentials), every STATUS_REFRESH_TICKS ticks
+    kIdentityTier, // cmdline & environ, only when start_time or comm in stat changed
+    kRefreshTierCount
+};
+
+/**
+ * @brief Cost counters of a refresh tier, accumulated by all processes on all threads
+ */
+struct RefreshTierStats {
+    std::atomic<qulonglong> refreshes {0}; // number of process refreshes in this tier
+    std::atomic<qulonglong> files {0}; // files read
+    std::atomic<qulonglong> bytes {0}; // bytes read
+};
+
 QString getPriorityName(int prio);
 ProcessPriority getProcessPriorityStub(int prio);
 
@@ -47,6 +69,7 @@ ProcessPriority getProcessPriorityStub(int prio);
  * @brief The Process class
  */
 class ProcessPrivate;
+class ProcReader;
 class Process
 {
 public:
@@ -114,49 +137,90 @@ public:
     qulonglong recvBytes() const;
     qulonglong sentBytes() const;
 
+    /**
+     * @brief sockInodes Socket inodes opened by this process
+     */
+    QList<ino_t> sockInodes() const;
+    /**
+     * @brief sockIOBps Network rate of each socket over last interval, idle sockets left out
+     */
+    QHash<ino_t, IOPS> sockIOBps() const;
+
     void readProcessInfo();
     void readProcessSimpleInfo();
     void readProcessVariableInfo();
 
+    /**
+     * @brief readSimpleFiles Read /proc files needed by simple info, safe to run on worker threads
+     */
+    void readSimpleFiles();
+    /**
+     * @brief inheritSimpleFiles Take over simple info of forked parent instead of reading /proc
+     * @param parent Parent process, until exec the child shares its image and credentials
+     */
+    void inheritSimpleFiles(const Process &parent);
+    /**
+     * @brief updateSimpleInfo Resolve user, name, icon & app type from simple files read before
+     */
+    void updateSimpleInfo();
+    /**
+     * @brief readVariableFiles Read /proc files needed by variable info, safe to run on worker threads
+     */
+    void readVariableFiles();
+    /**
+     * @brief updateVariableInfo Update name & cpu/disk/network samples from variable files read before
+     */
+    void updateVariableInfo();
+
+    /**
+     * @brief tierStats Cost of refresh tier since last resetTierStats call
+     */
+    static RefreshTierStats &tierStats(RefreshTier tier);
+    static void resetTierStats();
+
 private:
     /**
      * @brief Read /proc/[pid]/stat
      * @return true: success; false: failure
      */
-    bool readStat();
+    bool readStat(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/cmdline
      * @return true: success; false: failure
      */
-    bool readCmdline();
+    bool readCmdline(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/environ
      */
-    void readEnviron();
+    void readEnviron(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/schedstat
      */
-    void readSchedStat();
+    void readSchedStat(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/status
      * @return true: success; false: failure
      */
-    bool readStatus();
+    bool readStatus(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/statm
      * @return true: success; false: failure
      */
-    bool readStatm();
+    bool readStatm(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/io
      * @return true: success; false: failure
      */
-    void readIO();
+    void readIO(ProcReader &reader);
     /**
      * @brief Read /proc/[pid]/fd
      * @return true: success; false: failure
      */
-    void readSockInodes();
+    void readSockInodes(ProcReader &reader);
+    /**
+     * @brief Take io stat of sockets from netif monitor, update network samples & per socket rates
+     */
+    void updateNetworkIO();
 
 private:
 //    QSharedDataPointer<ProcessPrivate> d;
@@ -13,6 +13,9 @@
 #include "process_name_cache.h"
 #include "process_controller.h"
 #include "priority_controller.h"
+#include "settings.h"
+#include "system/netif_monitor.h"
+#include "system/sys_info.h"
 
 #include <QReadLocker>
 #include <QWriteLocker>
@@ -27,10 +30,17 @@ namespace core {
 namespace process {
 
 const int DesktopEntryTimeCount = 150; // 5 minutes interval
+// socket table of capture job older than this is considered stale, capture job refreshes it every 2 seconds
+const int SockStatStaleTime = 5;
 ProcessDB::ProcessDB(QObject *parent)
     : QObject(parent)
+    , m_snapshot(std::make_shared<const ProcessSnapshot>())
+    , m_connections(std::make_shared<const ConnectionSnapshot>())
+    , m_connectionWatchers(0)
 {
     m_procSet = new ProcessSet();
+    m_procSet->setScanWorkers(Settings::instance()->getOption(kSettingKeyProcessScanWorkers, 0).toInt());
+    m_procSet->setEventMonitor(Settings::instance()->getOption(kSettingKeyProcessEventMonitor, true).toBool());
     m_windowList = new WMWindowList();
     m_desktopEntryCache = new DesktopEntryCache();
 
@@ -72,6 +82,27 @@ ProcessSet *ProcessDB::processSet()
     return m_procSet;
 }
 
+ProcessSnapshotPtr ProcessDB::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+ConnectionSnapshotPtr ProcessDB::connections() const
+{
+    return std::atomic_load(&m_connections);
+}
+
+void ProcessDB::watchConnections(bool watch)
+{
+    if (watch) {
+        ++m_connectionWatchers;
+    } else if (--m_connectionWatchers <= 0) {
+        m_connectionWatchers = 0;
+        // drop the table, it's rebuilt on next refresh once watched again
+        std::atomic_store(&m_connections, std::make_shared<const ConnectionSnapshot>());
+    }
+}
+
 WMWindowList *ProcessDB::windowList()
 {
     return m_windowList;
@@ -117,6 +148,23 @@ void ProcessDB::update()
 
     m_windowList->updateWindowListCache();
     m_procSet->refresh();
+
+    // publish a frozen copy, the previous snapshot is freed once the last reader drops it
+    std::atomic_store(&m_snapshot, std::make_shared<const ProcessSnapshot>(m_procSet->snapshot()));
+
+    if (m_connectionWatchers > 0) {
+        // reuse the socket table of capture job, only dump sockets ourselves if capture is not running
+        SockStatMap socks;
+        time_t ts = NetifMonitor::instance()->sockStats(socks);
+        if (ts == 0 || time(nullptr) - ts >= SockStatStaleTime) {
+            socks.clear();
+            SysInfo::readSockStat(socks);
+        }
+
+        auto connections = std::make_shared<ConnectionSnapshot>();
+        m_procSet->buildConnections(socks, *connections);
+        std::atomic_store(&m_connections, ConnectionSnapshotPtr(std::move(connections)));
+    }
 }
 
 void ProcessDB::setProcessPriority(pid_t pid, int priority)
@@ -11,10 +11,13 @@
 #include "system/system_monitor_thread.h"
 #include "system/system_monitor.h"
 #include "process_set.h"
+#include "process_snapshot.h"
+#include "connection_snapshot.h"
 
 #include <QReadWriteLock>
 #include <QObject>
 
+#include <atomic>
 #include <memory>
 
 #include <unistd.h>
@@ -45,6 +48,23 @@ public:
     static ProcessDB *instance();
 
     ProcessSet *processSet();
+    /**
+     * @brief snapshot Latest published process snapshot, safe to call from any thread
+     *
+     * The returned snapshot is never modified, it stays alive as long as the caller holds it,
+     * even after newer snapshots have been published.
+     */
+    ProcessSnapshotPtr snapshot() const;
+    /**
+     * @brief connections Latest published connection table, safe to call from any thread
+     *
+     * Only built while at least one view watches it, empty otherwise.
+     */
+    ConnectionSnapshotPtr connections() const;
+    /**
+     * @brief watchConnections Start or stop building the connection table each refresh (reference counted)
+     */
+    void watchConnections(bool watch);
     WMWindowList *windowList();
     DesktopEntryCache *desktopEntryCache();
 
@@ -86,6 +106,11 @@ private:
     DesktopEntryCache *m_desktopEntryCache;
 
     ProcessSet *m_procSet;
+    // written by monitor thread once per refresh, read by gui thread, only accessed atomically
+    ProcessSnapshotPtr m_snapshot;
+    // same as m_snapshot, built only while m_connectionWatchers > 0
+    ConnectionSnapshotPtr m_connections;
+    std::atomic_int m_connectionWatchers;
     int m_desktopEntryTimeCount;
 
     uid_t m_euid;
@@ -4,24 +4,73 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "process_set.h"
+#include "proc_reader.h"
 #include "process/process_db.h"
 #include "common/common.h"
 #include "wm/wm_window_list.h"
 // #include "settings.h"
 
 #include <QDebug>
+#include <QLoggingCategory>
+#include <QRunnable>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
 
 #include <errno.h>
 
 #define PROC_PATH "/proc"
 
+// max worker threads when chosen by cpu count
+#define MAX_AUTO_SCAN_WORKERS 8
+// process count each worker handles at least, smaller scans are not worth the dispatch
+#define MIN_SCAN_SHARD_SIZE 64
+// refreshes between two full /proc walks in event mode
+#define PROC_EVENT_RECONCILE_TICKS 30
+
 using namespace common::error;
 
+// per refresh scan cost, off by default:
+// QT_LOGGING_RULES="deepin.system.monitor.process.scan.debug=true" turns it on
+Q_LOGGING_CATEGORY(processScan, "deepin.system.monitor.process.scan", QtWarningMsg)
+
 namespace core {
 namespace process {
 
+namespace {
+
+/**
+ * @brief Run one /proc reading step on a shard of processes
+ */
+class ProcessScanShard : public QRunnable
+{
+public:
+    ProcessScanShard(Process *begin, Process *end, void (Process::*read)())
+        : m_begin(begin)
+        , m_end(end)
+        , m_read(read)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        for (Process *proc = m_begin; proc != m_end; ++proc) {
+            (proc->*m_read)();
+        }
+    }
+
+private:
+    Process *m_begin;
+    Process *m_end;
+    void (Process::*m_read)();
+};
+
+} // namespace
+
 ProcessSet::ProcessSet()
     : m_set {}
+    , m_snapshot {}
     , m_recentProcStage {}
     , m_pidCtoPMapping {}
     , m_pidPtoCMapping {}
@@ -30,15 +79,58 @@ ProcessSet::ProcessSet()
 
 ProcessSet::ProcessSet(const ProcessSet &other)
     : m_set(other.m_set)
+    , m_snapshot(other.m_snapshot)
     , m_recentProcStage(other.m_recentProcStage)
     , m_pidCtoPMapping(other.m_pidCtoPMapping)
     , m_pidPtoCMapping(other.m_pidPtoCMapping)
 {
-    m_prePid.clear();
-    m_curPid.clear();
-    m_pidMyApps.clear();
-    m_simpleSet.clear();
     // m_settings = Settings::instance();
+    setScanWorkers(other.m_scanWorkers);
+}
+
+ProcessSet::~ProcessSet()
+{
+    if (m_scanPool)
+        m_scanPool->waitForDone();
+}
+
+void ProcessSet::setScanWorkers(int workers)
+{
+    if (workers <= 0)
+        workers = qBound(1, QThread::idealThreadCount(), MAX_AUTO_SCAN_WORKERS);
+
+    m_scanWorkers = workers;
+    if (workers == 1) {
+        m_scanPool.reset();
+        return;
+    }
+
+    if (!m_scanPool)
+        m_scanPool.reset(new QThreadPool());
+    m_scanPool->setMaxThreadCount(workers);
+}
+
+int ProcessSet::scanWorkers() const
+{
+    return m_scanWorkers;
+}
+
+void ProcessSet::scanParallel(QVector<Process> &procs, void (Process::*read)())
+{
+    int nshards = m_scanPool ? qMin(m_scanWorkers, procs.size() / MIN_SCAN_SHARD_SIZE) : 1;
+    if (nshards <= 1) {
+        // single threaded fallback
+        ProcessScanShard(procs.begin(), procs.end(), read).run();
+        return;
+    }
+
+    int shardSize = (procs.size() + nshards - 1) / nshards;
+    for (int i = 0; i < procs.size(); i += shardSize) {
+        Process *begin = procs.begin() + i;
+        Process *end = procs.begin() + qMin(i + shardSize, procs.size());
+        m_scanPool->start(new ProcessScanShard(begin, end, read));
+    }
+    m_scanPool->waitForDone();
 }
 
 void ProcessSet::mergeSubProcNetIO(pid_t ppid, qreal &recvBps, qreal &sendBps)
@@ -68,7 +160,24 @@ void ProcessSet::mergeSubProcCpu(pid_t ppid, qreal &cpu)
 
 void ProcessSet::refresh()
 {
+    ProcReader::resetStats();
+    Process::resetTierStats();
     scanProcess();
+
+    if (!processScan().isDebugEnabled())
+        return;
+
+    const ProcReader::Stats &stats = ProcReader::stats();
+    qCDebug(processScan) << "process scan:" << stats.opens.load() << "opens," << stats.reads.load() << "reads,"
+                         << stats.bytes.load() << "bytes," << stats.allocs.load() << "scratch allocations,"
+                         << m_lifecycle.births << "births," << m_lifecycle.deaths << "deaths," << m_lifecycle.shortLived << "short lived";
+
+    const char *tierNames[kRefreshTierCount] = {"hot", "status", "identity"};
+    for (int tier = kHotTier; tier < kRefreshTierCount; ++tier) {
+        const RefreshTierStats &tierStats = Process::tierStats(RefreshTier(tier));
+        qCDebug(processScan) << "process refresh tier" << tierNames[tier] << ":" << tierStats.refreshes.load() << "processes,"
+                             << tierStats.files.load() << "files," << tierStats.bytes.load() << "bytes";
+    }
 }
 
 void ProcessSet::scanProcess()
@@ -82,64 +191,54 @@ void ProcessSet::scanProcess()
         procstage->uptime = iter->procuptime();
         m_recentProcStage[iter->pid()] = procstage;
     }
-    m_curPid.clear();
     m_set.clear();
     m_pidPtoCMapping.clear();
     m_pidCtoPMapping.clear();
     WMWindowList *wmwindowList = ProcessDB::instance()->windowList();
 
-    Iterator iter;
-    QList<pid_t> appLst;
-    while (iter.hasNext()) {
-        Process proc = iter.next();
-
-        if(!m_curPid.contains(proc.pid()))
-            m_curPid.append(proc.pid());
-
-    }
-
-    if(m_prePid != m_curPid) {
-        for (const pid_t &pid : m_prePid) {
-            if(!m_curPid.contains(pid)){
-                m_prePid.removeAt(pid);  //remove disappear process pid
-                if(m_simpleSet.contains(pid))
-                    m_simpleSet.remove(pid);
-                if(m_pidMyApps.contains(pid))
-                    m_pidMyApps.removeAt(pid);
-            }
-        }
-
-        for (const pid_t &pid : m_curPid) {
-            if(!m_prePid.contains(pid)){ //add  new process pid
-                Process *proc = new Process(pid);
-                proc->readProcessSimpleInfo();
-                if(!m_simpleSet.contains(pid))
-                     m_simpleSet.insert(proc->pid(), *proc);
-
-                if (proc->appType() == kFilterApps && !wmwindowList->isTrayApp(proc->pid())) {
-                     m_pidMyApps << proc->pid();
-                }
-            }
-        }
-        m_prePid = m_curPid;
+    m_table.beginScan();
+    m_lifecycle = {};
+    QVector<Process> bornProcs;
+    QVector<Process> forkedProcs;
+    if (!scanProcEvents(bornProcs, forkedProcs))
+        scanProcDir(bornProcs);
+    // reclaim disappeared processes in the same tick
+    m_lifecycle.deaths += m_table.sweep();
+
+    // parse /proc files of new processes in parallel, then resolve names & app types serially
+    scanParallel(bornProcs, &Process::readSimpleFiles);
+    forkedProcs << bornProcs;
+    for (Process &proc : forkedProcs) {
+        proc.updateSimpleInfo();
+        m_table.find(proc.pid())->myApp = proc.appType() == kFilterApps && !wmwindowList->isTrayApp(proc.pid());
     }
 
     // const QVariant &vindex = m_settings->getOption(kSettingKeyProcessTabIndex, kFilterApps);
     // int index = vindex.toInt();
 
-    for (const pid_t &pid : m_prePid) {
-        Process proc = m_simpleSet[pid];
+    QVector<Process> procs;
+    procs.reserve(m_table.size());
+    for (const ProcessTable::Entry &entry : m_table) {
+        procs << entry.proc;
+    }
+    scanParallel(procs, &Process::readVariableFiles);
+
+    // merge the results, tree aggregation below relies on the merged set
+    QList<pid_t> myApps;
+    for (Process &proc : procs) {
         // if( ((kFilterApps == index) && (proc.appType()<= kFilterApps)) ||
         //     ((kFilterCurrentUser == index) && (proc.appType() <= kFilterCurrentUser)) ||
         //         (kNoFilter == index))
-                {
-             proc.readProcessVariableInfo();  //
-               if (!proc.isValid())
-                     continue;
-
-               m_set.insert(proc.pid(), proc);
-               m_pidPtoCMapping.insert(proc.ppid(), proc.pid());
-               m_pidCtoPMapping.insert(proc.pid(), proc.ppid());
+        {
+            if (!proc.isValid())
+                continue;
+            proc.updateVariableInfo();
+
+            m_set.insert(proc.pid(), proc);
+            m_pidPtoCMapping.insert(proc.ppid(), proc.pid());
+            m_pidCtoPMapping.insert(proc.pid(), proc.ppid());
+            if (m_table.find(proc.pid())->myApp)
+                myApps << proc.pid();
         }
     }
 
@@ -155,7 +254,7 @@ void ProcessSet::scanProcess()
         return b;
     };
 
-    for (const pid_t &pid : m_pidMyApps) {
+    for (const pid_t &pid : myApps) {
         qreal recvBps = 0;
         qreal sendBps = 0;
         mergeSubProcNetIO(pid, recvBps, sendBps);
@@ -185,6 +284,125 @@ void ProcessSet::scanProcess()
     }
 
     m_recentProcStage.clear();
+    m_snapshot.build(m_set);
+}
+
+void ProcessSet::scanProcDir(QVector<Process> &bornProcs)
+{
+    // touch every pid found under /proc, new pids are born in this generation
+    Iterator iter;
+    while (iter.hasNext()) {
+        bool born = false;
+        ProcessTable::Entry *entry = m_table.touch(iter.nextPid(), born);
+        if (born) {
+            entry->proc = Process(entry->pid);
+            bornProcs << entry->proc;
+        }
+    }
+    m_lifecycle.births += bornProcs.size();
+}
+
+bool ProcessSet::scanProcEvents(QVector<Process> &bornProcs, QVector<Process> &forkedProcs)
+{
+    if (!m_procConnector)
+        return false;
+
+    m_procEvents.clear();
+    bool ok = m_procConnector->readEvents(m_procEvents);
+    // walk /proc on first scan, after lost events and periodically to reconcile with events
+    if (!ok || m_table.size() == 0 || ++m_eventScanTicks >= PROC_EVENT_RECONCILE_TICKS) {
+        m_eventScanTicks = 0;
+        return false;
+    }
+
+    m_table.touchAll();
+
+    QSet<pid_t> bornPids;
+    QSet<pid_t> execPids;
+    QVector<ProcEvent> forks;
+    for (const ProcEvent &event : m_procEvents) {
+        // same as Iterator, skip pid below 10
+        if (event.pid < 10)
+            continue;
+
+        bool born = false;
+        ProcessTable::Entry *entry = nullptr;
+        switch (event.type) {
+        case ProcEvent::kFork:
+            m_table.touch(event.pid, born)->proc = Process(event.pid);
+            if (born) {
+                bornPids << event.pid;
+                ++m_lifecycle.births;
+            }
+            forks << event;
+            break;
+        case ProcEvent::kExec:
+            entry = m_table.touch(event.pid, born);
+            if (born) {
+                entry->proc = Process(event.pid);
+                ++m_lifecycle.births;
+            }
+            execPids << event.pid;
+            break;
+        case ProcEvent::kExit:
+            if (m_table.contains(event.pid)) {
+                m_table.remove(event.pid);
+                ++m_lifecycle.deaths;
+                if (bornPids.remove(event.pid))
+                    ++m_lifecycle.shortLived;
+            }
+            break;
+        }
+    }
+
+    // image changed, read identity again
+    for (pid_t pid : execPids) {
+        const ProcessTable::Entry *entry = m_table.find(pid);
+        if (entry)
+            bornProcs << entry->proc;
+    }
+    // forked child shares parent's image until exec, inherit instead of reading /proc
+    for (const ProcEvent &event : forks) {
+        ProcessTable::Entry *entry = m_table.find(event.pid);
+        if (!entry || execPids.contains(event.pid))
+            continue;
+
+        const ProcessTable::Entry *parent = m_table.find(event.ppid);
+        if (parent && parent->proc.isValid()) {
+            entry->proc.inheritSimpleFiles(parent->proc);
+            forkedProcs << entry->proc;
+        } else {
+            bornProcs << entry->proc;
+        }
+    }
+
+    return true;
+}
+
+void ProcessSet::setEventMonitor(bool enable)
+{
+    if (!enable) {
+        m_procConnector.reset();
+        return;
+    }
+
+    if (!m_procConnector) {
+        m_procConnector.reset(new ProcConnector());
+        // no CAP_NET_ADMIN, keep walking /proc
+        if (!m_procConnector->isValid())
+            m_procConnector.reset();
+    }
+    m_eventScanTicks = 0;
+}
+
+bool ProcessSet::isEventMonitorActive() const
+{
+    return m_procConnector != nullptr;
+}
+
+ProcLifecycleStats ProcessSet::lifecycleStats() const
+{
+    return m_lifecycle;
 }
 
 ProcessSet::Iterator::Iterator()
@@ -205,6 +423,17 @@ bool ProcessSet::Iterator::hasNext()
     return m_dirent && isdigit(m_dirent->d_name[0]);
 }
 
+pid_t ProcessSet::Iterator::nextPid()
+{
+    if (m_dirent && isdigit(m_dirent->d_name[0])) {
+        auto pid = pid_t(atoi(m_dirent->d_name));
+        advance();
+        return pid;
+    }
+
+    return 0;
+}
+
 Process ProcessSet::Iterator::next()
 {
     if (m_dirent && isdigit(m_dirent->d_name[0])) {
@@ -238,6 +467,16 @@ std::weak_ptr<RecentProcStage> ProcessSet::getRecentProcStage(pid_t pid) const
     return m_recentProcStage[pid];
 }
 
+const ProcessSnapshot &ProcessSet::snapshot() const
+{
+    return m_snapshot;
+}
+
+void ProcessSet::buildConnections(const SockStatMap &socks, ConnectionSnapshot &snapshot) const
+{
+    snapshot.build(m_set, socks);
+}
+
 const Process ProcessSet::getProcessById(pid_t pid) const
 {
     return m_set[pid];
@@ -245,19 +484,8 @@ const Process ProcessSet::getProcessById(pid_t pid) const
 
 QList<pid_t> ProcessSet::getPIDList() const
 {
-    // 当系统读取到的m_set为空时,通过keys()函数返回会造成段错误 原因是keys函数效率低下,会造成大量的内存拷贝
-    // 替换方案是
-    QList<pid_t> pidList {};
-    pidList.clear();
-    int size = m_set.size();
-    QMap<pid_t, Process>::key_iterator iterBegin = m_set.keyBegin();
-    for (;iterBegin != m_set.keyEnd(); ++iterBegin) {
-        pid_t tmpKey = *iterBegin;
-        pidList.append(tmpKey);
-        if (size != m_set.size())
-            break;
-    }
-    return pidList;
+    // only accessed from monitor thread, gui reads ProcessDB::snapshot() instead
+    return m_set.keys();
 }
 
 void ProcessSet::removeProcess(pid_t pid)
@@ -7,14 +7,23 @@
 #define PROCESS_SET_H
 
 #include "process.h"
+#include "process_table.h"
+#include "process_snapshot.h"
+#include "connection_snapshot.h"
+#include "proc_connector.h"
 #include "common/common.h"
 
 #include <QMap>
+#include <QVector>
+
+#include <memory>
 
 #include <dirent.h>
 
 using namespace common::alloc;
 
+class QThreadPool;
+
 // class Settings;
 namespace core {
 namespace process {
@@ -24,6 +33,15 @@ enum FilterType { kFilterApps,
                   kNoFilter
                 };
 
+/**
+ * @brief Process births & deaths seen by last refresh
+ */
+struct ProcLifecycleStats {
+    int births = 0;
+    int deaths = 0;
+    int shortLived = 0; // born & exited between two refreshes, only counted in event mode
+};
+
 struct RecentProcStage {
     qulonglong ptime = 0;
     qulonglong read_bytes = 0; // disk read bytes
@@ -37,7 +55,7 @@ class ProcessSet
 public:
     explicit ProcessSet();
     ProcessSet(const ProcessSet &other);
-    ~ProcessSet() = default;
+    ~ProcessSet();
 
     const Process getProcessById(pid_t pid) const;
     QList<pid_t> getPIDList() const;
@@ -45,11 +63,41 @@ public:
     void updateProcessState(pid_t pid, char state);
     void updateProcessPriority(pid_t pid, int priority);
     std::weak_ptr<RecentProcStage> getRecentProcStage(pid_t pid) const;
+    /**
+     * @brief snapshot Columnar copy of the process set built by last refresh
+     *
+     * Rebuilt in place on monitor thread, other threads use ProcessDB::snapshot().
+     */
+    const ProcessSnapshot &snapshot() const;
+    /**
+     * @brief buildConnections Join sockets of last refresh with their owners
+     * @param socks Socket table keyed by flow
+     * @param snapshot Rebuilt in place
+     */
+    void buildConnections(const SockStatMap &socks, ConnectionSnapshot &snapshot) const;
+
+    /**
+     * @brief setScanWorkers Set number of worker threads parsing /proc in parallel
+     * @param workers 0: choose by cpu count; 1: scan on the calling thread only
+     */
+    void setScanWorkers(int workers);
+    int scanWorkers() const;
+
+    /**
+     * @brief setEventMonitor Learn process births & deaths from proc connector events instead of
+     * walking /proc every refresh, falls back to walking /proc if the connector is unavailable
+     */
+    void setEventMonitor(bool enable);
+    bool isEventMonitorActive() const;
+    ProcLifecycleStats lifecycleStats() const;
 
     void refresh();
 
 private:
     void scanProcess();
+    void scanProcDir(QVector<Process> &bornProcs);
+    bool scanProcEvents(QVector<Process> &bornProcs, QVector<Process> &forkedProcs);
+    void scanParallel(QVector<Process> &procs, void (Process::*read)());
     void mergeSubProcNetIO(pid_t ppid, qreal &recvBps, qreal &sendBps);
     void mergeSubProcCpu(pid_t ppid, qreal &cpu);
 
@@ -60,6 +108,7 @@ private:
 
         bool hasNext();
         Process next();
+        pid_t nextPid();
 
     private:
         void advance();
@@ -70,15 +119,21 @@ private:
 
 private:
     // Settings *m_settings = nullptr;
-    QMap<pid_t, Process> m_simpleSet;
+    ProcessTable m_table; // all processes seen by last scan
     QMap<pid_t, Process> m_set;
+    ProcessSnapshot m_snapshot {};
     QMap<pid_t, std::shared_ptr<RecentProcStage>> m_recentProcStage {};
 
     QMap<pid_t, pid_t> m_pidCtoPMapping {}; // child to parent pid mapping
     QMultiMap<pid_t, pid_t> m_pidPtoCMapping {}; // parent to child pid mapping
-    QList<pid_t> m_prePid;
-    QList<pid_t> m_curPid;
-    QList<pid_t> m_pidMyApps;
+
+    int m_scanWorkers {1};
+    std::unique_ptr<QThreadPool> m_scanPool {}; // null if scan on the calling thread only
+
+    std::unique_ptr<ProcConnector> m_procConnector {}; // null if event monitor disabled
+    QVector<ProcEvent> m_procEvents {};
+    int m_eventScanTicks {0}; // refreshes since last full /proc walk
+    ProcLifecycleStats m_lifecycle {};
 
     friend class Iterator;
 };
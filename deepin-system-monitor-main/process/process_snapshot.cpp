@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "process_snapshot.h"
+
+namespace core {
+namespace process {
+
+ProcessSnapshot::ProcessSnapshot()
+{
+}
+
+void ProcessSnapshot::build(const QMap<pid_t, Process> &set)
+{
+    clear();
+
+    int n = set.size();
+    m_pid.reserve(n);
+    m_ppid.reserve(n);
+    m_uid.reserve(n);
+    m_cpu.reserve(n);
+    m_memory.reserve(n);
+    m_shareMemory.reserve(n);
+    m_vtrMemory.reserve(n);
+    m_readBps.reserve(n);
+    m_writeBps.reserve(n);
+    m_recvBps.reserve(n);
+    m_sentBps.reserve(n);
+    m_priority.reserve(n);
+    m_state.reserve(n);
+    m_appType.reserve(n);
+    m_icon.reserve(n);
+    m_cmdline.reserve(n);
+    m_environ.reserve(n);
+    m_startTime.reserve(n);
+    m_nameId.reserve(n);
+    m_displayNameId.reserve(n);
+    m_userNameId.reserve(n);
+    m_rowOfPid.reserve(n);
+
+    for (const Process &proc : set) {
+        m_rowOfPid.insert(proc.pid(), m_pid.size());
+
+        m_pid << proc.pid();
+        m_ppid << proc.ppid();
+        m_uid << proc.uid();
+        m_cpu << proc.cpu();
+        m_memory << proc.memory();
+        m_shareMemory << proc.sharememory();
+        m_vtrMemory << proc.vtrmemory();
+        m_readBps << proc.readBps();
+        m_writeBps << proc.writeBps();
+        m_recvBps << proc.recvBps();
+        m_sentBps << proc.sentBps();
+        m_priority << proc.priority();
+        m_state << proc.state();
+        m_appType << proc.appType();
+        m_icon << proc.icon();
+        m_cmdline << proc.cmdlineString();
+        m_environ << proc.environ();
+        m_startTime << proc.startTime();
+
+        m_nameId << intern(proc.name());
+        m_displayNameId << intern(proc.displayName());
+        m_userNameId << intern(proc.userName());
+    }
+    m_stringIds.clear();
+}
+
+ProcessSnapshot ProcessSnapshot::select(const QVector<int> &rows) const
+{
+    ProcessSnapshot snapshot;
+    snapshot.m_strings = m_strings;
+    snapshot.m_rowOfPid.reserve(rows.size());
+
+    for (int row : rows) {
+        snapshot.m_rowOfPid.insert(m_pid[row], snapshot.m_pid.size());
+
+        snapshot.m_pid << m_pid[row];
+        snapshot.m_ppid << m_ppid[row];
+        snapshot.m_uid << m_uid[row];
+        snapshot.m_cpu << m_cpu[row];
+        snapshot.m_memory << m_memory[row];
+        snapshot.m_shareMemory << m_shareMemory[row];
+        snapshot.m_vtrMemory << m_vtrMemory[row];
+        snapshot.m_readBps << m_readBps[row];
+        snapshot.m_writeBps << m_writeBps[row];
+        snapshot.m_recvBps << m_recvBps[row];
+        snapshot.m_sentBps << m_sentBps[row];
+        snapshot.m_priority << m_priority[row];
+        snapshot.m_state << m_state[row];
+        snapshot.m_appType << m_appType[row];
+        snapshot.m_icon << m_icon[row];
+        snapshot.m_cmdline << m_cmdline[row];
+        snapshot.m_environ << m_environ[row];
+        snapshot.m_startTime << m_startTime[row];
+        snapshot.m_nameId << m_nameId[row];
+        snapshot.m_displayNameId << m_displayNameId[row];
+        snapshot.m_userNameId << m_userNameId[row];
+    }
+
+    return snapshot;
+}
+
+void ProcessSnapshot::clear()
+{
+    m_pid.clear();
+    m_ppid.clear();
+    m_uid.clear();
+    m_cpu.clear();
+    m_memory.clear();
+    m_shareMemory.clear();
+    m_vtrMemory.clear();
+    m_readBps.clear();
+    m_writeBps.clear();
+    m_recvBps.clear();
+    m_sentBps.clear();
+    m_priority.clear();
+    m_state.clear();
+    m_appType.clear();
+    m_icon.clear();
+    m_cmdline.clear();
+    m_environ.clear();
+    m_startTime.clear();
+    m_nameId.clear();
+    m_displayNameId.clear();
+    m_userNameId.clear();
+    m_strings.clear();
+    m_stringIds.clear();
+    m_rowOfPid.clear();
+}
+
+void ProcessSnapshot::setState(int row, char state)
+{
+    if (row >= 0 && row < size())
+        m_state[row] = state;
+}
+
+void ProcessSnapshot::setPriority(int row, int priority)
+{
+    if (row >= 0 && row < size())
+        m_priority[row] = priority;
+}
+
+int ProcessSnapshot::intern(const QString &str)
+{
+    auto it = m_stringIds.constFind(str);
+    if (it != m_stringIds.constEnd())
+        return it.value();
+
+    int id = m_strings.size();
+    m_strings << str;
+    m_stringIds.insert(str, id);
+    return id;
+}
+
+} // namespace process
+} // namespace core
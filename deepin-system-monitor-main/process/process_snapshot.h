@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROCESS_SNAPSHOT_H
+#define PROCESS_SNAPSHOT_H
+
+#include "process.h"
+
+#include <QHash>
+#include <QIcon>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+#include <numeric>
+
+#include <sys/types.h>
+
+namespace core {
+namespace process {
+
+/**
+ * @brief Columnar (struct of arrays) copy of the process set, built once per refresh
+ *
+ * Each field the table model sorts or sums on lives in its own contiguous array indexed
+ * by snapshot row, strings (name, display name, user name) are interned in one table and
+ * referenced by id. Columns are implicitly shared, copying a snapshot is cheap.
+ *
+ * A snapshot holds values only, no Process handle, so once published by ProcessDB it never
+ * changes and can be read from any thread.
+ */
+class ProcessSnapshot
+{
+public:
+    explicit ProcessSnapshot();
+
+    /**
+     * @brief build Rebuild all columns from process set
+     * @param set Processes keyed by pid
+     */
+    void build(const QMap<pid_t, Process> &set);
+    /**
+     * @brief select Build a snapshot with the given rows only, sharing the string table
+     * @param rows Row indexes of this snapshot
+     */
+    ProcessSnapshot select(const QVector<int> &rows) const;
+    void clear();
+
+    inline int size() const
+    {
+        return m_pid.size();
+    }
+    /**
+     * @brief indexOf Row of the process with pid, -1 if not found
+     */
+    inline int indexOf(pid_t pid) const
+    {
+        return m_rowOfPid.value(pid, -1);
+    }
+
+    inline const QVector<pid_t> &pid() const
+    {
+        return m_pid;
+    }
+    inline const QVector<pid_t> &ppid() const
+    {
+        return m_ppid;
+    }
+    inline const QVector<uid_t> &uid() const
+    {
+        return m_uid;
+    }
+    inline const QVector<qreal> &cpu() const
+    {
+        return m_cpu;
+    }
+    inline const QVector<qulonglong> &memory() const
+    {
+        return m_memory;
+    }
+    inline const QVector<qulonglong> &shareMemory() const
+    {
+        return m_shareMemory;
+    }
+    inline const QVector<qulonglong> &vtrMemory() const
+    {
+        return m_vtrMemory;
+    }
+    inline const QVector<qreal> &readBps() const
+    {
+        return m_readBps;
+    }
+    inline const QVector<qreal> &writeBps() const
+    {
+        return m_writeBps;
+    }
+    inline const QVector<qreal> &recvBps() const
+    {
+        return m_recvBps;
+    }
+    inline const QVector<qreal> &sentBps() const
+    {
+        return m_sentBps;
+    }
+    inline const QVector<int> &priority() const
+    {
+        return m_priority;
+    }
+    inline const QVector<char> &state() const
+    {
+        return m_state;
+    }
+    inline const QVector<int> &appType() const
+    {
+        return m_appType;
+    }
+
+    inline const QString &name(int row) const
+    {
+        return m_strings[m_nameId[row]];
+    }
+    inline const QString &displayName(int row) const
+    {
+        return m_strings[m_displayNameId[row]];
+    }
+    inline const QString &userName(int row) const
+    {
+        return m_strings[m_userNameId[row]];
+    }
+    inline const QIcon &icon(int row) const
+    {
+        return m_icon[row];
+    }
+    inline const QString &cmdline(int row) const
+    {
+        return m_cmdline[row];
+    }
+    inline const QHash<QString, QString> &environ(int row) const
+    {
+        return m_environ[row];
+    }
+    inline time_t startTime(int row) const
+    {
+        return m_startTime[row];
+    }
+
+    void setState(int row, char state);
+    void setPriority(int row, int priority);
+
+    /**
+     * @brief sum Sum of a whole column
+     */
+    template<typename T>
+    static inline T sum(const QVector<T> &column)
+    {
+        return std::accumulate(column.cbegin(), column.cend(), T(0));
+    }
+
+private:
+    int intern(const QString &str);
+
+private:
+    QVector<pid_t> m_pid;
+    QVector<pid_t> m_ppid;
+    QVector<uid_t> m_uid;
+    QVector<qreal> m_cpu; // cpu usage in percent
+    QVector<qulonglong> m_memory; // rss in kB
+    QVector<qulonglong> m_shareMemory; // shm in kB
+    QVector<qulonglong> m_vtrMemory; // vmsize in kB
+    QVector<qreal> m_readBps; // disk read bytes per second
+    QVector<qreal> m_writeBps; // disk write bytes per second
+    QVector<qreal> m_recvBps; // network recv bytes per second
+    QVector<qreal> m_sentBps; // network sent bytes per second
+    QVector<int> m_priority;
+    QVector<char> m_state;
+    QVector<int> m_appType;
+
+    QVector<QIcon> m_icon;
+    QVector<QString> m_cmdline; // cmdline joined with space
+    QVector<QHash<QString, QString>> m_environ;
+    QVector<time_t> m_startTime;
+
+    QVector<int> m_nameId; // index of m_strings
+    QVector<int> m_displayNameId; // index of m_strings
+    QVector<int> m_userNameId; // index of m_strings
+
+    QVector<QString> m_strings; // interned strings
+    QHash<QString, int> m_stringIds; // string to index of m_strings, only used while building
+    QHash<pid_t, int> m_rowOfPid;
+};
+
+// published snapshot, shared by all readers until the last one drops it
+using ProcessSnapshotPtr = std::shared_ptr<const ProcessSnapshot>;
+
+} // namespace process
+} // namespace core
+
+#endif // PROCESS_SNAPSHOT_H
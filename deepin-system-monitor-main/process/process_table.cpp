@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "process_table.h"
+
+namespace core {
+namespace process {
+
+// initial slot count 1 << 10, enough for a common desktop
+const int kInitSlotBits = 10;
+
+ProcessTable::ProcessTable()
+    : m_entries {}
+    , m_slots {}
+    , m_mask {0}
+    , m_shift {0}
+    , m_generation {0}
+{
+    rehash(kInitSlotBits);
+}
+
+void ProcessTable::beginScan()
+{
+    ++m_generation;
+}
+
+void ProcessTable::touchAll()
+{
+    for (Entry &entry : m_entries) {
+        entry.generation = m_generation;
+    }
+}
+
+ProcessTable::Entry *ProcessTable::touch(pid_t pid, bool &born)
+{
+    // keep load factor below 1/2
+    if ((m_entries.size() + 1) * 2 > m_slots.size())
+        rehash(32 - m_shift + 1);
+
+    quint32 slot = slotOf(pid);
+    int index = m_slots[int(slot)];
+    born = (index < 0);
+    if (born) {
+        Entry entry;
+        entry.pid = pid;
+        m_entries.append(entry);
+        index = m_entries.size() - 1;
+        m_slots[int(slot)] = index;
+    }
+
+    Entry &entry = m_entries[index];
+    entry.generation = m_generation;
+    return &entry;
+}
+
+int ProcessTable::sweep()
+{
+    int removed = 0;
+    int i = 0;
+    while (i < m_entries.size()) {
+        if (m_entries[i].generation != m_generation) {
+            // last entry is moved into i, check i again
+            removeAt(i);
+            ++removed;
+        } else {
+            ++i;
+        }
+    }
+    return removed;
+}
+
+ProcessTable::Entry *ProcessTable::find(pid_t pid)
+{
+    int index = m_slots[int(slotOf(pid))];
+    return index < 0 ? nullptr : &m_entries[index];
+}
+
+const ProcessTable::Entry *ProcessTable::find(pid_t pid) const
+{
+    int index = m_slots[int(slotOf(pid))];
+    return index < 0 ? nullptr : &m_entries[index];
+}
+
+bool ProcessTable::contains(pid_t pid) const
+{
+    return m_slots[int(slotOf(pid))] >= 0;
+}
+
+void ProcessTable::remove(pid_t pid)
+{
+    int index = m_slots[int(slotOf(pid))];
+    if (index >= 0)
+        removeAt(index);
+}
+
+void ProcessTable::clear()
+{
+    m_entries.clear();
+    m_slots.fill(-1);
+}
+
+quint32 ProcessTable::slotOf(pid_t pid) const
+{
+    quint32 slot = home(pid);
+    for (;;) {
+        int index = m_slots[int(slot)];
+        if (index < 0 || m_entries[index].pid == pid)
+            return slot;
+        slot = (slot + 1) & m_mask;
+    }
+}
+
+void ProcessTable::removeAt(int index)
+{
+    // backward shift deletion, no tombstones left behind
+    quint32 hole = slotOf(m_entries[index].pid);
+    quint32 slot = hole;
+    for (;;) {
+        slot = (slot + 1) & m_mask;
+        int next = m_slots[int(slot)];
+        if (next < 0)
+            break;
+
+        // move entry into the hole if the hole lies between its home slot and its current slot
+        quint32 h = home(m_entries[next].pid);
+        if (((slot - h) & m_mask) >= ((slot - hole) & m_mask)) {
+            m_slots[int(hole)] = next;
+            hole = slot;
+        }
+    }
+    m_slots[int(hole)] = -1;
+
+    // fill the gap in dense storage with the last entry
+    int last = m_entries.size() - 1;
+    if (index != last) {
+        m_slots[int(slotOf(m_entries[last].pid))] = index;
+        m_entries[index] = m_entries[last];
+    }
+    m_entries.removeLast();
+}
+
+void ProcessTable::rehash(int bits)
+{
+    m_shift = 32 - bits;
+    m_mask = (1u << bits) - 1;
+    m_slots.fill(-1, 1 << bits);
+
+    for (int i = 0; i < m_entries.size(); ++i) {
+        m_slots[int(slotOf(m_entries[i].pid))] = i;
+    }
+}
+
+} // namespace process
+} // namespace core
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include "process.h"
+
+#include <QVector>
+
+#include <sys/types.h>
+
+namespace core {
+namespace process {
+
+/**
+ * @brief Pid keyed process table with scan generation stamps
+ *
+ * Entries are kept densely in a vector, an open addressing (linear probing) slot array
+ * maps pid to entry index. Every scan bumps the generation, each pid seen during the scan
+ * is touched with the current generation, so births are reported by touch and deaths are
+ * the entries left with an old generation, which sweep reclaims in the same tick.
+ */
+class ProcessTable
+{
+public:
+    struct Entry {
+        pid_t pid {0};
+        quint32 generation {0};
+        bool myApp {false}; // kFilterApps process which is not a tray app
+        Process proc;
+    };
+
+    using iterator = QVector<Entry>::iterator;
+    using const_iterator = QVector<Entry>::const_iterator;
+
+    explicit ProcessTable();
+
+    /**
+     * @brief beginScan Start a new scan generation
+     */
+    void beginScan();
+    /**
+     * @brief touchAll Mark every entry as alive in current generation
+     */
+    void touchAll();
+    /**
+     * @brief touch Mark pid as alive in current generation, insert it if not exists
+     * @param pid Process id
+     * @param born Set to true if pid was not in the table before
+     * @return Entry of this pid, valid until next touch/remove/sweep
+     */
+    Entry *touch(pid_t pid, bool &born);
+    /**
+     * @brief sweep Remove entries not touched during current generation
+     * @return Number of entries removed
+     */
+    int sweep();
+
+    Entry *find(pid_t pid);
+    const Entry *find(pid_t pid) const;
+    bool contains(pid_t pid) const;
+    void remove(pid_t pid);
+    void clear();
+
+    inline int size() const
+    {
+        return m_entries.size();
+    }
+    inline quint32 generation() const
+    {
+        return m_generation;
+    }
+
+    inline iterator begin()
+    {
+        return m_entries.begin();
+    }
+    inline iterator end()
+    {
+        return m_entries.end();
+    }
+    inline const_iterator begin() const
+    {
+        return m_entries.cbegin();
+    }
+    inline const_iterator end() const
+    {
+        return m_entries.cend();
+    }
+
+private:
+    inline quint32 home(pid_t pid) const
+    {
+        // fibonacci hashing, take the high bits of the product
+        return (quint32(pid) * 2654435769u) >> m_shift;
+    }
+    quint32 slotOf(pid_t pid) const;
+    void removeAt(int index);
+    void rehash(int bits);
+
+private:
+    QVector<Entry> m_entries;
+    QVector<int> m_slots; // entry index, -1 if empty
+    quint32 m_mask;
+    int m_shift;
+    quint32 m_generation;
+};
+
+} // namespace process
+} // namespace core
+
+#endif // PROCESS_TABLE_H
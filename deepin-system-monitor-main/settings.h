@@ -16,6 +16,21 @@ const QString kSettingKeyProcessTabIndex = {"process_tab_index_new"};
 const QString kSettingKeyProcessAttributeDialogWidth = {"process_attribute_dialog_width"};
 const QString kSettingKeyProcessAttributeDialogHeight = {"process_attribute_dialog_height"};
 const QString kSettingKeyTimePeriod = {"time_period"};
+// worker threads of process scan, 0: by cpu count, 1: single threaded
+const QString kSettingKeyProcessScanWorkers = {"process_scan_workers"};
+// learn process births & deaths from proc connector events instead of walking /proc each refresh
+const QString kSettingKeyProcessEventMonitor = {"process_event_monitor"};
+// network capture ring buffer size in KiB, 0: libpcap default
+const QString kSettingKeyCaptureBufferSize = {"capture_buffer_size"};
+// capture network packets on all up interfaces instead of default route interface only
+const QString kSettingKeyCaptureAllInterfaces = {"capture_all_interfaces"};
+// account tcp traffic from kernel tcp_info counters, packet capture is then needed for udp only;
+// like capture, connections with both ends on loopback are not accounted
+const QString kSettingKeyTcpInfoAccounting = {"tcp_info_accounting"};
+// leave virtual interfaces (veth, docker, bridge...) out of network totals, they double-count on container hosts
+const QString kSettingKeyExcludeVirtualNetif = {"exclude_virtual_netif"};
+// multi core view shows one heatmap instead of a graph per cpu above this many cpus, 0: never
+const QString kSettingKeyCPUHeatmapThreshold = {"cpu_heatmap_threshold"};
 
 class QSettings;
 class Settings
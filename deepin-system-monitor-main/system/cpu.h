@@ -35,6 +35,13 @@ struct cpu_usage_t {
     unsigned long long idle {0};
 };
 
+// place of a logical cpu in package/core topology, from sysfs topology read by lscpu; -1 if unknown
+struct cpu_topology_t {
+    int cpu; // logical cpu id
+    int socket; // physical package id
+    int core; // core id in package, smt siblings share it
+};
+
 using CPUStat = std::shared_ptr<struct cpu_stat_t>;
 using CPUUsage = std::shared_ptr<struct cpu_usage_t>;
 
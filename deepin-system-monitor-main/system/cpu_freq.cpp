@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cpu_freq.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace core {
+namespace system {
+
+namespace {
+
+// read a decimal value from the start of file, file offset is left untouched
+bool preadValue(int fd, qulonglong &value)
+{
+    char buf[32];
+    ssize_t len = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (len <= 0)
+        return false;
+    buf[len] = '\0';
+
+    char *end = nullptr;
+    value = strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+} // namespace
+
+CPUFreq::CPUFreq(const QByteArray &root)
+    : m_root(root)
+{
+}
+
+CPUFreq::~CPUFreq()
+{
+    close();
+}
+
+int CPUFreq::open(const QVector<int> &cpus)
+{
+    close();
+    m_cpus.reserve(cpus.size());
+
+    for (int cpu : cpus) {
+        if (cpu < 0)
+            continue;
+        QByteArray dir = m_root + "/cpu" + QByteArray::number(cpu) + "/cpufreq/";
+
+        int fd = ::open((dir + "scaling_cur_freq").constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue; // no cpufreq driver, or cpu offline
+
+        qulonglong maxFreq = 0;
+        int maxfd = ::open((dir + "cpuinfo_max_freq").constData(), O_RDONLY | O_CLOEXEC);
+        if (maxfd >= 0) {
+            preadValue(maxfd, maxFreq);
+            ::close(maxfd);
+        }
+        while (m_indexOfCpu.size() <= cpu)
+            m_indexOfCpu << -1;
+        m_indexOfCpu[cpu] = m_cpus.size();
+        m_cpus << cpu_freq_t {cpu, fd, maxFreq, 0};
+    }
+
+    return m_cpus.size();
+}
+
+void CPUFreq::close()
+{
+    for (const cpu_freq_t &freq : m_cpus)
+        ::close(freq.fd);
+    m_cpus.clear();
+    m_indexOfCpu.clear();
+}
+
+bool CPUFreq::update()
+{
+    bool ok = false;
+    for (cpu_freq_t &freq : m_cpus) {
+        if (!preadValue(freq.fd, freq.curFreq)) {
+            freq.curFreq = 0;
+            continue;
+        }
+        ok = true;
+    }
+    return ok;
+}
+
+qulonglong CPUFreq::curFreq(int cpu) const
+{
+    int i = (cpu >= 0 && cpu < m_indexOfCpu.size()) ? m_indexOfCpu[cpu] : -1;
+    return i >= 0 ? m_cpus[i].curFreq : 0;
+}
+
+qreal CPUFreq::scaling() const
+{
+    qulonglong fmax = 0, fcur = 0;
+    for (const cpu_freq_t &freq : m_cpus) {
+        if (freq.maxFreq == 0 || freq.curFreq == 0)
+            continue;
+        fmax += freq.maxFreq;
+        fcur += freq.curFreq;
+    }
+    return fmax ? qreal(fcur) / fmax * 100 : 0.;
+}
+
+} // namespace system
+} // namespace core
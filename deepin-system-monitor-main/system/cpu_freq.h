@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPU_FREQ_H
+#define CPU_FREQ_H
+
+#include <QByteArray>
+#include <QVector>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief Current frequency of each cpu, read from cpufreq sysfs through kept-open files
+ *
+ * scaling_cur_freq of every cpu is opened once and re-read with pread each refresh,
+ * so refreshing n cpus costs n small reads and no open/close. Files are reopened by
+ * calling open again, e.g. after cpu hotplug.
+ */
+class CPUFreq
+{
+public:
+    explicit CPUFreq(const QByteArray &root = "/sys/devices/system/cpu");
+    ~CPUFreq();
+
+    /**
+     * @brief open Open frequency files of cpus, files opened before are closed
+     * @param cpus Logical cpu indexes
+     * @return Number of cpus having cpufreq
+     */
+    int open(const QVector<int> &cpus);
+    void close();
+    /**
+     * @brief update Read current frequency of all opened cpus
+     * @return false if nothing could be read
+     */
+    bool update();
+
+    inline int count() const
+    {
+        return m_cpus.size();
+    }
+    /**
+     * @brief curFreq Current frequency of cpu (kHz), 0 if unknown
+     */
+    qulonglong curFreq(int cpu) const;
+    /**
+     * @brief scaling Current frequency in percent of max frequency over all cpus, as lscpu's "CPU scaling MHz"
+     */
+    qreal scaling() const;
+
+private:
+    CPUFreq(const CPUFreq &) = delete;
+    CPUFreq &operator=(const CPUFreq &) = delete;
+
+    struct cpu_freq_t {
+        int cpu;
+        int fd; // scaling_cur_freq
+        qulonglong maxFreq; // cpuinfo_max_freq (kHz), static
+        qulonglong curFreq; // kHz
+    };
+
+    QByteArray m_root;
+    QVector<cpu_freq_t> m_cpus;
+    QVector<int> m_indexOfCpu; // logical cpu to index of m_cpus, -1 if not opened
+};
+
+} // namespace system
+} // namespace core
+
+#endif // CPU_FREQ_H
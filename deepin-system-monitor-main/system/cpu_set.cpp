@@ -11,6 +11,10 @@
 #include "system_monitor_thread.h"
 #include "system_monitor.h"
 #include "sys_info.h"
+#include "cpu_freq.h"
+#include "proc_stat.h"
+#include "udev.h"
+#include "udev_monitor.h"
 extern "C" {
 #include "../3rdparty/lscpu.h"
 #include "../3rdparty/include/path.h"
@@ -24,6 +28,9 @@ extern "C" {
 #include <QTextStream>
 #include <QProcess>
 
+#include <algorithm>
+#include <tuple>
+
 #include <ctype.h>
 #include <errno.h>
 #include <sched.h>
@@ -40,6 +47,16 @@ static bool read_dmi_cache = false;
 namespace core {
 namespace system {
 
+// cpu id of logical name, e.g. 17 of cpu17; -1 if cpu is not online
+static int statCpuId(const proc_stat_t &stat, const QByteArray &cpu)
+{
+    if (!cpu.startsWith("cpu"))
+        return -1;
+    bool ok = false;
+    int id = cpu.mid(3).toInt(&ok);
+    return (ok && id >= 0 && stat.listed.value(id)) ? id : -1;
+}
+
 static void lscpu_free_context(struct lscpu_cxt *cxt)
 {
     size_t i;
@@ -265,10 +282,16 @@ static void lscpu_free_context(struct lscpu_cxt *cxt)
 
 CPUSet::CPUSet()
     : d(new CPUSetPrivate())
+    , m_publishedStat(std::make_shared<const proc_stat_t>())
 {
 }
 CPUSet::CPUSet(const CPUSet &other)
     : d(other.d)
+    , m_udev(other.m_udev)
+    , m_hotplug(other.m_hotplug)
+    , m_freq(other.m_freq)
+    , m_statReader(other.m_statReader)
+    , m_publishedStat(std::atomic_load(&other.m_publishedStat))
 {
 }
 CPUSet &CPUSet::operator=(const CPUSet &rhs)
@@ -277,6 +300,11 @@ CPUSet &CPUSet::operator=(const CPUSet &rhs)
         return *this;
 
     d = rhs.d;
+    m_udev = rhs.m_udev;
+    m_hotplug = rhs.m_hotplug;
+    m_freq = rhs.m_freq;
+    m_statReader = rhs.m_statReader;
+    std::atomic_store(&m_publishedStat, std::atomic_load(&rhs.m_publishedStat));
     return *this;
 }
 
@@ -402,6 +430,11 @@ QString CPUSet::coreId(int index) const
     return d->m_infos.value(index).coreID();
 }
 
+QVector<cpu_topology_t> CPUSet::topology() const
+{
+    return d->m_topology;
+}
+
 const CPUUsage CPUSet::usage() const
 {
     return d->m_usage;
@@ -414,23 +447,84 @@ const CPUStat CPUSet::stat() const
 
 QList<QByteArray> CPUSet::cpuLogicName() const
 {
-    return d->m_usageDB.keys();
+    return d->m_cpuNames;
 }
 
 const CPUStat CPUSet::statDB(const QByteArray &cpu) const
 {
-    return d->m_statDB[cpu];
+    // published copy, these are read from the gui thread
+    std::shared_ptr<const proc_stat_t> procstat = procStat();
+    int id = statCpuId(*procstat, cpu);
+    if (id < 0)
+        return {};
+
+    const proc_stat_cpu_t &src = procstat->cpus[id];
+    auto stat = std::make_shared<cpu_stat_t>();
+    stat->cpu = cpu;
+    stat->user = src.user;
+    stat->nice = src.nice;
+    stat->sys = src.sys;
+    stat->idle = src.idle;
+    stat->iowait = src.iowait;
+    stat->hardirq = src.hardirq;
+    stat->softirq = src.softirq;
+    stat->steal = src.steal;
+    stat->guest = src.guest;
+    stat->guest_nice = src.guest_nice;
+    return stat;
 }
 
 const CPUUsage CPUSet::usageDB(const QByteArray &cpu) const
 {
-    return d->m_usageDB[cpu];
+    // published copy, these are read from the gui thread
+    std::shared_ptr<const proc_stat_t> procstat = procStat();
+    int id = statCpuId(*procstat, cpu);
+    if (id < 0)
+        return {};
+
+    const proc_stat_cpu_t &src = procstat->cpus[id];
+    auto usage = std::make_shared<cpu_usage_t>();
+    usage->cpu = cpu;
+    usage->total = src.total();
+    usage->idle = src.idleTotal();
+    return usage;
+}
+
+std::shared_ptr<const proc_stat_t> CPUSet::procStat() const
+{
+    return std::atomic_load(&m_publishedStat);
+}
+
+qulonglong CPUSet::contextSwitches() const
+{
+    return procStat()->ctxt;
+}
+
+qulonglong CPUSet::interrupts() const
+{
+    return procStat()->intr;
+}
+
+uint CPUSet::procsRunning() const
+{
+    return procStat()->procsRunning;
+}
+
+uint CPUSet::procsBlocked() const
+{
+    return procStat()->procsBlocked;
 }
 
 void CPUSet::update()
 {
     read_stats();
-    read_overall_info();
+
+    // topology & identity are static, reload them only when cpus went on/off line; online cpu count
+    // of /proc/stat catches hotplug as well if udev events are not available (e.g. no udevd)
+    bool hotplug = m_hotplug && m_hotplug->takeEvents();
+    if (!d->m_topologyLoaded || hotplug || d->m_nstatcpus != d->m_loadedStatCpus)
+        read_overall_info();
+    read_freqs();
 
     d->cpusageTotal[kLastStat] = d->cpusageTotal[kCurrentStat];
     d->cpusageTotal[kCurrentStat] = d->m_usage->total;
@@ -438,125 +532,80 @@ void CPUSet::update()
 
 void CPUSet::read_stats()
 {
-    FILE *fp;
-    uFile fPtr;
-    QByteArray line(BUFSIZ, '\0');
-    int ncpu = 0;
-    int nr;
-
-    if (!(fp = fopen(PROC_PATH_STAT, "r"))) {
-        print_errno(errno, QString("open %1 failed").arg(PROC_PATH_STAT));
+    if (!m_statReader)
+        m_statReader = std::make_shared<ProcStatReader>(PROC_PATH_STAT);
+    // per cpu stats are scanned into arrays indexed by cpu id, reused across updates
+    if (!m_statReader->read(d->m_procStat))
         return;
-    } // ::if(fopen)
-    fPtr.reset(fp);
-
-    while (fgets(line.data(), BUFSIZ, fp)) {
-        if (!strncmp(line.data(), "cpu ", 4)) {
-            if (!d->m_stat) {
-                d->m_stat = std::make_shared<struct cpu_stat_t>();
-                *d->m_stat = {};
-            }
-
-            if (d->m_stat) {
-                // all cpu stat in jiffies
-                nr = sscanf(line.data() + 5, "%llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
-                            &d->m_stat->user,
-                            &d->m_stat->nice,
-                            &d->m_stat->sys,
-                            &d->m_stat->idle,
-                            &d->m_stat->iowait,
-                            &d->m_stat->hardirq,
-                            &d->m_stat->softirq,
-                            &d->m_stat->steal,
-                            &d->m_stat->guest,
-                            &d->m_stat->guest_nice);
-
-                if (nr == 10) {
-                    // usage calc
-                    QByteArray cpu {"cpu"};
-                    d->m_stat->cpu = cpu;
-
-                    if (!d->m_usage) {
-                        d->m_usage = std::make_shared<struct cpu_usage_t>();
-                        *d->m_usage = {};
-                    }
-
-                    if (d->m_usage) {
-                        d->m_usage->cpu = cpu;
-                        d->m_usage->total = d->m_stat->user + d->m_stat->nice + d->m_stat->sys + d->m_stat->idle + d->m_stat->iowait + d->m_stat->hardirq + d->m_stat->softirq + d->m_stat->steal;
-                        d->m_usage->idle = d->m_stat->idle + d->m_stat->iowait;
-                    } // ::if(usage)
-                } else
-                    print_errno(errno, QString("read %1 failed, cpu").arg(PROC_PATH_STAT));
-            } // ::if(m_stat)
-        } else if (!strncmp(line.data(), "cpu", 3)) {
-            // per cpu stat in jiffies
-            auto stat = std::make_shared<struct cpu_stat_t>();
-            if (stat) {
-                *stat = {};
-
-                nr = sscanf(line.data() + 3, "%d %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
-                            &ncpu,
-                            &stat->user,
-                            &stat->nice,
-                            &stat->sys,
-                            &stat->idle,
-                            &stat->iowait,
-                            &stat->hardirq,
-                            &stat->softirq,
-                            &stat->steal,
-                            &stat->guest,
-                            &stat->guest_nice);
-
-                if (nr == 11) {
-                    QByteArray cpu {"cpu"};
-                    cpu.append(QByteArray::number(ncpu));
-                    stat->cpu = cpu;
-
-                    // usage calc
-                    auto usage = std::make_shared<struct cpu_usage_t>();
-                    if (usage) {
-                        *usage = {};
-                        usage->cpu = cpu;
-                        usage->total = stat->user + stat->nice + stat->sys + stat->idle + stat->iowait + stat->hardirq + stat->softirq + stat->steal;
-                        usage->idle = stat->idle + stat->iowait;
-
-                        d->m_statDB[stat->cpu] = stat;
-                        d->m_usageDB[usage->cpu] = usage;
-                    } //::if(usage)
-
-                } else
-                    print_errno(errno, QString("read %1 failed, cpu%2").arg(PROC_PATH_STAT).arg(ncpu));
-            } // ::if(stat)
-        } else if (!strncmp(line.data(), "btime", 5)) {
-            // read boot time in seconds since epoch
-            struct timeval btime {
-            };
-            long nsec {};
-            int nm = sscanf(line.data() + 5, "%ld", &nsec);
-            if (nm == 1) {
-                btime.tv_sec = nsec;
-                btime.tv_usec = 0;
-
-                // set sysinfo btime
-                auto *monitor = ThreadManager::instance()->thread<SystemMonitorThread>(BaseThread::kSystemMonitorThread)->systemMonitorInstance();
-                monitor->sysInfo()->set_btime(btime);
-            } // ::if(nm == 1)
-        } // ::if(btime)
-    } // ::while(fgets)
-
-    if (ferror(fp))
-        print_errno(errno, QString("read %1 failed").arg(PROC_PATH_STAT));
+    const proc_stat_t &stat = d->m_procStat;
+    // readers on other threads get their own copy; the arrays are shared until the next read
+    // writes them in place, which detaches (one allocation per array & tick) instead of racing
+    std::atomic_store(&m_publishedStat, std::make_shared<const proc_stat_t>(stat));
+
+    // all cpu stat in jiffies, updated in place
+    if (!d->m_stat)
+        d->m_stat = std::make_shared<struct cpu_stat_t>();
+    if (d->m_stat->cpu.isEmpty())
+        d->m_stat->cpu = "cpu";
+    d->m_stat->user = stat.cpu.user;
+    d->m_stat->nice = stat.cpu.nice;
+    d->m_stat->sys = stat.cpu.sys;
+    d->m_stat->idle = stat.cpu.idle;
+    d->m_stat->iowait = stat.cpu.iowait;
+    d->m_stat->hardirq = stat.cpu.hardirq;
+    d->m_stat->softirq = stat.cpu.softirq;
+    d->m_stat->steal = stat.cpu.steal;
+    d->m_stat->guest = stat.cpu.guest;
+    d->m_stat->guest_nice = stat.cpu.guest_nice;
+
+    // usage calc
+    if (!d->m_usage)
+        d->m_usage = std::make_shared<struct cpu_usage_t>();
+    if (d->m_usage->cpu.isEmpty())
+        d->m_usage->cpu = "cpu";
+    d->m_usage->total = stat.cpu.total();
+    d->m_usage->idle = stat.cpu.idleTotal();
+
+    // logical names are only rebuilt when cpus went on/off line
+    if (d->m_namedCpus != stat.online) {
+        d->m_namedCpus = stat.online;
+        d->m_cpuNames.clear();
+        for (int id : stat.online)
+            d->m_cpuNames << QByteArray("cpu").append(QByteArray::number(id));
+    }
+    d->m_nstatcpus = stat.online.size();
+
+    // boot time in seconds since epoch
+    if (stat.btime > 0) {
+        struct timeval btime {
+        };
+        btime.tv_sec = stat.btime;
+        btime.tv_usec = 0;
+
+        // set sysinfo btime
+        auto *monitor = ThreadManager::instance()->thread<SystemMonitorThread>(BaseThread::kSystemMonitorThread)->systemMonitorInstance();
+        monitor->sysInfo()->set_btime(btime);
+    }
 }
 
 void CPUSet::read_overall_info()
 {
+    // listen to hotplug before reading, so cpus going on/off line meanwhile are not missed
+    if (!m_hotplug) {
+        m_udev = std::make_shared<UDev>();
+        m_hotplug = std::make_shared<UDevMonitor>(m_udev.get(), "cpu");
+    }
+
     //proc/cpuinfo
     QList<CPUInfo> infos;
-    QProcess process;
-    process.start("cat /proc/cpuinfo");
-    process.waitForFinished(3000);
-    QString cpuinfo = process.readAllStandardOutput();
+    QString cpuinfo;
+    QFile file(PROC_PATH_CPUINFO);
+    if (file.open(QIODevice::ReadOnly)) {
+        cpuinfo = file.readAll();
+        file.close();
+    } else {
+        print_errno(errno, QString("open %1 failed").arg(PROC_PATH_CPUINFO));
+    }
     QStringList processors = cpuinfo.split("\n\n", QString::SkipEmptyParts);
 
     for (int i = 0; i < processors.count(); ++i) {
@@ -609,6 +658,39 @@ void CPUSet::read_overall_info()
 //    }
     read_lscpu();
     d->m_infos = infos;
+    d->m_topologyLoaded = true;
+    d->m_loadedStatCpus = d->m_nstatcpus;
+
+    if (!m_freq)
+        m_freq = std::make_shared<CPUFreq>();
+    if (modelName().contains("Kunpeng")) {
+        // lscpu reports nominal frequency from acpi_cppc on Kunpeng, keep it
+        m_freq->close();
+    } else {
+        QVector<int> cpus;
+        cpus.reserve(infos.size());
+        for (const CPUInfo &info : infos)
+            cpus << info.logicalIndex();
+        m_freq->open(cpus);
+    }
+}
+
+void CPUSet::read_freqs()
+{
+    if (!m_freq || !m_freq->update())
+        return;
+
+    for (CPUInfo &info : d->m_infos) {
+        qulonglong khz = m_freq->curFreq(info.logicalIndex());
+        if (khz > 0)
+            info.setCpuFreq(QString::number(khz / 1000., 'f', 3));
+    }
+
+    // same as lscpu: max frequency scaled by the current to max ratio summed over all cpus
+    qreal scal = m_freq->scaling();
+    qreal maxMHz = d->m_info.value("CPU max MHz").toDouble();
+    if (scal > 0 && maxMHz > 0)
+        d->m_info.insert("CPU MHz", QString::number(maxMHz * scal / 100, 'f', 4));
 }
 
 void CPUSet::read_dmi_cache_info()
@@ -756,6 +838,19 @@ void CPUSet::read_lscpu()
     lscpu_read_numas(cxt);
     lscpu_read_topology(cxt);
     lscpu_decode_arm(cxt);
+
+    // topology of online cpus, grouped by socket & core
+    QVector<cpu_topology_t> topology;
+    for (size_t i = 0; i < cxt->npossibles; i++) {
+        struct lscpu_cpu *cpu = cxt->cpus[i];
+        if (!cpu || !is_cpu_online(cxt, cpu))
+            continue;
+        topology << cpu_topology_t {cpu->logical_id, cpu->socketid, cpu->coreid};
+    }
+    std::sort(topology.begin(), topology.end(), [](const cpu_topology_t &lhs, const cpu_topology_t &rhs) {
+        return std::tie(lhs.socket, lhs.core, lhs.cpu) < std::tie(rhs.socket, rhs.core, rhs.cpu);
+    });
+    d->m_topology = topology;
     cxt->virt = lscpu_read_virtualization(cxt); // 获取CPU的虚拟化信息
     struct lscpu_cputype *ct;
     ct = lscpu_cputype_get_default(cxt); // 获取CPU类型信息
@@ -6,14 +6,21 @@
 #define CPUSET_H
 
 #include "cpu.h"
+#include "proc_stat.h"
 #include "3rdparty/dmidecode/dmidecode.h"
 #include <QList>
 #include <QSharedDataPointer>
 
+#include <memory>
+
 namespace core {
 namespace system {
 
 class CPUSetPrivate;
+class CPUFreq;
+class ProcStatReader;
+class UDev;
+class UDevMonitor;
 class CPUSet
 {
     friend class Process;
@@ -55,6 +62,12 @@ public://info
 public://core
     QString coreId(int index) const;
 
+    /**
+     * @brief topology Online cpus ordered by socket, core & cpu id, so smt siblings of a core
+     * and cores of a socket are next to each other
+     */
+    QVector<cpu_topology_t> topology() const;
+
 public://usage
     const CPUUsage usage() const;
 
@@ -68,6 +81,20 @@ public://usage
 
     qulonglong getUsageTotalDelta() const;
 
+    /**
+     * @brief procStat Copy of the last /proc/stat read, per cpu values indexed by cpu id;
+     * published once per update, safe to hold & read from another thread
+     */
+    std::shared_ptr<const proc_stat_t> procStat() const;
+
+    qulonglong contextSwitches() const;
+
+    qulonglong interrupts() const;
+
+    uint procsRunning() const;
+
+    uint procsBlocked() const;
+
 public:
     void update();
 
@@ -81,11 +108,29 @@ private:
      * @brief read_lscpu 通过lscpu读取CPU信息
      */
     void read_lscpu();
+    /**
+     * @brief read_overall_info Load topology & identity of cpus, only done on first update & on cpu hotplug
+     */
     void read_overall_info();
+    /**
+     * @brief read_freqs Read current frequency of online cpus through kept-open cpufreq files
+     */
+    void read_freqs();
 
 private:
     QSharedDataPointer<CPUSetPrivate> d;
 
+    // udev context of m_hotplug
+    std::shared_ptr<UDev> m_udev;
+    // cpu subsystem events, topology is reloaded when cpus go on/off line
+    std::shared_ptr<UDevMonitor> m_hotplug;
+    // scaling_cur_freq files of online cpus
+    std::shared_ptr<CPUFreq> m_freq;
+    // kept-open /proc/stat
+    std::shared_ptr<ProcStatReader> m_statReader;
+    // copy of d->m_procStat published after each read, swapped atomically
+    std::shared_ptr<const proc_stat_t> m_publishedStat;
+
     //true:modelName为空; false:modelName非空
     bool mIsEmptyModelName = false;
 
@@ -11,6 +11,7 @@
 #include "netif_info_db.h"
 #include "diskio_info.h"
 #include "net_info.h"
+#include "pressure.h"
 #include "common/thread_manager.h"
 #include "system/system_monitor.h"
 #include "system/system_monitor_thread.h"
@@ -30,6 +31,7 @@ DeviceDB::DeviceDB()
     m_blkDevInfoDB = new BlockDeviceInfoDB();
     m_diskIoInfo = new DiskIOInfo();
     m_netInfo = new NetInfo();
+    m_pressureInfo = new PressureInfo();
 }
 
 DeviceDB::~DeviceDB()
@@ -58,6 +60,10 @@ DeviceDB::~DeviceDB()
         delete m_netInfo;
         m_netInfo  = nullptr;
     }
+    if (m_pressureInfo) {
+        delete m_pressureInfo;
+        m_pressureInfo  = nullptr;
+    }
 }
 
 void DeviceDB::update()
@@ -67,7 +73,9 @@ void DeviceDB::update()
     m_netifInfoDB->update();
     m_blkDevInfoDB->update();
     m_diskIoInfo->update();
-    m_netInfo->resdNetInfo();
+    // totals are summed up from the link stats just read
+    m_netInfo->update(m_netifInfoDB->links());
+    m_pressureInfo->update();
 }
 
 DeviceDB *DeviceDB::instance()
@@ -106,5 +114,10 @@ NetInfo *DeviceDB::netInfo()
     return m_netInfo;
 }
 
+PressureInfo *DeviceDB::pressureInfo()
+{
+    return m_pressureInfo;
+}
+
 } // namespace system
 } // namespace core
@@ -16,6 +16,7 @@ class CPUSet;
 class SystemMonitor;
 class DiskIOInfo;
 class NetInfo;
+class PressureInfo;
 
 /**
  * @brief The DeviceDB class
@@ -34,6 +35,7 @@ public:
     BlockDeviceInfoDB *blockDeviceInfoDB();
     DiskIOInfo *diskIoInfo();
     NetInfo *netInfo();
+    PressureInfo *pressureInfo();
 
     void update();
 
@@ -44,6 +46,7 @@ private:
     BlockDeviceInfoDB *m_blkDevInfoDB;
     DiskIOInfo *m_diskIoInfo;
     NetInfo *m_netInfo;
+    PressureInfo *m_pressureInfo;
 };
 
 } // namespace system
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ethtool.h"
+#include "common/common.h"
+
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
+
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+// link mode masks the kernel may ask for at most (3 masks of up to SCHAR_MAX words each)
+#define ETHTOOL_LINK_MODE_WORDS_MAX 127
+
+using namespace common::error;
+
+namespace core {
+namespace system {
+
+Ethtool::Ethtool()
+    : m_fd(-1)
+    , m_linkModeWords(0)
+    , m_linkSettings(true)
+{
+    errno = 0;
+    m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (m_fd < 0) {
+        print_errno(errno, "create ethtool control socket failed");
+    }
+}
+
+Ethtool::~Ethtool()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool Ethtool::linkSpeed(const QByteArray &ifname, uint &speed)
+{
+    if (m_fd < 0 || ifname.isEmpty() || ifname.size() >= IFNAMSIZ)
+        return false;
+
+    if (m_linkSettings) {
+        if (readLinkSettings(ifname, speed))
+            return true;
+        if (errno != EOPNOTSUPP)
+            return false;
+        // kernel before 4.6 has no ETHTOOL_GLINKSETTINGS, stop trying it if legacy command works
+        if (!readLegacySettings(ifname, speed))
+            return false;
+        m_linkSettings = false;
+        return true;
+    }
+
+    return readLegacySettings(ifname, speed);
+}
+
+bool Ethtool::ethtool(const QByteArray &ifname, void *data)
+{
+    struct ifreq ifr {};
+    memcpy(ifr.ifr_name, ifname.constData(), size_t(ifname.size()));
+    ifr.ifr_data = reinterpret_cast<char *>(data);
+
+    errno = 0;
+    return ioctl(m_fd, SIOCETHTOOL, &ifr) == 0;
+}
+
+bool Ethtool::readLinkSettings(const QByteArray &ifname, uint &speed)
+{
+    // link settings followed by link mode masks, kernel header declares masks as flexible array
+    __u32 buf[(sizeof(struct ethtool_link_settings) / sizeof(__u32)) + 3 * ETHTOOL_LINK_MODE_WORDS_MAX] {};
+    auto *req = reinterpret_cast<struct ethtool_link_settings *>(buf);
+
+    // first call tells the number of link mode words kernel uses, it's the same for all interfaces
+    if (m_linkModeWords <= 0) {
+        req->cmd = ETHTOOL_GLINKSETTINGS;
+        if (!ethtool(ifname, buf))
+            return false;
+        if (req->link_mode_masks_nwords >= 0 || req->cmd != ETHTOOL_GLINKSETTINGS) {
+            errno = EOPNOTSUPP;
+            return false;
+        }
+        m_linkModeWords = qint8(-req->link_mode_masks_nwords);
+        memset(buf, 0, sizeof(buf));
+    }
+
+    req->cmd = ETHTOOL_GLINKSETTINGS;
+    req->link_mode_masks_nwords = m_linkModeWords;
+    if (!ethtool(ifname, buf))
+        return false;
+    if (req->link_mode_masks_nwords <= 0) {
+        // word count changed, can only happen across kernel updates; negotiate again next time
+        m_linkModeWords = 0;
+        errno = EAGAIN;
+        return false;
+    }
+
+    if (req->speed == 0 || req->speed == __u32(SPEED_UNKNOWN))
+        return false;
+    speed = req->speed;
+    return true;
+}
+
+bool Ethtool::readLegacySettings(const QByteArray &ifname, uint &speed)
+{
+    struct ethtool_cmd ecmd {};
+    ecmd.cmd = ETHTOOL_GSET;
+    if (!ethtool(ifname, &ecmd))
+        return false;
+
+    __u32 v = ethtool_cmd_speed(&ecmd);
+    if (v == 0 || v == __u32(SPEED_UNKNOWN) || v == 0xffff)
+        return false;
+    speed = v;
+    return true;
+}
+
+} // namespace system
+} // namespace core
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ETHTOOL_H
+#define ETHTOOL_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief Link settings reader based on SIOCETHTOOL ioctl
+ *
+ * One control socket is kept open for all interfaces & refreshes. Link speed is read
+ * with ETHTOOL_GLINKSETTINGS (linux 4.6+, 32bit speed), ETHTOOL_GSET is only used if
+ * that is not supported. One instance must only be used by one thread at a time.
+ */
+class Ethtool
+{
+public:
+    explicit Ethtool();
+    ~Ethtool();
+
+    /**
+     * @brief isValid Whether the control socket is usable
+     */
+    inline bool isValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief linkSpeed Read link speed of interface
+     * @param ifname Interface name
+     * @param speed Link speed (Mbit/s)
+     * @return false if speed is unknown, e.g. link down, wireless or virtual interface
+     */
+    bool linkSpeed(const QByteArray &ifname, uint &speed);
+
+private:
+    Ethtool(const Ethtool &) = delete;
+    Ethtool &operator=(const Ethtool &) = delete;
+
+    /**
+     * @brief ethtool Issue SIOCETHTOOL ioctl on interface
+     * @param data Ethtool command structure, starting with the command id
+     * @return false on failure, errno is set then
+     */
+    bool ethtool(const QByteArray &ifname, void *data);
+    bool readLinkSettings(const QByteArray &ifname, uint &speed);
+    bool readLegacySettings(const QByteArray &ifname, uint &speed);
+
+private:
+    int m_fd;
+    // link mode mask words of ETHTOOL_GLINKSETTINGS, negotiated on first use
+    qint8 m_linkModeWords;
+    // kernel supports ETHTOOL_GLINKSETTINGS
+    bool m_linkSettings;
+};
+
+} // namespace system
+} // namespace core
+
+#endif // ETHTOOL_H
@@ -4,21 +4,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "net_info.h"
-#include "common/common.h"
-#include "system/sys_info.h"
-
-#include <QScopedArrayPointer>
-
-using namespace common::error;
+#include "settings.h"
 
 namespace core {
 namespace system {
 
-#define PROC_PATH_NET       "/proc/net/dev"
-
 NetInfo::NetInfo()
 {
-
+    m_excludeVirtual = Settings::instance()->getOption(kSettingKeyExcludeVirtualNetif, false).toBool();
 }
 
 NetInfo::~NetInfo()
@@ -46,105 +39,52 @@ qulonglong NetInfo::totalSentBytes()
     return m_totalSentBytes;
 }
 
-void NetInfo::resdNetInfo()
+void NetInfo::setExcludeVirtual(bool exclude)
 {
-    // 时间间隔
-    timevalList[kLastStat] = timevalList[kCurrentStat];
-    timevalList[kCurrentStat] = SysInfo::instance()->uptime();
-
-    bool b = false;
-
-    auto statSum = QSharedPointer<struct net_stat>(new net_stat {});
-    memset(statSum.data(), 0, sizeof(struct net_stat));
-    strncpy(statSum->iface, "(sum)", 6);
-
-    FILE *fp;
-    const size_t bsiz = 256;
-    QScopedArrayPointer<char> line(new char[bsiz] {});
-    int rc;
-
-    if ((fp = fopen(PROC_PATH_NET, "r")) == nullptr) {
-        print_errno(errno, QString("open %1 failed").arg(PROC_PATH_NET));
-        return;
-    }
-
-    while (fgets(line.data(), bsiz, fp)) {
-        char *pos, *start;
-        start = line.data();
-        pos = strchr(line.data(), ':');
-        if (!pos)
-            continue;
+    m_excludeVirtual = exclude;
+}
 
-        *pos++ = '\0';
+bool NetInfo::excludeVirtual() const
+{
+    return m_excludeVirtual;
+}
 
-        auto stat = QSharedPointer<struct net_stat>(new net_stat {});
-        rc = sscanf(start, "%16s", stat->iface);
-        if (rc != 1)
-            continue;
+bool NetInfo::isCounted(const NetifInfo &netif, bool excludeVirtual)
+{
+    // loopback is never part of NetifInfoDB
+    return !(excludeVirtual && netif.isVirtual());
+}
 
-        unsigned long long rx_packets; // received packets
-        unsigned long long tx_packets; // transmitted packets
-        unsigned long long rx_compressed; // number of compressed packets received
-        unsigned long long tx_compressed; // number of compressed packets transmitted
-        unsigned long long multicast; // number of multicast frames transmitted or received
-
-        //******************1****2********************3****4****5****6************************7**
-        rc = sscanf(pos, "%llu %llu %*u %*u %*u %*u %llu %llu %llu %llu %*u %*u %*u %*u %*u %llu",
-                    &stat->rx_bytes,
-                    &rx_packets,
-                    &rx_compressed,
-                    &multicast,
-                    &stat->tx_bytes,
-                    &tx_packets,
-                    &tx_compressed);
-        if (rc != 7)
+void NetInfo::update(const QHash<int, NetifInfo> &links)
+{
+    // summed up by interface index, links without a hardware address (tun, wireguard, ppp)
+    // or sharing one (vlan, bond) are all counted
+    qulonglong rxBytes = 0, txBytes = 0;
+    qreal recvBps = 0, sentBps = 0;
+    for (auto it = links.constBegin(); it != links.constEnd(); ++it) {
+        const NetifInfo &netif = it.value();
+        if (!isCounted(netif, m_excludeVirtual))
             continue;
 
-        statSum->rx_bytes += stat->rx_bytes;
-        statSum->tx_bytes += stat->tx_bytes;
-
-        b = true;
-    }
-    b = !ferror(fp) && b;
-    fclose(fp);
-    if (!b) {
-        print_errno(errno, QString("read %1 failed").arg(PROC_PATH_NET));
+        rxBytes += netif.rxBytes();
+        txBytes += netif.txBytes();
+        // rates of interfaces come from the same interval, so they simply add up
+        recvBps += netif.recv_bps();
+        sentBps += netif.sent_bps();
     }
 
-    m_netStat[kLastStat] = m_netStat[kCurrentStat];
-    m_netStat[kCurrentStat] = statSum;
-
-    qulonglong prxb {}, ptxb{}, crxb {}, ctxb {};
-    if (!m_netStat[kCurrentStat].isNull()) {
-        crxb = m_netStat[kCurrentStat]->rx_bytes;
-        ctxb = m_netStat[kCurrentStat]->tx_bytes;
-    }
-    if (!m_netStat[kLastStat].isNull()) {
-        prxb = m_netStat[kLastStat]->rx_bytes;
-        ptxb = m_netStat[kLastStat]->tx_bytes;
-    }
-    if(m_netStat[kLastStat].isNull()){
+    // 得出当前速度和总流量大小
+    m_totalRecvBytes = rxBytes;
+    m_totalSentBytes = txBytes;
+    if (!m_sampled) {
+        // no interval yet
+        m_sampled = true;
         m_recvBps = 1;   // Bps
         m_sentBps = 1;
-        return ;
+        return;
     }
-    // receive increment between interval
-    auto rxdiff = (crxb > prxb) ? (crxb - prxb) : 0;
-    // transfer increment between interval
-    auto txdiff = (ctxb > ptxb) ? (ctxb - ptxb) : 0;
-
-    // 计算时间间隔
-    timeval cur_time = timevalList[kCurrentStat];
-    timeval prev_time = timevalList[kLastStat];
-    auto ltime = prev_time.tv_sec + prev_time.tv_usec * 1. / 1000000;
-    auto rtime = cur_time.tv_sec + cur_time.tv_usec * 1. / 1000000;
-    auto interval = (rtime > ltime) ? (rtime - ltime) : 1;
-
-    // 得出当前速度和总流量大小
-    m_totalRecvBytes = crxb;
-    m_totalSentBytes = ctxb;
-    m_recvBps = rxdiff / interval;   // Bps
-    m_sentBps = txdiff / interval;
+    m_recvBps = recvBps;   // Bps
+    m_sentBps = sentBps;
 }
 
 } // namespace system
@@ -4,32 +4,29 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #ifndef NET_INFO_H
-#define DISKIO_INFO_H
+#define NET_INFO_H
 
-#include <QSharedPointer>
+#include "netif.h"
 
-#ifndef IF_NAMESIZE
-#define IF_NAMESIZE 16
-#endif
+#include <QHash>
 
 namespace core {
 namespace system {
 
-struct net_stat {
-    unsigned long long rx_bytes; // received bytes
-    unsigned long long tx_bytes; // transmitted bytes
-    char iface[IF_NAMESIZE + 1]; // interface name
-};
-
+/**
+ * @brief Network totals, summed up from per link counters & rates of NetifInfoDB
+ */
 class NetInfo
 {
-    enum StatIndex { kLastStat = 0, kCurrentStat = 1, kStatCount = kCurrentStat + 1 };
-
 public:
     explicit NetInfo();
     virtual ~NetInfo();
 
-    void update();
+    /**
+     * @brief update    汇总各网卡的流量和速度
+     * @param links     Links of NetifInfoDB by interface index, updated in the same tick
+     */
+    void update(const QHash<int, NetifInfo> &links);
 
     /**
      * @brief recvBps   获取接收速度
@@ -56,13 +53,19 @@ public:
     qulonglong totalSentBytes();
 
     /**
-     * @brief resdNetInfo   读取网络信息
+     * @brief setExcludeVirtual 虚拟网卡(veth, docker, 网桥等)不计入总量
+     */
+    void setExcludeVirtual(bool exclude);
+    bool excludeVirtual() const;
+
+    /**
+     * @brief isCounted Whether interface takes part in totals
      */
-    void resdNetInfo();
+    static bool isCounted(const NetifInfo &netif, bool excludeVirtual);
 
 private:
-    timeval timevalList[kStatCount] = {timeval{0, 0}, timeval{0, 0}};
-    QSharedPointer<struct net_stat> m_netStat[kStatCount] {{}, {}};
+    bool m_excludeVirtual = false;   // 不统计虚拟网卡
+    bool m_sampled = false;          // 已有上次采样
 
     qreal m_recvBps = 0;             // 接收速度
     qreal m_sentBps = 0;             // 发送速度
@@ -73,4 +76,4 @@ private:
 } // namespace system
 } // namespace core
 
-#endif // DISKIO_INFO_H
+#endif // NET_INFO_H
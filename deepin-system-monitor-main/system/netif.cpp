@@ -9,14 +9,12 @@
 #include "nl_link.h"
 #include "wireless.h"
 #include "nl_hwaddr.h"
-
-#include <QProcess>
+#include "nl80211.h"
 
 #include <netlink/route/link.h>
 #include <netlink/addr.h>
-#include <linux/sockios.h>
-#include<unistd.h>
-#include<sys/ioctl.h>
+
+#include <unistd.h>
 
 namespace core {
 namespace system {
@@ -79,12 +77,19 @@ void NetifInfo::updateLinkInfo(const NLLink *link)
     d->hw_addr = link->addr();
     d->hw_bcast = link->bcast();
 
-    // ====link params====
+    // only interfaces backed by a device have a device link in sysfs
+    QByteArray devicePath = QByteArray("/sys/class/net/").append(d->ifname).append("/device");
+    d->isVirtual = (access(devicePath.constData(), F_OK) != 0);
 
-    QByteArray conn_type;
-    QString brand;
+    this->updateLinkStats(link);
+    this->updateWirelessInfo();
+    this->updateHWAddr(d->ifname);
+}
 
-    // ====stats====
+void NetifInfo::updateLinkStats(const NLLink *link)
+{
+    if (!link)
+        return;
 
     d->rx_packets = link->rx_packets();
     d->rx_bytes = link->rx_bytes();
@@ -100,10 +105,6 @@ void NetifInfo::updateLinkInfo(const NLLink *link)
     d->tx_fifo = link->tx_fifo();
     d->tx_carrier = link->tx_carrier();
     d->collisions = link->collisions();
-
-    this->updateWirelessInfo();
-    this->updateBrandInfo();
-    this->updateHWAddr(d->ifname);
 }
 
 void NetifInfo::updateWirelessInfo()
@@ -115,44 +116,27 @@ void NetifInfo::updateWirelessInfo()
         d->iw_info->qual.qual = wireless1.link_quality();
         d->iw_info->qual.level = wireless1.signal_levle();
         d->iw_info->qual.noise = wireless1.noise_level();
-        // 速率
-        //无线网速率ioctl没有提供相关接口，目前采用调用iwlist命令的方式获取 #bug 111694
-        QProcess process;
-        QString cmd = QString("iwlist ") + d.data()->ifname + QString(" rate");
-        process.start(cmd);
-        process.waitForFinished(-1);
-        //获取输出
-        QString data = process.readAllStandardOutput();
-        QStringList datalist = data.trimmed().split(":");
-        if (datalist.size() > 0) {
-            QString speedString = datalist[datalist.size() - 1];
-            float fspeed = 0;
-            QStringList  list = speedString.split(" ");
-            if (list.size() > 0) {
-                fspeed = list[0].toFloat();
-            }
-            d->speed = static_cast<uint>(fspeed);
+        // 速率, 信号强度, MCS
+        // nl80211 socket kept open for the monitor thread calling us
+        thread_local NL80211 nl80211;
+        station_info_t station;
+        if (nl80211.station(d->index, d->carrier_changes, station)) {
+            d->iw_info->signal = station.signal;
+            d->iw_info->tx_bitrate = station.tx_bitrate;
+            d->iw_info->rx_bitrate = station.rx_bitrate;
+            d->iw_info->tx_mcs = station.tx_mcs;
+            d->iw_info->rx_mcs = station.rx_mcs;
+            // bitrate in 100 kbit/s, speed in Mbit/s
+            d->speed = station.tx_bitrate / 10;
         }
     } else {
         d->isWireless = false;
     }
 }
 
-void NetifInfo::updateBrandInfo()
+void NetifInfo::updateLinkSpeed(uint speed)
 {
-    struct ifreq ifr;
-    struct ethtool_cmd ecmd;
-
-    ecmd.cmd = 0x00000001;
-    memset(&ifr, 0, sizeof(ifr));
-    strcpy(ifr.ifr_name, d->ifname);
-
-    ifr.ifr_data = reinterpret_cast<caddr_t>(&ecmd);
-    int fd = socket(PF_INET, SOCK_DGRAM, 0);
-    if (ioctl(fd, SIOCETHTOOL, &ifr) == 0) {
-        d->speed   = ecmd.speed;
-    }
-    close(fd);
+    d->speed = speed;
 }
 
 } // namespace system
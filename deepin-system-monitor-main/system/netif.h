@@ -32,49 +32,6 @@ struct inet_addr6_t : public inet_addr_t {
     int scope;
 };
 
-#ifdef __sw_64__
-struct ethtool_cmd {
-        uint32_t   cmd;
-        uint32_t   supported;
-        uint32_t   advertising;
-        uint16_t   speed;
-        uint8_t    duplex;
-        uint8_t    port;
-        uint8_t    phy_address;
-        uint8_t    transceiver;
-        uint8_t    autoneg;
-        uint8_t    mdio_support;
-        uint32_t   maxtxpkt;
-        uint32_t   maxrxpkt;
-        uint16_t   speed_hi;
-        uint8_t    eth_tp_mdix;
-        uint8_t    eth_tp_mdix_ctrl;
-        uint32_t   lp_advertising;
-        uint16_t reserved[4];
-};
-#else
-struct ethtool_cmd {
-    uint32_t cmd;
-    uint32_t supported;                                  /* Features this interface supports */
-    uint32_t advertising;                                /* Features this interface advertises */
-    uint16_t speed;                                      /* The forced speed, 10Mb, 100Mb, gigabit */
-    uint8_t duplex;                                      /* Duplex, half or full */
-    uint8_t port;                                        /* Which connector port */
-    uint8_t phy_address;
-    uint8_t transceiver;                                 /* Which tranceiver to use */
-    uint8_t autoneg;                                     /* Enable or disable autonegotiation */
-    uint16_t maxtxpkt;                                   /* Tx pkts before generating tx int */
-    uint16_t maxrxpkt;                                   /* Rx pkts before generating rx int */
-    uint16_t reserved[4];
-};
-#endif
-
-/* The forced speed, 10Mb, 100Mb, gigabit, 10GbE. */
-#define SPEED_10                10
-#define SPEED_100               100
-#define SPEED_1000              1000
-#define SPEED_10000             10000
-
 using INetAddr = std::shared_ptr<struct inet_addr_t>;
 using INet4Addr = std::shared_ptr<struct inet_addr4_t>;
 using INet6Addr = std::shared_ptr<struct inet_addr6_t>;
@@ -110,12 +67,18 @@ public:
     QByteArray linkAddress() const;
     QByteArray linkBroadcast() const;
     QString brand() const;
+    bool isVirtual() const;
 
     // wireless link only
     QByteArray essid() const;
     uint8_t linkQuality() const;
     uint8_t signalLevel() const;
     uint8_t noiseLevel() const;
+    int signalDbm() const;
+    uint txBitrate() const; // kbit/s
+    uint rxBitrate() const; // kbit/s
+    int txMcs() const;
+    int rxMcs() const;
     bool isWireless() const;
 
     // link stats
@@ -150,9 +113,10 @@ protected:
     void updateAddr4Info(const QList<INet4Addr> &addrList);
     void updateAddr6Info(const QList<INet6Addr> &addrList);
     void updateHWAddr(const QByteArray ifname);
-    void updateLinkInfo(const NLLink *link);
-    void updateWirelessInfo(); // ioctl
-    void updateBrandInfo(); // udev
+    void updateLinkInfo(const NLLink *link); // link params & stats, probes hw type & wireless
+    void updateLinkStats(const NLLink *link); // stats only
+    void updateWirelessInfo(); // ioctl & nl80211
+    void updateLinkSpeed(uint speed); // ethtool, queried by NetifInfoDB
 
 private:
     QSharedDataPointer<NetifInfoPrivate> d;
@@ -240,6 +204,11 @@ inline QString NetifInfo::brand() const
     return d->brand;
 }
 
+inline bool NetifInfo::isVirtual() const
+{
+    return d->isVirtual;
+}
+
 inline QByteArray NetifInfo::essid() const
 {
     if (d->iw_info)
@@ -264,6 +233,34 @@ inline uint8_t NetifInfo::signalLevel() const
         return 0;
 }
 
+inline int NetifInfo::signalDbm() const
+{
+    if (d->iw_info && d->iw_info->signal)
+        return d->iw_info->signal;
+    // wireless extensions report dBm as unsigned 8bit value
+    return int8_t(signalLevel());
+}
+
+inline uint NetifInfo::txBitrate() const
+{
+    return d->iw_info ? d->iw_info->tx_bitrate * 100 : 0;
+}
+
+inline uint NetifInfo::rxBitrate() const
+{
+    return d->iw_info ? d->iw_info->rx_bitrate * 100 : 0;
+}
+
+inline int NetifInfo::txMcs() const
+{
+    return d->iw_info ? d->iw_info->tx_mcs : -1;
+}
+
+inline int NetifInfo::rxMcs() const
+{
+    return d->iw_info ? d->iw_info->rx_mcs : -1;
+}
+
 inline bool NetifInfo::isWireless() const
 {
     return d->isWireless;
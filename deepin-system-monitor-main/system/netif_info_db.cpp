@@ -10,6 +10,7 @@
 #include "netlink.h"
 
 #include <QReadLocker>
+#include <QSet>
 #include <QWriteLocker>
 #include "common/thread_manager.h"
 #include "netif_monitor_thread.h"
@@ -22,14 +23,21 @@ namespace system {
 
 NetifInfoDB::NetifInfoDB()
     : m_netlink(new Netlink())
+    , m_watcher(new LinkWatcher())
+    , m_ethtool(new Ethtool())
 {
 }
 
 void NetifInfoDB::update_addr()
 {
-    AddrIterator iter = m_netlink->addrIterator();
+    // address cache is kept up to date by notifications, nothing to do unless they reported a change
+    if (m_watcher->isValid() && !m_watcher->takeAddrChanged())
+        return;
+
+    AddrIterator iter = m_watcher->isValid() ? m_watcher->addrIterator() : m_netlink->addrIterator();
     m_addrIpv4DB.clear();
     m_addrIpv6DB.clear();
+    m_addrChanged = true;
 
     while (iter.hasNext()) {
         auto it = iter.next();
@@ -56,49 +64,103 @@ void NetifInfoDB::update_addr()
 // 更新网络信息
 void NetifInfoDB::update_netif_info()
 {
+    // stats are not notified, dump links for counters
     LinkIterator iter = m_netlink->linkIterator();
-    QMap<QByteArray, NetifInfoPtr> old_infoDB = m_infoDB;
+    // link params & probe results are kept until link changes, all probed again without notifications
+    QSet<int> changedLinks = m_watcher->takeChangedLinks();
+    bool probeAll = !m_watcher->isValid();
 
     timevalList[kLastStat] = timevalList[kCurrentStat];
     timevalList[kCurrentStat] = SysInfo::instance()->uptime();
 
+    timeval cur_time = timevalList[kCurrentStat];
+    timeval prev_time = timevalList[kLastStat];
+    auto ltime = prev_time.tv_sec + prev_time.tv_usec * 1. / 1000000;
+    auto rtime = cur_time.tv_sec + cur_time.tv_usec * 1. / 1000000;
+    auto interval = (rtime > ltime) ? (rtime - ltime) : 1;
+
     m_infoDB.clear();
+    // links gone since last update are dropped, their index may be reused
+    QHash<int, NetifInfo> links;
+    links.reserve(m_links.size());
     while (iter.hasNext()) {
         auto it = iter.next();
 
         if (it->ifname() == "lo") {
             continue;
         }
-        NetifInfoPtr item = std::make_shared<NetifInfo>();
-        item->updateLinkInfo(it.get());
-        item->updateAddr4Info(m_addrIpv4DB.values(it->ifindex()));
-        item->updateAddr6Info(m_addrIpv6DB.values(it->ifindex()));
+        int ifindex = it->ifindex();
+        auto old_item = m_links.constFind(ifindex);
+        bool known = (old_item != m_links.constEnd());
+
+        NetifInfo item;
+        if (!known || probeAll || changedLinks.contains(ifindex)) {
+            item.updateLinkInfo(it.get());
+            // wireless bitrate is taken from nl80211 already
+            uint speed = 0;
+            if (!item.isWireless() && linkSpeed(it.get(), speed))
+                item.updateLinkSpeed(speed);
+        } else {
+            item = old_item.value();
+            item.updateLinkStats(it.get());
+            // signal & bitrate change without link notifications, nl80211 query is cached
+            if (item.isWireless())
+                item.updateWirelessInfo();
+        }
+        if (!known || m_addrChanged) {
+            item.updateAddr4Info(m_addrIpv4DB.values(ifindex));
+            item.updateAddr6Info(m_addrIpv6DB.values(ifindex));
+        }
 
         // 更新速率
-        if (old_infoDB.contains(it->addr())) {
-            auto old_item = old_infoDB.value(it->addr());
+        if (known) {
             // receive increment between interval
-            auto rxdiff = (item->rxBytes() > old_item->rxBytes()) ? (item->rxBytes() - old_item->rxBytes()) : 0;
+            auto rxdiff = (item.rxBytes() > old_item->rxBytes()) ? (item.rxBytes() - old_item->rxBytes()) : 0;
             // transfer increment between interval
-            auto txdiff = (item->txBytes() > old_item->txBytes()) ? (item->txBytes() - old_item->txBytes()) : 0;
-
-            timeval cur_time = timevalList[kCurrentStat];
-            timeval prev_time = timevalList[kLastStat];
+            auto txdiff = (item.txBytes() > old_item->txBytes()) ? (item.txBytes() - old_item->txBytes()) : 0;
 
-            auto ltime = prev_time.tv_sec + prev_time.tv_usec * 1. / 1000000;
-            auto rtime = cur_time.tv_sec + cur_time.tv_usec * 1. / 1000000;
-            auto interval = (rtime > ltime) ? (rtime - ltime) : 1;
             qreal recv_bps = rxdiff / interval;   // Bps
             qreal sent_bps = txdiff / interval;
-            item->set_recv_bps(recv_bps);
-            item->set_sent_bps(sent_bps);
+            item.set_recv_bps(recv_bps);
+            item.set_sent_bps(sent_bps);
         }
 
-        m_infoDB.insert(it->addr(), item);
+        links.insert(ifindex, item);
+        // shares data with item until next update writes to it
+        m_infoDB.insert(it->addr(), std::make_shared<NetifInfo>(item));
+    }
+    m_links.swap(links);
+    m_addrChanged = false;
+
+    for (auto it = m_linkSpeeds.begin(); it != m_linkSpeeds.end();) {
+        if (m_links.contains(it.key()))
+            ++it;
+        else
+            it = m_linkSpeeds.erase(it);
+    }
+}
+
+bool NetifInfoDB::linkSpeed(const NLLink *link, uint &speed)
+{
+    // speed only changes on renegotiation, which flips carrier or operational state
+    auto it = m_linkSpeeds.find(link->ifindex());
+    if (it == m_linkSpeeds.end()
+            || it->carrier_changes != link->carrier_changes()
+            || it->carrier != link->carrier()
+            || it->oper_stat != link->oper_stat()) {
+        link_speed_t entry {link->carrier_changes(), link->carrier(), link->oper_stat(), false, 0};
+        entry.ok = m_ethtool->linkSpeed(link->ifname(), entry.speed);
+        it = m_linkSpeeds.insert(link->ifindex(), entry);
     }
+
+    if (it->ok)
+        speed = it->speed;
+    return it->ok;
 }
+
 void NetifInfoDB::update()
 {
+    m_watcher->handleEvents();
     this->update_addr();
     this->update_netif_info();
 }
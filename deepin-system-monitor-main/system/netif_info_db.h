@@ -8,7 +8,9 @@
 
 #include "netif.h"
 #include "netlink.h"
+#include "ethtool.h"
 
+#include <QHash>
 #include <QMultiMap>
 #include <QMap>
 
@@ -33,18 +35,48 @@ public:
     virtual ~NetifInfoDB() = default;
 
     QMap<QByteArray, NetifInfoPtr> infoDB();
+    /**
+     * @brief Links by interface index, unlike infoDB every link is there, with or without hardware address
+     */
+    const QHash<int, NetifInfo> &links() const;
     void update();
 
 protected:
     void update_addr();
     void update_netif_info();
+    /**
+     * @brief Link speed of interface, queried again only if link state changed since last query
+     * @return false if speed is unknown
+     */
+    bool linkSpeed(const NLLink *link, uint &speed);
 
 private:
+    // link speed cache entry, valid while link state stays the same
+    struct link_speed_t {
+        uint carrier_changes;
+        uint8_t carrier;
+        uint8_t oper_stat;
+        bool ok; // speed known
+        uint speed; // Mbit/s
+    };
+
+    // link stats dump, read every update
     std::unique_ptr<Netlink> m_netlink;
+    // link & address change notifications
+    std::unique_ptr<LinkWatcher> m_watcher;
+    // ethtool control socket, shared by all interfaces
+    std::unique_ptr<Ethtool> m_ethtool;
+    // link speed by interface index
+    QHash<int, link_speed_t> m_linkSpeeds;
 
     QMultiMap<int, INet4Addr> m_addrIpv4DB;
     QMultiMap<int, INet6Addr> m_addrIpv6DB;
 
+    // address lists changed since links took them
+    bool m_addrChanged {true};
+
+    // interfaces kept across updates by index, published to m_infoDB as implicitly shared copies
+    QHash<int, NetifInfo> m_links;
     QMap<QByteArray, NetifInfoPtr> m_infoDB;
 
     QMap<ino_t, SockIOStat> m_sockIOStatMap;
@@ -59,6 +91,11 @@ inline QMap<QByteArray, NetifInfoPtr> NetifInfoDB::infoDB()
     return m_infoDB;
 }
 
+inline const QHash<int, NetifInfo> &NetifInfoDB::links() const
+{
+    return m_links;
+}
+
 } // namespace system
 } // namespace core
 
@@ -47,53 +47,81 @@ void NetifMonitor::handleNetData()
 {
     while (!m_quitRequested.load()) {
         m_pktqLock.lock();      // +++m_pktqLock+++
-        // packets available for processing when pending queue mutex unlocked
-        m_pktqWatcher.wait(&m_pktqLock);
+        // sleep until capture job queued packets, queue is checked with lock held so a wakeup in between is not lost
+        while (m_pendingPackets.isEmpty() && !m_quitRequested.load())
+            m_pktqWatcher.wait(&m_pktqLock);
+        m_pktqLock.unlock();    // ---m_pktqLock---
 
         // check if quit requested again after wakeup by another thread, break the loop if need
         if (m_quitRequested.load())
             break;
 
-        // append pending queue packets to local queue, so we dont lock the mutex for too long
-        m_localPendingPackets.append(m_pendingPackets);
-        m_pendingPackets.clear();
-        m_pktqLock.unlock();    // ---m_pktqLock---
+        mergePendingPackets();
+        reportQueueDrops();
+    }
+}
+
+void NetifMonitor::reportQueueDrops()
+{
+    // capture job drops packets rather than blocking on a full queue, which under sustained
+    // overload happens on every wakeup, so sum the drops up & log them once per interval
+    qulonglong drops = m_pendingPackets.dropped();
+    if (drops == m_reportedDrops)
+        return;
+
+    time_t now = time(nullptr);
+    if (m_lastDropReport && now - m_lastDropReport < PACKET_DROP_REPORT_INTERVAL)
+        return;
+
+    qDebug() << "packet queue full," << drops - m_reportedDrops << "packets dropped," << drops << "in total";
+    m_reportedDrops = drops;
+    m_lastDropReport = now;
+}
 
-        // process payload queue
-        while (!m_localPendingPackets.isEmpty()) {
-            auto payload = m_localPendingPackets.dequeue();
-
-            // lock sockiostatmap
-            m_sockIOStatMapLock.lock();     // +++m_sockIOStatMapLock+++
-
-            // sum up sock io stat by inode
-            auto ino = payload->ino;
-            if (m_sockIOStatMap.contains(ino)) {
-                // sum up sock io stat if already exists with same inode stat
-                auto &hist = m_sockIOStatMap[ino];
-                if (payload->direction == kInboundPacket) {
-                    hist->rx_bytes += payload->payload;
-                    hist->rx_packets++;
-                } else if (payload->direction == kOutboundPacket) {
-                    hist->tx_bytes += (payload->payload * 2);
-                    hist->tx_packets++;
-                }
-            } else {
-                // add new sock io stat if sock ino no exists in cache before
-                auto stat = QSharedPointer<struct sock_io_stat_t>::create();
-                stat->ino = payload->ino;
-                if (payload->direction == kInboundPacket) {
-                    stat->rx_bytes = payload->payload;
-                    stat->rx_packets++;
-                } else if (payload->direction == kOutboundPacket) {
-                    stat->tx_bytes = payload->payload;
-                    stat->tx_packets++;
-                }
-                m_sockIOStatMap[stat->ino] = stat;
-            }
-            m_sockIOStatMapLock.unlock();   // ---m_sockIOStatMapLock---
+int NetifMonitor::mergePendingPackets()
+{
+    // sum up sock io stat by inode without lock, a batch usually touches a few sockets only
+    int npkts = 0;
+    while (!m_pendingPackets.isEmpty() && npkts < PACKET_PENDING_QUEUE_SIZE) {
+        const packet_payload_t &payload = m_pendingPackets.front();
+
+        auto &stat = m_batchIOStats[payload.ino];
+        stat.ino = payload.ino;
+        if (payload.direction == kInboundPacket) {
+            stat.rx_bytes += payload.payload;
+            stat.rx_packets++;
+        } else if (payload.direction == kOutboundPacket) {
+            stat.tx_bytes += payload.payload;
+            stat.tx_packets++;
+        }
+
+        m_pendingPackets.pop();
+        ++npkts;
+    }
+    if (m_batchIOStats.isEmpty())
+        return npkts;
+
+    addSockIOStats(m_batchIOStats);
+    m_batchIOStats.clear();
+    return npkts;
+}
+
+void NetifMonitor::addSockIOStats(const QHash<ino_t, sock_io_stat_t> &stats)
+{
+    m_sockIOStatMapLock.lock();     // +++m_sockIOStatMapLock+++
+    for (auto it = stats.cbegin(); it != stats.cend(); ++it) {
+        auto &hist = m_sockIOStatMap[it.key()];
+        if (hist.isNull()) {
+            // add new sock io stat if sock ino no exists in cache before
+            hist = QSharedPointer<struct sock_io_stat_t>::create(it.value());
+        } else {
+            hist->rx_bytes += it->rx_bytes;
+            hist->rx_packets += it->rx_packets;
+            hist->tx_bytes += it->tx_bytes;
+            hist->tx_packets += it->tx_packets;
         }
     }
+    m_sockIOStatMapLock.unlock();   // ---m_sockIOStatMapLock---
 }
 
 }
@@ -11,12 +11,17 @@
 
 #include <QObject>
 #include <QBasicTimer>
+#include <QHash>
 #include <QMutex>
+#include <QMutexLocker>
 #include <QWaitCondition>
 #include <QThread>
 
 using namespace common::core;
 
+#define PACKET_PENDING_QUEUE_SIZE 16384 // capacity of packet queue between capture job & monitor, power of two
+#define PACKET_DROP_REPORT_INTERVAL 60 // queue drops are logged at most once per interval (seconds)
+
 namespace core {
 namespace system {
 
@@ -34,6 +39,14 @@ struct sock_io_stat_t {
 // socket io stat typedef
 using SockIOStat = QSharedPointer<struct sock_io_stat_t>;
 
+/**
+ * @brief Kernel counters of packet capture (pcap_stats)
+ */
+struct capture_stat_t {
+    qulonglong recv_packets {}; // packets passed capture filter
+    qulonglong dropped_packets {}; // packets dropped for lack of buffer space, or by interface driver
+};
+
 class NetifMonitor : public QObject
 {
     Q_OBJECT
@@ -44,7 +57,7 @@ public:
     inline void requestQuit()
     {
         m_quitRequested.store(true);
-        m_pktqWatcher.wakeAll();
+        wakeConsumer();
     }
 
 public:
@@ -53,6 +66,14 @@ public:
     void startNetmonitorJob();
 
     void handleNetData();
+
+    /**
+     * @brief Packets dropped because the pending queue was full (thread safe accessor)
+     */
+    inline qulonglong queueDroppedPackets() const
+    {
+        return m_pendingPackets.dropped();
+    }
 public:
     /**
      * @brief Get socket io stat data with specified inode (thread safe accessor)
@@ -79,27 +100,109 @@ public:
 
         return ok;
     }
+    /**
+     * @brief Add io stat of sockets to stat cache (thread safe accessor)
+     * @param stats Bytes & packets since last call, by socket inode
+     */
+    void addSockIOStats(const QHash<ino_t, sock_io_stat_t> &stats);
     // socket inode to io stat mapping
     QMap<ino_t, SockIOStat> m_sockIOStatMap     {};
 
+    /**
+     * @brief Get kernel counters of packet capture on interface (thread safe accessor)
+     * @param ifname Interface name
+     * @param stat Capture counters
+     * @return Return true if interface is being captured, otherwise return false
+     */
+    inline bool captureStat(const QString &ifname, capture_stat_t &stat)
+    {
+        QMutexLocker locker(&m_captureStatLock);
+        auto it = m_captureStats.constFind(ifname);
+        if (it == m_captureStats.constEnd())
+            return false;
+        stat = it.value();
+        return true;
+    }
+    /**
+     * @brief Replace kernel counters of all captured interfaces, called by capture job (thread safe accessor)
+     */
+    inline void setCaptureStats(const QMap<QString, capture_stat_t> &stats)
+    {
+        QMutexLocker locker(&m_captureStatLock);
+        m_captureStats = stats;
+    }
+
+    /**
+     * @brief Socket table last read by capture job (thread safe accessor)
+     * @param stats Sockets keyed by flow, implicitly shared with capture job
+     * @return Time the table was read, 0 if never
+     */
+    inline time_t sockStats(SockStatMap &stats)
+    {
+        QMutexLocker locker(&m_captureStatLock);
+        stats = m_sockStats;
+        return m_sockStatsTime;
+    }
+    /**
+     * @brief Publish socket table, called by capture job after each refresh (thread safe accessor)
+     */
+    inline void setSockStats(const SockStatMap &stats, time_t ts)
+    {
+        QMutexLocker locker(&m_captureStatLock);
+        m_sockStats = stats;
+        m_sockStatsTime = ts;
+    }
+
+private:
+    /**
+     * @brief Wake up handleNetData, called by capture job after queueing packets
+     */
+    inline void wakeConsumer()
+    {
+        // consumer checks the queue with the lock held before waiting, so no wakeup is lost
+        QMutexLocker locker(&m_pktqLock);
+        m_pktqWatcher.wakeAll();
+    }
+    /**
+     * @brief Drain pending queue, sum up io stat per inode locally then merge it into the stat cache
+     * @return Number of packets drained
+     */
+    int mergePendingPackets();
+    /**
+     * @brief Log packets dropped by a full queue, rate limited, queueDroppedPackets has the live count
+     */
+    void reportQueueDrops();
+
 private:
     NetifPacketCapture *m_netifCapture;
     // packet monitor thread object
     QThread m_packetMonitorThread;
 
-    // pending packet queue
-    PacketPayloadQueue  m_pendingPackets        {};
-    // pending packet queue locker
+    // pending packet queue, capture job thread produces & handleNetData thread consumes without locking
+    PacketPayloadSpscRing m_pendingPackets      {PACKET_PENDING_QUEUE_SIZE};
+    // guards m_pktqWatcher only, never held while packets are queued or drained
     QMutex              m_pktqLock              {};
     // packet queue watcher
     QWaitCondition      m_pktqWatcher           {};
-    // local pending packet queue
-    PacketPayloadQueue  m_localPendingPackets   {}; // local cache
+    // io stat of the batch being drained, merged into m_sockIOStatMap under one lock
+    QHash<ino_t, sock_io_stat_t> m_batchIOStats {};
+    // queue drops already reported
+    qulonglong          m_reportedDrops         {0};
+    // last time queue drops reported
+    time_t              m_lastDropReport        {0};
 
 
     // socket io stat map access locker
     QMutex                  m_sockIOStatMapLock {};
 
+    // packet capture counters of captured interfaces
+    QMap<QString, capture_stat_t> m_captureStats {};
+    // socket table of capture job, guarded by m_captureStatLock as well
+    SockStatMap             m_sockStats         {};
+    time_t                  m_sockStatsTime     {0};
+    // packet capture counters access locker
+    QMutex                  m_captureStatLock   {};
+
     // packet monitor thread object
     //QThread             m_packetMonitorThread;
     // packet monitor job instace
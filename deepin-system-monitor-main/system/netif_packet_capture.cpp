@@ -5,7 +5,6 @@
 
 #include "netif_packet_capture.h"
 #include "netif_packet_parser.h"
-#include "common/hash.h"
 #include "netif_monitor.h"
 #include <arpa/inet.h>
 #include "device_db.h"
@@ -14,32 +13,44 @@
 #include <iostream>
 
 #include "sys_info.h"
+#include "netlink.h"
+#include "settings.h"
 #include <sys/ioctl.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <QCoreApplication>
-#include <QProcess>
+#include <QSocketNotifier>
 
 #ifndef IFNAMESZ
 #define IFNAMESZ 16
 #endif
 
 
-//#define PACKET_DISPATCH_IDLE_TIME 200 // pcap dispatch interval
-#define PACKET_DISPATCH_IDLE_TIME 50 // pcap dispatch interval
-#define PACKET_DISPATCH_BATCH_COUNT 64 // packets to process in a batch
-#define PACKET_DISPATCH_QUEUE_LWAT 64 // queue low water mark
-#define PACKET_DISPATCH_QUEUE_HWAT 256 // queue high water mark
+#define PACKET_DISPATCH_IDLE_TIME 50 // pcap dispatch interval, only if pcap has no selectable fd
+#define PACKET_DISPATCH_BATCH_COUNT 64 // minimal packets to process in a batch
+#define PACKET_DISPATCH_BATCH_MAX 4096 // maximal packets to process in a batch
+#define PACKET_DISPATCH_WAKEUP_MAX 65536 // packets to process before returning to event loop
+#define PACKET_BUFFER_TIMEOUT 200 // time kernel may hold captured packets before waking us up (ms)
+#define PACKET_BUFFER_SIZE 2048 // default capture ring buffer size (KiB)
+// ethernet + ipv6 with 64 bytes of extension headers + tcp with max options, enough for any ipv4 header too
+#define PACKET_CAPTURE_SNAPLEN 192
+// only tcp & udp over ip/ip6 are accounted, let kernel drop anything else
+#define PACKET_CAPTURE_FILTER "(ip or ip6) and (tcp or udp)"
+// tcp is accounted from tcp_info counters, capture udp only
+#define PACKET_CAPTURE_FILTER_UDP "(ip or ip6) and udp"
+#define PACKET_CAPTURE_MAX_HANDLES 8 // interfaces to capture on at most
 
 #define SOCKSTAT_REFRESH_INTERVAL 2 // socket stat refresh interval (2 seconds)
-#define IFADDRS_HASH_CACHE_REFRESH_INTERVAL 10 // socket ifaddrs cache refresh interval (10 seconds)
-#define DEVICE_CHANGE_JUDGEMENT_TIME 5000 //判断网卡是否变更时间间隔
+#define IFADDRS_CACHE_REFRESH_INTERVAL 10 // socket ifaddrs cache refresh interval (10 seconds)
+#define TCPINFO_SAMPLE_INTERVAL 1000 // tcp_info counters sample interval (ms)
 
 using namespace std;
 
 namespace core {
 namespace system {
 
+bool readNetIfAddrs(NetIFAddrsMap &addrsMap);
+
 
 
 
@@ -51,23 +62,55 @@ NetifPacketCapture::NetifPacketCapture(NetifMonitor *netIfmontor, QObject *paren
     m_timer->setSingleShot(true);
     // dispatch packets on timerout signal
     connect(m_timer, &QTimer::timeout, this, &NetifPacketCapture::dispatchPackets);
-    //设置定时器定时判断是否变更网卡
-    m_timerChangeDev = new QTimer(this);
-    connect(m_timerChangeDev, &QTimer::timeout, this, &NetifPacketCapture::whetherDevChanged);
-    m_timerChangeDev->start(DEVICE_CHANGE_JUDGEMENT_TIME);
+
+    m_tcpInfoTimer = new QTimer(this);
+    m_tcpInfoTimer->setInterval(TCPINFO_SAMPLE_INTERVAL);
+    connect(m_tcpInfoTimer, &QTimer::timeout, this, [this]() {
+        if (m_quitRequested.load()) {
+            m_tcpInfoTimer->stop();
+            return;
+        }
+        if (!sampleTcpBytes()) {
+            // restart with a new baseline, tcp packets are captured if counters stay unreadable
+            qDebug() << "tcp_info sampling failed, restart monitor job";
+            m_tcpBytes.clear();
+            m_tcpBytesSampled = false;
+            startNetifMonitorJob();
+        }
+    });
+}
+
+NetifPacketCapture::~NetifPacketCapture()
+{
+    closeHandle();
+}
+
+void NetifPacketCapture::requestQuit()
+{
+    m_quitRequested.store(true);
+    // notifiers of idle interfaces never fire again, wake capture thread up with a queued call instead
+    QMetaObject::invokeMethod(this, "onQuitRequested", Qt::QueuedConnection);
+}
+
+void NetifPacketCapture::onQuitRequested()
+{
+    m_tcpInfoTimer->stop();
+    if (m_routeNotifier)
+        m_routeNotifier->setEnabled(false);
+    if (m_linkNotifier)
+        m_linkNotifier->setEnabled(false);
+    closeHandle();
 }
 
 
 void NetifPacketCapture::whetherDevChanged()
 {
-    if (m_devName.isEmpty()) {
+    if (m_devNames.isEmpty()) {
         m_changedDev = true;
         startNetifMonitorJob();
     } else {
-        QString current_dev = m_devName;
-        getCurrentDevName();
-        //若新增网卡设备优先级高于当前使用网卡设备,则重新开始监测任务
-        if (current_dev.compare(m_devName) != 0) {
+        //若新增网卡设备优先级高于当前使用网卡设备, 或抓包网卡增减, 则重新开始监测任务
+        if (captureDevices() != m_devNames) {
             m_changedDev = true;
             startNetifMonitorJob();
         }
@@ -76,374 +119,428 @@ void NetifPacketCapture::whetherDevChanged()
 
 bool NetifPacketCapture::hasDevIP()
 {
-    if (!m_devName.isEmpty()) {
-        return false;
-    }
-
-    struct sockaddr_in *addr {};
-    struct ifreq ifr {};
-    char *address {};
-    int sockfd;
     //设备名称过长
-    if (m_devName.size() >= IFNAMSIZ) {
-        //qDebug()<<"Device name too long! Invalid device Name!";
+    if (m_devName.isEmpty() || m_devName.size() >= IFNAMSIZ) {
         return false;
     }
 
-    strcpy(ifr.ifr_name, m_devName.toLocal8Bit().data());
-    //创建socket
-    sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    // interface addresses from getifaddrs, no socket & ioctl needed
+    NetIFAddrsMap addrsMap;
+    if (!readNetIfAddrs(addrsMap))
+        return false;
 
     //获取网络IP(IPv4)
-    if (ioctl(sockfd, SIOCGIFADDR, &ifr) == -1) {
-        close(sockfd);
-        //qDebug()<<"ioctl error!";
-        return false;
+    for (const NetIFAddr &ifaddr : addrsMap.values(m_devName)) {
+        if (ifaddr->family == AF_INET)
+            return true;
     }
+    return false;
+}
 
-    addr = (struct sockaddr_in *) & (ifr.ifr_addr);
-    address = inet_ntoa(addr->sin_addr);
-    if (address) {
-        close(sockfd);
-        //cout<<"IP of  "<<m_devName<<" :" <<address;
-        return true;
-    } else {
-        close(sockfd);
+bool NetifPacketCapture::getCurrentDevName()
+{
+    // route table is dumped once, then kept in sync by route change notifications
+    if (!m_routeWatcher) {
+        m_routeWatcher.reset(new RouteWatcher());
+    }
+    m_devName = m_routeWatcher->defaultDevice();
+
+    //无可用设备
+    if (m_devName.isEmpty()) {
         return false;
     }
+    return true;
+}
 
+void NetifPacketCapture::watchRoutes()
+{
+    if (m_routeNotifier)
+        return;
 
+    if (!m_routeWatcher) {
+        m_routeWatcher.reset(new RouteWatcher());
+    }
+    int fd = m_routeWatcher->fd();
+    if (fd < 0)
+        return;
+
+    m_routeNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_routeNotifier, &QSocketNotifier::activated, this, [this]() {
+        // 路由变更时判断使用网卡是否变更
+        if (m_routeWatcher->handleEvents())
+            whetherDevChanged();
+    });
 }
 
-bool NetifPacketCapture::getCurrentDevName()
+void NetifPacketCapture::watchLinks()
 {
-    QProcess process;
-    process.start("route", QStringList() << "-n");
-    process.waitForFinished(-1);
-    QString output = QString(process.readAllStandardOutput());
-    // 先区分换行符号
-    QStringList outputList = output.split("\n");
-    if (outputList.size() > 0)
-        outputList.removeFirst();
-    QList<QStringList> totalList;
-    foreach (QString tmpList, outputList) {
-        QStringList lineList = tmpList.split(QRegExp("\\s{1,}"));
-        totalList.append(lineList);
-    }
-    // 设备和优先级列编号
-    int metricColNum = 0;
-    int devColNum = 0;
-    QList<QPair<QString, int> > metricList = {};
-    QString devName = "";
-    if (totalList.size() > 0) {
-        QStringList firstLine = totalList[0];
-        for (int j = 0; j < firstLine.size(); j++) {
-            if (firstLine[j].compare("Metric", Qt::CaseInsensitive) == 0) {
-                metricColNum = j;
-            }
-            if (firstLine[j].compare("Iface", Qt::CaseInsensitive) == 0) {
-                devColNum = j;
-            }
+    // default route interface alone is judged on route changes
+    if (!m_captureAll) {
+        if (m_linkNotifier) {
+            // may be called from the notifier's own slot
+            m_linkNotifier->setEnabled(false);
+            m_linkNotifier->deleteLater();
+            m_linkNotifier = nullptr;
         }
+        m_linkWatcher.reset();
+        return;
     }
+    if (m_linkNotifier)
+        return;
 
-    if (totalList.size() > 0)
-        totalList.removeFirst();
-
-    for (int i = 0; i < totalList.size(); i++) {
-        auto list = totalList[i];
-        if (list.size() > devColNum && list.size() > metricColNum) {
-            // 默认网卡
-            if (!list.isEmpty() && list.first() == "0.0.0.0") {
-                metricList.clear();
-                metricList.append(QPair<QString, int>(list[devColNum], list[metricColNum].toInt()));
-                break;
-            } else {
-                metricList.append(QPair<QString, int>(list[devColNum], list[metricColNum].toInt()));
-            }
-        }
+    if (!m_linkWatcher) {
+        m_linkWatcher.reset(new LinkWatcher());
     }
-    int minMetric = 0;
-    QString perfectDev = "";
-    for (int i = 0; i < metricList.size(); i++) {
-        QPair<QString, int> pair = metricList[i];
-        if (i == 0) {
-            minMetric = pair.second;
-            perfectDev = pair.first;
-        } else {
-            if (minMetric > pair.second) {
-                minMetric = pair.second;
-                perfectDev = pair.first;
-            }
+    int fd = m_linkWatcher->fd();
+    if (fd < 0)
+        return;
+
+    m_linkNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_linkNotifier, &QSocketNotifier::activated, this, [this]() {
+        // interface went up/down or got/lost an address, set of captured interfaces may change
+        if (m_linkWatcher->handleEvents()) {
+            m_linkWatcher->takeChangedLinks();
+            m_linkWatcher->takeAddrChanged();
+            whetherDevChanged();
         }
-    }
-    m_devName = perfectDev;
+    });
+}
 
-    //无可用设备
-    if (m_devName.isEmpty()) {
-        return false;
+QStringList NetifPacketCapture::captureDevices()
+{
+    QStringList devices;
+
+    getCurrentDevName();
+    if (!m_devName.isEmpty())
+        devices << m_devName;
+    if (!m_captureAll)
+        return devices;
+
+    NetIFAddrsMap addrsMap;
+    readNetIfAddrs(addrsMap);
+    for (const QString &iface : addrsMap.uniqueKeys()) {
+        if (devices.size() >= PACKET_CAPTURE_MAX_HANDLES)
+            break;
+
+        // loopback packets have local sockets on both ends, which would count them twice
+        uint flags = addrsMap.value(iface)->flags;
+        if ((flags & (IFF_UP | IFF_RUNNING)) != (IFF_UP | IFF_RUNNING) || (flags & IFF_LOOPBACK))
+            continue;
+        if (!devices.contains(iface))
+            devices << iface;
     }
-    return true;
 
+    return devices;
 }
+
 //
 void NetifPacketCapture::startNetifMonitorJob()
 {
-    int rc = 0;
-    char errbuf[PCAP_ERRBUF_SIZE] {};
-
-    getCurrentDevName();
-    if (m_devName.isEmpty()) {
+    // restarted on device change, release captures of previous devices first
+    closeHandle();
+    // route change queued before quit request
+    if (m_quitRequested.load())
         return;
+    // device change is judged on route changes
+    watchRoutes();
+
+    m_captureAll = Settings::instance()->getOption(kSettingKeyCaptureAllInterfaces, false).toBool();
+    // other interfaces are captured too, judged on link & address changes as well
+    watchLinks();
+    m_devNames = captureDevices();
+
+    // tcp traffic from kernel counters needs neither packet copies nor capture privileges,
+    // fall back to capturing tcp as well if the counters are not available
+    m_tcpInfoAccounting = Settings::instance()->getOption(kSettingKeyTcpInfoAccounting, true).toBool();
+    if (m_tcpInfoAccounting && !m_tcpBytesSampled) {
+        m_tcpInfoAccounting = sampleTcpBytes();
+    }
+    if (m_tcpInfoAccounting) {
+        m_tcpInfoTimer->start();
+    } else {
+        m_tcpInfoTimer->stop();
     }
 
-    // create pcap handler
-    m_handle = pcap_create(m_devName.toLocal8Bit().data(), errbuf);
-    if (!m_handle) {
-        qDebug() << "pcap_create failed: " << errbuf;
+    for (const QString &devName : m_devNames) {
+        NetifCapture capture = openCapture(devName);
+        if (capture)
+            m_captures << capture;
+    }
+    if (m_captures.isEmpty()) {
         return;
     }
+    go = true;
 
-    // pcap_compile crashes everytime without any reason, need researching...
-#if 0
-    char pattern[] = 0111 "TCP and UDP";
-    struct bpf_program pgm;
+    // pcap handlers without selectable fd are polled with timer
+    for (const NetifCapture &capture : m_captures) {
+        if (!capture->notifier) {
+            m_timer->start();
+            break;
+        }
+    }
+}
 
-    rc = pcap_compile(m_handle, &pgm, pattern, 1, PCAP_NETMASK_UNKNOWN);
-    if (rc == -1) {
-        qDebug() << "pcap_compile failed: " << pcap_geterr(m_handle);
-        pcap_close(m_handle);
-        return;
+NetifCapture NetifPacketCapture::openCapture(const QString &devName)
+{
+    int rc = 0;
+    char errbuf[PCAP_ERRBUF_SIZE] {};
+
+    // create pcap handler
+    pcap_t *handle = pcap_create(devName.toLocal8Bit().data(), errbuf);
+    if (!handle) {
+        qDebug() << "pcap_create failed: " << errbuf;
+        return {};
     }
-    rc = pcap_setfilter(m_handle, &pgm);
-    if (rc == -1) {
-        qDebug() << "pcap_setfilter failed: " << pcap_geterr(m_handle);
-        pcap_close(m_handle);
-        return;
+
+    // capture headers only, parser takes payload size from packet length on wire
+    pcap_set_snaplen(handle, PACKET_CAPTURE_SNAPLEN);
+    // memory mapped (TPACKET_V3) ring buffer size, a small snaplen fits many more packets into it
+    int bufferSize = Settings::instance()->getOption(kSettingKeyCaptureBufferSize, PACKET_BUFFER_SIZE).toInt();
+    if (bufferSize > 0) {
+        pcap_set_buffer_size(handle, bufferSize * 1024);
     }
-#endif
+    // let kernel batch packets, we are woken up when a buffer block fills up or the timeout expires
+    pcap_set_immediate_mode(handle, 0);
+    pcap_set_timeout(handle, PACKET_BUFFER_TIMEOUT);
 
     // activate pcap handler
-    rc = pcap_activate(m_handle);
+    rc = pcap_activate(handle);
     if (rc > 0) {
-        qDebug() << "pcap_activate warning: " << pcap_statustostr(rc);
+        qDebug() << "pcap_activate warning: " << devName << pcap_statustostr(rc);
     } else if (rc < 0) {
-        qDebug() << "pcap_setnonblock failed: " << pcap_statustostr(rc);
-        pcap_close(m_handle);
-        return;
+        qDebug() << "pcap_activate failed: " << devName << pcap_statustostr(rc);
+        pcap_close(handle);
+        return {};
     }
 
-    // setm_timer->start(); non block dispatch mode
-    rc = pcap_setnonblock(m_handle, 1, errbuf);
+    // filter can only be compiled for an activated handler, as it depends on link type;
+    // capture goes on unfiltered if it fails, parser ignores unrelated packets anyway
+    struct bpf_program pgm;
+    const char *filter = m_tcpInfoAccounting ? PACKET_CAPTURE_FILTER_UDP : PACKET_CAPTURE_FILTER;
+    rc = pcap_compile(handle, &pgm, filter, 1, PCAP_NETMASK_UNKNOWN);
     if (rc == -1) {
-        pcap_close(m_handle);
-        return;
+        qDebug() << "pcap_compile failed: " << pcap_geterr(handle);
+    } else {
+        rc = pcap_setfilter(handle, &pgm);
+        if (rc == -1) {
+            qDebug() << "pcap_setfilter failed: " << pcap_geterr(handle);
+        }
+        pcap_freecode(&pgm);
     }
-    go = true;
-    m_timer->start();
+
+    // non block dispatch mode
+    rc = pcap_setnonblock(handle, 1, errbuf);
+    if (rc == -1) {
+        qDebug() << "pcap_setnonblock failed: " << errbuf;
+        pcap_close(handle);
+        return {};
+    }
+
+    auto capture = NetifCapture::create();
+    capture->job = this;
+    capture->devName = devName;
+    capture->handle = handle;
+    capture->batchCount = PACKET_DISPATCH_BATCH_COUNT;
+
+    // dispatch packets when pcap fd becomes readable, all interfaces share this thread's event loop
+    int fd = pcap_get_selectable_fd(handle);
+    if (fd >= 0) {
+        netif_capture_t *ctx = capture.data();
+        capture->notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        connect(capture->notifier, &QSocketNotifier::activated, this, [this, ctx]() {
+            if (m_quitRequested.load()) {
+                closeHandle();
+                return;
+            }
+            refreshCaches();
+            if (dispatchCapture(ctx)) {
+                // packets queued below half capacity are handled once the wakeup is done
+                m_netifMonitor->wakeConsumer();
+            }
+        });
+    }
+
+    // local addresses are refreshed on first dispatch
+    m_lastIfAddrsRefresh = 0;
+
+    return capture;
+}
+
+void NetifPacketCapture::closeCapture(const NetifCapture &capture)
+{
+    if (capture->notifier) {
+        // may be called from notifier's own activated signal
+        capture->notifier->setEnabled(false);
+        capture->notifier->deleteLater();
+        capture->notifier = nullptr;
+    }
+    if (capture->handle) {
+        pcap_close(capture->handle);
+        capture->handle = nullptr;
+    }
+}
+
+void NetifPacketCapture::closeHandle()
+{
+    go = false;
+    m_timer->stop();
+    for (const NetifCapture &capture : m_captures) {
+        closeCapture(capture);
+    }
+    m_captures.clear();
 }
 
 void pcap_callback(u_char *context, const struct pcap_pkthdr *hdr, const u_char *packet)
 {
-    QByteArray fmtbuf;
-    uint64_t hash {}, cchash[2] {};
-    QString pattern {};
 
     // packet payload calc
     if (!context)
         return;
 
-    // get monitor & monitor job instance from user context
-    auto *netifMonitorJob = reinterpret_cast<NetifPacketCapture *>(context);
+    // get interface capture & monitor job instance from user context
+    auto *capture = reinterpret_cast<netif_capture_t *>(context);
+    auto *netifMonitorJob = capture->job;
     Q_ASSERT(netifMonitorJob != nullptr);
-    auto *netifMonitor = netifMonitorJob->m_netifMonitor;
-    Q_ASSERT(netifMonitor != nullptr);
 
-    // parse packet & calculate payload
-    PacketPayload payload = QSharedPointer<struct packet_payload_t>::create();
-    auto ok = NetifPacketParser::parsePacket(hdr, packet, payload);
+    // parse packet in place into the next free slot of monitor's queue
+    PacketPayloadSpscRing &pending = netifMonitorJob->m_netifMonitor->m_pendingPackets;
+    packet_payload_t *payload = pending.back();
+    if (!payload) {
+        // monitor can't keep up, drop this packet instead of stalling capture
+        pending.drop();
+        return;
+    }
+    auto ok = NetifPacketParser::parsePacket(hdr, packet, *payload);
     if (!ok)
         return;
-    char dMac[256];
-    auto *eth_hdr = reinterpret_cast<const struct ether_header *>(packet);
-    sprintf(dMac, "%x:%x:%x:%x:%x:%x", (eth_hdr->ether_dhost)[0], (eth_hdr->ether_dhost)[1],
-            (eth_hdr->ether_dhost)[2], (eth_hdr->ether_dhost)[3],
-            (eth_hdr->ether_dhost)[4], (eth_hdr->ether_dhost)[5]);
-    // calc hash from caputured packet's src:sport-dest:dport
-    if (payload->sa_family == AF_INET) {
-        // ipv4 packet payload
-        char saddr_str[INET_ADDRSTRLEN + 1] {}, daddr_str[INET_ADDRSTRLEN + 1] {};
-        // convert ipv4 source & destination address to string format
-        inet_ntop(AF_INET, &payload->s_addr.in4, saddr_str, INET_ADDRSTRLEN);
-        inet_ntop(AF_INET, &payload->d_addr.in4, daddr_str, INET_ADDRSTRLEN);
-
-        // pattern that matches kernel sock stat table
-        pattern = QString("%1:%2-%3:%4").arg(saddr_str).arg(payload->s_port).arg(daddr_str).arg(payload->d_port);
-        uint64_t saddr_hpair[2] {}, daddr_hpair[2] {};
-        // generate source address hash
-        util::common::hash(saddr_str, int(strlen(saddr_str)), util::common::global_seed, saddr_hpair);
-        // generate destination address hash
-        util::common::hash(daddr_str, int(strlen(daddr_str)), util::common::global_seed, daddr_hpair);
-        if (netifMonitorJob->m_ifaddrsHashCache.contains(saddr_hpair[0])) {
-            payload->direction = kOutboundPacket;
-        } else if (netifMonitorJob->m_ifaddrsHashCache.contains(daddr_hpair[0])) {
-            payload->direction = kInboundPacket;
-        } else {
-            return;
-        }
-
-    } else if (payload->sa_family == AF_INET6) {
-        // ipv6 packet payload
-        char saddr6_str[INET6_ADDRSTRLEN + 1] {}, daddr6_str[INET6_ADDRSTRLEN + 1] {};
-        inet_ntop(AF_INET6, &payload->s_addr.in6, saddr6_str, INET6_ADDRSTRLEN);
-        inet_ntop(AF_INET6, &payload->d_addr.in6, daddr6_str, INET6_ADDRSTRLEN);
-
-        // pattern that matches kernel sock stat table
-        pattern = QString("%1:%2-%3:%4").arg(saddr6_str).arg(payload->s_port).arg(daddr6_str).arg(payload->d_port);
-        uint64_t saddr6_hpair[2] {}, daddr6_hpair[2] {};
-        // generate source address hash
-        util::common::hash(saddr6_str, int(strlen(saddr6_str)), util::common::global_seed, saddr6_hpair);
-        // generate destination address hash
-        util::common::hash(daddr6_str, int(strlen(daddr6_str)), util::common::global_seed, daddr6_hpair);
-        if (netifMonitorJob->m_ifaddrsHashCache.contains(saddr6_hpair[0])) {
-            payload->direction = kOutboundPacket;
-        } else if (netifMonitorJob->m_ifaddrsHashCache.contains(daddr6_hpair[0])) {
-            payload->direction = kInboundPacket;
-        } else {
-            return;
-        }
+    // tcp is accounted from tcp_info already, in case capture filter could not be set
+    if (payload->proto == IPPROTO_TCP && netifMonitorJob->m_tcpInfoAccounting)
+        return;
 
+    // packet direction from addresses of the capturing interface
+    if (capture->localAddrs.contains(payload->sa_family, &payload->s_addr)) {
+        payload->direction = kOutboundPacket;
+    } else if (capture->localAddrs.contains(payload->sa_family, &payload->d_addr)) {
+        payload->direction = kInboundPacket;
     } else {
-        // unexpected here
+        return;
     }
 
-    fmtbuf = pattern.toLocal8Bit();
-    util::common::hash(fmtbuf.constData(), fmtbuf.length(), util::common::global_seed, cchash);
-    hash = cchash[0];
+    // flow key that matches kernel sock stat table
+    const sock_flow_key_t key = sockFlowKey(payload->sa_family, int(payload->proto),
+                                            &payload->s_addr, payload->s_port,
+                                            &payload->d_addr, payload->d_port);
     // get ino from map
-    if (netifMonitorJob->m_sockStats.contains(hash)) {
-        QMultiMap<uint64_t, SockStat>::const_iterator it = netifMonitorJob->m_sockStats.find(hash);
-        while (it != netifMonitorJob->m_sockStats.cend() && it.key() == hash) {
-            // TODO: UDP traffic identify method refine
-            // UDP socks may have same kernel hash slot (sl: hash generated with same src:port + dest:port),
-            // which means there's no way to distinguish which packet sent/received by which socket, what
-            // makes it very tricky to get the real UDP traffic for specific process, we assume
-            // socks with same sl are created by same process for temporary, need a much fine way to
-            // distinguish the traffic at a later time.
-            payload->ino = it.value()->ino;
-            break;
-        }
+    SockStatMap::const_iterator it = netifMonitorJob->m_sockStats.constFind(key);
+    if (it != netifMonitorJob->m_sockStats.cend()) {
+        // TODO: UDP traffic identify method refine
+        // UDP socks may share the same src:port + dest:port, which means there's no way to distinguish
+        // which packet sent/received by which socket, what makes it very tricky to get the real UDP
+        // traffic for specific process, we assume such socks are created by same process for temporary,
+        // need a much fine way to distinguish the traffic at a later time.
+        payload->ino = it.value()->ino;
     } else {
         // no matching sockets in /proc tcp/udp table, which means we cant grab inode from socket table,
         // the only thing we can do here is ignore this packet.
         return;
     }
-    netifMonitorJob->m_localPendingPackets.enqueue(payload);
-    auto npkts = netifMonitorJob->m_localPendingPackets.size();
-    if (npkts >= PACKET_DISPATCH_QUEUE_LWAT && npkts < PACKET_DISPATCH_QUEUE_HWAT) {
-        // if dispatch queue is between low & high water mark, then we can just use try lock in relax way
-        if (netifMonitor->m_pktqLock.tryLock()) {
-            netifMonitor->m_pendingPackets.append(netifMonitorJob->m_localPendingPackets);
-            netifMonitor->m_pktqLock.unlock();
-
-            // clear local pending queue after move packets to monitor instance's queue
-            netifMonitorJob->m_localPendingPackets.clear();
-
-            netifMonitor->m_pktqWatcher.wakeAll();
-        }
-    } else if (npkts >= PACKET_DISPATCH_QUEUE_HWAT) {
-        // otherwise we forcefully use lock instead
-        netifMonitor->m_pktqLock.lock();
-        netifMonitor->m_pendingPackets.append(netifMonitorJob->m_localPendingPackets);
-        netifMonitor->m_pktqLock.unlock();
-
-        // clear local pending queue after move packets to monitor instance's queue
-        netifMonitorJob->m_localPendingPackets.clear();
-
-        netifMonitor->m_pktqWatcher.wakeAll();
-    }
+    // wake monitor up early if queue fills up within one dispatch
+    if (pending.push() == pending.capacity() / 2)
+        netifMonitorJob->m_netifMonitor->wakeConsumer();
 }
 
 // dispatch packet handler
 void NetifPacketCapture::dispatchPackets()
 {
-    usleep(20000);
     if (!go) return;
     //无可用设备
-    if (m_devName.isEmpty()) return;
-    // check pending packets before dispatching packets
-    auto npkts = m_localPendingPackets.size();
-    if (npkts > 0) {
-        if (npkts >= PACKET_DISPATCH_QUEUE_LWAT && npkts < PACKET_DISPATCH_QUEUE_HWAT) {
-            // pending packets between low & high water mark
-            if (m_netifMonitor->m_pktqLock.tryLock()) {
-                m_netifMonitor->m_pendingPackets.append(m_localPendingPackets);
-                m_netifMonitor->m_pktqLock.unlock();
-
-                m_netifMonitor->m_pktqWatcher.wakeAll();
-
-                m_localPendingPackets.clear();
-            }
-        } else if (npkts >= PACKET_DISPATCH_QUEUE_HWAT) {
-            // acquire lock forcefully if too many packets pending
-            m_netifMonitor->m_pktqLock.lock();
-            m_netifMonitor->m_pendingPackets.append(m_localPendingPackets);
-            m_netifMonitor->m_pktqLock.unlock();
+    if (m_captures.isEmpty()) return;
 
-            m_netifMonitor->m_pktqWatcher.wakeAll();
+    // quit requested, stop capturing then
+    if (m_quitRequested.load()) {
+        closeHandle();
+        return;
+    }
 
-            m_localPendingPackets.clear();
-        }
+    refreshCaches();
+
+    bool polled = false;
+    // copy, failed captures are removed while iterating
+    const QVector<NetifCapture> captures = m_captures;
+    for (const NetifCapture &capture : captures) {
+        if (!dispatchCapture(capture.data()))
+            continue;
+        polled = polled || !capture->notifier;
     }
 
-    time_t last_sockstat {};
-    time_t last_ifaddrs_refresh {};
+    // packets queued below half capacity are handled once the wakeup is done
+    m_netifMonitor->wakeConsumer();
 
-    do {
-        usleep(20000);
-        // quit requested, break the loop then
-        auto quit = m_quitRequested.load();
-        if (quit) {
-            m_timer->stop();
-            break;
-        }
-        // refresh m_sockStat cache every 2 seconds
-        time_t now = time(nullptr);
-        if (!last_sockstat || (now - last_sockstat) >= SOCKSTAT_REFRESH_INTERVAL) {
-            m_sockStats.clear();
-            SysInfo::readSockStat(m_sockStats);
-            last_sockstat = now;
-        }
+    if (polled) {
+        // no packets are available, idle this loop for a fraction second
+        m_timer->start(PACKET_DISPATCH_IDLE_TIME);
+    }
+}
 
-        // refresh m_ifaddrsHashCache every 10 seconds in case user change ip address on the fly
-        if (!last_ifaddrs_refresh || (now - last_ifaddrs_refresh) >= IFADDRS_HASH_CACHE_REFRESH_INTERVAL) {
-            refreshIfAddrsHashCache();
-            last_ifaddrs_refresh = now;
-        }
+bool NetifPacketCapture::dispatchCapture(netif_capture_t *capture)
+{
+    if (!capture->handle)
+        return false;
 
-        // start packet dispatching
-        auto nr = pcap_dispatch(m_handle,
-                                PACKET_DISPATCH_BATCH_COUNT,
+    // drain capture buffer, batch size grows while backlog remains and shrinks back once caught up;
+    // return to event loop after a while, the notifier fires again right away if packets are left
+    int total = 0;
+    while (total < PACKET_DISPATCH_WAKEUP_MAX) {
+        auto nr = pcap_dispatch(capture->handle,
+                                capture->batchCount,
                                 pcap_callback,
-                                reinterpret_cast<u_char *>(this));
-        if (nr == 0) {
-            // no packets are available, idle this loop for a fraction second
-            m_timer->start(PACKET_DISPATCH_IDLE_TIME);
-            return;
-        } else if (nr == -1) {
-            // error occurred while processing packets
-            qDebug() << "pcap_dispatch failed: " << pcap_geterr(m_handle);
-            m_timer->stop();
-            break;
-        } else if (nr == -2) {
-            // breakloop requested (can only happen inside the callbackm_localPendingPackets function)
-            m_timer->stop();
+                                reinterpret_cast<u_char *>(capture));
+        if (nr < 0) {
+            // error occurred while processing packets, e.g. interface removed,
+            // or breakloop requested (can only happen inside the callback function)
+            if (nr == -1)
+                qDebug() << "pcap_dispatch failed: " << capture->devName << pcap_geterr(capture->handle);
+
+            for (int i = 0; i < m_captures.size(); ++i) {
+                if (m_captures[i].data() == capture) {
+                    closeCapture(m_captures[i]);
+                    m_captures.remove(i);
+                    break;
+                }
+            }
+            return false;
+        }
+
+        total += nr;
+        if (nr < capture->batchCount) {
+            capture->batchCount = qMax(capture->batchCount / 2, PACKET_DISPATCH_BATCH_COUNT);
             break;
         }
-    } while (true);
+        capture->batchCount = qMin(capture->batchCount * 2, PACKET_DISPATCH_BATCH_MAX);
+    }
 
-    // close pcap handle
-    pcap_close(m_handle);
+    return true;
+}
+
+void NetifPacketCapture::refreshCaches()
+{
+    // refresh m_sockStat cache every 2 seconds
+    time_t now = time(nullptr);
+    if (!m_lastSockStatRefresh || (now - m_lastSockStatRefresh) >= SOCKSTAT_REFRESH_INTERVAL) {
+        m_sockStats.clear();
+        SysInfo::readSockStat(m_sockStats);
+        m_lastSockStatRefresh = now;
+        // connections view reads the same table, copy is shared until next refresh
+        m_netifMonitor->setSockStats(m_sockStats, now);
+
+        updateCaptureStat();
+    }
+
+    // refresh local addresses every 10 seconds in case user change ip address on the fly
+    if (!m_lastIfAddrsRefresh || (now - m_lastIfAddrsRefresh) >= IFADDRS_CACHE_REFRESH_INTERVAL) {
+        refreshLocalAddrs();
+        m_lastIfAddrsRefresh = now;
+    }
 }
 
 bool readNetIfAddrs(NetIFAddrsMap &addrsMap)
@@ -462,6 +559,7 @@ bool readNetIfAddrs(NetIFAddrsMap &addrsMap)
 
         auto netifAddr = QSharedPointer<struct net_ifaddr_t>::create();
         netifAddr->family = addr_p->ifa_addr->sa_family;
+        netifAddr->flags = addr_p->ifa_flags;
         if (netifAddr->family == AF_INET) {
             netifAddr->addr.in4 = reinterpret_cast<struct sockaddr_in *>(addr_p->ifa_addr)->sin_addr;
         } else if (netifAddr->family == AF_INET6) {
@@ -481,40 +579,80 @@ bool readNetIfAddrs(NetIFAddrsMap &addrsMap)
         return false;
 }
 
-// refresh network interface hash cache
-void NetifPacketCapture::refreshIfAddrsHashCache()
+bool NetifPacketCapture::sampleTcpBytes()
+{
+    if (!m_sockDiag) {
+        m_sockDiag.reset(new SockDiag());
+    }
+
+    SockBytesMap bytes;
+    bytes.reserve(m_tcpBytes.size());
+    if (!m_sockDiag->readTcpBytes(AF_INET, bytes) || !m_sockDiag->readTcpBytes(AF_INET6, bytes))
+        return false;
+
+    // first sample is the baseline, traffic before monitoring started is not accounted
+    if (m_tcpBytesSampled) {
+        QHash<ino_t, sock_io_stat_t> deltas;
+        diffSockBytes(m_tcpBytes, bytes, deltas);
+        if (!deltas.isEmpty())
+            m_netifMonitor->addSockIOStats(deltas);
+    }
+    m_tcpBytes.swap(bytes);
+    m_tcpBytesSampled = true;
+
+    return true;
+}
+
+void NetifPacketCapture::diffSockBytes(const SockBytesMap &prev, const SockBytesMap &cur, QHash<ino_t, sock_io_stat_t> &deltas)
+{
+    for (auto it = cur.cbegin(); it != cur.cend(); ++it) {
+        sock_bytes_t base {};
+        auto pit = prev.constFind(it.key());
+        if (pit != prev.cend() && pit->rx_bytes <= it->rx_bytes && pit->tx_bytes <= it->tx_bytes)
+            base = pit.value();
+
+        if (it->rx_bytes == base.rx_bytes && it->tx_bytes == base.tx_bytes)
+            continue;
+
+        sock_io_stat_t &stat = deltas[it.key()];
+        stat.ino = it.key();
+        stat.rx_bytes = it->rx_bytes - base.rx_bytes;
+        stat.tx_bytes = it->tx_bytes - base.tx_bytes;
+        // segment counters are 32bit & wrap around, unsigned difference handles that
+        stat.rx_packets = quint32(it->rx_segs - base.rx_segs);
+        stat.tx_packets = quint32(it->tx_segs - base.tx_segs);
+    }
+}
+
+// publish kernel capture counters of captured devices
+void NetifPacketCapture::updateCaptureStat()
+{
+    QMap<QString, capture_stat_t> stats;
+    for (const NetifCapture &capture : m_captures) {
+        struct pcap_stat ps {};
+        if (pcap_stats(capture->handle, &ps) == -1)
+            continue;
+
+        capture_stat_t &stat = stats[capture->devName];
+        stat.recv_packets = ps.ps_recv;
+        stat.dropped_packets = ps.ps_drop + ps.ps_ifdrop;
+    }
+    m_netifMonitor->setCaptureStats(stats);
+}
+
+// refresh local interface address cache
+void NetifPacketCapture::refreshLocalAddrs()
 {
     NetIFAddrsMap addrsMap;
 
     // get network interface map
     auto ok = readNetIfAddrs(addrsMap);
     if (ok) {
-        NetIFAddrsMap::const_iterator it = addrsMap.constBegin();
-        // process each address in map
-        while (it != addrsMap.constEnd()) {
-            auto ifaddr = it.value();
-
-            uint64_t ifaddr_hash[2] {};
-            if (ifaddr->family == AF_INET) {
-                char addr_str[INET_ADDRSTRLEN + 1] {};
-                // convert to ipv4 format string
-                inet_ntop(AF_INET, &ifaddr->addr.in4, addr_str, INET_ADDRSTRLEN);
-
-                // calculate hash
-                util::common::hash(addr_str, int(strlen(addr_str)), util::common::global_seed, ifaddr_hash);
-                m_ifaddrsHashCache[ifaddr_hash[0]] = 0;
-
-            } else if (ifaddr->family == AF_INET6) {
-                char addr6_str[INET6_ADDRSTRLEN + 1] {};
-                // convert to ipv6 format string
-                inet_ntop(AF_INET6, &ifaddr->addr.in6, addr6_str, INET6_ADDRSTRLEN);
-
-                // calculate hash
-                util::common::hash(addr6_str, int(strlen(addr6_str)), util::common::global_seed, ifaddr_hash);
-                m_ifaddrsHashCache[ifaddr_hash[0]] = 0;
+        for (const NetifCapture &capture : m_captures) {
+            capture->localAddrs.clear();
+            for (const NetIFAddr &ifaddr : addrsMap.values(capture->devName)) {
+                capture->localAddrs.insert(ifaddr->family, &ifaddr->addr);
             }
-
-            ++it;
         }
     }
 }
@@ -8,28 +8,51 @@
 
 #include <QObject>
 #include "packet.h"
+#include "sock_diag.h"
 #include <QTimer>
 #include <QMap>
+#include <QStringList>
 #include <unistd.h>
 
+#include <memory>
+
+class QSocketNotifier;
 
 namespace core {
 namespace system {
 class NetifMonitor;
+class NetifPacketCapture;
+class RouteWatcher;
+class LinkWatcher;
+struct sock_io_stat_t;
+
+/**
+ * @brief Capture state of one network interface
+ */
+struct netif_capture_t {
+    NetifPacketCapture *job {};     // owner capture job
+    QString devName {};             // interface name
+    pcap_t *handle {};              // pcap handler instance
+    QSocketNotifier *notifier {};   // pcap selectable fd watcher
+    LocalAddrSet localAddrs {};     // addresses of this interface
+    int batchCount {};              // packets per pcap_dispatch call, adapts to backlog
+};
+using NetifCapture = QSharedPointer<struct netif_capture_t>;
+
 class NetifPacketCapture : public QObject
 {
     Q_OBJECT
 public:
     explicit NetifPacketCapture(NetifMonitor *netInfmontor, QObject *parent = nullptr);
-    inline void requestQuit()
-    {
-        m_quitRequested.store(true);
-    }
+    ~NetifPacketCapture();
+    /**
+     * @brief Request capture to stop, handlers are closed from this job's own event loop
+     */
+    void requestQuit();
     /**
-     * @brief Packet dispatch handler
+     * @brief Packet dispatch handler of all captured interfaces
      */
     void dispatchPackets();
-    pcap_t  *getHandle() { return m_handle;}
 
 
 protected:
@@ -42,6 +65,25 @@ protected:
      * @brief 判断当前网卡是否被分配可用网络IP(IPv4)
      */
     bool hasDevIP();
+    /**
+     * @brief Interfaces to capture on, default route interface first
+     *
+     * Only the default route interface unless capture on all interfaces is enabled,
+     * then every up & running interface with an address except loopback, at most
+     * PACKET_CAPTURE_MAX_HANDLES of them.
+     */
+    QStringList captureDevices();
+    /**
+     * @brief Sample tcp_info counters of all tcp sockets & publish the change since last sample
+     * @return false if counters can not be read, tcp traffic must be captured then
+     */
+    bool sampleTcpBytes();
+    /**
+     * @brief Per inode change of socket counters between two samples
+     *
+     * Sockets new in cur count from zero, counters going backwards mean the inode was reused.
+     */
+    static void diffSockBytes(const SockBytesMap &prev, const SockBytesMap &cur, QHash<ino_t, sock_io_stat_t> &deltas);
 signals:
 
 public slots:
@@ -55,41 +97,99 @@ public slots:
      */
     void whetherDevChanged();
 
-private:
+private slots:
+    /**
+     * @brief Stop capturing on quit request, whether or not any packet arrives afterwards
+     */
+    void onQuitRequested();
 
+private:
+    /**
+     * @brief Call whetherDevChanged whenever routes change
+     */
+    void watchRoutes();
+    /**
+     * @brief Call whetherDevChanged whenever links or addresses change, capture-all mode only
+     */
+    void watchLinks();
+    /**
+     * @brief Open & activate pcap handler of interface
+     * @return Capture of interface, null if interface can not be captured
+     */
+    NetifCapture openCapture(const QString &devName);
+    /**
+     * @brief Stop dispatching & close pcap handler of one interface
+     */
+    void closeCapture(const NetifCapture &capture);
+    /**
+     * @brief Stop dispatching & close pcap handlers of all interfaces
+     */
+    void closeHandle();
+    /**
+     * @brief Dispatch packets of one interface
+     * @return false if capture failed & was closed
+     */
+    bool dispatchCapture(netif_capture_t *capture);
+    /**
+     * @brief Refresh socket table & local addresses when they are due
+     */
+    void refreshCaches();
+    /**
+     * @brief Publish pcap_stats counters to monitor
+     */
+    void updateCaptureStat();
     /**
-     * @brief Refresh network interface address hash cache
+     * @brief Refresh local network interface address cache
      */
-    void refreshIfAddrsHashCache();
+    void refreshLocalAddrs();
 
 
 private:
     // socket io stat cache
     SockStatMap     m_sockStats {};
-    // network interface name hash cache
-    QMap<uint64_t, int> m_ifaddrsHashCache; // key: hash code generated from ifaddr; value: not used
 
     // network interface monitor
     NetifMonitor       *m_netifMonitor         {};
-    // pcap handler instance
-    pcap_t             *m_handle               {};
-    // local pending packet queue
-    PacketPayloadQueue  m_localPendingPackets  {};
+    // captured interfaces
+    QVector<NetifCapture> m_captures           {};
+    // last time m_sockStats & local addresses refreshed
+    time_t              m_lastSockStatRefresh  {};
+    time_t              m_lastIfAddrsRefresh   {};
 
     // request quit atomic flag
     std::atomic_bool m_quitRequested {false};
     bool go {false};
-    // packet dispatch timer
+    // packet dispatch timer, used only if pcap has no selectable fd
     QTimer *m_timer {};
 
     //是否变更网卡
     bool m_changedDev {false}; 
     //当前使用网卡名
     QString m_devName {};
+    // capture on all interfaces instead of default route interface only
+    bool m_captureAll {false};
+    // interfaces requested on last start
+    QStringList m_devNames {};
     //当前系统所有网卡设备链表
     pcap_if_t *m_alldevs {};
-    //判断网卡是否变更定时器
-    QTimer *m_timerChangeDev {};
+    // route table cache, default route interface is picked from
+    std::unique_ptr<RouteWatcher> m_routeWatcher;
+    // route change notification watcher
+    QSocketNotifier *m_routeNotifier {};
+    // link & address cache, interfaces come up or get an address without any route change
+    std::unique_ptr<LinkWatcher> m_linkWatcher;
+    // link & address change notification watcher
+    QSocketNotifier *m_linkNotifier {};
+    // tcp traffic accounted from tcp_info, only udp is captured then
+    bool m_tcpInfoAccounting {false};
+    // sock_diag socket of tcp_info sampling
+    std::unique_ptr<SockDiag> m_sockDiag;
+    // tcp_info counters of last sample
+    SockBytesMap m_tcpBytes {};
+    // whether m_tcpBytes holds a sample yet
+    bool m_tcpBytesSampled {false};
+    // tcp_info sample timer
+    QTimer *m_tcpInfoTimer {};
     friend void pcap_callback(u_char *, const struct pcap_pkthdr *, const u_char *);
 
 };
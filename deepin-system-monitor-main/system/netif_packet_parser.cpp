@@ -38,19 +38,40 @@ bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
     if (!payload) {
         payload = QSharedPointer<struct packet_payload_t>::create();
     }
-    payload->ts = pkt_hdr->ts;
+    return parsePacket(pkt_hdr, packet, *payload);
+}
+
+bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
+                                    const u_char *packet,
+                                    packet_payload_t &payload)
+{
+    payload.ts = pkt_hdr->ts;
+    // headers are read from the captured bytes, while payload size is calculated from the length
+    // on wire, capture snaplen may cut the packet right after the headers
+    const u_char *end = packet + pkt_hdr->caplen;
     const u_char *hdr = packet;
+    auto eth_hdr_len = sizeof(struct ether_header);
+    // truncated packets
+    if (pkt_hdr->caplen < eth_hdr_len) {
+        return false;
+    }
     // parse hdr&packet
     auto *eth_hdr = reinterpret_cast<const struct ether_header *>(packet);
     auto type = ntohs(eth_hdr->ether_type);
-    auto eth_hdr_len = sizeof(struct ether_header);
     uint proto {};
     ulong ip_hdr_len {};
 
     if (type == ETHERTYPE_IP) {
         auto *ip_hdr = reinterpret_cast<const struct ip *>(packet + eth_hdr_len);
-        // ip header length
+        // truncated packets
+        if (pkt_hdr->caplen < eth_hdr_len + sizeof(struct ip)) {
+            return false;
+        }
+        // ip header length, less than the 20 bytes of fixed header on malformed packets only
         ip_hdr_len = ulong((ip_hdr->ip_hl & 0x0f) * 4);
+        if (ip_hdr_len < sizeof(struct ip)) {
+            return false;
+        }
         // ip payload
         hdr = packet + eth_hdr_len + ip_hdr_len;
         // protocol
@@ -61,13 +82,17 @@ bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
             return false;
         }
 
-        payload->sa_family = AF_INET;
-        payload->proto = proto;
-        payload->s_addr.in4 = ip_hdr->ip_src;
-        payload->d_addr.in4 = ip_hdr->ip_dst;
+        payload.sa_family = AF_INET;
+        payload.proto = proto;
+        payload.s_addr.in4 = ip_hdr->ip_src;
+        payload.d_addr.in4 = ip_hdr->ip_dst;
 
     } else if (type == ETHERTYPE_IPV6) {
         auto *ip6_hdr = reinterpret_cast<const struct ip6_hdr *>(packet + eth_hdr_len);
+        // truncated packets
+        if (pkt_hdr->caplen < eth_hdr_len + sizeof(struct ip6_hdr)) {
+            return false;
+        }
 
         // next header field in ip6 header
         uint8_t nhtype = ip6_hdr->ip6_nxt;
@@ -75,6 +100,10 @@ bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
         hdr = packet + eth_hdr_len + sizeof(struct ip6_hdr);
         bool stop {false};
         while (!stop) {
+            // extension headers are at least 8 bytes, stop if truncated by snaplen
+            if (hdr + 8 > end) {
+                return false;
+            }
             switch (nhtype) {
             case  IP6_NEXT_HEADER_HBH: {
                 // Hop-by-Hop Options Header
@@ -146,29 +175,41 @@ bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
             } // !switch
         } // !while
 
-        payload->sa_family = AF_INET6;
-        payload->proto = proto;
-        payload->s_addr.in6 = ip6_hdr->ip6_src;
-        payload->d_addr.in6 = ip6_hdr->ip6_dst;
+        payload.sa_family = AF_INET6;
+        payload.proto = proto;
+        payload.s_addr.in6 = ip6_hdr->ip6_src;
+        payload.d_addr.in6 = ip6_hdr->ip6_dst;
 
     } else {
         // ignore non ip4 & ip6 packets
         return false;
     }
 
+    // offset of upper-layer protocol header
+    auto l4_off = ulong(hdr - packet);
+
     if (proto == IPPROTO_TCP) {
         auto *tcp_hdr = reinterpret_cast<const struct tcphdr *>(hdr);
-        auto tcp_hdr_len = ulong(((tcp_hdr->th_off & 0xf0) >> 4) * 4);
+        // truncated packets
+        if (hdr + sizeof(struct tcphdr) > end) {
+            return false;
+        }
+        // data offset in 32bit words
+        auto tcp_hdr_len = ulong(tcp_hdr->th_off * 4);
         // no payload data
-        if (pkt_hdr->caplen <= eth_hdr_len + ip_hdr_len + tcp_hdr_len) {
+        if (pkt_hdr->len <= l4_off + tcp_hdr_len) {
             return false;
         }
-        payload->payload = pkt_hdr->caplen - eth_hdr_len - ip_hdr_len - tcp_hdr_len;
-        payload->s_port = ntohs(tcp_hdr->th_sport);
-        payload->d_port = ntohs(tcp_hdr->th_dport);
+        payload.payload = pkt_hdr->len - l4_off - tcp_hdr_len;
+        payload.s_port = ntohs(tcp_hdr->th_sport);
+        payload.d_port = ntohs(tcp_hdr->th_dport);
 
     } else if (proto == IPPROTO_UDP) {
         auto *udp_hdr = reinterpret_cast<const struct udphdr *>(hdr);
+        // truncated packets
+        if (hdr + sizeof(struct udphdr) > end) {
+            return false;
+        }
         auto udp_len = ulong(ntohs(udp_hdr->uh_ulen));
         auto udp_hdr_len = sizeof(struct udphdr);
         ulong ulen {};
@@ -182,13 +223,13 @@ bool NetifPacketParser::parsePacket(const pcap_pkthdr *pkt_hdr,
         } else {
             ulen = udp_hdr_len;
         }
-        // truncated, no payload data
-        if (pkt_hdr->caplen <= eth_hdr_len + ip_hdr_len + ulen) {
+        // no payload data
+        if (pkt_hdr->len <= l4_off + ulen) {
             return false;
         }
-        payload->payload = pkt_hdr->caplen - eth_hdr_len - ip_hdr_len - ulen;
-        payload->s_port = ntohs(udp_hdr->uh_sport);
-        payload->d_port = ntohs(udp_hdr->uh_dport);
+        payload.payload = pkt_hdr->len - l4_off - ulen;
+        payload.s_port = ntohs(udp_hdr->uh_sport);
+        payload.d_port = ntohs(udp_hdr->uh_dport);
 
     } else {
         // unexpected case, unknown proto type
@@ -17,6 +17,13 @@ public:
     static bool parsePacket(const struct pcap_pkthdr *pkt_hdr,
                             const u_char *packet,
                             PacketPayload &payload);
+    /**
+     * @brief parsePacket Parse packet into a preallocated payload record
+     * @return false if packet carries no tcp/udp payload, record content is undefined then
+     */
+    static bool parsePacket(const struct pcap_pkthdr *pkt_hdr,
+                            const u_char *packet,
+                            packet_payload_t &payload);
 
 
 private:
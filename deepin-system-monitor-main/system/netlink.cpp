@@ -13,11 +13,36 @@
 #include <netlink/netlink.h>
 #include <netlink/route/link.h>
 #include <netlink/route/addr.h>
+#include <netlink/route/route.h>
 #include <netlink/cache.h>
 
+#include <net/if.h>
+
 namespace core {
 namespace system {
 
+namespace {
+
+// dump cache of a cache manager again after notifications got lost, manager socket is non-blocking
+// & receives notifications, so a socket of its own is used
+void resyncCache(struct nl_cache *cache, change_func_t cb, void *data)
+{
+    struct nl_sock *sock = nl_socket_alloc();
+    if (!sock) {
+        qWarning() << "Error: nl_socket_alloc failed";
+        return;
+    }
+
+    int rc = nl_connect(sock, NETLINK_ROUTE);
+    if (rc == 0)
+        rc = nl_cache_resync(sock, cache, cb, data);
+    if (rc < 0)
+        qWarning() << "Error: nl_cache_resync failed:" << nl_geterror(rc);
+    nl_socket_free(sock);
+}
+
+} // namespace
+
 Netlink::Netlink()
 {
     int rc = 0;
@@ -64,5 +89,227 @@ AddrIterator Netlink::addrIterator()
     return it;
 }
 
+LinkWatcher::LinkWatcher()
+    : m_sock(nullptr)
+    , m_mngr(nullptr)
+    , m_linkCache(nullptr)
+    , m_addrCache(nullptr)
+    , m_addrChanged(true)
+{
+    int rc = 0;
+    m_sock = nl_socket_alloc();
+    if (!m_sock) {
+        qWarning() << "Error: nl_socket_alloc failed";
+        return;
+    }
+
+    rc = nl_cache_mngr_alloc(m_sock, NETLINK_ROUTE, 0, &m_mngr);
+    if (rc < 0) {
+        qWarning() << "Error: nl_cache_mngr_alloc failed:" << nl_geterror(rc);
+        return;
+    }
+
+    // initial dumps, route/addr subscribes to both IPv4 & IPv6 address groups
+    rc = nl_cache_mngr_add(m_mngr, "route/link", &LinkWatcher::linkChanged, this, &m_linkCache);
+    if (rc < 0) {
+        qWarning() << "Error: nl_cache_mngr_add route/link failed:" << nl_geterror(rc);
+        m_linkCache = nullptr;
+        return;
+    }
+    rc = nl_cache_mngr_add(m_mngr, "route/addr", &LinkWatcher::addrChanged, this, &m_addrCache);
+    if (rc < 0) {
+        qWarning() << "Error: nl_cache_mngr_add route/addr failed:" << nl_geterror(rc);
+        m_addrCache = nullptr;
+    }
+}
+
+LinkWatcher::~LinkWatcher()
+{
+    // frees caches as well
+    if (m_mngr)
+        nl_cache_mngr_free(m_mngr);
+    if (m_sock)
+        nl_socket_free(m_sock);
+}
+
+int LinkWatcher::fd() const
+{
+    return isValid() ? nl_cache_mngr_get_fd(m_mngr) : -1;
+}
+
+bool LinkWatcher::handleEvents()
+{
+    if (!isValid())
+        return false;
+
+    int rc = nl_cache_mngr_data_ready(m_mngr);
+    if (rc < 0) {
+        // notifications lost (ENOBUFS), dump again & treat everything as changed
+        qWarning() << "Error: nl_cache_mngr_data_ready failed:" << nl_geterror(rc);
+        resyncCache(m_linkCache, nullptr, nullptr);
+        resyncCache(m_addrCache, nullptr, nullptr);
+        for (auto *obj = nl_cache_get_first(m_linkCache); obj; obj = nl_cache_get_next(obj))
+            m_changedLinks.insert(rtnl_link_get_ifindex(reinterpret_cast<struct rtnl_link *>(obj)));
+        m_addrChanged = true;
+    }
+
+    return !m_changedLinks.isEmpty() || m_addrChanged;
+}
+
+QSet<int> LinkWatcher::takeChangedLinks()
+{
+    QSet<int> links;
+    links.swap(m_changedLinks);
+    return links;
+}
+
+bool LinkWatcher::takeAddrChanged()
+{
+    bool changed = m_addrChanged;
+    m_addrChanged = false;
+    return changed;
+}
+
+AddrIterator LinkWatcher::addrIterator()
+{
+    AddrIterator it(nullptr, m_addrCache);
+    return it;
+}
+
+void LinkWatcher::linkChanged(struct nl_cache *, struct nl_object *obj, int, void *data)
+{
+    auto *watcher = reinterpret_cast<LinkWatcher *>(data);
+    watcher->m_changedLinks.insert(rtnl_link_get_ifindex(reinterpret_cast<struct rtnl_link *>(obj)));
+}
+
+void LinkWatcher::addrChanged(struct nl_cache *, struct nl_object *, int, void *data)
+{
+    reinterpret_cast<LinkWatcher *>(data)->m_addrChanged = true;
+}
+
+RouteWatcher::RouteWatcher()
+    : m_sock(nullptr)
+    , m_mngr(nullptr)
+    , m_routeCache(nullptr)
+    , m_changed(false)
+{
+    int rc = 0;
+    m_sock = nl_socket_alloc();
+    if (!m_sock) {
+        qWarning() << "Error: nl_socket_alloc failed";
+        return;
+    }
+
+    // subscribes to route groups of the caches added & switches socket to non-blocking mode
+    rc = nl_cache_mngr_alloc(m_sock, NETLINK_ROUTE, 0, &m_mngr);
+    if (rc < 0) {
+        qWarning() << "Error: nl_cache_mngr_alloc failed:" << nl_geterror(rc);
+        return;
+    }
+
+    // initial dump
+    rc = nl_cache_mngr_add(m_mngr, "route/route", &RouteWatcher::routeChanged, this, &m_routeCache);
+    if (rc < 0) {
+        qWarning() << "Error: nl_cache_mngr_add failed:" << nl_geterror(rc);
+        m_routeCache = nullptr;
+    }
+}
+
+RouteWatcher::~RouteWatcher()
+{
+    // frees caches as well
+    if (m_mngr)
+        nl_cache_mngr_free(m_mngr);
+    if (m_sock)
+        nl_socket_free(m_sock);
+}
+
+int RouteWatcher::fd() const
+{
+    return isValid() ? nl_cache_mngr_get_fd(m_mngr) : -1;
+}
+
+bool RouteWatcher::handleEvents()
+{
+    if (!isValid())
+        return false;
+
+    m_changed = false;
+    int rc = nl_cache_mngr_data_ready(m_mngr);
+    if (rc < 0) {
+        // notifications lost (ENOBUFS), cache may be out of sync, dump again
+        qWarning() << "Error: nl_cache_mngr_data_ready failed:" << nl_geterror(rc);
+        resyncCache(m_routeCache, nullptr, nullptr);
+        return true;
+    }
+
+    return m_changed;
+}
+
+void RouteWatcher::routeChanged(struct nl_cache *, struct nl_object *, int, void *data)
+{
+    reinterpret_cast<RouteWatcher *>(data)->m_changed = true;
+}
+
+QString RouteWatcher::defaultDevice() const
+{
+    if (!isValid())
+        return {};
+
+    QList<route_entry_t> routes;
+    for (auto *obj = nl_cache_get_first(m_routeCache); obj; obj = nl_cache_get_next(obj)) {
+        auto *route = reinterpret_cast<struct rtnl_route *>(obj);
+        // only what route -n used to show
+        if (rtnl_route_get_table(route) != RT_TABLE_MAIN || rtnl_route_get_type(route) != RTN_UNICAST)
+            continue;
+        if (rtnl_route_get_nnexthops(route) < 1)
+            continue;
+
+        route_entry_t entry;
+        entry.family = rtnl_route_get_family(route);
+        entry.prefixlen = int(nl_addr_get_prefixlen(rtnl_route_get_dst(route)));
+        entry.metric = rtnl_route_get_priority(route);
+        entry.ifindex = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, 0));
+        routes << entry;
+    }
+
+    int index = pickDefaultRoute(routes);
+    if (index < 0)
+        return {};
+
+    char ifname[IF_NAMESIZE] {};
+    if (!if_indextoname(uint(routes[index].ifindex), ifname))
+        return {};
+    return QString(ifname);
+}
+
+int RouteWatcher::pickDefaultRoute(const QList<route_entry_t> &routes)
+{
+    int best[3] = {-1, -1, -1}; // ipv4 default, ipv6 default, ipv4 any
+    for (int i = 0; i < routes.size(); ++i) {
+        const route_entry_t &route = routes[i];
+        if (route.ifindex <= 0)
+            continue;
+
+        int kind = -1;
+        if (route.family == AF_INET && route.prefixlen == 0) {
+            kind = 0;
+        } else if (route.family == AF_INET6 && route.prefixlen == 0) {
+            kind = 1;
+        }
+
+        if (kind >= 0 && (best[kind] < 0 || route.metric < routes[best[kind]].metric))
+            best[kind] = i;
+        if (route.family == AF_INET && (best[2] < 0 || route.metric < routes[best[2]].metric))
+            best[2] = i;
+    }
+
+    for (int index : best) {
+        if (index >= 0)
+            return index;
+    }
+    return -1;
+}
+
 } // namespace system
 } // namespace core
@@ -11,6 +11,8 @@
 
 #include <QtGlobal>
 #include <QList>
+#include <QSet>
+#include <QString>
 
 #include <netlink/socket.h>
 #include <netlink/cache.h>
@@ -18,7 +20,9 @@
 #include <memory>
 
 struct nl_cache;
+struct nl_cache_mngr;
 struct nl_link;
+struct nl_object;
 
 namespace core {
 namespace system {
@@ -65,8 +69,10 @@ private:
     CacheIterator(struct nl_sock *sock, struct nl_cache *cache)
         : d(new context {sock, cache, nullptr})
     {
-        if (d->m_sock && d->m_cache) {
-            nl_cache_refill(d->m_sock, d->m_cache);
+        if (d->m_cache) {
+            // caches of a cache manager are kept up to date by notifications, no socket given then
+            if (d->m_sock)
+                nl_cache_refill(d->m_sock, d->m_cache);
 
             d->m_next = nl_cache_get_first(d->m_cache);
         }
@@ -81,6 +87,7 @@ private:
     struct context *d;
 
     friend class Netlink;
+    friend class LinkWatcher;
 };
 using LinkIterator = CacheIterator<NLLink, struct rtnl_link>;
 using AddrIterator = CacheIterator<NLAddr, struct rtnl_addr>;
@@ -100,6 +107,134 @@ private:
     nl_cache *m_addrCache;
 };
 
+/**
+ * @brief Link & address change watcher
+ *
+ * Links & addresses are dumped once on construction, after that the caches are kept up to date
+ * by change notifications (RTNLGRP_LINK, RTNLGRP_IPV4_IFADDR & RTNLGRP_IPV6_IFADDR). Link stats
+ * are not part of these notifications, so counters still have to be read by a regular dump.
+ * Owner calls handleEvents() to apply pending changes, it never blocks.
+ */
+class LinkWatcher
+{
+public:
+    explicit LinkWatcher();
+    ~LinkWatcher();
+
+    inline bool isValid() const
+    {
+        return m_linkCache != nullptr && m_addrCache != nullptr;
+    }
+
+    /**
+     * @brief fd Notification socket, readable when link or address changes are pending
+     * @return -1 if watcher is not valid
+     */
+    int fd() const;
+    /**
+     * @brief handleEvents Apply pending changes to caches, never blocks
+     * @return true if any link or address changed
+     */
+    bool handleEvents();
+
+    /**
+     * @brief takeChangedLinks Interfaces whose link attributes changed (or that were removed)
+     * since last call
+     */
+    QSet<int> takeChangedLinks();
+    /**
+     * @brief takeAddrChanged Whether any address changed since last call
+     */
+    bool takeAddrChanged();
+
+    /**
+     * @brief addrIterator Iterate cached addresses, nothing is read from kernel
+     */
+    AddrIterator addrIterator();
+
+private:
+    LinkWatcher(const LinkWatcher &) = delete;
+    LinkWatcher &operator=(const LinkWatcher &) = delete;
+
+    static void linkChanged(struct nl_cache *cache, struct nl_object *obj, int action, void *data);
+    static void addrChanged(struct nl_cache *cache, struct nl_object *obj, int action, void *data);
+
+private:
+    nl_sock *m_sock;
+    nl_cache_mngr *m_mngr;
+    nl_cache *m_linkCache; // owned by m_mngr
+    nl_cache *m_addrCache; // owned by m_mngr
+    QSet<int> m_changedLinks;
+    bool m_addrChanged;
+};
+
+/**
+ * @brief Main table unicast route, as needed to pick default interface
+ */
+struct route_entry_t {
+    int family; // AF_INET or AF_INET6
+    int prefixlen; // destination prefix length, 0 for default route
+    uint metric; // route priority
+    int ifindex; // output interface of first nexthop
+};
+
+/**
+ * @brief Route table watcher
+ *
+ * Routes are dumped (RTM_GETROUTE) once on construction, after that the cache is kept up to date
+ * by route change notifications (RTMGRP_IPV4_ROUTE & RTMGRP_IPV6_ROUTE), so nothing is read
+ * unless routes actually change. Owner watches fd() and calls handleEvents() when it's readable.
+ */
+class RouteWatcher
+{
+public:
+    explicit RouteWatcher();
+    ~RouteWatcher();
+
+    inline bool isValid() const
+    {
+        return m_routeCache != nullptr;
+    }
+
+    /**
+     * @brief fd Notification socket, readable when route changes are pending
+     * @return -1 if watcher is not valid
+     */
+    int fd() const;
+    /**
+     * @brief handleEvents Apply pending route changes to cache, never blocks
+     * @return true if any route changed
+     */
+    bool handleEvents();
+
+    /**
+     * @brief defaultDevice Interface of the default route
+     * @return Interface name, empty if there's no route at all
+     */
+    QString defaultDevice() const;
+
+    /**
+     * @brief pickDefaultRoute Pick route of default interface
+     *
+     * IPv4 default route with lowest metric, else IPv6 default route with lowest metric,
+     * else IPv4 route with lowest metric.
+     * @return Index in routes, -1 if none
+     */
+    static int pickDefaultRoute(const QList<route_entry_t> &routes);
+
+private:
+    RouteWatcher(const RouteWatcher &) = delete;
+    RouteWatcher &operator=(const RouteWatcher &) = delete;
+
+    static void routeChanged(struct nl_cache *cache, struct nl_object *obj, int action, void *data);
+
+private:
+    nl_sock *m_sock;
+    nl_cache_mngr *m_mngr;
+    nl_cache *m_routeCache; // owned by m_mngr
+    bool m_changed;
+};
+
 } // namespace system
 } // namespace core
 
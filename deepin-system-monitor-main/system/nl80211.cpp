@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "nl80211.h"
+#include "common/common.h"
+
+#include <QDebug>
+
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/nl80211.h>
+
+#include <sys/socket.h>
+#include <string.h>
+#include <unistd.h>
+
+// receive buffer of one recv call
+#define NL80211_RECV_BUF_SIZE (16 * 1024)
+// max payload of the single attribute of our requests
+#define NL80211_REQ_ATTR_MAX 32
+// station info older than this is queried again, bitrate adapts to link conditions (seconds)
+#define NL80211_STATION_CACHE_TIME 5
+// failed family lookup is retried after this, cfg80211 may get loaded later (seconds)
+#define NL80211_FAMILY_RETRY_TIME 30
+
+using namespace common::error;
+
+namespace core {
+namespace system {
+
+namespace {
+
+// call fn(type, payload, len) for each attribute in a stream of netlink attributes
+template<typename F>
+void forEachAttr(const char *data, int len, F fn)
+{
+    while (len >= NLA_HDRLEN) {
+        auto *nla = reinterpret_cast<const struct nlattr *>(data);
+        if (nla->nla_len < NLA_HDRLEN || nla->nla_len > len)
+            break;
+        fn(nla->nla_type & NLA_TYPE_MASK, data + NLA_HDRLEN, int(nla->nla_len) - NLA_HDRLEN);
+
+        int alen = NLA_ALIGN(nla->nla_len);
+        data += alen;
+        len -= alen;
+    }
+}
+
+// nested NL80211_RATE_INFO_* attributes
+void parseRateInfo(const char *data, int len, uint &bitrate, int &mcs)
+{
+    uint bitrate16 = 0;
+    bitrate = 0;
+    mcs = -1;
+    forEachAttr(data, len, [&](int type, const char *payload, int plen) {
+        switch (type) {
+        case NL80211_RATE_INFO_BITRATE32:
+            if (plen >= int(sizeof(quint32)))
+                memcpy(&bitrate, payload, sizeof(quint32));
+            break;
+        case NL80211_RATE_INFO_BITRATE:
+            if (plen >= int(sizeof(quint16))) {
+                quint16 v;
+                memcpy(&v, payload, sizeof(v));
+                bitrate16 = v;
+            }
+            break;
+        case NL80211_RATE_INFO_MCS:
+        case NL80211_RATE_INFO_VHT_MCS:
+        case NL80211_RATE_INFO_HE_MCS:
+            if (plen >= 1)
+                mcs = quint8(payload[0]);
+            break;
+        default:
+            break;
+        }
+    });
+    // 16bit bitrate is not set for rates beyond 6.5 Gbps
+    if (bitrate == 0)
+        bitrate = bitrate16;
+}
+
+} // namespace
+
+NL80211::NL80211()
+    : NL80211(-1)
+{
+    errno = 0;
+    m_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_GENERIC);
+    if (m_fd < 0) {
+        print_errno(errno, "create generic netlink socket failed");
+    }
+}
+
+NL80211::NL80211(int fd)
+    : m_fd(fd)
+    , m_seq(0)
+    , m_familyId(0)
+    , m_familyResolved(false)
+    , m_familyRetryTs(0)
+{
+}
+
+NL80211::~NL80211()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool NL80211::station(int ifindex, uint linkStamp, station_info_t &info)
+{
+    time_t now = time(nullptr);
+    auto it = m_stations.find(ifindex);
+    if (it == m_stations.end() || it->linkStamp != linkStamp || (now - it->ts) >= NL80211_STATION_CACHE_TIME) {
+        station_cache_t entry {linkStamp, now, false, {}};
+        entry.ok = readStation(ifindex, entry.info);
+        it = m_stations.insert(ifindex, entry);
+    }
+
+    if (it->ok)
+        info = it->info;
+    return it->ok;
+}
+
+bool NL80211::readStation(int ifindex, station_info_t &info)
+{
+    if (!resolveFamily())
+        return false;
+
+    quint32 index = quint32(ifindex);
+    if (!request(m_familyId, NLM_F_REQUEST | NLM_F_DUMP, NL80211_CMD_GET_STATION,
+                 NL80211_ATTR_IFINDEX, &index, sizeof(index)))
+        return false;
+
+    bool found = false;
+    alignas(struct nlmsghdr) char buf[NL80211_RECV_BUF_SIZE];
+    for (;;) {
+        ssize_t len = recv(m_fd, buf, sizeof(buf), 0);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0) {
+            print_errno(errno, "read nl80211 station dump failed");
+            return false;
+        }
+
+        // ENODEV or EOPNOTSUPP if interface is not an nl80211 interface, nothing to report then
+        int rc = parseStationMessages(buf, size_t(len), m_seq, info, found);
+        if (rc != 0) {
+            if (rc < 0)
+                drain();
+            return rc > 0 && found;
+        }
+    }
+}
+
+int NL80211::parseFamilyMessages(const char *buf, size_t len, quint32 seq, quint16 &familyId)
+{
+    int remain = int(len);
+    for (auto *nlh = reinterpret_cast<const struct nlmsghdr *>(buf); NLMSG_OK(nlh, remain); nlh = NLMSG_NEXT(nlh, remain)) {
+        // left over from an earlier request
+        if (nlh->nlmsg_seq != seq)
+            continue;
+        if (nlh->nlmsg_type == NLMSG_ERROR) {
+            auto *err = reinterpret_cast<const struct nlmsgerr *>(NLMSG_DATA(nlh));
+            // ENOENT if cfg80211 is not loaded, i.e. no wireless hardware
+            qDebug() << "resolve nl80211 family failed:" << strerror(-err->error);
+            return -1;
+        }
+        if (nlh->nlmsg_type != GENL_ID_CTRL)
+            continue;
+
+        bool found = false;
+        const char *attrs = reinterpret_cast<const char *>(NLMSG_DATA(nlh)) + GENL_HDRLEN;
+        forEachAttr(attrs, int(nlh->nlmsg_len) - int(NLMSG_LENGTH(GENL_HDRLEN)), [&](int type, const char *payload, int plen) {
+            if (type == CTRL_ATTR_FAMILY_ID && plen >= int(sizeof(quint16))) {
+                memcpy(&familyId, payload, sizeof(quint16));
+                found = true;
+            }
+        });
+        if (found)
+            return 1;
+    }
+
+    return 0;
+}
+
+int NL80211::parseStationMessages(const char *buf, size_t len, quint32 seq, station_info_t &info, bool &found)
+{
+    int remain = int(len);
+    for (auto *nlh = reinterpret_cast<const struct nlmsghdr *>(buf); NLMSG_OK(nlh, remain); nlh = NLMSG_NEXT(nlh, remain)) {
+        // left over from an earlier request
+        if (nlh->nlmsg_seq != seq)
+            continue;
+        if (nlh->nlmsg_type == NLMSG_DONE)
+            return 1;
+        if (nlh->nlmsg_type == NLMSG_ERROR)
+            return -1;
+        if (nlh->nlmsg_type < NLMSG_MIN_TYPE || found)
+            continue;
+
+        // managed interface has its access point as the only station
+        const char *attrs = reinterpret_cast<const char *>(NLMSG_DATA(nlh)) + GENL_HDRLEN;
+        forEachAttr(attrs, int(nlh->nlmsg_len) - int(NLMSG_LENGTH(GENL_HDRLEN)), [&](int type, const char *payload, int plen) {
+            if (type != NL80211_ATTR_STA_INFO)
+                return;
+
+            found = true;
+            info = station_info_t {};
+            forEachAttr(payload, plen, [&](int stype, const char *spayload, int splen) {
+                switch (stype) {
+                case NL80211_STA_INFO_SIGNAL:
+                    if (splen >= 1)
+                        info.signal = qint8(spayload[0]);
+                    break;
+                case NL80211_STA_INFO_TX_BITRATE:
+                    parseRateInfo(spayload, splen, info.tx_bitrate, info.tx_mcs);
+                    break;
+                case NL80211_STA_INFO_RX_BITRATE:
+                    parseRateInfo(spayload, splen, info.rx_bitrate, info.rx_mcs);
+                    break;
+                default:
+                    break;
+                }
+            });
+        });
+    }
+
+    return 0;
+}
+
+bool NL80211::resolveFamily()
+{
+    if (m_familyResolved)
+        return true;
+    if (m_fd < 0)
+        return false;
+
+    // resolved once, family id does not change while cfg80211 stays loaded; a failed lookup
+    // is not repeated on every station query but only after NL80211_FAMILY_RETRY_TIME
+    time_t now = time(nullptr);
+    if (now < m_familyRetryTs)
+        return false;
+    m_familyRetryTs = now + NL80211_FAMILY_RETRY_TIME;
+
+    const char name[] = NL80211_GENL_NAME;
+    if (!request(GENL_ID_CTRL, NLM_F_REQUEST, CTRL_CMD_GETFAMILY, CTRL_ATTR_FAMILY_NAME, name, sizeof(name)))
+        return false;
+
+    alignas(struct nlmsghdr) char buf[NL80211_RECV_BUF_SIZE];
+    for (;;) {
+        ssize_t len = recv(m_fd, buf, sizeof(buf), 0);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0) {
+            print_errno(errno, "read nl80211 family failed");
+            return false;
+        }
+
+        int rc = parseFamilyMessages(buf, size_t(len), m_seq, m_familyId);
+        if (rc != 0) {
+            if (rc < 0)
+                drain();
+            m_familyResolved = rc > 0;
+            return m_familyResolved;
+        }
+    }
+}
+
+bool NL80211::request(quint16 type, quint16 flags, quint8 cmd, quint16 attrType, const void *attr, quint16 attrLen)
+{
+    if (attrLen > NL80211_REQ_ATTR_MAX)
+        return false;
+
+    alignas(struct nlmsghdr) char msg[NLMSG_SPACE(GENL_HDRLEN + NLA_HDRLEN + NLA_ALIGN(NL80211_REQ_ATTR_MAX))] {};
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg);
+    nlh->nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN + NLA_HDRLEN + NLA_ALIGN(attrLen));
+    nlh->nlmsg_type = type;
+    nlh->nlmsg_flags = flags;
+    nlh->nlmsg_seq = ++m_seq;
+
+    auto *genl = reinterpret_cast<struct genlmsghdr *>(NLMSG_DATA(nlh));
+    genl->cmd = cmd;
+    genl->version = 1;
+
+    auto *nla = reinterpret_cast<struct nlattr *>(reinterpret_cast<char *>(genl) + GENL_HDRLEN);
+    nla->nla_type = attrType;
+    nla->nla_len = quint16(NLA_HDRLEN + attrLen);
+    memcpy(reinterpret_cast<char *>(nla) + NLA_HDRLEN, attr, attrLen);
+
+    // unconnected netlink socket sends to kernel by default
+    errno = 0;
+    if (send(m_fd, msg, nlh->nlmsg_len, 0) < 0) {
+        print_errno(errno, "send generic netlink request failed");
+        return false;
+    }
+    return true;
+}
+
+void NL80211::drain()
+{
+    // rest of a failed dump, anything arriving later is told apart by its sequence number
+    alignas(struct nlmsghdr) char buf[NL80211_RECV_BUF_SIZE];
+    while (recv(m_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+    }
+}
+
+} // namespace system
+} // namespace core
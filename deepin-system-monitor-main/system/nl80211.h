@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NL80211_H
+#define NL80211_H
+
+#include <QHash>
+#include <QtGlobal>
+
+#include <time.h>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief Station (access point of a managed interface) info from nl80211
+ */
+struct station_info_t {
+    int signal {0}; // signal strength of last received frame (dBm), 0 if unknown
+    uint tx_bitrate {0}; // tx bitrate (100 kbit/s), 0 if unknown
+    uint rx_bitrate {0}; // rx bitrate (100 kbit/s), 0 if unknown
+    int tx_mcs {-1}; // tx MCS index (HT, VHT or HE), -1 if legacy rate or unknown
+    int rx_mcs {-1}; // rx MCS index (HT, VHT or HE), -1 if legacy rate or unknown
+};
+
+/**
+ * @brief Wireless station reader based on generic netlink nl80211
+ *
+ * Queries NL80211_CMD_GET_STATION on a generic netlink socket kept open between
+ * queries, no external tool is run. Results are cached per interface until link
+ * changes or they get older than a few seconds, as bitrate adapts over time.
+ * One instance must only be used by one thread at a time.
+ */
+class NL80211
+{
+public:
+    explicit NL80211();
+    ~NL80211();
+
+    /**
+     * @brief isValid Whether the generic netlink socket is usable
+     */
+    inline bool isValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief station Station info of interface, cached
+     * @param ifindex Interface index
+     * @param linkStamp Changes whenever link changes (e.g. carrier changes), drops cached info
+     * @param info Station info
+     * @return false if interface is not an nl80211 interface or not associated
+     */
+    bool station(int ifindex, uint linkStamp, station_info_t &info);
+
+    /**
+     * @brief readStation Query station info of interface from kernel
+     * @return false if query failed or interface has no station
+     */
+    bool readStation(int ifindex, station_info_t &info);
+
+    /**
+     * @brief parseFamilyMessages Read family id from CTRL_CMD_GETFAMILY reply
+     * @param buf Netlink messages as received from kernel
+     * @param len Buffer length
+     * @param seq Sequence number of request, replies to other requests are skipped
+     * @param familyId Family id if found
+     * @return 1 if family id found, 0 if more messages follow, -1 on error
+     */
+    static int parseFamilyMessages(const char *buf, size_t len, quint32 seq, quint16 &familyId);
+
+    /**
+     * @brief parseStationMessages Read first station in NL80211_CMD_GET_STATION dump
+     * @param buf Netlink messages as received from kernel
+     * @param len Buffer length
+     * @param seq Sequence number of request, replies to other requests are skipped
+     * @param info Station info if found
+     * @param found Set if a station was found, later stations are skipped
+     * @return 1 if end of dump reached, 0 if more messages follow, -1 on error
+     */
+    static int parseStationMessages(const char *buf, size_t len, quint32 seq, station_info_t &info, bool &found);
+
+private:
+    // takes ownership of fd, used by unit tests to talk to a mock responder
+    explicit NL80211(int fd);
+
+    NL80211(const NL80211 &) = delete;
+    NL80211 &operator=(const NL80211 &) = delete;
+
+    /**
+     * @brief resolveFamily Look up nl80211 family id, once
+     */
+    bool resolveFamily();
+    /**
+     * @brief request Send a generic netlink request with an optional u32 or string attribute
+     */
+    bool request(quint16 type, quint16 flags, quint8 cmd, quint16 attrType, const void *attr, quint16 attrLen);
+    /**
+     * @brief drain Discard replies still queued on socket after a failed request
+     */
+    void drain();
+
+private:
+    struct station_cache_t {
+        uint linkStamp; // link stamp of query
+        time_t ts; // time of query
+        bool ok; // query found a station
+        station_info_t info;
+    };
+
+    int m_fd;
+    quint32 m_seq;
+    quint16 m_familyId;
+    bool m_familyResolved;
+    time_t m_familyRetryTs; // failed family lookup is not retried before this time
+    QHash<int, station_cache_t> m_stations;
+};
+
+} // namespace system
+} // namespace core
+
+#endif // NL80211_H
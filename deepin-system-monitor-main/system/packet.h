@@ -6,15 +6,21 @@
 #ifndef PACKET_H
 #define PACKET_H
 
-#include <QQueue>
+#include <QHash>
+#include <QMap>
 #include <QSharedPointer>
+#include <QVector>
 
+#include <atomic>
 #include <memory>
 
 #include <pcap.h>
+#include <string.h>
 #include <time.h>
 #include <netinet/in.h>
 
+#define PACKET_CACHE_LINE_SIZE 64 // bytes
+
 namespace core {
 namespace system {
 
@@ -46,7 +52,7 @@ struct packet_payload_t {
 struct net_ifaddr_t {
     char iface[16]; // interface name
     int family; // address family
-    // flags
+    uint flags; // interface flags (IFF_UP, IFF_LOOPBACK...)
     union {
         in_addr in4;
         in6_addr in6;
@@ -55,7 +61,7 @@ struct net_ifaddr_t {
     // broadcast/p2p
 };
 
-// from /proc/net/tcp & /proc/net/udp & /proc/net/tcp6 & /proc/net/udp6
+// from inet_diag dump, or /proc/net/tcp & /proc/net/udp & /proc/net/tcp6 & /proc/net/udp6
 struct sock_stat_t {
     ino_t   ino;              // socket inode
     int     sa_family;        // AF_INET & AF_INET6
@@ -71,12 +77,262 @@ struct sock_stat_t {
     }       d_addr;           // remote address
     uint    d_port;           // remote port
     uid_t   uid;              // socket uid
+    uint    state;            // TCP_ESTABLISHED... (netinet/tcp.h), udp sockets use TCP_ESTABLISHED & TCP_CLOSE too
+};
+
+// binary 5-tuple of a flow, addresses in network byte order & ports in host byte order,
+// compared and hashed bytewise, so always build it with sockFlowKey
+struct sock_flow_key_t {
+    union {
+        in_addr in4;
+        in6_addr in6;
+    } s_addr;
+    union {
+        in_addr in4;
+        in6_addr in6;
+    } d_addr;
+    uint16_t s_port;
+    uint16_t d_port;
+    uint8_t sa_family;
+    uint8_t proto;
+    uint16_t reserved; // always zero
 };
 
+inline sock_flow_key_t sockFlowKey(int family, int proto,
+                                   const void *saddr, uint16_t sport,
+                                   const void *daddr, uint16_t dport)
+{
+    sock_flow_key_t key;
+    memset(&key, 0, sizeof(key));
+    size_t alen = (family == AF_INET6) ? sizeof(in6_addr) : sizeof(in_addr);
+    memcpy(&key.s_addr, saddr, alen);
+    memcpy(&key.d_addr, daddr, alen);
+    key.s_port = sport;
+    key.d_port = dport;
+    key.sa_family = uint8_t(family);
+    key.proto = uint8_t(proto);
+    return key;
+}
+
+inline bool operator==(const sock_flow_key_t &lhs, const sock_flow_key_t &rhs)
+{
+    return memcmp(&lhs, &rhs, sizeof(sock_flow_key_t)) == 0;
+}
+
+// key is hashed per captured packet, mix it as 64bit words instead of bytewise
+inline uint qHash(const sock_flow_key_t &key, uint seed = 0)
+{
+    static_assert(sizeof(sock_flow_key_t) % sizeof(quint64) == 0, "flow key must be a multiple of 8 bytes");
+
+    quint64 words[sizeof(sock_flow_key_t) / sizeof(quint64)];
+    memcpy(words, &key, sizeof(words));
+
+    quint64 h = seed;
+    for (quint64 w : words) {
+        h ^= w;
+        h *= Q_UINT64_C(0x9e3779b97f4a7c15);
+        h ^= h >> 32;
+    }
+    return uint(h);
+}
+
 using PacketPayload      = QSharedPointer<struct packet_payload_t>;
-using PacketPayloadQueue = QQueue<PacketPayload>;
+
+/**
+ * @brief Bounded lock free ring of packet payload records, one producer & one consumer thread
+ *
+ * Producer fills back() in place then push(), consumer reads front() then pop(), neither
+ * side takes a lock. Head is written by consumer only, tail by producer only, each index is
+ * published with release & read with acquire by the other side. Records offered while the
+ * ring is full are counted as dropped instead of blocking the capture thread.
+ *
+ * Capacity is rounded up to a power of two, indexes run free and are masked on access.
+ */
+class PacketPayloadSpscRing
+{
+public:
+    explicit PacketPayloadSpscRing(quint32 capacity)
+    {
+        quint32 n = 1;
+        while (n < capacity)
+            n <<= 1;
+        m_mask = n - 1;
+        m_buf.reset(new packet_payload_t[n]);
+    }
+
+    inline quint32 capacity() const
+    {
+        return m_mask + 1;
+    }
+    /**
+     * @brief size Records in ring, exact only when called from producer or consumer thread
+     */
+    inline quint32 size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    inline bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    // producer side
+    /**
+     * @brief back Free slot after the last record, nullptr if ring is full
+     *
+     * Slot content is undefined, it becomes visible to consumer only after push() is called.
+     */
+    inline packet_payload_t *back()
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+            return nullptr;
+        return &m_buf[tail & m_mask];
+    }
+    /**
+     * @brief push Publish the slot returned by back()
+     * @return Records in ring after push
+     */
+    inline quint32 push()
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed) + 1;
+        m_tail.store(tail, std::memory_order_release);
+        return tail - m_head.load(std::memory_order_acquire);
+    }
+    /**
+     * @brief drop Count a record that could not be queued because the ring was full
+     */
+    inline void drop()
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // consumer side
+    inline const packet_payload_t &front() const
+    {
+        Q_ASSERT(!isEmpty());
+        return m_buf[m_head.load(std::memory_order_relaxed) & m_mask];
+    }
+    inline void pop()
+    {
+        Q_ASSERT(!isEmpty());
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    /**
+     * @brief clear Discard all records, consumer side
+     */
+    inline void clear()
+    {
+        m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * @brief dropped Records dropped on full ring since creation, readable from any thread
+     */
+    inline qulonglong dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    PacketPayloadSpscRing(const PacketPayloadSpscRing &) = delete;
+    PacketPayloadSpscRing &operator=(const PacketPayloadSpscRing &) = delete;
+
+private:
+    std::unique_ptr<packet_payload_t[]> m_buf;
+    quint32 m_mask {0};
+    // indexes padded apart to separate cache lines, so producer & consumer don't bounce the same line
+    // (padding instead of alignas, over-aligned heap allocation needs C++17)
+    char m_pad0[PACKET_CACHE_LINE_SIZE];
+    std::atomic<quint32> m_head {0};
+    char m_pad1[PACKET_CACHE_LINE_SIZE - sizeof(std::atomic<quint32>)];
+    std::atomic<quint32> m_tail {0};
+    std::atomic<qulonglong> m_dropped {0}; // written by producer only
+    char m_pad2[PACKET_CACHE_LINE_SIZE];
+};
+
+/**
+ * @brief Flat set of local interface addresses
+ *
+ * A host has a handful of addresses, a linear scan over binary addresses is cheaper
+ * than hashing per packet. Addresses are in network byte order.
+ */
+class LocalAddrSet
+{
+public:
+    inline void clear()
+    {
+        m_in4.clear();
+        m_in6.clear();
+    }
+
+    inline void insert(int family, const void *addr)
+    {
+        if (contains(family, addr))
+            return;
+
+        if (family == AF_INET) {
+            m_in4 << *reinterpret_cast<const in_addr *>(addr);
+        } else if (family == AF_INET6) {
+            m_in6 << *reinterpret_cast<const in6_addr *>(addr);
+        }
+    }
+
+    inline bool contains(int family, const void *addr) const
+    {
+        if (family == AF_INET) {
+            auto *in4 = reinterpret_cast<const in_addr *>(addr);
+            for (const in_addr &a : m_in4) {
+                if (a.s_addr == in4->s_addr)
+                    return true;
+            }
+        } else if (family == AF_INET6) {
+            auto *in6 = reinterpret_cast<const in6_addr *>(addr);
+            for (const in6_addr &a : m_in6) {
+                if (IN6_ARE_ADDR_EQUAL(&a, in6))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    inline int size() const
+    {
+        return m_in4.size() + m_in6.size();
+    }
+
+private:
+    QVector<in_addr> m_in4;
+    QVector<in6_addr> m_in6;
+};
 using SockStat      = QSharedPointer<struct sock_stat_t>;
-using SockStatMap   = QMultiMap<uint64_t, SockStat>; // [hash, SockStat]
+using SockStatMap   = QHash<sock_flow_key_t, SockStat>; // [flow, SockStat]
+
+/**
+ * @brief insertSockStat Index socket by its flow, TCP sockets by the reverse flow as well
+ *
+ * IPv4 mapped IPv6 addresses are converted to IPv4 first, as captured packets carry plain IPv4.
+ */
+inline void insertSockStat(SockStatMap &statMap, const SockStat &stat)
+{
+    if (stat->sa_family == AF_INET6 && IN6_IS_ADDR_V4MAPPED(&stat->s_addr.in6)) {
+        stat->sa_family = AF_INET;
+        stat->s_addr.in4.s_addr = stat->s_addr.in6.s6_addr32[3];
+        stat->d_addr.in4.s_addr = stat->d_addr.in6.s6_addr32[3];
+    }
+
+    statMap.insert(sockFlowKey(stat->sa_family, stat->proto,
+                               &stat->s_addr, uint16_t(stat->s_port),
+                               &stat->d_addr, uint16_t(stat->d_port)),
+                   stat);
+    // TCP is bidirectional piping, add reverse mapping, otherwise we wont be able to get the inode
+    if (stat->proto == IPPROTO_TCP) {
+        statMap.insert(sockFlowKey(stat->sa_family, stat->proto,
+                                   &stat->d_addr, uint16_t(stat->d_port),
+                                   &stat->s_addr, uint16_t(stat->s_port)),
+                       stat);
+    }
+}
 using NetIFAddr     = QSharedPointer<struct net_ifaddr_t>;
 using NetIFAddrsMap = QMultiMap<QString, NetIFAddr>;
 
@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "pressure.h"
+#include "common/common.h"
+
+#include <QDebug>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PROC_PATH_PRESSURE "/proc/pressure/"
+// unified hierarchy, mounted alone or below the v1 controllers in hybrid mode
+#define SYSFS_PATH_CGROUP2 "/sys/fs/cgroup"
+#define SYSFS_PATH_CGROUP2_HYBRID "/sys/fs/cgroup/unified"
+// two lines of less than 64 chars each
+#define PRESSURE_BUF_SIZE 256
+
+using namespace common::alloc;
+using namespace common::error;
+
+namespace core {
+namespace system {
+
+namespace {
+
+const char *const kResourceNames[PressureInfo::kPressureResourceCount] = {"cpu", "memory", "io"};
+
+// mount point of cgroup v2 hierarchy, empty if there's none
+QByteArray cgroup2Mount()
+{
+    if (!access(SYSFS_PATH_CGROUP2 "/cgroup.controllers", F_OK))
+        return SYSFS_PATH_CGROUP2;
+    if (!access(SYSFS_PATH_CGROUP2_HYBRID "/cgroup.controllers", F_OK))
+        return SYSFS_PATH_CGROUP2_HYBRID;
+    return {};
+}
+
+// share of interval spent in stall, counters are in us
+inline qreal stallOf(unsigned long long last, unsigned long long cur, qreal interval)
+{
+    if (cur <= last || interval <= 0)
+        return 0;
+    return qBound(0., (cur - last) / interval, 1.);
+}
+
+} // namespace
+
+PressureInfo::PressureInfo()
+{
+    init(PROC_PATH_PRESSURE, "");
+}
+
+PressureInfo::PressureInfo(const QByteArray &cgroup)
+{
+    if (cgroup == "/") {
+        // root cgroup has no pressure files, its pressure is the system wide one
+        init(PROC_PATH_PRESSURE, "");
+        return;
+    }
+
+    QByteArray mount = cgroup.isEmpty() ? QByteArray() : cgroup2Mount();
+    init(mount + cgroup + "/", ".pressure");
+    if (mount.isEmpty()) {
+        for (auto &res : m_res)
+            res.available = false;
+    }
+}
+
+PressureInfo::~PressureInfo()
+{
+    for (auto &res : m_res) {
+        if (res.fd >= 0)
+            close(res.fd);
+    }
+}
+
+void PressureInfo::init(const QByteArray &prefix, const char *suffix)
+{
+    for (int i = 0; i < kPressureResourceCount; ++i)
+        m_res[i].path = prefix + kResourceNames[i] + suffix;
+}
+
+void PressureInfo::update()
+{
+    struct timespec now {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    qreal interval = (now.tv_sec - m_lastTime.tv_sec) * 1000000. + (now.tv_nsec - m_lastTime.tv_nsec) / 1000.;
+
+    for (int i = 0; i < kPressureResourceCount; ++i) {
+        resource_t &res = m_res[i];
+        if (!res.available)
+            continue;
+
+        psi_stat_t last = res.stat;
+        if (!read(Resource(i)) || !m_sampled) {
+            res.someStall = 0;
+            res.fullStall = 0;
+            continue;
+        }
+        res.someStall = stallOf(last.some.total, res.stat.some.total, interval);
+        res.fullStall = res.stat.hasFull ? stallOf(last.full.total, res.stat.full.total, interval) : 0;
+    }
+
+    m_lastTime = now;
+    m_sampled = true;
+}
+
+bool PressureInfo::read(Resource res)
+{
+    resource_t &r = m_res[res];
+    errno = 0;
+    if (r.fd < 0) {
+        r.fd = open(r.path.constData(), O_RDONLY | O_CLOEXEC);
+        if (r.fd < 0) {
+            // no psi support or cgroup gone, don't retry
+            if (errno != ENOENT)
+                print_errno(errno, QString("open %1 failed").arg(QString(r.path)));
+            r.available = false;
+            return false;
+        }
+    }
+
+    char buf[PRESSURE_BUF_SIZE];
+    ssize_t len;
+    do {
+        len = pread(r.fd, buf, sizeof(buf) - 1, 0);
+    } while (len < 0 && errno == EINTR);
+
+    if (len < 0 || !parse(buf, size_t(len), r.stat)) {
+        // EOPNOTSUPP: psi disabled by boot option, ENODEV: cgroup removed
+        if (len >= 0 || (errno != EOPNOTSUPP && errno != ENODEV))
+            print_errno(errno, QString("read %1 failed").arg(QString(r.path)));
+        close(r.fd);
+        r.fd = -1;
+        r.available = false;
+        return false;
+    }
+    return true;
+}
+
+bool PressureInfo::parse(const char *buf, size_t len, psi_stat_t &stat)
+{
+    stat.hasSome = false;
+    stat.hasFull = false;
+
+    const char *p = buf;
+    const char *end = buf + len;
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', size_t(end - p)));
+        if (!eol)
+            eol = end;
+
+        // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+        char line[PRESSURE_BUF_SIZE] {};
+        memcpy(line, p, qMin(size_t(eol - p), sizeof(line) - 1));
+        char kind[8] {};
+        psi_line_t v;
+        int nm = sscanf(line, "%7s avg10=%f avg60=%f avg300=%f total=%llu",
+                        kind, &v.avg10, &v.avg60, &v.avg300, &v.total);
+        if (nm == 5) {
+            if (!strcmp(kind, "some")) {
+                stat.some = v;
+                stat.hasSome = true;
+            } else if (!strcmp(kind, "full")) {
+                stat.full = v;
+                stat.hasFull = true;
+            }
+        }
+        p = eol + 1;
+    }
+
+    return stat.hasSome;
+}
+
+bool PressureInfo::available() const
+{
+    for (const auto &res : m_res) {
+        if (res.available)
+            return true;
+    }
+    return false;
+}
+
+bool PressureInfo::available(Resource res) const
+{
+    return m_res[res].available;
+}
+
+const psi_stat_t &PressureInfo::stat(Resource res) const
+{
+    return m_res[res].stat;
+}
+
+qreal PressureInfo::someStall(Resource res) const
+{
+    return m_res[res].someStall;
+}
+
+qreal PressureInfo::fullStall(Resource res) const
+{
+    return m_res[res].fullStall;
+}
+
+QByteArray PressureInfo::cgroupOf(pid_t pid)
+{
+    QByteArray path = QByteArray("/proc/") + QByteArray::number(pid) + "/cgroup";
+    FILE *fp = fopen(path.constData(), "r");
+    if (!fp)
+        return {};
+
+    uFile fPtr;
+    fPtr.reset(fp);
+
+    // unified hierarchy line: 0::/user.slice/user-1000.slice/session-2.scope
+    char line[PATH_MAX + 8] {};
+    while (fgets(line, sizeof(line), fp)) {
+        if (!strncmp(line, "0::", 3))
+            return QByteArray(line + 3).trimmed();
+    }
+    return {};
+}
+
+} // namespace system
+} // namespace core
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PRESSURE_H
+#define PRESSURE_H
+
+#include <QByteArray>
+
+#include <sys/types.h>
+#include <time.h>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief One line of a pressure file
+ */
+struct psi_line_t {
+    float avg10 {0}; // % of time stalled, 10s average
+    float avg60 {0}; // 60s average
+    float avg300 {0}; // 300s average
+    unsigned long long total {0}; // stall time since boot (or cgroup creation), in us
+};
+
+/**
+ * @brief Values of a pressure file
+ *
+ * some: at least one task stalled on the resource, full: all non idle tasks stalled at once.
+ * System wide cpu pressure has no full line before linux 5.13.
+ */
+struct psi_stat_t {
+    bool hasSome {false};
+    bool hasFull {false};
+    psi_line_t some {};
+    psi_line_t full {};
+};
+
+/**
+ * @brief Pressure stall information (PSI) of cpu, memory & io
+ *
+ * System wide values are read from /proc/pressure, per cgroup values from <cgroup>/{cpu,memory,io}.pressure
+ * of the cgroup v2 hierarchy. Files are kept open & re-read with one pread each refresh.
+ * A resource without pressure file (CONFIG_PSI=n, psi=0 boot option, cgroup v1 or removed cgroup)
+ * is marked unavailable and not tried again.
+ */
+class PressureInfo
+{
+public:
+    enum Resource {
+        kCPUPressure,
+        kMemoryPressure,
+        kIOPressure,
+        kPressureResourceCount
+    };
+
+    /**
+     * @brief PressureInfo System wide pressure
+     */
+    explicit PressureInfo();
+    /**
+     * @brief PressureInfo Pressure of a cgroup
+     * @param cgroup Path of cgroup in the cgroup v2 hierarchy, as listed in /proc/[pid]/cgroup
+     */
+    explicit PressureInfo(const QByteArray &cgroup);
+    virtual ~PressureInfo();
+
+    void update();
+
+    bool available() const;
+    bool available(Resource res) const;
+    const psi_stat_t &stat(Resource res) const;
+
+    /**
+     * @brief someStall Share of time at least one task stalled between the last two updates, 0~1
+     */
+    qreal someStall(Resource res) const;
+    /**
+     * @brief fullStall Share of time all non idle tasks stalled between the last two updates, 0~1
+     */
+    qreal fullStall(Resource res) const;
+
+    /**
+     * @brief cgroupOf Cgroup v2 path of process
+     * @return empty if process is gone or not in a cgroup v2 hierarchy
+     */
+    static QByteArray cgroupOf(pid_t pid);
+
+    /**
+     * @brief parse Parse pressure file content into stat
+     * @return false if there's no some line
+     */
+    static bool parse(const char *buf, size_t len, psi_stat_t &stat);
+
+private:
+    PressureInfo(const PressureInfo &) = delete;
+    PressureInfo &operator=(const PressureInfo &) = delete;
+
+    void init(const QByteArray &prefix, const char *suffix);
+    bool read(Resource res);
+
+    struct resource_t {
+        QByteArray path;
+        int fd {-1};
+        bool available {true};
+        psi_stat_t stat {};
+        qreal someStall {0};
+        qreal fullStall {0};
+    };
+    resource_t m_res[kPressureResourceCount];
+
+    struct timespec m_lastTime {0, 0}; // time of last update, monotonic
+    bool m_sampled {false}; // last update exists
+};
+
+} // namespace system
+} // namespace core
+
+#endif // PRESSURE_H
@@ -7,6 +7,7 @@
 #define CPU_SET_P_H
 
 #include "system/cpu.h"
+#include "system/proc_stat.h"
 
 #include <QSharedData>
 #include <QMap>
@@ -39,10 +40,15 @@ public:
         , m_virtualization {}
         , m_stat {std::make_shared<cpu_stat_t>()}
         , m_usage {std::make_shared<cpu_usage_t>()}
-        , m_statDB {}
-        , m_usageDB {}
+        , m_procStat {}
+        , m_cpuNames {}
+        , m_namedCpus {}
         , m_info {}
         , m_infos {}
+        , m_topology {}
+        , m_topologyLoaded {false}
+        , m_nstatcpus {0}
+        , m_loadedStatCpus {0}
     {
 
     }
@@ -61,20 +67,15 @@ public:
         , m_virtualization(other.m_virtualization)
         , m_stat(std::make_shared<cpu_stat_t>(*(other.m_stat)))
         , m_usage(std::make_shared<cpu_usage_t>(*(other.m_usage)))
+        , m_procStat(other.m_procStat)
+        , m_cpuNames(other.m_cpuNames)
+        , m_namedCpus(other.m_namedCpus)
         , m_info(other.m_info)
+        , m_topology(other.m_topology)
+        , m_topologyLoaded(other.m_topologyLoaded)
+        , m_nstatcpus(other.m_nstatcpus)
+        , m_loadedStatCpus(other.m_loadedStatCpus)
     {
-        for (auto &stat : other.m_statDB) {
-            if (stat) {
-                auto cp = std::make_shared<cpu_stat_t>(*stat);
-                m_statDB[stat->cpu] = cp;
-            }
-        }
-        for (auto &usage : other.m_usageDB) {
-            if (usage) {
-                auto cp = std::make_shared<cpu_usage_t>(*usage);
-                m_usageDB[usage->cpu] = cp;
-            }
-        }
         for (auto &info : other.m_infos) {
             CPUInfo cp(info);
             m_infos << cp;
@@ -97,14 +98,20 @@ private:
     CPUStat m_stat; // overall stat
     CPUUsage m_usage; // overall usage
 
-    QMap<QByteArray, CPUStat> m_statDB; // per cpu stat
-    QMap<QByteArray, CPUUsage> m_usageDB; // per cpu usage
+    proc_stat_t m_procStat; // last /proc/stat read, per cpu stat indexed by cpu id
+    QList<QByteArray> m_cpuNames; // logical names of online cpus, e.g. cpu0
+    QVector<int> m_namedCpus; // cpu ids of m_cpuNames
 
     qulonglong cpusageTotal[kStatCount] = {0, 0};
     friend class CPUSet;
 
     QMap<QString, QString> m_info;   //overall info
     QList<CPUInfo> m_infos;         //per cpu info
+    QVector<cpu_topology_t> m_topology; // online cpus, ordered by socket, core & cpu id
+
+    bool m_topologyLoaded; // m_info & m_infos loaded
+    int m_nstatcpus; // online cpus in last /proc/stat read
+    int m_loadedStatCpus; // online cpus when m_info & m_infos were loaded
 };
 
 } // namespace system
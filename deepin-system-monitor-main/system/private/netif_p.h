@@ -36,7 +36,12 @@ struct iw_info_t {
     struct iw_quality qual {
         0, 0, 0, 0
     };
-    // bitrate
+    // from nl80211 station info
+    int signal {0}; // dBm, 0 if unknown
+    uint tx_bitrate {0}; // 100 kbit/s
+    uint rx_bitrate {0}; // 100 kbit/s
+    int tx_mcs {-1}; // -1 if legacy rate or unknown
+    int rx_mcs {-1}; // -1 if legacy rate or unknown
     // mode
     // ap/cell
     // txpower
@@ -109,6 +114,8 @@ public:
         , addr4infolst {other.addr4infolst}
         , addr6infolst {other.addr6infolst}
         , iw_info {std::unique_ptr<iw_info_t>(new iw_info_t(*(other.iw_info)))}
+        , isWireless {other.isWireless}
+        , isVirtual {other.isVirtual}
         , rx_packets {other.rx_packets}
         , rx_bytes {other.rx_bytes}
         , rx_errors {other.rx_errors}
@@ -156,6 +163,8 @@ private:
     // wireless link extension
     std::unique_ptr<iw_info_t> iw_info;
     bool isWireless = false;
+    // no backing device (veth, bridge, tun...)
+    bool isVirtual = false;
     // ====stats====
 
     unsigned long long rx_packets; // total packets received
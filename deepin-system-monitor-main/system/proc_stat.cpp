@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "proc_stat.h"
+#include "common/common.h"
+
+#include <QDebug>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+// initial read buffer, grown when the file does not fit
+#define PROC_STAT_BUF_SIZE (16 * 1024)
+// upper bound of cpu ids (CONFIG_NR_CPUS max), higher ids are taken as garbage
+#define PROC_STAT_CPU_ID_MAX 8192
+
+using namespace common::error;
+
+namespace core {
+namespace system {
+
+namespace {
+
+// skip blanks, then scan a decimal number; p is left on the first non digit
+inline unsigned long long scanNumber(const char *&p, const char *end)
+{
+    while (p < end && *p == ' ')
+        ++p;
+
+    unsigned long long v = 0;
+    for (; p < end; ++p) {
+        unsigned d = unsigned(*p - '0');
+        if (d > 9)
+            break;
+        v = v * 10 + d;
+    }
+    return v;
+}
+
+inline bool startsWith(const char *p, const char *end, const char *prefix, size_t n)
+{
+    return size_t(end - p) >= n && memcmp(p, prefix, n) == 0;
+}
+
+// fields missing on older kernels (steal, guest, guest_nice) are read as 0
+inline void scanCpu(const char *p, const char *end, proc_stat_cpu_t &cpu)
+{
+    cpu.user = scanNumber(p, end);
+    cpu.nice = scanNumber(p, end);
+    cpu.sys = scanNumber(p, end);
+    cpu.idle = scanNumber(p, end);
+    cpu.iowait = scanNumber(p, end);
+    cpu.hardirq = scanNumber(p, end);
+    cpu.softirq = scanNumber(p, end);
+    cpu.steal = scanNumber(p, end);
+    cpu.guest = scanNumber(p, end);
+    cpu.guest_nice = scanNumber(p, end);
+}
+
+} // namespace
+
+ProcStatReader::ProcStatReader(const QByteArray &path)
+    : m_path(path)
+    , m_fd(-1)
+    , m_buf(PROC_STAT_BUF_SIZE, '\0')
+{
+}
+
+ProcStatReader::~ProcStatReader()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool ProcStatReader::read(proc_stat_t &stat)
+{
+    if (m_fd < 0) {
+        errno = 0;
+        m_fd = open(m_path.constData(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            print_errno(errno, QString("open %1 failed").arg(QString(m_path)));
+            return false;
+        }
+    }
+
+    for (;;) {
+        // seq file restarts from the beginning on read at offset 0
+        ssize_t len = pread(m_fd, m_buf.data(), size_t(m_buf.size()), 0);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len < 0) {
+            print_errno(errno, QString("read %1 failed").arg(QString(m_path)));
+            return false;
+        }
+        if (len == m_buf.size()) {
+            // may be truncated, e.g. intr line of many irqs; read again into a larger buffer
+            m_buf.resize(m_buf.size() * 2);
+            continue;
+        }
+        if (!parse(m_buf.constData(), size_t(len), stat)) {
+            qWarning() << "read" << m_path << "failed, no cpu line";
+            return false;
+        }
+        return true;
+    }
+}
+
+bool ProcStatReader::parse(const char *buf, size_t len, proc_stat_t &stat)
+{
+    for (int id : stat.online)
+        stat.listed[id] = false;
+    stat.online.resize(0);
+
+    bool found = false;
+    const char *p = buf;
+    const char *end = buf + len;
+    while (p < end) {
+        auto *eol = static_cast<const char *>(memchr(p, '\n', size_t(end - p)));
+        if (!eol)
+            eol = end;
+
+        const char *q = p;
+        if (startsWith(p, eol, "cpu", 3)) {
+            q += 3;
+            if (q < eol && *q == ' ') {
+                scanCpu(q, eol, stat.cpu);
+                found = true;
+            } else {
+                auto id = scanNumber(q, eol);
+                if (q > p + 3 && id < PROC_STAT_CPU_ID_MAX) {
+                    int i = int(id);
+                    if (i >= stat.cpus.size()) {
+                        // new elements are zeroed
+                        stat.cpus.resize(i + 1);
+                        stat.listed.resize(i + 1);
+                    }
+                    scanCpu(q, eol, stat.cpus[i]);
+                    stat.listed[i] = true;
+                    stat.online << i;
+                }
+            }
+        } else if (startsWith(p, eol, "intr ", 5)) {
+            // total goes first, per irq counts are not needed
+            q += 5;
+            stat.intr = scanNumber(q, eol);
+        } else if (startsWith(p, eol, "ctxt ", 5)) {
+            q += 5;
+            stat.ctxt = scanNumber(q, eol);
+        } else if (startsWith(p, eol, "btime ", 6)) {
+            q += 6;
+            stat.btime = long(scanNumber(q, eol));
+        } else if (startsWith(p, eol, "procs_running ", 14)) {
+            q += 14;
+            stat.procsRunning = uint(scanNumber(q, eol));
+        } else if (startsWith(p, eol, "procs_blocked ", 14)) {
+            q += 14;
+            stat.procsBlocked = uint(scanNumber(q, eol));
+        }
+
+        p = eol + 1;
+    }
+
+    return found;
+}
+
+} // namespace system
+} // namespace core
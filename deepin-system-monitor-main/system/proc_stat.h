@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROC_STAT_H
+#define PROC_STAT_H
+
+#include <QByteArray>
+#include <QVector>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief One cpu line of /proc/stat, in jiffies
+ */
+struct proc_stat_cpu_t {
+    unsigned long long user;
+    unsigned long long nice;
+    unsigned long long sys;
+    unsigned long long idle;
+    unsigned long long iowait;
+    unsigned long long hardirq;
+    unsigned long long softirq;
+    unsigned long long steal;
+    unsigned long long guest; // included in user
+    unsigned long long guest_nice; // included in nice
+
+    inline unsigned long long total() const
+    {
+        return user + nice + sys + idle + iowait + hardirq + softirq + steal;
+    }
+    inline unsigned long long idleTotal() const
+    {
+        return idle + iowait;
+    }
+};
+
+/**
+ * @brief Values of the last /proc/stat read
+ *
+ * Per cpu values are indexed by cpu id. Offline cpus are not listed by the kernel,
+ * they keep the values of their last read & are left out of online.
+ */
+struct proc_stat_t {
+    proc_stat_cpu_t cpu {}; // all cpus
+    QVector<proc_stat_cpu_t> cpus; // per cpu
+    QVector<bool> listed; // cpu id listed in last read
+    QVector<int> online; // cpu ids listed in last read, ascending
+    unsigned long long ctxt {0}; // context switches since boot
+    unsigned long long intr {0}; // interrupts serviced since boot
+    long btime {0}; // boot time, seconds since epoch
+    unsigned int procsRunning {0}; // runnable tasks
+    unsigned int procsBlocked {0}; // tasks blocked on io
+};
+
+/**
+ * @brief /proc/stat reader, kept open & re-read with one pread each refresh
+ *
+ * Numbers are scanned in place from the read buffer. Buffer & per cpu arrays are reused
+ * across reads, so a refresh does not allocate once the highest cpu id has been seen.
+ */
+class ProcStatReader
+{
+public:
+    explicit ProcStatReader(const QByteArray &path = "/proc/stat");
+    ~ProcStatReader();
+
+    /**
+     * @brief read Read & parse the file into stat
+     * @return false if file could not be read or has no overall cpu line
+     */
+    bool read(proc_stat_t &stat);
+
+    /**
+     * @brief parse Parse /proc/stat content into stat
+     * @return false if there's no overall cpu line
+     */
+    static bool parse(const char *buf, size_t len, proc_stat_t &stat);
+
+private:
+    ProcStatReader(const ProcStatReader &) = delete;
+    ProcStatReader &operator=(const ProcStatReader &) = delete;
+
+    QByteArray m_path;
+    int m_fd;
+    QByteArray m_buf;
+};
+
+} // namespace system
+} // namespace core
+
+#endif // PROC_STAT_H
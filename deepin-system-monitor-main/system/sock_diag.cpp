@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sock_diag.h"
+#include "common/common.h"
+
+#include <QDebug>
+
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/rtnetlink.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+// receive buffer of one recv call, kernel fills it with as many messages as fit
+#define SOCK_DIAG_RECV_BUF_SIZE (32 * 1024)
+
+using namespace common::error;
+
+namespace core {
+namespace system {
+
+// request sockets never match a captured flow, time-wait sockets have no inode; listening sockets
+// don't match either but are listed by the connections view
+const quint32 kTcpDumpStates = ~((1u << TCP_SYN_RECV) | (1u << TCP_TIME_WAIT));
+// connected (TCP_ESTABLISHED) & unconnected (TCP_CLOSE) udp sockets
+const quint32 kUdpDumpStates = ~0u;
+
+// kernel struct tcp_info up to tcpi_segs_in, glibc's copy of it ends at tcpi_total_retrans
+struct tcp_info_bytes_t {
+    quint8 head[offsetof(struct tcp_info, tcpi_total_retrans) + sizeof(quint32)];
+    quint64 tcpi_pacing_rate;
+    quint64 tcpi_max_pacing_rate;
+    quint64 tcpi_bytes_acked; // since linux 4.1
+    quint64 tcpi_bytes_received; // since linux 4.1
+    quint32 tcpi_segs_out; // since linux 4.2
+    quint32 tcpi_segs_in; // since linux 4.2
+};
+static_assert(offsetof(tcp_info_bytes_t, tcpi_bytes_acked) == 120, "tcp_info layout mismatch");
+
+// both ends on loopback, such traffic never leaves the host & loopback is not captured either
+static bool isLoopbackSock(const struct inet_diag_msg *diag)
+{
+    auto loopback = [diag](const quint32 *addr) {
+        if (diag->idiag_family == AF_INET)
+            return (ntohl(addr[0]) >> 24) == 127;
+        auto *addr6 = reinterpret_cast<const struct in6_addr *>(addr);
+        return IN6_IS_ADDR_LOOPBACK(addr6) || (IN6_IS_ADDR_V4MAPPED(addr6) && (ntohl(addr[3]) >> 24) == 127);
+    };
+    return loopback(diag->id.idiag_src) && loopback(diag->id.idiag_dst);
+}
+
+SockDiag::SockDiag()
+    : m_fd(-1)
+    , m_seq(0)
+{
+    errno = 0;
+    m_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (m_fd < 0) {
+        print_errno(errno, "create sock_diag socket failed");
+    }
+}
+
+SockDiag::~SockDiag()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool SockDiag::readSockStat(int family, int proto, SockStatMap &statMap)
+{
+    return dump(family, proto, 0, [proto, &statMap](const char *buf, size_t len, quint32 seq) {
+        return parseMessages(buf, len, seq, proto, statMap);
+    });
+}
+
+bool SockDiag::readTcpBytes(int family, SockBytesMap &bytesMap)
+{
+    return dump(family, IPPROTO_TCP, quint8(1 << (INET_DIAG_INFO - 1)), [&bytesMap](const char *buf, size_t len, quint32 seq) {
+        return parseTcpInfoMessages(buf, len, seq, bytesMap);
+    });
+}
+
+bool SockDiag::dump(int family, int proto, quint8 ext, const DumpParser &parse)
+{
+    if (m_fd < 0)
+        return false;
+
+    struct {
+        struct nlmsghdr nlh;
+        struct inet_diag_req_v2 req;
+    } msg {};
+    msg.nlh.nlmsg_len = sizeof(msg);
+    msg.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    msg.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    msg.nlh.nlmsg_seq = ++m_seq;
+    msg.req.sdiag_family = quint8(family);
+    msg.req.sdiag_protocol = quint8(proto);
+    msg.req.idiag_ext = ext;
+    msg.req.idiag_states = (proto == IPPROTO_TCP) ? kTcpDumpStates : kUdpDumpStates;
+
+    struct sockaddr_nl addr {};
+    addr.nl_family = AF_NETLINK;
+
+    errno = 0;
+    if (sendto(m_fd, &msg, sizeof(msg), 0, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+        print_errno(errno, "send sock_diag request failed");
+        return false;
+    }
+
+    alignas(struct nlmsghdr) char buf[SOCK_DIAG_RECV_BUF_SIZE];
+    for (;;) {
+        ssize_t len = recv(m_fd, buf, sizeof(buf), 0);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            print_errno(errno, "read sock_diag dump failed");
+            return false;
+        }
+        if (len == 0)
+            return false;
+
+        // remains of an earlier dump that failed halfway are skipped by sequence number
+        int rc = parse(buf, size_t(len), m_seq);
+        if (rc != 0) {
+            if (rc < 0) {
+                // drain the rest of this dump, so replies of the next request are not mixed up with it
+                while (recv(m_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+                }
+            }
+            return rc > 0;
+        }
+    }
+}
+
+int SockDiag::parseMessages(const char *buf, size_t len, quint32 seq, int proto, SockStatMap &statMap)
+{
+    int remain = int(len);
+    for (auto *nlh = reinterpret_cast<const struct nlmsghdr *>(buf); NLMSG_OK(nlh, remain); nlh = NLMSG_NEXT(nlh, remain)) {
+        // left over from an earlier dump, its DONE or ERROR does not end this one
+        if (nlh->nlmsg_seq != seq)
+            continue;
+        if (nlh->nlmsg_type == NLMSG_DONE)
+            return 1;
+        if (nlh->nlmsg_type == NLMSG_ERROR) {
+            // ENOENT if inet_diag module of this protocol is not available
+            auto *err = reinterpret_cast<const struct nlmsgerr *>(NLMSG_DATA(nlh));
+            qDebug() << "sock_diag dump failed:" << strerror(-err->error);
+            return -1;
+        }
+        if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY)
+            continue;
+
+        auto *diag = reinterpret_cast<const struct inet_diag_msg *>(NLMSG_DATA(nlh));
+        // socket still in waiting state
+        if (diag->idiag_inode == 0)
+            continue;
+
+        auto stat = QSharedPointer<struct sock_stat_t>::create();
+        stat->ino = diag->idiag_inode;
+        stat->sa_family = diag->idiag_family;
+        stat->proto = proto;
+        stat->uid = diag->idiag_uid;
+        stat->state = diag->idiag_state;
+        stat->s_port = ntohs(diag->id.idiag_sport);
+        stat->d_port = ntohs(diag->id.idiag_dport);
+        // idiag_src & idiag_dst hold the address in network byte order, ipv4 in the first word
+        memcpy(&stat->s_addr, diag->id.idiag_src, sizeof(stat->s_addr));
+        memcpy(&stat->d_addr, diag->id.idiag_dst, sizeof(stat->d_addr));
+
+        insertSockStat(statMap, stat);
+    }
+
+    return 0;
+}
+
+int SockDiag::parseTcpInfoMessages(const char *buf, size_t len, quint32 seq, SockBytesMap &bytesMap)
+{
+    int remain = int(len);
+    for (auto *nlh = reinterpret_cast<const struct nlmsghdr *>(buf); NLMSG_OK(nlh, remain); nlh = NLMSG_NEXT(nlh, remain)) {
+        // left over from an earlier dump, its DONE or ERROR does not end this one
+        if (nlh->nlmsg_seq != seq)
+            continue;
+        if (nlh->nlmsg_type == NLMSG_DONE)
+            return 1;
+        if (nlh->nlmsg_type == NLMSG_ERROR) {
+            auto *err = reinterpret_cast<const struct nlmsgerr *>(NLMSG_DATA(nlh));
+            qDebug() << "sock_diag dump failed:" << strerror(-err->error);
+            return -1;
+        }
+        if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY)
+            continue;
+
+        auto *diag = reinterpret_cast<const struct inet_diag_msg *>(NLMSG_DATA(nlh));
+        if (diag->idiag_inode == 0 || isLoopbackSock(diag))
+            continue;
+
+        // extensions follow the message as route attributes
+        int attrlen = int(nlh->nlmsg_len) - int(NLMSG_LENGTH(sizeof(*diag)));
+        auto *attr = reinterpret_cast<const struct rtattr *>(diag + 1);
+        for (; RTA_OK(attr, attrlen); attr = RTA_NEXT(attr, attrlen)) {
+            if (attr->rta_type != INET_DIAG_INFO)
+                continue;
+
+            // kernel sends its own size of tcp_info, copy what both sides know of
+            size_t infolen = RTA_PAYLOAD(attr);
+            if (infolen < offsetof(tcp_info_bytes_t, tcpi_segs_out)) {
+                qDebug() << "tcp_info has no byte counters, size" << infolen;
+                return -1;
+            }
+            tcp_info_bytes_t info {};
+            memcpy(&info, RTA_DATA(attr), qMin(infolen, sizeof(info)));
+
+            sock_bytes_t &bytes = bytesMap[diag->idiag_inode];
+            bytes.rx_bytes = info.tcpi_bytes_received;
+            bytes.tx_bytes = info.tcpi_bytes_acked;
+            bytes.rx_segs = info.tcpi_segs_in;
+            bytes.tx_segs = info.tcpi_segs_out;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace system
+} // namespace core
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SOCK_DIAG_H
+#define SOCK_DIAG_H
+
+#include "packet.h"
+
+#include <QHash>
+#include <QtGlobal>
+
+#include <functional>
+
+#include <sys/types.h>
+
+namespace core {
+namespace system {
+
+/**
+ * @brief Kernel byte & segment counters of one tcp socket (tcp_info)
+ */
+struct sock_bytes_t {
+    qulonglong rx_bytes {}; // tcpi_bytes_received
+    qulonglong tx_bytes {}; // tcpi_bytes_acked
+    quint32 rx_segs {}; // tcpi_segs_in, wraps around
+    quint32 tx_segs {}; // tcpi_segs_out, wraps around
+};
+using SockBytesMap = QHash<ino_t, sock_bytes_t>; // [inode, counters]
+
+/**
+ * @brief Socket table reader based on NETLINK_SOCK_DIAG (inet_diag)
+ *
+ * Kernel dumps sockets as binary netlink messages carrying inode, uid & 4-tuple,
+ * so no text parsing or address formatting is needed. The netlink socket is kept
+ * open between dumps, one instance must only be used by one thread at a time.
+ */
+class SockDiag
+{
+public:
+    explicit SockDiag();
+    ~SockDiag();
+
+    /**
+     * @brief isValid Whether the sock_diag netlink socket is usable
+     */
+    inline bool isValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief readSockStat Dump sockets of one address family & protocol
+     * @param family AF_INET or AF_INET6
+     * @param proto IPPROTO_TCP or IPPROTO_UDP
+     * @param statMap Sockets are added to this map
+     * @return false if the dump failed, e.g. diag module of proto not loaded
+     */
+    bool readSockStat(int family, int proto, SockStatMap &statMap);
+
+    /**
+     * @brief parseMessages Add sockets in a buffer of inet_diag netlink messages to map
+     * @param buf Netlink messages as received from kernel
+     * @param len Buffer length
+     * @param seq Sequence number of the dump, messages of earlier dumps are skipped
+     * @param proto Protocol of the dump
+     * @param statMap Sockets are added to this map
+     * @return 1 if end of dump reached, 0 if more messages follow, -1 on error
+     */
+    static int parseMessages(const char *buf, size_t len, quint32 seq, int proto, SockStatMap &statMap);
+
+    /**
+     * @brief readTcpBytes Dump byte counters of tcp sockets of one address family
+     * @param family AF_INET or AF_INET6
+     * @param bytesMap Counters are added to this map by socket inode
+     * @return false if the dump failed or kernel tcp_info has no byte counters (before 4.1)
+     */
+    bool readTcpBytes(int family, SockBytesMap &bytesMap);
+
+    /**
+     * @brief parseTcpInfoMessages Add counters in a buffer of inet_diag messages with INET_DIAG_INFO to map,
+     * sockets with both ends on loopback are left out like loopback packets are left out of capture
+     * @param buf Netlink messages as received from kernel
+     * @param len Buffer length
+     * @param seq Sequence number of the dump, messages of earlier dumps are skipped
+     * @param bytesMap Counters are added to this map by socket inode
+     * @return 1 if end of dump reached, 0 if more messages follow, -1 on error
+     */
+    static int parseTcpInfoMessages(const char *buf, size_t len, quint32 seq, SockBytesMap &bytesMap);
+
+private:
+    // parser of one received buffer & sequence number of the dump, returns as parseMessages does
+    using DumpParser = std::function<int(const char *, size_t, quint32)>;
+
+    /**
+     * @brief dump Request a socket dump & feed replies to parser until done
+     * @param ext INET_DIAG_* extensions to include, as bit mask of (1 << (ext - 1))
+     */
+    bool dump(int family, int proto, quint8 ext, const DumpParser &parse);
+
+private:
+    SockDiag(const SockDiag &) = delete;
+    SockDiag &operator=(const SockDiag &) = delete;
+
+private:
+    int m_fd;
+    quint32 m_seq;
+};
+
+} // namespace system
+} // namespace core
+
+#endif // SOCK_DIAG_H
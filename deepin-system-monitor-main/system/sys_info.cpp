@@ -12,6 +12,7 @@
 #include "common/thread_manager.h"
 #include "system/system_monitor_thread.h"
 #include "packet.h"
+#include "sock_diag.h"
 #include <DSysInfo>
 
 #include <QString>
@@ -27,7 +28,6 @@
 #include <stdio.h>
 #include <sys/sysinfo.h>
 #include <arpa/inet.h>
-#include "common/hash.h"
 
 #define PROC_PATH_SOCK_TCP  "/proc/net/tcp"
 #define PROC_PATH_SOCK_TCP6 "/proc/net/tcp6"
@@ -78,131 +78,95 @@ SysInfo *SysInfo::instance()
 
 bool SysInfo::readSockStat(SockStatMap &statMap)
 {
-    bool ok {true};
-
-    auto parseSocks = [](int family, int proto, const char *proc, SockStatMap & statMap) -> bool {
-        bool ok {true};
-        FILE *fp {};
-        const size_t BLEN = 4096;
-        QByteArray buffer {BLEN, 0};
-        int nr {};
-        ino_t ino {};
-        char s_addr[128] {}, d_addr[128] {};
-        uint64_t hash {};
-        QByteArray fmtbuf {};
-        uint64_t cchash[2] {};
-        QString patternA {}, patternB {};
-
-        errno = 0;
-        if (!(fp = fopen(proc, "r")))
-        {
-            return !ok;
-        }
-
-        while (fgets(buffer.data(), BLEN, fp))
-        {
-            auto stat = QSharedPointer<struct sock_stat_t>::create();
-
-            //*****************************************************************
-            nr = sscanf(buffer.data(), "%*s %64[0-9A-Fa-f]:%x %64[0-9A-Fa-f]:%x %*x %*s %*s %*s %u %*u %ld",
-                        s_addr,
-                        &stat->s_port,
-                        d_addr,
-                        &stat->d_port,
-                        &stat->uid,
-                        &ino);
-
-            // ignore first line
-            if (nr == 0)
-                continue;
-
-            // socket still in waiting state
-            if (ino == 0) {
-                continue;
-            }
-
-            stat->ino = ino;
-            stat->sa_family = family;
-            stat->proto = proto;
-
-            // saddr & daddr
-            if (family == AF_INET6) {
-                sscanf(s_addr, "%08x%08x%08x%08x",
-                       &stat->s_addr.in6.s6_addr32[0],
-                       &stat->s_addr.in6.s6_addr32[1],
-                       &stat->s_addr.in6.s6_addr32[2],
-                       &stat->s_addr.in6.s6_addr32[3]);
-                sscanf(d_addr, "%08x%08x%08x%08x",
-                       &stat->d_addr.in6.s6_addr32[0],
-                       &stat->d_addr.in6.s6_addr32[1],
-                       &stat->d_addr.in6.s6_addr32[2],
-                       &stat->d_addr.in6.s6_addr32[3]);
-                // convert ipv4 mapped ipv6 address to ipv4
-                if (stat->s_addr.in6.s6_addr32[0] == 0x0 &&
-                        stat->s_addr.in6.s6_addr32[1] == 0x0 &&
-                        stat->s_addr.in6.s6_addr32[2] == 0xffff0000) {
-                    stat->sa_family = AF_INET;
-                    stat->s_addr.in4.s_addr = stat->s_addr.in6.s6_addr32[3];
-                    stat->d_addr.in4.s_addr = stat->d_addr.in6.s6_addr32[3];
-                }
-            } else {
-                sscanf(s_addr, "%x", &stat->s_addr.in4.s_addr);
-                sscanf(d_addr, "%x", &stat->d_addr.in4.s_addr);
-            }
-
-            if (stat->sa_family == AF_INET) {
-                char saddr_str[INET_ADDRSTRLEN + 1] {}, daddr_str[INET_ADDRSTRLEN + 1] {};
-                inet_ntop(AF_INET, &stat->s_addr.in4, saddr_str, INET_ADDRSTRLEN);
-                inet_ntop(AF_INET, &stat->d_addr.in4, daddr_str, INET_ADDRSTRLEN);
+    struct SockTable {
+        int family;
+        int proto;
+        const char *proc;
+    };
+    const SockTable tables[] = {
+        {AF_INET, IPPROTO_TCP, PROC_PATH_SOCK_TCP},
+        {AF_INET, IPPROTO_UDP, PROC_PATH_SOCK_UDP},
+        {AF_INET6, IPPROTO_TCP, PROC_PATH_SOCK_TCP6},
+        {AF_INET6, IPPROTO_UDP, PROC_PATH_SOCK_UDP6},
+    };
+    // netlink socket kept open for the capture thread calling us
+    thread_local SockDiag diag;
 
-                patternA = QString("%1:%2-%3:%4").arg(saddr_str).arg(stat->s_port).arg(daddr_str).arg(stat->d_port);
-                if (proto == IPPROTO_TCP) {
-                    patternB = QString("%1:%2-%3:%4").arg(daddr_str).arg(stat->d_port).arg(saddr_str).arg(stat->s_port);
-                }
+    bool ok {true};
+    statMap.clear();
+    for (const SockTable &table : tables) {
+        // fall back to procfs table if inet_diag of this family/proto is not available
+        if (!diag.readSockStat(table.family, table.proto, statMap))
+            ok = readSockStatFile(table.family, table.proto, table.proc, statMap) && ok;
+    }
 
-            } else if (stat->sa_family == AF_INET6) {
-                char saddr6_str[INET6_ADDRSTRLEN + 1] {}, daddr6_str[INET6_ADDRSTRLEN + 1] {};
-                inet_ntop(AF_INET6, &stat->s_addr.in6, saddr6_str, INET6_ADDRSTRLEN);
-                inet_ntop(AF_INET6, &stat->d_addr.in6, daddr6_str, INET6_ADDRSTRLEN);
+    return ok;
+}
 
-                patternA = QString("%1:%2-%3:%4").arg(saddr6_str).arg(stat->s_port).arg(daddr6_str).arg(stat->d_port);
-                if (proto == IPPROTO_TCP) {
-                    patternB = QString("%1:%2-%3:%4").arg(daddr6_str).arg(stat->d_port).arg(saddr6_str).arg(stat->s_port);
-                }
+bool SysInfo::readSockStatFile(int family, int proto, const char *proc, SockStatMap &statMap)
+{
+    bool ok {true};
+    FILE *fp {};
+    const size_t BLEN = 4096;
+    QByteArray buffer {BLEN, 0};
+    int nr {};
+    ino_t ino {};
+    char s_addr[128] {}, d_addr[128] {};
 
-            } else {
-                // unexpected here
-            }
+    errno = 0;
+    if (!(fp = fopen(proc, "r"))) {
+        return !ok;
+    }
 
-            fmtbuf = patternA.toLocal8Bit();
-            util::common::hash(fmtbuf.constData(), fmtbuf.length(), util::common::global_seed, cchash);
-            hash = cchash[0];
-            statMap.insert(hash, stat);
-
-            // if it's TCP, we need add reverse mapping due to its bidirectional piping feature,
-            // otherwise we wont be able to get the inode
-            if (proto == IPPROTO_TCP) {
-                fmtbuf = patternB.toLocal8Bit();
-                util::common::hash(fmtbuf.constData(), fmtbuf.length(), util::common::global_seed, cchash);
-                hash = cchash[0];
-                statMap.insert(hash, stat);
-            }
+    while (fgets(buffer.data(), BLEN, fp)) {
+        auto stat = QSharedPointer<struct sock_stat_t>::create();
+
+        //*****************************************************************
+        nr = sscanf(buffer.data(), "%*s %64[0-9A-Fa-f]:%x %64[0-9A-Fa-f]:%x %x %*s %*s %*s %u %*u %ld",
+                    s_addr,
+                    &stat->s_port,
+                    d_addr,
+                    &stat->d_port,
+                    &stat->state,
+                    &stat->uid,
+                    &ino);
+
+        // ignore first line
+        if (nr == 0)
+            continue;
+
+        // socket still in waiting state
+        if (ino == 0) {
+            continue;
         }
-        if (ferror(fp))
-        {
-            ok = !ok;
-        }
-        fclose(fp);
-
-        return ok;
-    };
 
-    statMap.clear();
+        stat->ino = ino;
+        stat->sa_family = family;
+        stat->proto = proto;
+
+        // saddr & daddr, printed as raw 32bit words in host byte order
+        if (family == AF_INET6) {
+            sscanf(s_addr, "%08x%08x%08x%08x",
+                   &stat->s_addr.in6.s6_addr32[0],
+                   &stat->s_addr.in6.s6_addr32[1],
+                   &stat->s_addr.in6.s6_addr32[2],
+                   &stat->s_addr.in6.s6_addr32[3]);
+            sscanf(d_addr, "%08x%08x%08x%08x",
+                   &stat->d_addr.in6.s6_addr32[0],
+                   &stat->d_addr.in6.s6_addr32[1],
+                   &stat->d_addr.in6.s6_addr32[2],
+                   &stat->d_addr.in6.s6_addr32[3]);
+        } else {
+            sscanf(s_addr, "%x", &stat->s_addr.in4.s_addr);
+            sscanf(d_addr, "%x", &stat->d_addr.in4.s_addr);
+        }
 
-    ok = parseSocks(AF_INET, IPPROTO_TCP, PROC_PATH_SOCK_TCP, statMap);
-    ok = parseSocks(AF_INET, IPPROTO_UDP, PROC_PATH_SOCK_UDP, statMap) && ok;
-    ok = parseSocks(AF_INET6, IPPROTO_TCP, PROC_PATH_SOCK_TCP6, statMap) && ok;
-    ok = parseSocks(AF_INET6, IPPROTO_UDP, PROC_PATH_SOCK_UDP6, statMap) && ok;
+        insertSockStat(statMap, stat);
+    }
+    if (ferror(fp)) {
+        ok = !ok;
+    }
+    fclose(fp);
 
     return ok;
 }
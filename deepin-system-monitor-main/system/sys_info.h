@@ -77,9 +77,19 @@ public:
 
     void readSysInfo();
     void readSysInfoStatic();
+    /**
+     * @brief readSockStat Read tcp & udp socket tables, through inet_diag if available, procfs otherwise
+     * @param statMap Socket map keyed by flow
+     * @return true if all tables have been read
+     */
     static bool readSockStat(SockStatMap &statMap);
 
 private:
+    /**
+     * @brief readSockStatFile Parse a /proc/net/{tcp,udp}{,6} socket table
+     */
+    static bool readSockStatFile(int family, int proto, const char *proc, SockStatMap &statMap);
+
     quint32 read_file_nr();
     quint32 read_threads();
     quint32 read_processes();
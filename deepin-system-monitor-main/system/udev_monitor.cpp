@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "udev_monitor.h"
+#include "udev.h"
+
+#include <QDebug>
+
+#include <libudev.h>
+
+namespace core {
+namespace system {
+
+UDevMonitor::UDevMonitor(const UDev *udev, const QByteArray &subsystem)
+    : m_monitor(nullptr)
+{
+    if (!udev || !udev->handle())
+        return;
+
+    // events processed by udevd, socket is created non-blocking
+    m_monitor = udev_monitor_new_from_netlink(udev->handle(), "udev");
+    if (!m_monitor) {
+        qWarning() << "create udev monitor failed";
+        return;
+    }
+    if (udev_monitor_filter_add_match_subsystem_devtype(m_monitor, subsystem.constData(), nullptr) < 0
+            || udev_monitor_enable_receiving(m_monitor) < 0) {
+        qWarning() << "enable udev monitor failed, subsystem:" << subsystem;
+        udev_monitor_unref(m_monitor);
+        m_monitor = nullptr;
+    }
+}
+
+UDevMonitor::~UDevMonitor()
+{
+    if (m_monitor)
+        udev_monitor_unref(m_monitor);
+}
+
+bool UDevMonitor::takeEvents()
+{
+    if (!m_monitor)
+        return false;
+
+    bool pending = false;
+    while (auto *device = udev_monitor_receive_device(m_monitor)) {
+        pending = true;
+        udev_device_unref(device);
+    }
+    return pending;
+}
+
+} // namespace system
+} // namespace core
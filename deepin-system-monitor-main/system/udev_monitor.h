@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef UDEV_MONITOR_H
+#define UDEV_MONITOR_H
+
+#include <QByteArray>
+
+struct udev_monitor;
+
+namespace core {
+namespace system {
+
+class UDev;
+
+/**
+ * @brief Non-blocking listener of udev events of one subsystem
+ *
+ * Polled by its owner on each refresh instead of being read by an event loop,
+ * events are only counted, not interpreted.
+ */
+class UDevMonitor
+{
+public:
+    using HANDLE = struct udev_monitor *;
+
+    /**
+     * @param udev Udev context, must outlive the monitor
+     * @param subsystem Subsystem to listen to, e.g. cpu
+     */
+    explicit UDevMonitor(const UDev *udev, const QByteArray &subsystem);
+    ~UDevMonitor();
+
+    inline bool isValid() const
+    {
+        return m_monitor != nullptr;
+    }
+    /**
+     * @brief takeEvents Drain pending events
+     * @return true if any event was pending
+     */
+    bool takeEvents();
+
+private:
+    UDevMonitor(const UDevMonitor &) = delete;
+    UDevMonitor &operator=(const UDevMonitor &) = delete;
+
+    HANDLE m_monitor;
+};
+
+} // namespace system
+} // namespace core
+
+#endif // UDEV_MONITOR_H
@@ -45,6 +45,17 @@
         <translation type="unfinished"></translation>
     </message>
 </context>
+<context>
+    <name>CPUHeatmapWidget</name>
+    <message>
+        <source>Socket %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>(socket %1, core %2)</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>CPUInfoModel</name>
     <message>
@@ -148,6 +159,41 @@
         <translation type="unfinished"></translation>
     </message>
 </context>
+<context>
+    <name>Connection.Table.Header</name>
+    <message>
+        <source>Process</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>PID</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Protocol</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Local address</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Remote address</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>State</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Download</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Upload</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>CpuMonitor</name>
     <message>
@@ -645,6 +691,25 @@ Are you sure you want to continue?</translation>
         <source>TX dropped</source>
         <translation type="unfinished"></translation>
     </message>
+    <message>
+        <source>Capture dropped</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>PressureViewWidget</name>
+    <message>
+        <source>Some stalled</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Full stalled</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>Pressure %1% / %2% / %3% (10s / 60s / 300s)</source>
+        <translation type="unfinished"></translation>
+    </message>
 </context>
 <context>
     <name>Process.Attributes.Dialog</name>
@@ -660,6 +725,18 @@ Are you sure you want to continue?</translation>
         <source>Name</source>
         <translation>Name</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>Connections</translation>
+    </message>
+    <message>
+        <source>Cgroup pressure</source>
+        <translation>Cgroup pressure</translation>
+    </message>
+    <message>
+        <source>IO</source>
+        <translation>IO</translation>
+    </message>
 </context>
 <context>
     <name>Process.Choose.Window.Dialog</name>
@@ -1147,6 +1224,10 @@ Are you sure you want to continue?</translation>
         <source>Users</source>
         <translation>Users</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>Connections</translation>
+    </message>
 </context>
 <context>
     <name>User.Account.Type</name>
@@ -43,6 +43,17 @@
         <translation>60 seconds</translation>
     </message>
 </context>
+<context>
+    <name>CPUHeatmapWidget</name>
+    <message>
+        <source>Socket %1</source>
+        <translation>Socket %1</translation>
+    </message>
+    <message>
+        <source>(socket %1, core %2)</source>
+        <translation>(socket %1, core %2)</translation>
+    </message>
+</context>
 <context>
     <name>CPUInfoModel</name>
     <message>
@@ -150,6 +161,41 @@
         <translation>Details</translation>
     </message>
 </context>
+<context>
+    <name>Connection.Table.Header</name>
+    <message>
+        <source>Process</source>
+        <translation>Process</translation>
+    </message>
+    <message>
+        <source>PID</source>
+        <translation>PID</translation>
+    </message>
+    <message>
+        <source>Protocol</source>
+        <translation>Protocol</translation>
+    </message>
+    <message>
+        <source>Local address</source>
+        <translation>Local address</translation>
+    </message>
+    <message>
+        <source>Remote address</source>
+        <translation>Remote address</translation>
+    </message>
+    <message>
+        <source>State</source>
+        <translation>State</translation>
+    </message>
+    <message>
+        <source>Download</source>
+        <translation>Download</translation>
+    </message>
+    <message>
+        <source>Upload</source>
+        <translation>Upload</translation>
+    </message>
+</context>
 <context>
     <name>CpuMonitor</name>
     <message>
@@ -628,6 +674,25 @@ Are you sure you want to continue?</translation>
         <source>TX dropped</source>
         <translation>TX dropped</translation>
     </message>
+    <message>
+        <source>Capture dropped</source>
+        <translation>Capture dropped</translation>
+    </message>
+</context>
+<context>
+    <name>PressureViewWidget</name>
+    <message>
+        <source>Some stalled</source>
+        <translation>Some stalled</translation>
+    </message>
+    <message>
+        <source>Full stalled</source>
+        <translation>Full stalled</translation>
+    </message>
+    <message>
+        <source>Pressure %1% / %2% / %3% (10s / 60s / 300s)</source>
+        <translation>Pressure %1% / %2% / %3% (10s / 60s / 300s)</translation>
+    </message>
 </context>
 <context>
     <name>Process.Attributes.Dialog</name>
@@ -643,6 +708,18 @@ Are you sure you want to continue?</translation>
         <source>Name</source>
         <translation>Name</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>Connections</translation>
+    </message>
+    <message>
+        <source>Cgroup pressure</source>
+        <translation>Cgroup pressure</translation>
+    </message>
+    <message>
+        <source>IO</source>
+        <translation>IO</translation>
+    </message>
 </context>
 <context>
     <name>Process.Choose.Window.Dialog</name>
@@ -1114,6 +1191,10 @@ Are you sure you want to continue?</translation>
         <source>Users</source>
         <translation>Users</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>Connections</translation>
+    </message>
 </context>
 <context>
     <name>User.Account.Type</name>
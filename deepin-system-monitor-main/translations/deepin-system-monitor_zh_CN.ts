@@ -45,6 +45,17 @@
         <translation>60秒</translation>
     </message>
 </context>
+<context>
+    <name>CPUHeatmapWidget</name>
+    <message>
+        <source>Socket %1</source>
+        <translation>插槽 %1</translation>
+    </message>
+    <message>
+        <source>(socket %1, core %2)</source>
+        <translation>（插槽 %1，核心 %2）</translation>
+    </message>
+</context>
 <context>
     <name>CPUInfoModel</name>
     <message>
@@ -148,6 +159,41 @@
         <translation>详细信息</translation>
     </message>
 </context>
+<context>
+    <name>Connection.Table.Header</name>
+    <message>
+        <source>Process</source>
+        <translation>进程</translation>
+    </message>
+    <message>
+        <source>PID</source>
+        <translation>进程号</translation>
+    </message>
+    <message>
+        <source>Protocol</source>
+        <translation>协议</translation>
+    </message>
+    <message>
+        <source>Local address</source>
+        <translation>本地地址</translation>
+    </message>
+    <message>
+        <source>Remote address</source>
+        <translation>远程地址</translation>
+    </message>
+    <message>
+        <source>State</source>
+        <translation>状态</translation>
+    </message>
+    <message>
+        <source>Download</source>
+        <translation>下载</translation>
+    </message>
+    <message>
+        <source>Upload</source>
+        <translation>上传</translation>
+    </message>
+</context>
 <context>
     <name>CpuMonitor</name>
     <message>
@@ -645,6 +691,25 @@ Are you sure you want to continue?</source>
         <source>TX dropped</source>
         <translation>发送（丢弃包）</translation>
     </message>
+    <message>
+        <source>Capture dropped</source>
+        <translation>抓包（丢弃包）</translation>
+    </message>
+</context>
+<context>
+    <name>PressureViewWidget</name>
+    <message>
+        <source>Some stalled</source>
+        <translation>部分停滞</translation>
+    </message>
+    <message>
+        <source>Full stalled</source>
+        <translation>全部停滞</translation>
+    </message>
+    <message>
+        <source>Pressure %1% / %2% / %3% (10s / 60s / 300s)</source>
+        <translation>压力 %1% / %2% / %3%（10秒 / 60秒 / 300秒）</translation>
+    </message>
 </context>
 <context>
     <name>Process.Attributes.Dialog</name>
@@ -660,6 +725,18 @@ Are you sure you want to continue?</source>
         <source>Name</source>
         <translation>进程名</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>网络连接</translation>
+    </message>
+    <message>
+        <source>Cgroup pressure</source>
+        <translation>控制组压力</translation>
+    </message>
+    <message>
+        <source>IO</source>
+        <translation>磁盘读写</translation>
+    </message>
 </context>
 <context>
     <name>Process.Choose.Window.Dialog</name>
@@ -1129,6 +1206,10 @@ Are you sure you want to continue?</source>
         <source>Users</source>
         <translation>用户</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>网络连接</translation>
+    </message>
 </context>
 <context>
     <name>User.Account.Type</name>
@@ -43,6 +43,17 @@
         <translation>60秒</translation>
     </message>
 </context>
+<context>
+    <name>CPUHeatmapWidget</name>
+    <message>
+        <source>Socket %1</source>
+        <translation>插槽 %1</translation>
+    </message>
+    <message>
+        <source>(socket %1, core %2)</source>
+        <translation>（插槽 %1，核心 %2）</translation>
+    </message>
+</context>
 <context>
     <name>CPUInfoModel</name>
     <message>
@@ -150,6 +161,41 @@
         <translation>詳細訊息</translation>
     </message>
 </context>
+<context>
+    <name>Connection.Table.Header</name>
+    <message>
+        <source>Process</source>
+        <translation>進程</translation>
+    </message>
+    <message>
+        <source>PID</source>
+        <translation>進程號</translation>
+    </message>
+    <message>
+        <source>Protocol</source>
+        <translation>協定</translation>
+    </message>
+    <message>
+        <source>Local address</source>
+        <translation>本機位址</translation>
+    </message>
+    <message>
+        <source>Remote address</source>
+        <translation>遠端位址</translation>
+    </message>
+    <message>
+        <source>State</source>
+        <translation>狀態</translation>
+    </message>
+    <message>
+        <source>Download</source>
+        <translation>下載</translation>
+    </message>
+    <message>
+        <source>Upload</source>
+        <translation>上傳</translation>
+    </message>
+</context>
 <context>
     <name>CpuMonitor</name>
     <message>
@@ -628,6 +674,25 @@ Are you sure you want to continue?</source>
         <source>TX dropped</source>
         <translation>發送（丟棄包）</translation>
     </message>
+    <message>
+        <source>Capture dropped</source>
+        <translation>抓包（丟棄包）</translation>
+    </message>
+</context>
+<context>
+    <name>PressureViewWidget</name>
+    <message>
+        <source>Some stalled</source>
+        <translation>部分停滯</translation>
+    </message>
+    <message>
+        <source>Full stalled</source>
+        <translation>全部停滯</translation>
+    </message>
+    <message>
+        <source>Pressure %1% / %2% / %3% (10s / 60s / 300s)</source>
+        <translation>壓力 %1% / %2% / %3%（10秒 / 60秒 / 300秒）</translation>
+    </message>
 </context>
 <context>
     <name>Process.Attributes.Dialog</name>
@@ -643,6 +708,18 @@ Are you sure you want to continue?</source>
         <source>Name</source>
         <translation>名稱</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>網路連線</translation>
+    </message>
+    <message>
+        <source>Cgroup pressure</source>
+        <translation>控制組壓力</translation>
+    </message>
+    <message>
+        <source>IO</source>
+        <translation>磁碟讀寫</translation>
+    </message>
 </context>
 <context>
     <name>Process.Choose.Window.Dialog</name>
@@ -1114,6 +1191,10 @@ Are you sure you want to continue?</source>
         <source>Users</source>
         <translation>使用者</translation>
     </message>
+    <message>
+        <source>Connections</source>
+        <translation>網路連線</translation>
+    </message>
 </context>
 <context>
     <name>User.Account.Type</name>
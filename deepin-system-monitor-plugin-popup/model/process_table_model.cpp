@@ -8,6 +8,7 @@
 #include "common/common.h"
 
 #include <QDebug>
+#include <QHash>
 #include <QTimer>
 #include <DApplication>
 #include <DGuiApplicationHelper>
@@ -51,22 +52,14 @@ ProcessTableModel::ProcessTableModel(QObject *parent)
 
 char ProcessTableModel::getProcessState(pid_t pid) const
 {
-    if (m_procIdList.contains(pid)) {
-        return ProcessDB::instance()->processSet()->getProcessById(pid).state();
+    int row = m_procIdList.indexOf(pid);
+    if (row >= 0 && m_snapshotRows[row] >= 0) {
+        return m_snapshot.state()[m_snapshotRows[row]];
     }
 
     return 0;
 }
 
-Process ProcessTableModel::getProcess(pid_t pid) const
-{
-    if (m_procIdList.contains(pid)) {
-        return ProcessDB::instance()->processSet()->getProcessById(pid);
-    }
-
-    return Process();
-}
-
 // update process model with the data provided by list
 void ProcessTableModel::updateProcessList()
 {
@@ -75,33 +68,39 @@ void ProcessTableModel::updateProcessList()
 
 void ProcessTableModel::updateProcessListDelay()
 {
-    ProcessSet *processSet = ProcessDB::instance()->processSet();
-    const QList<pid_t> &newpidlst = processSet->getPIDList();
-    QList<pid_t> oldpidlst = m_procIdList;
+    // our copy shares columns with the published snapshot, nothing here touches monitor thread data
+    m_snapshot = *ProcessDB::instance()->snapshot();
+
+    // remap existing rows before any row is touched, rows of ended processes map to -1
+    QHash<pid_t, int> oldRows;
+    oldRows.reserve(m_procIdList.size());
+    for (int row = 0; row < m_procIdList.size(); ++row) {
+        oldRows.insert(m_procIdList[row], row);
+        m_snapshotRows[row] = m_snapshot.indexOf(m_procIdList[row]);
+    }
 
-    for (const auto &pid : newpidlst) {
-        int row = m_procIdList.indexOf(pid);
+    for (int srow = 0; srow < m_snapshot.size(); ++srow) {
+        pid_t pid = m_snapshot.pid()[srow];
+        int row = oldRows.value(pid, -1);
         if (row >= 0) {
             // update
-            m_processList[row] = processSet->getProcessById(pid);
             Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
         } else {
             // insert
             row = m_procIdList.size();
             beginInsertRows({}, row, row);
             m_procIdList << pid;
-            m_processList << processSet->getProcessById(pid);
+            m_snapshotRows << srow;
             endInsertRows();
         }
     }
 
-    // remove
-    for (const auto &pid : oldpidlst) {
-        if (!newpidlst.contains(pid)) {
-            int row = m_procIdList.indexOf(pid);
+    // remove, from the last row so that earlier rows keep their index
+    for (int row = m_procIdList.size() - 1; row >= 0; --row) {
+        if (m_snapshotRows[row] < 0) {
             beginRemoveRows({}, row, row);
             m_procIdList.removeAt(row);
-            m_processList.removeAt(row);
+            m_snapshotRows.removeAt(row);
             endRemoveRows();
         }
     }
@@ -154,21 +153,22 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         return {};
 
     // validate index
-    if (index.row() < 0 || index.row() >= m_processList.size())
+    if (index.row() < 0 || index.row() >= m_procIdList.size())
         return {};
 
-    int row = index.row();
-    const Process &proc = m_processList[row];
-    if (!proc.isValid())
+    int srow = m_snapshotRows[index.row()];
+    if (srow < 0)
         return {};
 
+    const ProcessSnapshot &snap = m_snapshot;
+
     if (role == Qt::DisplayRole || role == Qt::AccessibleTextRole) {
         QString name;
         switch (index.column()) {
         case kProcessNameColumn: {
             // prepended tag based on process state
-            name = proc.displayName();
-            switch (proc.state()) {
+            name = snap.displayName(srow);
+            switch (snap.state()[srow]) {
             case 'Z':
                 name = QString("(%1) %2")
                        .arg(QApplication::translate("Process.Table", "No response"))
@@ -184,7 +184,7 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         }
         case kProcessCPUColumn:
             // formated cpu percent utilization
-            return QString("%1%").arg(proc.cpu(), 0, 'f', 1);
+            return QString("%1%").arg(snap.cpu()[srow], 0, 'f', 1);
 
         default:
             break;
@@ -193,7 +193,7 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         switch (index.column()) {
         case kProcessNameColumn:
             // process icon
-            return proc.icon();
+            return snap.icon(srow);
         default:
             return {};
         }
@@ -201,10 +201,10 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
         // get process's raw data
         switch (index.column()) {
         case kProcessNameColumn:
-            return proc.name();
+            return snap.name(srow);
 
         case kProcessCPUColumn:
-            return proc.cpu();
+            return snap.cpu()[srow];
 
         default:
             return {};
@@ -231,16 +231,16 @@ QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
     } else if (role == Qt::UserRole + 2) {
         // text color role based on process's state
         if (index.column() == kProcessNameColumn) {
-            char state = proc.state();
+            char state = snap.state()[srow];
             if (state == 'Z' || state == 'T') {
                 return QVariant(int(Dtk::Gui::DPalette::TextWarning));
             }
         }
         return {};
     } else if (role == Qt::UserRole + 3) {
-        return proc.appType();
+        return snap.appType()[srow];
     } else if (role == Qt::UserRole + 4) {
-        return QString("%1").arg(proc.pid());
+        return QString("%1").arg(snap.pid()[srow]);
     }
     return {};
 }
@@ -258,8 +258,8 @@ Qt::ItemFlags ProcessTableModel::flags(const QModelIndex &index) const
 ProcessPriority ProcessTableModel::getProcessPriority(pid_t pid) const
 {
     int row = m_procIdList.indexOf(pid);
-    if (row >= 0) {
-        int prio = ProcessDB::instance()->processSet()->getProcessById(pid).priority();
+    if (row >= 0 && m_snapshotRows[row] >= 0) {
+        int prio = m_snapshot.priority()[m_snapshotRows[row]];
         return getProcessPriorityStub(prio);
     }
 
@@ -273,7 +273,7 @@ void ProcessTableModel::removeProcess(pid_t pid)
     if (row >= 0) {
         beginRemoveRows(QModelIndex(), row, row);
         m_procIdList.removeAt(row);
-        m_processList.removeAt(row);
+        m_snapshotRows.removeAt(row);
         endRemoveRows();
     }
 }
@@ -283,7 +283,8 @@ void ProcessTableModel::updateProcessState(pid_t pid, char state)
 {
     int row = m_procIdList.indexOf(pid);
     if (row >= 0) {
-        m_processList[row].setState(state);
+        if (m_snapshotRows[row] >= 0)
+            m_snapshot.setState(m_snapshotRows[row], state);
         Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
     }
 }
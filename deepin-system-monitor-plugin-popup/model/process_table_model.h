@@ -127,13 +127,6 @@ public:
      */
     ProcessPriority getProcessPriority(pid_t pid) const;
 
-    /**
-     * @brief Get process entry from list with specified pid
-     * @param pid Process id
-     * @return Process entry item
-     */
-    Process getProcess(pid_t pid) const;
-
 Q_SIGNALS:
     /**
      * @brief Model updated signal
@@ -157,7 +150,8 @@ private Q_SLOTS:
 
 private:
     QList<pid_t> m_procIdList; // pid list
-    QList<Process> m_processList; // pid list
+    ProcessSnapshot m_snapshot; // copy of the snapshot published by ProcessDB
+    QVector<int> m_snapshotRows; // model row to snapshot row, -1 if ended
 };
 
 #endif  // PROCESS_TABLE_MODEL_H
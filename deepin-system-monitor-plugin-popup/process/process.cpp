@@ -46,6 +46,12 @@ using namespace core::system;
 namespace core {
 namespace process {
 
+namespace {
+
+RefreshTierStats tierStatsTable[kRefreshTierCount];
+
+} // namespace
+
 QString getPriorityName(int prio)
 {
     const static QMap<ProcessPriority, QString> priorityMap = {
@@ -121,32 +127,26 @@ timeval Process::procuptime() const
 
 void Process::readProcessVariableInfo()
 {
-    readProcessInfo();
-}
-
-void Process::readProcessSimpleInfo()
-{
-    readProcessInfo();
+    readVariableFiles();
+    updateVariableInfo();
 }
 
-void Process::readProcessInfo()
+void Process::readVariableFiles()
 {
-    d->valid = true;
-
-    bool ok = true;
-
-    ok = ok && readStat();
-    ok = ok && readCmdline();
-//    readEnviron();
+    bool ok = readStat();
     readSchedStat();
     ok = ok && readStatus();
     ok = ok && readStatm();
-//    readIO();
-//    readSockInodes();
+    d->valid = ok;
 
-    d->usrerName = SysInfo::userName(d->uid);
-    d->proc_name.refreashProcessName(this);
-    d->proc_icon.refreashProcessIcon(this);
+    tierStatsTable[kHotTier].refreshes++;
+    tierStatsTable[kHotTier].files += 4;
+}
+
+void Process::updateVariableInfo()
+{
+    // plugin follows window list every tick, resolve names & app types again
+    updateSimpleInfo();
     d->uptime = SysInfo::instance()->uptime();
 
     CPUSet *cpuset = DeviceDB::instance()->cpuSet();
@@ -170,6 +170,44 @@ void Process::readProcessInfo()
     auto pair = d->diskIOSample->recentSamplePair();
     struct IOPS iops = DISKIOSampleFrame::diskiops(pair.first, pair.second);
     d->diskIOSpeedSample->addSample(new IOPSSampleFrame(iops));
+}
+
+void Process::readProcessSimpleInfo()
+{
+    readSimpleFiles();
+    updateSimpleInfo();
+}
+
+void Process::readSimpleFiles()
+{
+    bool ok = readStat();
+    ok = ok && readCmdline();
+    ok = ok && readStatus();
+    d->valid = ok;
+}
+
+void Process::inheritSimpleFiles(const Process &parent)
+{
+    d->valid = parent.d->valid;
+    d->ppid = parent.d->pid;
+    d->name = parent.d->name;
+    d->cmdline = parent.d->cmdline;
+    d->state = parent.d->state;
+    d->uid = parent.d->uid;
+    d->euid = parent.d->euid;
+    d->suid = parent.d->suid;
+    d->fuid = parent.d->fuid;
+    d->gid = parent.d->gid;
+    d->egid = parent.d->egid;
+    d->sgid = parent.d->sgid;
+    d->fgid = parent.d->fgid;
+}
+
+void Process::updateSimpleInfo()
+{
+    d->usrerName = SysInfo::userName(d->uid);
+    d->proc_name.refreashProcessName(this);
+    d->proc_icon.refreashProcessIcon(this);
 
     d->apptype = kNoFilter;
     const QVariant &euid = ProcessDB::instance()->processEuid();
@@ -182,8 +220,32 @@ void Process::readProcessInfo()
     } else if (euid == d->uid) {
         d->apptype = kFilterCurrentUser;
     }
+}
+
+void Process::readProcessInfo()
+{
+    bool ok = readStat();
+    ok = ok && readCmdline();
+    readSchedStat();
+    ok = ok && readStatus();
+    ok = ok && readStatm();
+
+    updateVariableInfo();
+    d->valid = ok;
+}
 
-    d->valid = d->valid && ok;
+RefreshTierStats &Process::tierStats(RefreshTier tier)
+{
+    return tierStatsTable[tier];
+}
+
+void Process::resetTierStats()
+{
+    for (RefreshTierStats &stats : tierStatsTable) {
+        stats.refreshes = 0;
+        stats.files = 0;
+        stats.bytes = 0;
+    }
 }
 
 // read /proc/[pid]/stat
@@ -708,6 +770,16 @@ qulonglong Process::cancelledWriteBytes() const
     return d->cancelled_write_bytes;
 }
 
+QList<ino_t> Process::sockInodes() const
+{
+    return d->sockInodes;
+}
+
+QHash<ino_t, IOPS> Process::sockIOBps() const
+{
+    return d->sockIOBps;
+}
+
 qreal Process::recvBps() const
 {
     auto *sample = d->networkBandwidthSample->recentSample();
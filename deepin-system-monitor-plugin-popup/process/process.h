@@ -7,6 +7,7 @@
 #define PROCESS_H
 
 #include "system/sys_info.h"
+#include "common/sample.h"
 
 #include <QByteArray>
 #include <QString>
@@ -14,6 +15,8 @@
 #include <QSharedDataPointer>
 #include <QUrl>
 
+#include <atomic>
+
 #include <sys/types.h>
 
 using namespace core::system;
@@ -40,6 +43,25 @@ static const int kLowPriorityMin = 10;
 static const int kVeryLowPriorityMax = 11;
 static const int kVeryLowPriorityMin = 19;
 
+/**
+ * @brief Refresh tiers of /proc files read by readVariableFiles
+ */
+enum RefreshTier {
+    kHotTier, // stat, statm, schedstat & status, every tick
+    kStatusTier, // not used by plugin, status is part of hot tier
+    kIdentityTier, // not used by plugin, cmdline is read once when process is born
+    kRefreshTierCount
+};
+
+/**
+ * @brief Cost counters of a refresh tier, accumulated by all processes on all threads
+ */
+struct RefreshTierStats {
+    std::atomic<qulonglong> refreshes {0}; // number of process refreshes in this tier
+    std::atomic<qulonglong> files {0}; // files read
+    std::atomic<qulonglong> bytes {0}; // bytes read, not tracked by plugin
+};
+
 QString getPriorityName(int prio);
 ProcessPriority getProcessPriorityStub(int prio);
 
@@ -114,10 +136,47 @@ public:
     qulonglong recvBytes() const;
     qulonglong sentBytes() const;
 
+    /**
+     * @brief sockInodes Socket inodes opened by this process, not read by plugin
+     */
+    QList<ino_t> sockInodes() const;
+    /**
+     * @brief sockIOBps Network rate of each socket over last interval, not tracked by plugin
+     */
+    QHash<ino_t, IOPS> sockIOBps() const;
+
     void readProcessInfo();
     void readProcessVariableInfo();
     void readProcessSimpleInfo();
 
+    /**
+     * @brief readSimpleFiles Read /proc files needed by simple info, safe to run on worker threads
+     */
+    void readSimpleFiles();
+    /**
+     * @brief inheritSimpleFiles Take over simple info of forked parent instead of reading /proc
+     * @param parent Parent process, until exec the child shares its image and credentials
+     */
+    void inheritSimpleFiles(const Process &parent);
+    /**
+     * @brief updateSimpleInfo Resolve user, name, icon & app type from simple files read before
+     */
+    void updateSimpleInfo();
+    /**
+     * @brief readVariableFiles Read /proc files needed by variable info, safe to run on worker threads
+     */
+    void readVariableFiles();
+    /**
+     * @brief updateVariableInfo Update name & cpu/disk samples from variable files read before
+     */
+    void updateVariableInfo();
+
+    /**
+     * @brief tierStats Cost of refresh tier since last resetTierStats call
+     */
+    static RefreshTierStats &tierStats(RefreshTier tier);
+    static void resetTierStats();
+
 private:
     /**
      * @brief Read /proc/[pid]/stat
@@ -159,7 +218,8 @@ private:
     void readSockInodes();
 
 private:
-    QSharedDataPointer<ProcessPrivate> d;
+    // shared with the process table of ProcessSet, refreshes through any copy are seen by all
+    QExplicitlySharedDataPointer<ProcessPrivate> d;
 };
 
 } // namespace process
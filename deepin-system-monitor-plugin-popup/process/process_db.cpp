@@ -28,6 +28,7 @@ namespace process {
 const int DesktopEntryTimeCount = 150; // 5 minutes interval
 ProcessDB::ProcessDB(QObject *parent)
     : QObject(parent)
+    , m_snapshot(std::make_shared<const ProcessSnapshot>())
 {
     m_procSet = new ProcessSet();
     m_windowList = new WMWindowList();
@@ -70,6 +71,11 @@ ProcessSet *ProcessDB::processSet()
     return m_procSet;
 }
 
+ProcessSnapshotPtr ProcessDB::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
 WMWindowList *ProcessDB::windowList()
 {
     return m_windowList;
@@ -115,6 +121,9 @@ void ProcessDB::update()
 
     m_windowList->updateWindowListCache();
     m_procSet->refresh();
+
+    // publish a frozen copy, the previous snapshot is freed once the last reader drops it
+    std::atomic_store(&m_snapshot, std::make_shared<const ProcessSnapshot>(m_procSet->snapshot()));
 }
 
 void ProcessDB::setProcessPriority(pid_t pid, int priority)
@@ -11,6 +11,7 @@
 #include "system/system_monitor_thread.h"
 #include "system/system_monitor.h"
 #include "process/process_set.h"
+#include "process/process_snapshot.h"
 
 #include <QReadWriteLock>
 #include <QObject>
@@ -45,6 +46,10 @@ public:
     static ProcessDB *instance();
 
     ProcessSet *processSet();
+    /**
+     * @brief snapshot Latest published process snapshot, safe to call from any thread
+     */
+    ProcessSnapshotPtr snapshot() const;
     WMWindowList *windowList();
     DesktopEntryCache *desktopEntryCache();
 
@@ -83,6 +88,8 @@ private:
     DesktopEntryCache *m_desktopEntryCache;
 
     ProcessSet *m_procSet;
+    // written by monitor thread once per refresh, read by gui thread, only accessed atomically
+    ProcessSnapshotPtr m_snapshot;
     int m_desktopEntryTimeCount;
 
     uid_t m_euid;
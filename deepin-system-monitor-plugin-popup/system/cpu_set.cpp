@@ -12,6 +12,7 @@
 #include "system/system_monitor_thread.h"
 #include "system/system_monitor.h"
 #include "system/sys_info.h"
+#include "system/proc_stat.h"
 
 #include <QMap>
 #include <QByteArray>
@@ -32,6 +33,16 @@ using namespace common::alloc;
 namespace core {
 namespace system {
 
+// cpu id of logical name, e.g. 17 of cpu17; -1 if cpu is not online
+static int statCpuId(const proc_stat_t &stat, const QByteArray &cpu)
+{
+    if (!cpu.startsWith("cpu"))
+        return -1;
+    bool ok = false;
+    int id = cpu.mid(3).toInt(&ok);
+    return (ok && id >= 0 && stat.listed.value(id)) ? id : -1;
+}
+
 /*
 * borrowed & modified from LINUX bitmap.c
 */
@@ -208,10 +219,13 @@ namespace system {
 
 CPUSet::CPUSet()
     : d(new CPUSetPrivate())
+    , m_publishedStat(std::make_shared<const proc_stat_t>())
 {
 }
 CPUSet::CPUSet(const CPUSet &other)
     : d(other.d)
+    , m_statReader(other.m_statReader)
+    , m_publishedStat(std::atomic_load(&other.m_publishedStat))
 {
 }
 CPUSet &CPUSet::operator=(const CPUSet &rhs)
@@ -220,6 +234,8 @@ CPUSet &CPUSet::operator=(const CPUSet &rhs)
         return *this;
 
     d = rhs.d;
+    m_statReader = rhs.m_statReader;
+    std::atomic_store(&m_publishedStat, std::atomic_load(&rhs.m_publishedStat));
     return *this;
 }
 
@@ -305,19 +321,53 @@ const CPUStat CPUSet::stat() const
 
 QList<QByteArray> CPUSet::cpuLogicName() const
 {
-    return d->m_usageDB.keys();
+    return d->m_cpuNames;
 }
 
 const CPUStat CPUSet::statDB(const QByteArray &cpu) const
 {
-    return d->m_statDB[cpu];
+    // published copy, these are read from the gui thread
+    std::shared_ptr<const proc_stat_t> procstat = procStat();
+    int id = statCpuId(*procstat, cpu);
+    if (id < 0)
+        return {};
+
+    const proc_stat_cpu_t &src = procstat->cpus[id];
+    auto stat = std::make_shared<cpu_stat_t>();
+    stat->cpu = cpu;
+    stat->user = src.user;
+    stat->nice = src.nice;
+    stat->sys = src.sys;
+    stat->idle = src.idle;
+    stat->iowait = src.iowait;
+    stat->hardirq = src.hardirq;
+    stat->softirq = src.softirq;
+    stat->steal = src.steal;
+    stat->guest = src.guest;
+    stat->guest_nice = src.guest_nice;
+    return stat;
 }
 
 const CPUUsage CPUSet::usageDB(const QByteArray &cpu) const
 {
-    return d->m_usageDB[cpu];
+    // published copy, these are read from the gui thread
+    std::shared_ptr<const proc_stat_t> procstat = procStat();
+    int id = statCpuId(*procstat, cpu);
+    if (id < 0)
+        return {};
+
+    const proc_stat_cpu_t &src = procstat->cpus[id];
+    auto usage = std::make_shared<cpu_usage_t>();
+    usage->cpu = cpu;
+    usage->total = src.total();
+    usage->idle = src.idleTotal();
+    return usage;
 }
 
+std::shared_ptr<const proc_stat_t> CPUSet::procStat() const
+{
+    return std::atomic_load(&m_publishedStat);
+}
 
 void CPUSet::update()
 {
@@ -330,115 +380,48 @@ void CPUSet::update()
 
 void CPUSet::read_stats()
 {
-    FILE *fp;
-    uFile fPtr;
-    QByteArray line(BUFSIZ, '\0');
-    int ncpu = 0;
-    int nr;
-
-    if (!(fp = fopen(PROC_PATH_STAT, "r"))) {
-        print_errno(errno, QString("open %1 failed").arg(PROC_PATH_STAT));
+    if (!m_statReader)
+        m_statReader = std::make_shared<ProcStatReader>(PROC_PATH_STAT);
+    // per cpu stats are scanned into arrays indexed by cpu id, reused across updates
+    if (!m_statReader->read(d->m_procStat))
         return;
-    } // ::if(fopen)
-    fPtr.reset(fp);
-
-    while (fgets(line.data(), BUFSIZ, fp)) {
-        if (!strncmp(line.data(), "cpu ", 4)) {
-            if (!d->m_stat) {
-                d->m_stat = std::make_shared<struct cpu_stat_t>();
-                *d->m_stat = {};
-            }
-
-            if (d->m_stat) {
-                // all cpu stat in jiffies
-                nr = sscanf(line.data() + 5, "%llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
-                            &d->m_stat->user,
-                            &d->m_stat->nice,
-                            &d->m_stat->sys,
-                            &d->m_stat->idle,
-                            &d->m_stat->iowait,
-                            &d->m_stat->hardirq,
-                            &d->m_stat->softirq,
-                            &d->m_stat->steal,
-                            &d->m_stat->guest,
-                            &d->m_stat->guest_nice);
-
-                if (nr == 10) {
-                    // usage calc
-                    QByteArray cpu {"cpu"};
-                    d->m_stat->cpu = cpu;
-
-                    if (!d->m_usage) {
-                        d->m_usage = std::make_shared<struct cpu_usage_t>();
-                        *d->m_usage = {};
-                    }
-
-                    if (d->m_usage) {
-                        d->m_usage->cpu = cpu;
-                        d->m_usage->total = d->m_stat->user + d->m_stat->nice + d->m_stat->sys + d->m_stat->idle + d->m_stat->iowait + d->m_stat->hardirq + d->m_stat->softirq + d->m_stat->steal;
-                        d->m_usage->idle = d->m_stat->idle + d->m_stat->iowait;
-                    } // ::if(usage)
-                } else
-                    print_errno(errno, QString("read %1 failed, cpu").arg(PROC_PATH_STAT));
-            } // ::if(m_stat)
-        } else if (!strncmp(line.data(), "cpu", 3)) {
-            // per cpu stat in jiffies
-            auto stat = std::make_shared<struct cpu_stat_t>();
-            if (stat) {
-                *stat = {};
-
-                nr = sscanf(line.data() + 3, "%d %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
-                            &ncpu,
-                            &stat->user,
-                            &stat->nice,
-                            &stat->sys,
-                            &stat->idle,
-                            &stat->iowait,
-                            &stat->hardirq,
-                            &stat->softirq,
-                            &stat->steal,
-                            &stat->guest,
-                            &stat->guest_nice);
-
-                if (nr == 11) {
-                    QByteArray cpu {"cpu"};
-                    cpu.append(QByteArray::number(ncpu));
-                    stat->cpu = cpu;
-
-                    // usage calc
-                    auto usage = std::make_shared<struct cpu_usage_t>();
-                    if (usage) {
-                        *usage = {};
-                        usage->cpu = cpu;
-                        usage->total = stat->user + stat->nice + stat->sys + stat->idle + stat->iowait + stat->hardirq + stat->softirq + stat->steal;
-                        usage->idle = stat->idle + stat->iowait;
-
-                        d->m_statDB[stat->cpu] = stat;
-                        d->m_usageDB[usage->cpu] = usage;
-                    } //::if(usage)
-
-                } else
-                    print_errno(errno, QString("read %1 failed, cpu%2").arg(PROC_PATH_STAT).arg(ncpu));
-            } // ::if(stat)
-        } else if (!strncmp(line.data(), "btime", 5)) {
-            // read boot time in seconds since epoch
-            struct timeval btime {
-            };
-            long nsec {};
-            int nm = sscanf(line.data() + 5, "%ld", &nsec);
-            if (nm == 1) {
-                btime.tv_sec = nsec;
-                btime.tv_usec = 0;
-
-                // set sysinfo btime
-                auto *monitor = ThreadManager::instance()->thread<SystemMonitorThread>(BaseThread::kSystemMonitorThread)->systemMonitorInstance();
-//                monitor->sysInfo()->set_btime(btime);
-            } // ::if(nm == 1)
-        } // ::if(btime)
-    } // ::while(fgets)
-
-    if (ferror(fp))
-        print_errno(errno, QString("read %1 failed").arg(PROC_PATH_STAT));
+    const proc_stat_t &stat = d->m_procStat;
+    // readers on other threads get their own copy; the arrays are shared until the next read
+    // writes them in place, which detaches (one allocation per array & tick) instead of racing
+    std::atomic_store(&m_publishedStat, std::make_shared<const proc_stat_t>(stat));
+
+    // all cpu stat in jiffies, updated in place
+    if (!d->m_stat)
+        d->m_stat = std::make_shared<struct cpu_stat_t>();
+    if (d->m_stat->cpu.isEmpty())
+        d->m_stat->cpu = "cpu";
+    d->m_stat->user = stat.cpu.user;
+    d->m_stat->nice = stat.cpu.nice;
+    d->m_stat->sys = stat.cpu.sys;
+    d->m_stat->idle = stat.cpu.idle;
+    d->m_stat->iowait = stat.cpu.iowait;
+    d->m_stat->hardirq = stat.cpu.hardirq;
+    d->m_stat->softirq = stat.cpu.softirq;
+    d->m_stat->steal = stat.cpu.steal;
+    d->m_stat->guest = stat.cpu.guest;
+    d->m_stat->guest_nice = stat.cpu.guest_nice;
+
+    // usage calc
+    if (!d->m_usage)
+        d->m_usage = std::make_shared<struct cpu_usage_t>();
+    if (d->m_usage->cpu.isEmpty())
+        d->m_usage->cpu = "cpu";
+    d->m_usage->total = stat.cpu.total();
+    d->m_usage->idle = stat.cpu.idleTotal();
+
+    // logical names are only rebuilt when cpus went on/off line
+    if (d->m_namedCpus != stat.online) {
+        d->m_namedCpus = stat.online;
+        d->m_cpuNames.clear();
+        for (int id : stat.online)
+            d->m_cpuNames << QByteArray("cpu").append(QByteArray::number(id));
+    }
+    d->m_nstatcpus = stat.online.size();
 }
 
 void CPUSet::read_overall_info()
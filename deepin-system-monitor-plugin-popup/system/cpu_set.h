@@ -6,14 +6,18 @@
 #define CPUSET_H
 
 #include "system/cpu.h"
+#include "system/proc_stat.h"
 
 #include <QList>
 #include <QSharedDataPointer>
 
+#include <memory>
+
 namespace core {
 namespace system {
 
 class CPUSetPrivate;
+class ProcStatReader;
 class CPUSet
 {
     friend class Process;
@@ -68,6 +72,12 @@ public://usage
 
     qulonglong getUsageTotalDelta() const;
 
+    /**
+     * @brief procStat Copy of the last /proc/stat read, per cpu values indexed by cpu id;
+     * published once per update, safe to hold & read from another thread
+     */
+    std::shared_ptr<const proc_stat_t> procStat() const;
+
 public:
     void update();
 
@@ -78,6 +88,11 @@ private:
 
 private:
     QSharedDataPointer<CPUSetPrivate> d;
+
+    // kept-open /proc/stat
+    std::shared_ptr<ProcStatReader> m_statReader;
+    // copy of d->m_procStat published after each read, swapped atomically
+    std::shared_ptr<const proc_stat_t> m_publishedStat;
 };
 
 } // namespace system
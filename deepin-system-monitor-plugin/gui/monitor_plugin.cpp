@@ -18,6 +18,8 @@
 #include <QPainter>
 #include <QFile>
 
+#include <stdio.h>
+
 namespace constantVal {
 const QString PLUGIN_STATE_KEY = "enable";
 }
@@ -357,31 +359,33 @@ void MonitorPlugin::calcMemRate(qlonglong &memory, qlonglong &memoryAll)
 
 void MonitorPlugin::calcNetRate(qlonglong &netDown, qlonglong &netUpload)
 {
+    // dock runs in its own process, so it reads the counters the monitor sums up (loopback left out)
     QFile file("/proc/net/dev");
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (!file.open(QIODevice::ReadOnly))
         return;
 
-    qlonglong down = 0;
-    qlonglong upload = 0;
-    QTextStream stream(&file);
-    QString line = stream.readLine();
-    line = stream.readLine();
-    line = stream.readLine();
-    while (!line.isNull()) {
-        line = line.trimmed();
-        QStringList list = line.split(QRegExp("\\s{1,}")); // match number >= 1 space character
-
-        if (!list.isEmpty()) {
-            down = list.at(1).toLongLong();
-            upload = list.at(9).toLongLong();
-        }
+    const QByteArray content = file.readAll();
+    file.close();
 
-        netDown += down;
-        netUpload += upload;
-        line = stream.readLine();
+    int pos = 0;
+    while (pos < content.size()) {
+        int end = content.indexOf('\n', pos);
+        if (end < 0)
+            end = content.size();
+        const QByteArray line = content.mid(pos, end - pos);
+        pos = end + 1;
+
+        // two header lines have no colon
+        int colon = line.indexOf(':');
+        if (colon < 0 || line.left(colon).trimmed() == "lo")
+            continue;
+
+        unsigned long long down = 0, upload = 0;
+        if (sscanf(line.constData() + colon + 1, "%llu %*u %*u %*u %*u %*u %*u %*u %llu", &down, &upload) == 2) {
+            netDown += qlonglong(down);
+            netUpload += qlonglong(upload);
+        }
     }
-
-    file.close();
 }
 
 QString MonitorPlugin::setRateUnitSensitive(MonitorPlugin::RateUnit unit)
@@ -6,6 +6,8 @@
 //Self
 #include "cpu_detail_widget.h"
 #include "model/cpu_info_model.h"
+#include "cpu_heatmap_widget.h"
+#include "settings.h"
 
 //gtest
 #include "stub.h"
@@ -58,6 +60,11 @@ int stub_setMultiModeLayout_sysconf_cpu0()
 {
     return 0;
 }
+
+QVariant stub_getOption_heatmapDisabled()
+{
+    return 0;
+}
 /***************************************STUB end**********************************************/
 
 class UT_CPUDetailGrapTableItem : public ::testing::Test
@@ -135,10 +142,12 @@ TEST_F(UT_CPUDetailGrapTableItem, test_updateStat_01)
 
 TEST_F(UT_CPUDetailGrapTableItem, test_updateStat_02)
 {
+    // multi core mode reads its row of the model history, nothing kept in item
     m_tester->m_isMutliCoreMode = true;
     m_tester->updateStat();
 
-    EXPECT_EQ(m_tester->m_cpuPercents.size(), 1);
+    EXPECT_EQ(m_tester->m_cpuPercents.size(), 0);
+    EXPECT_EQ(m_tester->historySize(), m_tester->m_cpuInfomodel->cpuUsageHistory().size());
 }
 
 TEST_F(UT_CPUDetailGrapTableItem, test_updateStat_03)
@@ -146,12 +155,24 @@ TEST_F(UT_CPUDetailGrapTableItem, test_updateStat_03)
     for (int i = 0; i < 33; i++) {
         m_tester->m_cpuPercents.append(qreal(i));
     }
-    m_tester->m_isMutliCoreMode = true;
+    m_tester->m_isMutliCoreMode = false;
     m_tester->updateStat();
 
     EXPECT_EQ(m_tester->m_cpuPercents.size(), 31);
 }
 
+TEST_F(UT_CPUDetailGrapTableItem, test_percentAt_01)
+{
+    m_tester->m_isMutliCoreMode = false;
+    m_tester->m_cpuPercents.append(0.5);
+    EXPECT_DOUBLE_EQ(m_tester->percentAt(0), 0.5);
+    EXPECT_DOUBLE_EQ(m_tester->percentAt(1), 0);
+
+    // unknown values of the cpu row are drawn as 0
+    m_tester->m_isMutliCoreMode = true;
+    EXPECT_DOUBLE_EQ(m_tester->percentAt(m_tester->m_cpuInfomodel->cpuUsageHistory().capacity()), 0);
+}
+
 TEST_F(UT_CPUDetailGrapTableItem, test_paintEvent_01)
 {
     m_tester->m_mode = 1;
@@ -355,6 +376,8 @@ TEST_F(UT_CPUDetailGrapTable, test_setMultiModeLayout_64)
 {
     Stub stub;
     stub.set(sysconf, stub_setMultiModeLayout_sysconf_cpu64);
+    // heatmap off, 64 cpus still get the grid of graphs
+    stub.set(ADDR(Settings, getOption), stub_getOption_heatmapDisabled);
     m_tester2->setMultiModeLayout(m_tester2->m_cpuInfoModel);
 
     EXPECT_EQ(m_tester2->layout()->margin(), 0);
@@ -362,6 +385,28 @@ TEST_F(UT_CPUDetailGrapTable, test_setMultiModeLayout_64)
     EXPECT_EQ(dynamic_cast<QGridLayout*>(m_tester2->layout())->horizontalSpacing(), 10);
 }
 
+TEST_F(UT_CPUDetailGrapTable, test_setMultiModeLayout_heatmap_01)
+{
+    Stub stub;
+    stub.set(sysconf, stub_setMultiModeLayout_sysconf_cpu64);
+    m_tester2->setMutliCoreMode(true);
+
+    // above default threshold, one heatmap instead of a graph per cpu
+    EXPECT_NE(m_tester2->findChild<CPUHeatmapWidget *>(), nullptr);
+    EXPECT_EQ(m_tester2->findChildren<CPUDetailGrapTableItem *>().size(), 0);
+}
+
+TEST_F(UT_CPUDetailGrapTable, test_setMultiModeLayout_heatmap_02)
+{
+    Stub stub;
+    stub.set(sysconf, stub_setMultiModeLayout_sysconf_cpu64);
+    stub.set(ADDR(Settings, getOption), stub_getOption_heatmapDisabled);
+    m_tester2->setMutliCoreMode(true);
+
+    EXPECT_EQ(m_tester2->findChild<CPUHeatmapWidget *>(), nullptr);
+    EXPECT_EQ(m_tester2->findChildren<CPUDetailGrapTableItem *>().size(), 64);
+}
+
 TEST_F(UT_CPUDetailGrapTable, test_setMultiModeLayout_0)
 {
     Stub stub;
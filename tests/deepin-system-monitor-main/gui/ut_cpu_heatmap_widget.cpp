@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//Self
+#include "cpu_heatmap_widget.h"
+#include "model/cpu_info_model.h"
+#include "system/cpu_set.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//Qt
+#include <QPainter>
+
+#include <cmath>
+
+using namespace core::system;
+
+/***************************************STUB begin*********************************************/
+// two sockets of two cores with two threads each, cpu ids interleaved across sockets
+QVector<cpu_topology_t> stub_topology_2s()
+{
+    return {{0, 0, 0}, {4, 0, 0}, {2, 0, 1}, {6, 0, 1},
+            {1, 1, 0}, {5, 1, 0}, {3, 1, 1}, {7, 1, 1}};
+}
+
+QVector<cpu_topology_t> stub_topology_empty()
+{
+    return {};
+}
+/***************************************STUB end**********************************************/
+
+class UT_CPUHeatmapWidget : public ::testing::Test
+{
+public:
+    UT_CPUHeatmapWidget() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        static CPUInfoModel model;
+        static QWidget widget;
+        m_stub.set(ADDR(CPUSet, topology), stub_topology_2s);
+        m_tester = new CPUHeatmapWidget(&model, &widget);
+        m_tester->resize(400, 200);
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    Stub m_stub;
+    CPUHeatmapWidget *m_tester;
+};
+
+TEST_F(UT_CPUHeatmapWidget, initTest)
+{
+    // rows in topology order, socket boundary after the first four rows
+    ASSERT_EQ(m_tester->m_rows.size(), 8);
+    EXPECT_EQ(m_tester->m_rows[1].cpu, 4);
+    EXPECT_EQ(m_tester->m_socketStarts, QVector<int>({4}));
+
+    // one pixel per cpu & sample
+    EXPECT_EQ(m_tester->m_image.height(), 8);
+    EXPECT_EQ(m_tester->m_image.width(), m_tester->m_model->cpuUsageHistory().capacity());
+}
+
+TEST_F(UT_CPUHeatmapWidget, test_loadTopology_01)
+{
+    // same topology, nothing to reload
+    EXPECT_FALSE(m_tester->loadTopology());
+
+    // no topology from lscpu, online cpus of /proc/stat in id order
+    Stub stub;
+    stub.set(ADDR(CPUSet, topology), stub_topology_empty);
+    m_tester->m_model->cpuSet()->read_stats();
+    const proc_stat_t stat = *m_tester->m_model->cpuSet()->procStat();
+    m_tester->loadTopology();
+    ASSERT_EQ(m_tester->m_rows.size(), stat.online.size());
+    if (!stat.online.isEmpty())
+        EXPECT_EQ(m_tester->m_rows[0].cpu, stat.online[0]);
+    EXPECT_TRUE(m_tester->m_socketStarts.isEmpty());
+}
+
+TEST_F(UT_CPUHeatmapWidget, test_scroll_01)
+{
+    QImage &image = m_tester->m_image;
+    int last = image.width() - 1;
+    image.setPixel(last, 0, qRgb(1, 2, 3));
+    image.setPixel(last, 7, qRgb(4, 5, 6));
+
+    m_tester->scroll();
+
+    // older samples move one column left
+    EXPECT_EQ(image.pixel(last - 1, 0), qRgb(1, 2, 3));
+    EXPECT_EQ(image.pixel(last - 1, 7), qRgb(4, 5, 6));
+    EXPECT_EQ(image.pixel(last, 0), m_tester->colorOf(m_tester->m_model->cpuUsageHistory().latest(0)));
+}
+
+TEST_F(UT_CPUHeatmapWidget, test_colorOf_01)
+{
+    EXPECT_EQ(m_tester->colorOf(std::nanf("")), m_tester->m_unknownColor);
+    EXPECT_EQ(m_tester->colorOf(-3.f), m_tester->m_colors[0]);
+    EXPECT_EQ(m_tester->colorOf(49.6f), m_tester->m_colors[50]);
+    EXPECT_EQ(m_tester->colorOf(120.f), m_tester->m_colors[100]);
+    EXPECT_EQ(QColor(m_tester->m_colors[100]), QColor("#FB1818"));
+}
+
+TEST_F(UT_CPUHeatmapWidget, test_updateStat_01)
+{
+    m_tester->updateStat();
+    EXPECT_EQ(m_tester->m_rows.size(), 8);
+}
+
+TEST_F(UT_CPUHeatmapWidget, test_paintEvent_01)
+{
+    EXPECT_FALSE(m_tester->grab().isNull());
+}
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//Self
+#include "pressure_view_widget.h"
+#include "chart_view_widget.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//Qt
+#include <QResizeEvent>
+
+using namespace core::system;
+
+/***************************************STUB begin*********************************************/
+bool stub_pressure_available()
+{
+    return true;
+}
+
+bool stub_pressure_unavailable()
+{
+    return false;
+}
+
+qreal stub_pressure_someStall()
+{
+    return 0.25;
+}
+/***************************************STUB end**********************************************/
+
+class UT_PressureViewWidget : public ::testing::Test
+{
+public:
+    UT_PressureViewWidget() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        static QWidget parent;
+        m_tester = new PressureViewWidget(PressureInfo::kMemoryPressure, &parent);
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    PressureViewWidget *m_tester;
+};
+
+TEST_F(UT_PressureViewWidget, initTest)
+{
+    EXPECT_EQ(m_tester->m_res, PressureInfo::kMemoryPressure);
+}
+
+TEST_F(UT_PressureViewWidget, test_onModelUpdate_01)
+{
+    Stub stub;
+    stub.set((bool (PressureInfo::*)(PressureInfo::Resource) const)ADDR(PressureInfo, available), stub_pressure_available);
+    stub.set(ADDR(PressureInfo, someStall), stub_pressure_someStall);
+
+    int count = m_tester->m_chartWidget->m_listData1.size();
+    m_tester->onModelUpdate();
+    ASSERT_EQ(m_tester->m_chartWidget->m_listData1.size(), count + 1);
+    EXPECT_DOUBLE_EQ(m_tester->m_chartWidget->m_listData1.last().toDouble(), 0.25);
+}
+
+TEST_F(UT_PressureViewWidget, test_onModelUpdate_02)
+{
+    // no psi, chart hidden & not fed
+    Stub stub;
+    stub.set((bool (PressureInfo::*)(PressureInfo::Resource) const)ADDR(PressureInfo, available), stub_pressure_unavailable);
+
+    int count = m_tester->m_chartWidget->m_listData1.size();
+    m_tester->onModelUpdate();
+    EXPECT_TRUE(m_tester->isHidden());
+    EXPECT_EQ(m_tester->m_chartWidget->m_listData1.size(), count);
+}
+
+TEST_F(UT_PressureViewWidget, test_fontChanged_01)
+{
+    QFont font;
+    font.setItalic(true);
+    m_tester->fontChanged(font);
+
+    EXPECT_TRUE(m_tester->m_font.italic());
+    EXPECT_GT(m_tester->height(), 0);
+}
+
+TEST_F(UT_PressureViewWidget, test_resizeEvent_01)
+{
+    QResizeEvent event(QSize(200, 100), QSize(20, 20));
+    m_tester->resize(200, 100);
+    m_tester->resizeEvent(&event);
+    EXPECT_EQ(m_tester->m_chartWidget->width(), m_tester->width());
+}
+
+TEST_F(UT_PressureViewWidget, test_paintEvent_01)
+{
+    EXPECT_TRUE(!m_tester->grab().isNull());
+}
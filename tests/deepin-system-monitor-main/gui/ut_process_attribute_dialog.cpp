@@ -5,6 +5,7 @@
 
 //Self
 #include "process_attribute_dialog.h"
+#include "system/pressure.h"
 
 //gtest
 #include "stub.h"
@@ -18,7 +19,9 @@
 
 
 /***************************************STUB begin*********************************************/
-
+void stub_pressure_update()
+{
+}
 
 /***************************************STUB end**********************************************/
 
@@ -115,12 +118,22 @@ TEST_F(UT_ProcessAttributeDialog, test_eventFitler_04)
     m_tester1->eventFilter(m_tester1, &ev);
 }
 
-
-
-
-
-
-
-
-
-
+TEST_F(UT_ProcessAttributeDialog, test_updatePressure_01)
+{
+    using core::system::PressureInfo;
+    Stub stub;
+    stub.set(ADDR(PressureInfo, update), stub_pressure_update);
+
+    for (auto &res : m_tester1->m_pressureInfo->m_res)
+        res.available = false;
+    m_tester1->m_pressureInfo->m_res[PressureInfo::kIOPressure].available = true;
+    m_tester1->m_pressureInfo->m_res[PressureInfo::kIOPressure].stat.some.avg10 = 1.5f;
+    m_tester1->updatePressure();
+    EXPECT_TRUE(m_tester1->m_pressureText->text().endsWith("1.50%"));
+
+    // no cgroup v2 or psi
+    m_tester1->m_pressureInfo->m_res[PressureInfo::kIOPressure].available = false;
+    m_tester1->updatePressure();
+    EXPECT_TRUE(m_tester1->m_pressureLabel->isHidden());
+    EXPECT_TRUE(m_tester1->m_pressureText->isHidden());
+}
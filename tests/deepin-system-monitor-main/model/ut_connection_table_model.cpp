@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "model/connection_table_model.h"
+#include "process/process_db.h"
+#include "process/private/process_p.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+//Qt
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QSortFilterProxyModel>
+//system
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+using namespace core::process;
+
+namespace {
+
+ConnectionSnapshotPtr g_connections;
+
+ConnectionSnapshotPtr stub_connections()
+{
+    return g_connections;
+}
+
+void stub_watchConnections(bool)
+{
+}
+
+// one tcp socket per inode, all owned by pid 100
+void publish(const QList<ino_t> &inodes, uint state = TCP_ESTABLISHED, const QHash<ino_t, IOPS> &bps = {})
+{
+    SockStatMap socks;
+    for (ino_t ino : inodes) {
+        SockStat stat(new sock_stat_t {});
+        stat->ino = ino;
+        stat->sa_family = AF_INET;
+        stat->proto = IPPROTO_TCP;
+        stat->s_port = uint(ino);
+        stat->state = state;
+        insertSockStat(socks, stat);
+    }
+
+    Process proc(100);
+    proc.d->sockInodes = inodes;
+    proc.d->sockIOBps = bps;
+    QMap<pid_t, Process> set;
+    set.insert(100, proc);
+
+    auto snapshot = std::make_shared<ConnectionSnapshot>();
+    snapshot->build(set, socks);
+    g_connections = snapshot;
+}
+
+} // namespace
+
+class UT_ConnectionTableModel : public ::testing::Test
+{
+public:
+    UT_ConnectionTableModel() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_stub.set(ADDR(ProcessDB, connections), stub_connections);
+        m_stub.set(ADDR(ProcessDB, watchConnections), stub_watchConnections);
+        m_tester = new ConnectionTableModel();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+        g_connections.reset();
+    }
+
+protected:
+    ConnectionTableModel *m_tester;
+    Stub m_stub;
+};
+
+TEST_F(UT_ConnectionTableModel, initTest)
+{
+}
+
+TEST_F(UT_ConnectionTableModel, test_updateModel_01)
+{
+    publish({1, 2, 3, 4, 5});
+    // not shown, no update
+    m_tester->updateModel();
+    EXPECT_EQ(m_tester->rowCount(), 0);
+
+    m_tester->setActive(true);
+    m_tester->updateModel();
+    ASSERT_EQ(m_tester->rowCount(), 5);
+
+    // inodes 2 & 3 closed as one run, 5 closed alone, 6 & 7 opened
+    publish({1, 4, 6, 7});
+    QSignalSpy removed(m_tester, &ConnectionTableModel::rowsRemoved);
+    QSignalSpy inserted(m_tester, &ConnectionTableModel::rowsInserted);
+    QSignalSpy changed(m_tester, &ConnectionTableModel::dataChanged);
+    m_tester->updateModel();
+
+    EXPECT_EQ(removed.count(), 2);
+    EXPECT_EQ(inserted.count(), 1);
+    // surviving rows stayed idle
+    EXPECT_EQ(changed.count(), 0);
+    ASSERT_EQ(m_tester->rowCount(), 4);
+    // surviving rows keep their order, new rows appended
+    EXPECT_EQ(m_tester->m_keys[0].second, ino_t(1));
+    EXPECT_EQ(m_tester->m_keys[1].second, ino_t(4));
+    EXPECT_EQ(m_tester->data(m_tester->index(1, ConnectionTableModel::kConnectionLocalAddressColumn)).toString(), QString("*:4"));
+    EXPECT_EQ(m_tester->data(m_tester->index(3, ConnectionTableModel::kConnectionPIDColumn)).toString(), QString("100"));
+}
+
+TEST_F(UT_ConnectionTableModel, test_updateModel_02)
+{
+    m_tester->setActive(true);
+    publish({1, 2, 3, 4, 5});
+    m_tester->updateModel();
+
+    // traffic on 2 & 3 reported as one run, on 5 alone
+    QHash<ino_t, IOPS> bps;
+    bps.insert(2, {100., 10.});
+    bps.insert(3, {200., 20.});
+    bps.insert(5, {300., 30.});
+    publish({1, 2, 3, 4, 5}, TCP_ESTABLISHED, bps);
+    QSignalSpy changed(m_tester, &ConnectionTableModel::dataChanged);
+    m_tester->updateModel();
+
+    ASSERT_EQ(changed.count(), 2);
+    EXPECT_EQ(changed[0][0].toModelIndex().row(), 1);
+    EXPECT_EQ(changed[0][1].toModelIndex().row(), 2);
+    EXPECT_EQ(changed[0][0].toModelIndex().column(), int(ConnectionTableModel::kConnectionStateColumn));
+    EXPECT_EQ(changed[0][1].toModelIndex().column(), int(ConnectionTableModel::kConnectionUploadColumn));
+    EXPECT_EQ(changed[1][0].toModelIndex().row(), 4);
+    EXPECT_EQ(changed[1][1].toModelIndex().row(), 4);
+    EXPECT_DOUBLE_EQ(m_tester->data(m_tester->index(2, ConnectionTableModel::kConnectionDownloadColumn), Qt::UserRole).toDouble(), 200.);
+
+    // nothing changed
+    changed.clear();
+    m_tester->updateModel();
+    EXPECT_EQ(changed.count(), 0);
+
+    // state change of all rows
+    publish({1, 2, 3, 4, 5}, TCP_CLOSE_WAIT, bps);
+    m_tester->updateModel();
+    ASSERT_EQ(changed.count(), 1);
+    EXPECT_EQ(changed[0][0].toModelIndex().row(), 0);
+    EXPECT_EQ(changed[0][1].toModelIndex().row(), 4);
+}
+
+TEST_F(UT_ConnectionTableModel, test_updateModel_benchmark)
+{
+    const int nsocks = 20000;
+    const int rounds = 20;
+    // few hundred sockets with traffic each tick, like a busy desktop
+    const int nactive = 200;
+
+    QList<ino_t> inodes;
+    for (int i = 1; i <= nsocks; ++i)
+        inodes << ino_t(i);
+
+    // sorted on download like the connections view
+    QSortFilterProxyModel proxy;
+    proxy.setSourceModel(m_tester);
+    proxy.setSortRole(Qt::UserRole);
+    proxy.sort(ConnectionTableModel::kConnectionDownloadColumn, Qt::DescendingOrder);
+
+    m_tester->setActive(true);
+    publish(inodes);
+    QElapsedTimer timer;
+    timer.start();
+    m_tester->updateModel();
+    qint64 fillNs = timer.nsecsElapsed();
+    ASSERT_EQ(proxy.rowCount(), nsocks);
+
+    QVector<QHash<ino_t, IOPS>> rates;
+    for (int i = 0; i < rounds; ++i) {
+        QHash<ino_t, IOPS> bps;
+        for (int j = 0; j < nactive; ++j)
+            bps.insert(ino_t((i * 97 + j * 31) % nsocks + 1), {qreal(j + i), qreal(j)});
+        rates << bps;
+    }
+
+    qint64 updateNs = 0;
+    for (int i = 0; i < rounds; ++i) {
+        publish(inodes, TCP_ESTABLISHED, rates[i]);
+        timer.restart();
+        m_tester->updateModel();
+        updateNs += timer.nsecsElapsed();
+    }
+
+    qInfo() << "connection table of" << nsocks << "sockets: fill" << fillNs / 1000 << "us, update of"
+            << nactive << "active sockets" << updateNs / rounds / 1000 << "us";
+
+    EXPECT_EQ(proxy.rowCount(), nsocks);
+    // busiest socket of last tick on top
+    EXPECT_DOUBLE_EQ(proxy.data(proxy.index(0, ConnectionTableModel::kConnectionDownloadColumn), Qt::UserRole).toDouble(),
+                     qreal(nactive - 1 + rounds - 1));
+}
+
+TEST_F(UT_ConnectionTableModel, test_stateName_01)
+{
+    EXPECT_EQ(ConnectionTableModel::stateName(TCP_ESTABLISHED), QString("ESTAB"));
+    EXPECT_EQ(ConnectionTableModel::stateName(TCP_LISTEN), QString("LISTEN"));
+    EXPECT_EQ(ConnectionTableModel::stateName(TCP_CLOSE), QString("UNCONN"));
+    EXPECT_EQ(ConnectionTableModel::stateName(0), QString("UNKNOWN"));
+}
+
+TEST_F(UT_ConnectionTableModel, test_formatAddress_01)
+{
+    in_addr in4 {};
+    inet_pton(AF_INET, "10.0.0.1", &in4);
+    EXPECT_EQ(ConnectionTableModel::formatAddress(AF_INET, &in4, 443), QString("10.0.0.1:443"));
+
+    in6_addr in6 {};
+    inet_pton(AF_INET6, "fe80::1", &in6);
+    EXPECT_EQ(ConnectionTableModel::formatAddress(AF_INET6, &in6, 22), QString("[fe80::1]:22"));
+
+    in6 = in6addr_any;
+    EXPECT_EQ(ConnectionTableModel::formatAddress(AF_INET6, &in6, 0), QString("*:*"));
+}
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "model/cpu_usage_history.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//qt
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <cmath>
+
+using namespace core::system;
+
+namespace {
+
+// list cpu with total & idle jiffies, busy time accounted as user
+void setCpu(proc_stat_t &stat, int cpu, unsigned long long total, unsigned long long idle)
+{
+    if (cpu >= stat.cpus.size()) {
+        stat.cpus.resize(cpu + 1);
+        stat.listed.resize(cpu + 1);
+    }
+    stat.cpus[cpu] = proc_stat_cpu_t {};
+    stat.cpus[cpu].user = total - idle;
+    stat.cpus[cpu].idle = idle;
+    if (!stat.listed[cpu]) {
+        stat.listed[cpu] = true;
+        stat.online << cpu;
+    }
+}
+
+void setOffline(proc_stat_t &stat, int cpu)
+{
+    stat.listed[cpu] = false;
+    stat.online.removeAll(cpu);
+}
+
+} // namespace
+
+class UT_CPUUsageHistory : public ::testing::Test
+{
+public:
+    UT_CPUUsageHistory() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new CPUUsageHistory(4);
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    CPUUsageHistory *m_tester;
+};
+
+TEST_F(UT_CPUUsageHistory, initTest)
+{
+    EXPECT_EQ(m_tester->rows(), 0);
+    EXPECT_EQ(m_tester->size(), 0);
+    EXPECT_TRUE(std::isnan(m_tester->latest(0)));
+}
+
+TEST_F(UT_CPUUsageHistory, test_update_01)
+{
+    proc_stat_t stat;
+    setCpu(stat, 0, 1000, 750);
+    setCpu(stat, 1, 1000, 1000);
+    m_tester->update(stat);
+
+    // first sample is the average since boot
+    ASSERT_EQ(m_tester->rows(), 2);
+    EXPECT_EQ(m_tester->size(), 1);
+    EXPECT_FLOAT_EQ(m_tester->latest(0), 25.f);
+    EXPECT_FLOAT_EQ(m_tester->latest(1), 0.f);
+
+    setCpu(stat, 0, 1200, 790);
+    setCpu(stat, 1, 1200, 1100);
+    m_tester->update(stat);
+    EXPECT_FLOAT_EQ(m_tester->latest(0), 80.f);
+    EXPECT_FLOAT_EQ(m_tester->latest(1), 50.f);
+    EXPECT_FLOAT_EQ(m_tester->value(0, 1), 25.f);
+    EXPECT_TRUE(std::isnan(m_tester->value(0, 2)));
+}
+
+TEST_F(UT_CPUUsageHistory, test_update_02)
+{
+    proc_stat_t stat;
+    setCpu(stat, 0, 100, 100);
+    for (unsigned long long tick = 1; tick <= 6; ++tick) {
+        setCpu(stat, 0, 100 + tick * 100, 100 + tick * 100 - 5 * tick * (tick + 1));
+        m_tester->update(stat);
+    }
+
+    // ring keeps the last capacity samples, newest first
+    EXPECT_EQ(m_tester->size(), 4);
+    EXPECT_FLOAT_EQ(m_tester->latest(0), 60.f);
+    EXPECT_FLOAT_EQ(m_tester->value(0, 3), 30.f);
+    EXPECT_TRUE(std::isnan(m_tester->value(0, 4)));
+}
+
+TEST_F(UT_CPUUsageHistory, test_update_03)
+{
+    proc_stat_t stat;
+    setCpu(stat, 0, 100, 50);
+    m_tester->update(stat);
+
+    // cpu3 came online, rows grow & keep history of existing rows
+    setCpu(stat, 0, 200, 100);
+    setCpu(stat, 3, 100, 100);
+    m_tester->update(stat);
+    ASSERT_EQ(m_tester->rows(), 4);
+    EXPECT_FLOAT_EQ(m_tester->value(0, 1), 50.f);
+    EXPECT_TRUE(std::isnan(m_tester->value(3, 1)));
+    EXPECT_TRUE(std::isnan(m_tester->latest(1)));
+    EXPECT_FLOAT_EQ(m_tester->latest(3), 0.f);
+
+    // offline cpu has no value
+    setOffline(stat, 3);
+    setCpu(stat, 0, 300, 150);
+    m_tester->update(stat);
+    EXPECT_TRUE(std::isnan(m_tester->latest(3)));
+    EXPECT_FLOAT_EQ(m_tester->latest(0), 50.f);
+}
+
+TEST_F(UT_CPUUsageHistory, test_benchmark_001)
+{
+    const int ncpus = 512;
+    const int rounds = 1000;
+    CPUUsageHistory history(31);
+
+    proc_stat_t stat;
+    for (int cpu = 0; cpu < ncpus; ++cpu)
+        setCpu(stat, cpu, 0, 0);
+
+    QElapsedTimer timer;
+    qint64 updateNs = 0;
+    for (int i = 1; i <= rounds; ++i) {
+        for (int cpu = 0; cpu < ncpus; ++cpu) {
+            stat.cpus[cpu].user += (i + cpu) % 100;
+            stat.cpus[cpu].idle += 100 - (i + cpu) % 100;
+        }
+        timer.restart();
+        history.update(stat);
+        updateNs += timer.nsecsElapsed();
+    }
+
+    // all per core views reading their rows
+    timer.restart();
+    double sum = 0;
+    for (int cpu = 0; cpu < ncpus; ++cpu) {
+        for (int age = 0; age < history.size(); ++age)
+            sum += double(history.value(cpu, age));
+    }
+    qint64 readNs = timer.nsecsElapsed();
+
+    qInfo() << "usage history of" << ncpus << "cpus: update" << updateNs / rounds / 1000 << "us, read all rows" << readNs / 1000 << "us";
+
+    EXPECT_GT(sum, 0);
+    for (int cpu = 0; cpu < ncpus; ++cpu)
+        EXPECT_FLOAT_EQ(history.latest(cpu), float((rounds + cpu) % 100));
+}
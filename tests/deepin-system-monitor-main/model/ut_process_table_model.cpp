@@ -154,11 +154,12 @@ TEST_F(UT_ProcessTableModel, test_getProcessState_002)
 
 }
 
-TEST_F(UT_ProcessTableModel, test_getProcess_001)
+TEST_F(UT_ProcessTableModel, test_snapshot_001)
 {
-    pid_t pid = getpid();
-    m_tester->getProcess(pid);
-
+    // model rows follow the snapshot published by ProcessDB
+    m_tester->updateProcessListDelay();
+    EXPECT_EQ(m_tester->rowCount(), ProcessDB::instance()->snapshot()->size());
+    EXPECT_EQ(m_tester->snapshot().size(), m_tester->rowCount());
 }
 
 TEST_F(UT_ProcessTableModel, test_getProcess_002)
@@ -190,8 +191,6 @@ TEST_F(UT_ProcessTableModel, test_updateProcessListDelay_003)
     Stub stub;
     stub.set(ADDR(ProcessSet, getPIDList), stub_getPIDList);
     m_tester->m_procIdList.append(1);
-    Process proc;
-    m_tester->m_processList.append(proc);
     m_tester->updateProcessListDelay();
 }
 
@@ -368,7 +367,7 @@ TEST_F(UT_ProcessTableModel, test_data_003)
      Process *proc = new Process;
      QModelIndex *index = new QModelIndex();
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -387,7 +386,7 @@ TEST_F(UT_ProcessTableModel, test_data_004)
      Process *proc = new Process;
      QModelIndex *index = new QModelIndex();
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
 
@@ -410,7 +409,7 @@ TEST_F(UT_ProcessTableModel, test_data_005)
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
      Stub b5;
      b5.set(ADDR(Process,state),stub_process_data_state1);
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -431,7 +430,7 @@ TEST_F(UT_ProcessTableModel, test_data_006)
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
      Stub b5;
      b5.set(ADDR(Process,state),stub_process_data_state2);
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -452,7 +451,7 @@ TEST_F(UT_ProcessTableModel, test_data_007)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column2);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -472,7 +471,7 @@ TEST_F(UT_ProcessTableModel, test_data_008)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column3);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -492,7 +491,7 @@ TEST_F(UT_ProcessTableModel, test_data_009)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column4);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -512,7 +511,7 @@ TEST_F(UT_ProcessTableModel, test_data_010)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column5);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -532,7 +531,7 @@ TEST_F(UT_ProcessTableModel, test_data_011)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column6);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -552,7 +551,7 @@ TEST_F(UT_ProcessTableModel, test_data_012)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column7);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -572,7 +571,7 @@ TEST_F(UT_ProcessTableModel, test_data_013)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column8);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -592,7 +591,7 @@ TEST_F(UT_ProcessTableModel, test_data_014)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column9);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -612,7 +611,7 @@ TEST_F(UT_ProcessTableModel, test_data_015)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column10);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -632,7 +631,7 @@ TEST_F(UT_ProcessTableModel, test_data_016)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column11);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -652,7 +651,7 @@ TEST_F(UT_ProcessTableModel, test_data_017)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column12);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -672,7 +671,7 @@ TEST_F(UT_ProcessTableModel, test_data_018)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column13);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DisplayRole;
      m_tester->data(*index,role);
      delete proc;
@@ -692,7 +691,7 @@ TEST_F(UT_ProcessTableModel, test_data_019)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::DecorationRole;
      m_tester->data(*index,role);
      delete proc;
@@ -712,7 +711,7 @@ TEST_F(UT_ProcessTableModel, test_data_020)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
      delete proc;
@@ -732,7 +731,7 @@ TEST_F(UT_ProcessTableModel, test_data_021)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column4);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
      delete proc;
@@ -752,7 +751,7 @@ TEST_F(UT_ProcessTableModel, test_data_022)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column5);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
      delete proc;
@@ -772,7 +771,7 @@ TEST_F(UT_ProcessTableModel, test_data_023)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column6);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
 
      delete proc;
@@ -792,7 +791,7 @@ TEST_F(UT_ProcessTableModel, test_data_024)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column2);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -813,7 +812,7 @@ TEST_F(UT_ProcessTableModel, test_data_025)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column7);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -834,7 +833,7 @@ TEST_F(UT_ProcessTableModel, test_data_026)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column8);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -855,7 +854,7 @@ TEST_F(UT_ProcessTableModel, test_data_027)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column11);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -876,7 +875,7 @@ TEST_F(UT_ProcessTableModel, test_data_028)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column9);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -897,7 +896,7 @@ TEST_F(UT_ProcessTableModel, test_data_029)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column10);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -918,7 +917,7 @@ TEST_F(UT_ProcessTableModel, test_data_030)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column12);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole;
      m_tester->data(*index,role);
 
@@ -939,7 +938,7 @@ TEST_F(UT_ProcessTableModel, test_data_031)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column7);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = (Qt::UserRole + 1);
      m_tester->data(*index,role);
 
@@ -960,7 +959,7 @@ TEST_F(UT_ProcessTableModel, test_data_032)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column8);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = (Qt::UserRole + 1);
      m_tester->data(*index,role);
 
@@ -981,7 +980,7 @@ TEST_F(UT_ProcessTableModel, test_data_033)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column8);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::TextAlignmentRole;
      QVariant expect = m_tester->data(*index,role);
 
@@ -1003,7 +1002,7 @@ TEST_F(UT_ProcessTableModel, test_data_034)
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
      Stub b5;
      b5.set(ADDR(Process,state),stub_process_data_state1);
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole + 2;
      QVariant expect = m_tester->data(*index,role);
 
@@ -1024,7 +1023,7 @@ TEST_F(UT_ProcessTableModel, test_data_035)
      Stub b4;
      b4.set(ADDR(QModelIndex,column),stub_process_data_column1);
 
-     m_tester->m_processList  << *proc;
+     m_tester->m_procIdList  << proc->pid();
      int role = Qt::UserRole + 4;
      m_tester->data(*index,role);
 
@@ -1079,7 +1078,6 @@ TEST_F(UT_ProcessTableModel, test_updateProcessState_001)
      Process proc(pid);
      char state = 'Z';
      m_tester->m_procIdList << pid;
-     m_tester->m_processList << proc;
 
      m_tester->updateProcessState(pid,state);
 
@@ -1091,7 +1089,6 @@ TEST_F(UT_ProcessTableModel, test_updateProcessPriority_001)
      Process proc(pid);
      int priority = 0;
      m_tester->m_procIdList << pid;
-     m_tester->m_processList << proc;
 
      m_tester->updateProcessPriority(pid,priority);
 
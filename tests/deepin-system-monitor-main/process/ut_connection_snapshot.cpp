@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "process/connection_snapshot.h"
+#include "process/private/process_p.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+//system
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+using namespace core::process;
+
+namespace {
+
+SockStat makeSock(ino_t ino, int proto, const char *saddr, uint sport, const char *daddr, uint dport, uint state)
+{
+    SockStat stat(new sock_stat_t {});
+    stat->ino = ino;
+    stat->sa_family = AF_INET;
+    stat->proto = proto;
+    inet_pton(AF_INET, saddr, &stat->s_addr.in4);
+    stat->s_port = sport;
+    inet_pton(AF_INET, daddr, &stat->d_addr.in4);
+    stat->d_port = dport;
+    stat->state = state;
+    return stat;
+}
+
+Process makeProcess(pid_t pid, const QList<ino_t> &inodes)
+{
+    Process proc(pid);
+    proc.d->sockInodes = inodes;
+    return proc;
+}
+
+} // namespace
+
+class UT_ConnectionSnapshot : public ::testing::Test
+{
+public:
+    UT_ConnectionSnapshot() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ConnectionSnapshot();
+
+        SockStatMap socks;
+        insertSockStat(socks, makeSock(11, IPPROTO_TCP, "192.168.1.2", 40000, "10.0.0.1", 443, TCP_ESTABLISHED));
+        insertSockStat(socks, makeSock(12, IPPROTO_TCP, "0.0.0.0", 22, "0.0.0.0", 0, TCP_LISTEN));
+        insertSockStat(socks, makeSock(13, IPPROTO_UDP, "0.0.0.0", 5353, "0.0.0.0", 0, TCP_CLOSE));
+        // time wait, no owner & no inode
+        insertSockStat(socks, makeSock(0, IPPROTO_TCP, "192.168.1.2", 40001, "10.0.0.1", 443, TCP_TIME_WAIT));
+
+        QMap<pid_t, Process> set;
+        set.insert(100, makeProcess(100, {11, 99}));
+        // forked server, listening socket shared by parent & child
+        set.insert(200, makeProcess(200, {12}));
+        set.insert(201, makeProcess(201, {12}));
+        set[100].d->sockIOBps.insert(11, {2048., 512.});
+
+        m_tester->build(set, socks);
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ConnectionSnapshot *m_tester;
+};
+
+TEST_F(UT_ConnectionSnapshot, test_build_001)
+{
+    // tcp sockets listed once though keyed by both directions, unknown inode skipped
+    ASSERT_EQ(m_tester->size(), 4);
+
+    int row = m_tester->indexOf(100, 11);
+    ASSERT_GE(row, 0);
+    EXPECT_EQ(m_tester->at(row).sock->d_port, 443u);
+    EXPECT_DOUBLE_EQ(m_tester->at(row).recvBps, 2048.);
+    EXPECT_DOUBLE_EQ(m_tester->at(row).sentBps, 512.);
+}
+
+TEST_F(UT_ConnectionSnapshot, test_build_002)
+{
+    // shared socket listed for each holder
+    EXPECT_GE(m_tester->indexOf(200, 12), 0);
+    EXPECT_GE(m_tester->indexOf(201, 12), 0);
+    EXPECT_DOUBLE_EQ(m_tester->at(m_tester->indexOf(201, 12)).recvBps, 0.);
+
+    // socket without visible owner
+    int row = m_tester->indexOf(0, 13);
+    ASSERT_GE(row, 0);
+    EXPECT_EQ(m_tester->at(row).sock->state, uint(TCP_CLOSE));
+}
+
+TEST_F(UT_ConnectionSnapshot, test_indexOf_001)
+{
+    EXPECT_EQ(m_tester->indexOf(100, 12), -1);
+    EXPECT_EQ(m_tester->indexOf(100, 99), -1);
+    EXPECT_EQ(m_tester->indexOf(0, 0), -1);
+
+    m_tester->clear();
+    EXPECT_EQ(m_tester->size(), 0);
+}
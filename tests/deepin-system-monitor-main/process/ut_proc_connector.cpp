@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "process/proc_connector.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+//system
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace core::process;
+
+class UT_ProcConnector : public ::testing::Test
+{
+public:
+    UT_ProcConnector() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ProcConnector();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ProcConnector *m_tester;
+};
+
+TEST_F(UT_ProcConnector, test_readEvents_001)
+{
+    QVector<ProcEvent> events;
+    bool ok = m_tester->readEvents(events);
+
+    // nothing can be read without subscription
+    if (!m_tester->isValid()) {
+        EXPECT_FALSE(ok);
+        EXPECT_TRUE(events.isEmpty());
+    }
+}
+
+TEST_F(UT_ProcConnector, test_readEvents_002)
+{
+    if (!m_tester->isValid())
+        return;
+
+    pid_t child = fork();
+    if (child == 0)
+        _exit(0);
+    waitpid(child, nullptr, 0);
+
+    QVector<ProcEvent> events;
+    EXPECT_TRUE(m_tester->readEvents(events));
+
+    bool forked = false, exited = false;
+    for (const ProcEvent &event : events) {
+        if (event.pid != child)
+            continue;
+        if (event.type == ProcEvent::kFork) {
+            forked = true;
+            EXPECT_EQ(event.ppid, getpid());
+        } else if (event.type == ProcEvent::kExit) {
+            exited = true;
+        }
+    }
+    EXPECT_TRUE(forked);
+    EXPECT_TRUE(exited);
+}
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "process/proc_reader.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+//system
+#include <string.h>
+#include <unistd.h>
+
+using namespace core::process;
+
+class UT_ProcReader : public ::testing::Test
+{
+public:
+    UT_ProcReader() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ProcReader(getpid());
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ProcReader *m_tester;
+};
+
+TEST_F(UT_ProcReader, initTest)
+{
+    EXPECT_TRUE(m_tester->isOpen());
+    EXPECT_FALSE(m_tester->isGone());
+}
+
+TEST_F(UT_ProcReader, test_read_001)
+{
+    size_t len = 0;
+    char *buf = m_tester->read("stat", &len);
+
+    ASSERT_NE(buf, nullptr);
+    EXPECT_GT(len, 0u);
+    EXPECT_EQ(strlen(buf), len);
+    EXPECT_EQ(atoi(buf), getpid());
+}
+
+TEST_F(UT_ProcReader, test_read_002)
+{
+    size_t len = 0;
+    char *buf = m_tester->read("cmdline", &len, 4);
+
+    ASSERT_NE(buf, nullptr);
+    EXPECT_LE(len, 4u);
+}
+
+TEST_F(UT_ProcReader, test_read_003)
+{
+    char *buf = m_tester->read("no_such_file");
+
+    EXPECT_EQ(buf, nullptr);
+    EXPECT_FALSE(m_tester->isGone());
+}
+
+TEST_F(UT_ProcReader, test_openDir_001)
+{
+    int fd = m_tester->openDir("fd");
+
+    EXPECT_GE(fd, 0);
+    if (fd >= 0)
+        close(fd);
+}
+
+TEST_F(UT_ProcReader, test_gone_001)
+{
+    // pid_max never exceeds 2^22
+    ProcReader reader(1 << 23);
+
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_TRUE(reader.isGone());
+    EXPECT_EQ(reader.read("stat"), nullptr);
+}
+
+TEST_F(UT_ProcReader, test_stats_001)
+{
+    ProcReader::resetStats();
+    m_tester->read("statm");
+
+    EXPECT_EQ(ProcReader::stats().opens.load(), 1u);
+    EXPECT_GE(ProcReader::stats().reads.load(), 1u);
+    EXPECT_GT(ProcReader::stats().bytes.load(), 0u);
+}
@@ -5,6 +5,7 @@
 
 //self
 #include "process/process.h"
+#include "process/proc_reader.h"
 #include "common/common.h"
 #include "process/private/process_p.h"
 //gtest
@@ -46,16 +47,6 @@ ssize_t stub_readStat_read2()
     m_Sresult = "read failed";
     return -1;
 }
-FILE *stub_readCmdline_fopen()
-{
-    m_Sresult = "fopen failed";
-    return nullptr;
-}
-uDir *stub_readSockInodes_opendir()
-{
-    m_Sresult = "diropen failed";
-    return nullptr;
-}
 /***************************************STUB end**********************************************/
 class UT_Process : public ::testing::Test
 {
@@ -444,7 +435,8 @@ TEST_F(UT_Process, test_readStat_001)
     b2.set(read, stub_readStat_read1);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStat(reader);
 
 }
 
@@ -452,7 +444,8 @@ TEST_F(UT_Process, test_readStat_002)
 {
     Stub b1;
     b1.set(open, stub_readStat_open2);
-    m_tester->readStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStat(reader);
 
     EXPECT_TRUE(m_Sresult == "open failed");
 }
@@ -465,7 +458,8 @@ TEST_F(UT_Process, test_readStat_003)
     b2.set(read, stub_readStat_read2);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStat(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -474,7 +468,8 @@ TEST_F(UT_Process, test_readStat_004)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStat(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -482,26 +477,28 @@ TEST_F(UT_Process, test_readStat_004)
 TEST_F(UT_Process, test_readCmdline_001)
 {
     Stub b1;
-    b1.set(fopen, stub_readCmdline_fopen);
-    m_tester->readCmdline();
+    b1.set(open, stub_readStat_open2);
+    ProcReader reader(m_tester->pid());
+    EXPECT_FALSE(m_tester->readCmdline(reader));
 
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    EXPECT_TRUE(m_Sresult == "open failed");
 }
 
 TEST_F(UT_Process, test_readCmdline_002)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readCmdline();
-
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    ProcReader reader(m_tester->pid());
+    EXPECT_TRUE(m_tester->readCmdline(reader));
+    EXPECT_FALSE(m_tester->cmdline().isEmpty());
 }
 
 TEST_F(UT_Process, test_readEnviron_001)
 {
     Stub b1;
     b1.set(open, stub_readStat_open2);
-    m_tester->readEnviron();
+    ProcReader reader(m_tester->pid());
+    m_tester->readEnviron(reader);
 
     EXPECT_TRUE(m_Sresult == "open failed");
 }
@@ -510,9 +507,10 @@ TEST_F(UT_Process, test_readEnviron_002)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readEnviron();
+    ProcReader reader(m_tester->pid());
+    m_tester->readEnviron(reader);
 
-    EXPECT_TRUE(m_Sresult == "open failed");
+    EXPECT_FALSE(reader.isGone());
 }
 
 TEST_F(UT_Process, test_readSchedStat_001)
@@ -523,7 +521,8 @@ TEST_F(UT_Process, test_readSchedStat_001)
     b2.set(read, stub_readStat_read1);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readSchedStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readSchedStat(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -532,7 +531,8 @@ TEST_F(UT_Process, test_readSchedStat_002)
 {
     Stub b1;
     b1.set(open, stub_readStat_open2);
-    m_tester->readSchedStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readSchedStat(reader);
 
     EXPECT_TRUE(m_Sresult == "open failed");
 }
@@ -545,7 +545,8 @@ TEST_F(UT_Process, test_readSchedStat_003)
     b2.set(read, stub_readStat_read2);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readSchedStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readSchedStat(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -554,7 +555,8 @@ TEST_F(UT_Process, test_readSchedStat_004)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readSchedStat();
+    ProcReader reader(m_tester->pid());
+    m_tester->readSchedStat(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -562,19 +564,21 @@ TEST_F(UT_Process, test_readSchedStat_004)
 TEST_F(UT_Process, test_readStatus_001)
 {
     Stub b1;
-    b1.set(fopen, stub_readCmdline_fopen);
-    m_tester->readStatus();
+    b1.set(open, stub_readStat_open2);
+    ProcReader reader(m_tester->pid());
+    EXPECT_FALSE(m_tester->readStatus(reader));
 
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    EXPECT_TRUE(m_Sresult == "open failed");
 }
 
 TEST_F(UT_Process, test_readStatus_002)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readStatus();
+    ProcReader reader(m_tester->pid());
+    EXPECT_TRUE(m_tester->readStatus(reader));
 
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    EXPECT_EQ(m_tester->uid(), getuid());
 }
 
 TEST_F(UT_Process, test_readStatm_001)
@@ -585,7 +589,8 @@ TEST_F(UT_Process, test_readStatm_001)
     b2.set(read, stub_readStat_read1);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readStatm();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStatm(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -594,7 +599,8 @@ TEST_F(UT_Process, test_readStatm_002)
 {
     Stub b1;
     b1.set(open, stub_readStat_open2);
-    m_tester->readStatm();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStatm(reader);
 
     EXPECT_TRUE(m_Sresult == "open failed");
 }
@@ -607,7 +613,8 @@ TEST_F(UT_Process, test_readStatm_003)
     b2.set(read, stub_readStat_read2);
     Stub b3;
     b3.set(close, stub_readStat_close);
-    m_tester->readStatm();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStatm(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -616,7 +623,8 @@ TEST_F(UT_Process, test_readStatm_004)
 {
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readStatm();
+    ProcReader reader(m_tester->pid());
+    m_tester->readStatm(reader);
 
 //    EXPECT_TRUE(m_Sresult=="close");
 }
@@ -624,10 +632,11 @@ TEST_F(UT_Process, test_readStatm_004)
 TEST_F(UT_Process, test_readIO_001)
 {
     Stub b1;
-    b1.set(fopen, stub_readCmdline_fopen);
-    m_tester->readIO();
+    b1.set(open, stub_readStat_open2);
+    ProcReader reader(m_tester->pid());
+    m_tester->readIO(reader);
 
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    EXPECT_TRUE(m_Sresult == "open failed");
 }
 
 TEST_F(UT_Process, test_readIO_002)
@@ -635,18 +644,18 @@ TEST_F(UT_Process, test_readIO_002)
 
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readIO();
-
-    EXPECT_TRUE(m_Sresult == "fopen failed");
+    ProcReader reader(m_tester->pid());
+    m_tester->readIO(reader);
 }
 
 TEST_F(UT_Process, test_readSockInodes_001)
 {
     Stub b1;
-    b1.set(opendir, stub_readSockInodes_opendir);
-    m_tester->readSockInodes();
+    b1.set(open, stub_readStat_open2);
+    ProcReader reader(m_tester->pid());
+    m_tester->readSockInodes(reader);
 
-    EXPECT_TRUE(m_Sresult == "diropen failed");
+    EXPECT_TRUE(m_Sresult == "open failed");
 }
 
 TEST_F(UT_Process, test_readSockInodes_002)
@@ -654,8 +663,59 @@ TEST_F(UT_Process, test_readSockInodes_002)
 
     pid_t pid = getpid();
     m_tester->d->pid = pid;
-    m_tester->readSockInodes();
+    ProcReader reader(m_tester->pid());
+    m_tester->readSockInodes(reader);
+
+}
+
+TEST_F(UT_Process, test_readSimpleFiles_001)
+{
+    m_tester->readSimpleFiles();
+
+    EXPECT_TRUE(m_tester->isValid());
+    EXPECT_EQ(m_tester->uid(), getuid());
+}
+
+TEST_F(UT_Process, test_readVariableFiles_001)
+{
+    m_tester->readVariableFiles();
+
+    EXPECT_TRUE(m_tester->isValid());
+    EXPECT_GT(m_tester->vtrmemory(), 0u);
+}
+
+TEST_F(UT_Process, test_readVariableFiles_002)
+{
+    m_tester->readSimpleFiles();
+    Process::resetTierStats();
+
+    // only hot files are read until status is due
+    m_tester->readVariableFiles();
+    EXPECT_EQ(Process::tierStats(kHotTier).refreshes.load(), 1u);
+    EXPECT_GT(Process::tierStats(kHotTier).bytes.load(), 0u);
+    EXPECT_EQ(Process::tierStats(kStatusTier).refreshes.load(), 0u);
+    EXPECT_EQ(Process::tierStats(kIdentityTier).refreshes.load(), 0u);
+
+    for (int i = 0; i < 5; ++i)
+        m_tester->readVariableFiles();
+    EXPECT_EQ(Process::tierStats(kStatusTier).refreshes.load(), 1u);
+    EXPECT_EQ(Process::tierStats(kIdentityTier).refreshes.load(), 0u);
+}
+
+TEST_F(UT_Process, test_readVariableFiles_003)
+{
+    m_tester->readSimpleFiles();
+    Process::resetTierStats();
+
+    // changed comm means exec, identity files are read again
+    m_tester->d->comm = "exec-before";
+    m_tester->d->cmdline.clear();
+    m_tester->readVariableFiles();
 
+    EXPECT_TRUE(m_tester->d->identityChanged);
+    EXPECT_EQ(Process::tierStats(kStatusTier).refreshes.load(), 1u);
+    EXPECT_EQ(Process::tierStats(kIdentityTier).refreshes.load(), 1u);
+    EXPECT_FALSE(m_tester->cmdline().isEmpty());
 }
 
 TEST_F(UT_Process, test_readProcessInfo_001)
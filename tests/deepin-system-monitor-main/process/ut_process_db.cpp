@@ -121,6 +121,32 @@ TEST_F(UT_ProcessDB, test_processSet_001)
     EXPECT_EQ(list,m_tester->m_procSet->getPIDList());
 }
 
+TEST_F(UT_ProcessDB, test_snapshot_001)
+{
+    // empty snapshot is published before first refresh
+    ProcessSnapshotPtr snapshot = m_tester->snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->size(), 0);
+}
+
+TEST_F(UT_ProcessDB, test_snapshot_002)
+{
+    Stub b1;
+    b1.set(ADDR(DesktopEntryCache,updateCache), stub_update_updateCache);
+    b1.set(ADDR(WMWindowList,updateWindowListCache), stub_update_updateWindowListCache);
+    Stub b2;
+    b2.set(ADDR(ProcessSet,refresh), stub_update_refresh);
+
+    ProcessSnapshotPtr before = m_tester->snapshot();
+    m_tester->update();
+    ProcessSnapshotPtr after = m_tester->snapshot();
+
+    // a new snapshot is published, the old one stays intact for readers still holding it
+    EXPECT_NE(before, after);
+    EXPECT_EQ(before->size(), 0);
+    EXPECT_EQ(after->size(), m_tester->processSet()->getPIDList().size());
+}
+
 TEST_F(UT_ProcessDB, test_isCurrentProcess_001)
 {
     pid_t pid = 50000;
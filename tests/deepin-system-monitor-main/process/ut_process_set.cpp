@@ -13,7 +13,12 @@
 #include "stub.h"
 #include <gtest/gtest.h>
 
+//qt
+#include <QLoggingCategory>
+
 using namespace core::process;
+
+Q_DECLARE_LOGGING_CATEGORY(processScan)
 /***************************************STUB begin*********************************************/
 
 /***************************************STUB end**********************************************/
@@ -69,6 +74,13 @@ TEST_F(UT_ProcessSet, test_refresh_001)
     m_tester->refresh();
 }
 
+TEST_F(UT_ProcessSet, test_refresh_002)
+{
+    // scan stats are not logged unless asked for
+    EXPECT_FALSE(processScan().isDebugEnabled());
+    m_tester->refresh();
+}
+
 TEST_F(UT_ProcessSet, test_scanProcess_001)
 {
     Process *proc = new Process;
@@ -77,6 +89,68 @@ TEST_F(UT_ProcessSet, test_scanProcess_001)
     delete proc;
 }
 
+TEST_F(UT_ProcessSet, test_setScanWorkers_001)
+{
+    m_tester->setScanWorkers(0);
+    EXPECT_GE(m_tester->scanWorkers(), 1);
+
+    m_tester->setScanWorkers(1);
+    EXPECT_EQ(m_tester->scanWorkers(), 1);
+    EXPECT_EQ(m_tester->m_scanPool.get(), nullptr);
+
+    m_tester->setScanWorkers(4);
+    EXPECT_EQ(m_tester->scanWorkers(), 4);
+    EXPECT_NE(m_tester->m_scanPool.get(), nullptr);
+}
+
+TEST_F(UT_ProcessSet, test_scanParallel_001)
+{
+    m_tester->setScanWorkers(4);
+
+    QVector<Process> procs;
+    for (int i = 0; i < 1024; ++i)
+        procs << Process(getpid());
+    m_tester->scanParallel(procs, &Process::readVariableFiles);
+
+    for (const Process &proc : procs) {
+        EXPECT_TRUE(proc.isValid());
+        EXPECT_EQ(proc.ppid(), getppid());
+    }
+}
+
+TEST_F(UT_ProcessSet, test_setEventMonitor_001)
+{
+    m_tester->setEventMonitor(false);
+    EXPECT_FALSE(m_tester->isEventMonitorActive());
+
+    // active only with CAP_NET_ADMIN, falls back to /proc walk otherwise
+    m_tester->setEventMonitor(true);
+    EXPECT_EQ(m_tester->isEventMonitorActive(), ProcConnector().isValid());
+}
+
+TEST_F(UT_ProcessSet, test_scanProcEvents_001)
+{
+    m_tester->setEventMonitor(false);
+
+    QVector<Process> bornProcs, forkedProcs;
+    EXPECT_FALSE(m_tester->scanProcEvents(bornProcs, forkedProcs));
+    EXPECT_TRUE(bornProcs.isEmpty());
+}
+
+TEST_F(UT_ProcessSet, test_scanProcDir_001)
+{
+    m_tester->m_table.clear();
+    m_tester->m_lifecycle = {};
+    m_tester->m_table.beginScan();
+
+    QVector<Process> bornProcs;
+    m_tester->scanProcDir(bornProcs);
+
+    EXPECT_GT(bornProcs.size(), 0);
+    EXPECT_EQ(m_tester->lifecycleStats().births, bornProcs.size());
+    EXPECT_TRUE(m_tester->m_table.contains(getpid()));
+}
+
 TEST_F(UT_ProcessSet, test_hasNext_001)
 {
     ProcessSet::Iterator *it = new ProcessSet::Iterator();
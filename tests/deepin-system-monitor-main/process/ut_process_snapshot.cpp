@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "process/process_snapshot.h"
+#include "process/private/process_p.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+//system
+#include <unistd.h>
+
+using namespace core::process;
+
+namespace {
+
+Process makeProcess(pid_t pid, const QString &name, const QString &user, qreal cpu, qulonglong rss)
+{
+    Process proc(pid);
+    proc.d->ppid = 1;
+    proc.d->name = name;
+    proc.d->usrerName = user;
+    proc.d->rss = rss;
+    proc.setCpu(cpu);
+    return proc;
+}
+
+} // namespace
+
+class UT_ProcessSnapshot : public ::testing::Test
+{
+public:
+    UT_ProcessSnapshot() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ProcessSnapshot();
+
+        QMap<pid_t, Process> set;
+        set.insert(100, makeProcess(100, "bash", "root", 1.5, 1024));
+        set.insert(200, makeProcess(200, "bash", "user", 2.5, 2048));
+        set.insert(300, makeProcess(300, "vim", "user", 3.0, 4096));
+        m_tester->build(set);
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ProcessSnapshot *m_tester;
+};
+
+TEST_F(UT_ProcessSnapshot, test_build_001)
+{
+    ASSERT_EQ(m_tester->size(), 3);
+    EXPECT_EQ(m_tester->pid()[1], 200);
+    EXPECT_EQ(m_tester->ppid()[1], 1);
+    EXPECT_EQ(m_tester->memory()[2], 4096u);
+    EXPECT_EQ(m_tester->name(0), QString("bash"));
+    EXPECT_EQ(m_tester->userName(2), QString("user"));
+
+    // equal strings share one interned entry
+    EXPECT_EQ(m_tester->m_nameId[0], m_tester->m_nameId[1]);
+    EXPECT_EQ(m_tester->m_userNameId[1], m_tester->m_userNameId[2]);
+    EXPECT_TRUE(m_tester->m_stringIds.isEmpty());
+}
+
+TEST_F(UT_ProcessSnapshot, test_indexOf_001)
+{
+    EXPECT_EQ(m_tester->indexOf(300), 2);
+    EXPECT_EQ(m_tester->indexOf(400), -1);
+}
+
+TEST_F(UT_ProcessSnapshot, test_select_001)
+{
+    ProcessSnapshot user = m_tester->select({1, 2});
+
+    ASSERT_EQ(user.size(), 2);
+    EXPECT_EQ(user.pid()[0], 200);
+    EXPECT_EQ(user.name(1), QString("vim"));
+    EXPECT_EQ(user.indexOf(300), 1);
+    EXPECT_EQ(user.indexOf(100), -1);
+    EXPECT_EQ(ProcessSnapshot::sum(user.memory()), 6144u);
+    EXPECT_DOUBLE_EQ(ProcessSnapshot::sum(user.cpu()), 5.5);
+}
+
+TEST_F(UT_ProcessSnapshot, test_setState_001)
+{
+    m_tester->setState(0, 'T');
+    m_tester->setPriority(0, 5);
+    // out of range rows are ignored
+    m_tester->setState(-1, 'T');
+    m_tester->setPriority(3, 5);
+
+    EXPECT_EQ(m_tester->state()[0], 'T');
+    EXPECT_EQ(m_tester->priority()[0], 5);
+}
+
+TEST_F(UT_ProcessSnapshot, test_clear_001)
+{
+    m_tester->clear();
+
+    EXPECT_EQ(m_tester->size(), 0);
+    EXPECT_EQ(m_tester->indexOf(100), -1);
+}
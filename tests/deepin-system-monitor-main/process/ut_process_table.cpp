@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "process/process_table.h"
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+using namespace core::process;
+
+class UT_ProcessTable : public ::testing::Test
+{
+public:
+    UT_ProcessTable() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ProcessTable();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ProcessTable *m_tester;
+};
+
+TEST_F(UT_ProcessTable, initTest)
+{
+    EXPECT_EQ(m_tester->size(), 0);
+}
+
+TEST_F(UT_ProcessTable, test_touch_001)
+{
+    bool born = false;
+    m_tester->beginScan();
+    ProcessTable::Entry *entry = m_tester->touch(100, born);
+
+    ASSERT_NE(entry, nullptr);
+    EXPECT_TRUE(born);
+    EXPECT_EQ(entry->pid, 100);
+    EXPECT_EQ(entry->generation, m_tester->generation());
+
+    m_tester->beginScan();
+    entry = m_tester->touch(100, born);
+    EXPECT_FALSE(born);
+    EXPECT_EQ(m_tester->size(), 1);
+}
+
+TEST_F(UT_ProcessTable, test_sweep_001)
+{
+    bool born = false;
+    m_tester->beginScan();
+    for (pid_t pid = 1; pid <= 5000; ++pid)
+        m_tester->touch(pid, born);
+    EXPECT_EQ(m_tester->sweep(), 0);
+    EXPECT_EQ(m_tester->size(), 5000);
+
+    // odd pids exit
+    m_tester->beginScan();
+    for (pid_t pid = 2; pid <= 5000; pid += 2)
+        m_tester->touch(pid, born);
+    EXPECT_EQ(m_tester->sweep(), 2500);
+    EXPECT_EQ(m_tester->size(), 2500);
+
+    for (pid_t pid = 1; pid <= 5000; ++pid) {
+        EXPECT_EQ(m_tester->contains(pid), pid % 2 == 0);
+    }
+    for (const ProcessTable::Entry &entry : *m_tester) {
+        EXPECT_EQ(m_tester->find(entry.pid), &entry);
+    }
+}
+
+TEST_F(UT_ProcessTable, test_remove_001)
+{
+    bool born = false;
+    m_tester->beginScan();
+    m_tester->touch(1, born);
+    m_tester->touch(1025, born);
+    m_tester->remove(1);
+
+    EXPECT_FALSE(m_tester->contains(1));
+    EXPECT_TRUE(m_tester->contains(1025));
+    EXPECT_EQ(m_tester->find(2), nullptr);
+}
+
+TEST_F(UT_ProcessTable, test_clear_001)
+{
+    bool born = false;
+    m_tester->beginScan();
+    m_tester->touch(1, born);
+    m_tester->clear();
+
+    EXPECT_EQ(m_tester->size(), 0);
+    EXPECT_FALSE(m_tester->contains(1));
+}
@@ -42,63 +42,19 @@ TEST_F(UT_CPUSetPrivate, initTest)
 
 TEST_F(UT_CPUSetPrivate, test_cpoy)
 {
-    FILE *fp;
-    QByteArray line(BUFSIZ, '\0');
-    int ncpu = 0;
-    int nr;
+    const char content[] = "cpu  4 3 2 1 0 0 0 0 0 0\ncpu0 4 3 2 1 0 0 0 0 0 0\ncpu1 8 6 4 2 0 0 0 0 0 0\n";
+    ASSERT_TRUE(ProcStatReader::parse(content, sizeof(content) - 1, m_tester->m_procStat));
+    m_tester->m_namedCpus = m_tester->m_procStat.online;
+    m_tester->m_cpuNames = {"cpu0", "cpu1"};
 
-    if (!(fp = fopen("/proc/stat", "r"))) {
-//        return;
-    }
-
-    while (fgets(line.data(), BUFSIZ, fp)) {
-        if (!strncmp(line.data(), "cpu", 3)) {
-                    // per cpu stat in jiffies
-                    auto stat = std::make_shared<struct cpu_stat_t>();
-                    if (stat) {
-                        *stat = {};
-
-                        nr = sscanf(line.data() + 3, "%d %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
-                                    &ncpu,
-                                    &stat->user,
-                                    &stat->nice,
-                                    &stat->sys,
-                                    &stat->idle,
-                                    &stat->iowait,
-                                    &stat->hardirq,
-                                    &stat->softirq,
-                                    &stat->steal,
-                                    &stat->guest,
-                                    &stat->guest_nice);
-
-                        if (nr == 11) {
-                            QByteArray cpu {"cpu"};
-                            cpu.append(QByteArray::number(ncpu));
-                            stat->cpu = cpu;
-
-                            // usage calc
-                            auto usage = std::make_shared<struct cpu_usage_t>();
-                            if (usage) {
-                                *usage = {};
-                                usage->cpu = cpu;
-                                usage->total = stat->user + stat->nice + stat->sys + stat->idle + stat->iowait + stat->hardirq + stat->softirq + stat->steal;
-                                usage->idle = stat->idle + stat->iowait;
-
-                                m_tester->m_statDB[stat->cpu] = stat;
-                                m_tester->m_usageDB[usage->cpu] = usage;
-
-                                QList<CPUInfo> infos{};
-                                CPUInfo info{};
-                                infos.append(info);
-                                m_tester->m_infos = infos;
-                            }
-
-                        }
-                    }
-        }
-    }
+    QList<CPUInfo> infos{};
+    CPUInfo info{};
+    infos.append(info);
+    m_tester->m_infos = infos;
 
     CPUSetPrivate copy(*m_tester);
+    EXPECT_EQ(copy.m_procStat.online, m_tester->m_procStat.online);
+    EXPECT_EQ(copy.m_procStat.cpus[1].user, 8ull);
+    EXPECT_EQ(copy.m_cpuNames, m_tester->m_cpuNames);
+    EXPECT_EQ(copy.m_infos.size(), 1);
 }
-
-
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/cpu_freq.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//qt
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace core::system;
+
+namespace {
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+}
+
+// cpufreq directory of one cpu in a fake sysfs tree
+void addCpu(const QTemporaryDir &root, int cpu, const QByteArray &cur, const QByteArray &max)
+{
+    QString dir = QString("%1/cpu%2/cpufreq").arg(root.path()).arg(cpu);
+    QDir().mkpath(dir);
+    writeFile(dir + "/scaling_cur_freq", cur);
+    writeFile(dir + "/cpuinfo_max_freq", max);
+}
+
+} // namespace
+
+class UT_CPUFreq : public ::testing::Test
+{
+public:
+    UT_CPUFreq() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(m_root.isValid());
+        addCpu(m_root, 0, "1200000\n", "3000000\n");
+        addCpu(m_root, 1, "1800000\n", "3000000\n");
+        // cpu2 has no cpufreq
+        QDir().mkpath(m_root.path() + "/cpu2");
+        m_tester = new CPUFreq(m_root.path().toLocal8Bit());
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    QTemporaryDir m_root;
+    CPUFreq *m_tester;
+};
+
+TEST_F(UT_CPUFreq, initTest)
+{
+}
+
+TEST_F(UT_CPUFreq, test_update_01)
+{
+    EXPECT_EQ(m_tester->open({0, 1, 2}), 2);
+    EXPECT_EQ(m_tester->curFreq(0), 0u);
+
+    ASSERT_TRUE(m_tester->update());
+    EXPECT_EQ(m_tester->curFreq(0), 1200000u);
+    EXPECT_EQ(m_tester->curFreq(1), 1800000u);
+    EXPECT_EQ(m_tester->curFreq(2), 0u);
+    EXPECT_EQ(m_tester->curFreq(7), 0u);
+    EXPECT_DOUBLE_EQ(m_tester->scaling(), 50.);
+
+    // files stay open, new value is read from the start again
+    writeFile(m_root.path() + "/cpu0/cpufreq/scaling_cur_freq", "3000000\n");
+    ASSERT_TRUE(m_tester->update());
+    EXPECT_EQ(m_tester->curFreq(0), 3000000u);
+    EXPECT_DOUBLE_EQ(m_tester->scaling(), 80.);
+}
+
+TEST_F(UT_CPUFreq, test_open_01)
+{
+    EXPECT_EQ(m_tester->open({2}), 0);
+    EXPECT_FALSE(m_tester->update());
+    EXPECT_DOUBLE_EQ(m_tester->scaling(), 0.);
+
+    // reopened after hotplug
+    EXPECT_EQ(m_tester->open({1}), 1);
+    EXPECT_EQ(m_tester->count(), 1);
+    m_tester->close();
+    EXPECT_EQ(m_tester->count(), 0);
+}
@@ -21,15 +21,9 @@ using namespace core::system;
 
 /***************************************STUB begin*********************************************/
 
-FILE *stub_fopen(const char *__restrict __filename,
-                 const char *__restrict __modes)
+bool stub_read_stats_failed()
 {
-    return nullptr;
-}
-
-int stub_sscanf_stats(const char *__restrict __s, const char *__restrict __format, ...)
-{
-    return 1;
+    return false;
 }
 
 
@@ -260,19 +254,43 @@ TEST_F(UT_CPUSet, test_read_stats)
 TEST_F(UT_CPUSet, test_read_stats_02)
 {
     Stub stub;
-    stub.set(fopen, stub_fopen);
+    stub.set(ADDR(ProcStatReader, read), stub_read_stats_failed);
     m_tester->read_stats();
     core::system::CPUStat stat = m_tester->stat();
-    EXPECT_NE(stat->idle, -1);
+    EXPECT_EQ(stat->idle, 0ull);
+    EXPECT_TRUE(m_tester->cpuLogicName().isEmpty());
 }
 
 TEST_F(UT_CPUSet, test_read_stats_03)
 {
-    Stub stub;
-    stub.set(sscanf, stub_sscanf_stats);
     m_tester->read_stats();
-    core::system::CPUStat stat = m_tester->stat();
-    EXPECT_NE(stat->idle, -1);
+    // logical names & per cpu views follow the online cpus of the last read
+    std::shared_ptr<const proc_stat_t> published = m_tester->procStat();
+    const proc_stat_t &stat = *published;
+    QList<QByteArray> names = m_tester->cpuLogicName();
+    ASSERT_EQ(names.size(), stat.online.size());
+    for (int i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(names[i], QByteArray("cpu").append(QByteArray::number(stat.online[i])));
+        EXPECT_EQ(m_tester->usageDB(names[i])->total, stat.cpus[stat.online[i]].total());
+    }
+    EXPECT_EQ(m_tester->statDB("cpu-1"), nullptr);
+    EXPECT_EQ(m_tester->usageDB("cpu99999"), nullptr);
+    EXPECT_GE(m_tester->contextSwitches(), 0ull);
+}
+
+TEST_F(UT_CPUSet, test_read_stats_04)
+{
+    m_tester->read_stats();
+    // a held copy is not touched by later reads, the next read publishes a new one
+    std::shared_ptr<const proc_stat_t> held = m_tester->procStat();
+    proc_stat_t before = *held;
+    before.cpus.detach();
+    m_tester->read_stats();
+    EXPECT_NE(m_tester->procStat(), held);
+    EXPECT_EQ(held->ctxt, before.ctxt);
+    ASSERT_EQ(held->cpus.size(), before.cpus.size());
+    for (int i = 0; i < held->cpus.size(); ++i)
+        EXPECT_EQ(held->cpus[i].total(), before.cpus[i].total());
 }
 
 TEST_F(UT_CPUSet, test_read_overall_info)
@@ -324,3 +342,29 @@ TEST_F(UT_CPUSet, test_getUsageTotalDelta_02)
     qulonglong totalDelta = m_tester->getUsageTotalDelta();
     EXPECT_NE(totalDelta, 0);
 }
+
+static int g_readOverallInfoCount = 0;
+static void stub_read_overall_info()
+{
+    ++g_readOverallInfoCount;
+}
+
+TEST_F(UT_CPUSet, test_update_topology_01)
+{
+    Stub stub;
+    stub.set(ADDR(CPUSet, read_overall_info), stub_read_overall_info);
+    g_readOverallInfoCount = 0;
+
+    // topology is loaded once, not on every update
+    m_tester->update();
+    m_tester->d->m_topologyLoaded = true;
+    m_tester->d->m_loadedStatCpus = m_tester->d->m_nstatcpus;
+    m_tester->update();
+    m_tester->update();
+    EXPECT_EQ(g_readOverallInfoCount, 1);
+
+    // online cpu count changed, reloaded
+    m_tester->d->m_loadedStatCpus = m_tester->d->m_nstatcpus + 1;
+    m_tester->update();
+    EXPECT_EQ(g_readOverallInfoCount, 2);
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/ethtool.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//system
+#include <net/if.h>
+
+using namespace core::system;
+
+class UT_Ethtool : public ::testing::Test
+{
+public:
+    UT_Ethtool() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new Ethtool();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    Ethtool *m_tester;
+};
+
+TEST_F(UT_Ethtool, initTest)
+{
+}
+
+TEST_F(UT_Ethtool, test_linkSpeed_01)
+{
+    uint speed = 0;
+    // invalid names are rejected without ioctl
+    EXPECT_FALSE(m_tester->linkSpeed("", speed));
+    EXPECT_FALSE(m_tester->linkSpeed("12345678901234567", speed));
+    // loopback has no link speed
+    EXPECT_FALSE(m_tester->linkSpeed("lo", speed));
+    EXPECT_EQ(speed, 0u);
+}
+
+TEST_F(UT_Ethtool, test_linkSpeed_02)
+{
+    // speeds of real interfaces, if reported at all, are never the unknown marker
+    struct if_nameindex *ifs = if_nameindex();
+    for (struct if_nameindex *i = ifs; i && i->if_name; ++i) {
+        uint speed = 0;
+        if (m_tester->linkSpeed(i->if_name, speed)) {
+            EXPECT_GT(speed, 0u);
+            EXPECT_NE(speed, 0xffffffffu);
+        }
+    }
+    if_freenameindex(ifs);
+}
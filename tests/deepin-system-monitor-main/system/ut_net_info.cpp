@@ -13,6 +13,31 @@
 
 using namespace core::system;
 
+namespace {
+
+NetifInfo makeNetif(const QByteArray &hwAddr, bool isVirtual, qulonglong rxBytes, qulonglong txBytes, qreal recvBps, qreal sentBps)
+{
+    NetifInfo netif;
+    netif.d->hw_addr = hwAddr;
+    netif.d->isVirtual = isVirtual;
+    netif.d->rx_bytes = rxBytes;
+    netif.d->tx_bytes = txBytes;
+    netif.set_recv_bps(recvBps);
+    netif.set_sent_bps(sentBps);
+    return netif;
+}
+
+// one physical & one virtual interface
+QHash<int, NetifInfo> netifs()
+{
+    QHash<int, NetifInfo> links;
+    links.insert(2, makeNetif("00:11:22:33:44:55", false, 1000, 2000, 100, 200));
+    links.insert(3, makeNetif("02:42:ac:11:00:02", true, 10, 20, 1, 2));
+    return links;
+}
+
+} // namespace
+
 class UT_NetInfo: public ::testing::Test
 {
 public:
@@ -42,34 +67,64 @@ TEST_F(UT_NetInfo, initTest)
 
 TEST_F(UT_NetInfo, test_recvBps)
 {
-    m_tester->resdNetInfo();
+    m_tester->update(netifs());
     EXPECT_NE(m_tester->recvBps(), 0);
+    m_tester->update(netifs());
+    EXPECT_EQ(m_tester->recvBps(), 101);
 }
 
 TEST_F(UT_NetInfo, test_sentBps)
 {
-    m_tester->resdNetInfo();
+    m_tester->update(netifs());
     EXPECT_NE(m_tester->sentBps(), 0);
+    m_tester->update(netifs());
+    EXPECT_EQ(m_tester->sentBps(), 202);
 }
 
 TEST_F(UT_NetInfo, test_totalRecvBytes)
 {
-    m_tester->resdNetInfo();
-    sleep(1);
-    m_tester->resdNetInfo();
+    m_tester->update(netifs());
+    EXPECT_EQ(m_tester->totalRecvBytes(), 1010u);
 }
 
 TEST_F(UT_NetInfo, test_totalSentBytes)
 {
-    m_tester->resdNetInfo();
-    sleep(1);
-    m_tester->resdNetInfo();
+    m_tester->update(netifs());
+    EXPECT_EQ(m_tester->totalSentBytes(), 2020u);
+}
+
+TEST_F(UT_NetInfo, test_update_01)
+{
+    // virtual interfaces left out
+    m_tester->setExcludeVirtual(true);
+    m_tester->update(netifs());
+    m_tester->update(netifs());
+    EXPECT_EQ(m_tester->totalRecvBytes(), 1000u);
+    EXPECT_EQ(m_tester->totalSentBytes(), 2000u);
+    EXPECT_EQ(m_tester->recvBps(), 100);
+    EXPECT_EQ(m_tester->sentBps(), 200);
 }
 
-TEST_F(UT_NetInfo, test_resdNetInfo)
+TEST_F(UT_NetInfo, test_update_02)
 {
-    m_tester->resdNetInfo();
-    sleep(1);
-    m_tester->resdNetInfo();
+    m_tester->update({});
+    m_tester->update({});
+    EXPECT_EQ(m_tester->totalRecvBytes(), 0u);
+    EXPECT_EQ(m_tester->recvBps(), 0);
 }
 
+TEST_F(UT_NetInfo, test_update_03)
+{
+    // tun & wireguard links have no hardware address, vlan shares the one of its parent
+    QHash<int, NetifInfo> links = netifs();
+    links.insert(4, makeNetif({}, false, 300, 400, 30, 40));
+    links.insert(5, makeNetif({}, false, 5000, 6000, 500, 600));
+    links.insert(6, makeNetif("00:11:22:33:44:55", false, 70000, 80000, 7000, 8000));
+
+    m_tester->update(links);
+    m_tester->update(links);
+    EXPECT_EQ(m_tester->totalRecvBytes(), 76310u);
+    EXPECT_EQ(m_tester->totalSentBytes(), 88420u);
+    EXPECT_EQ(m_tester->recvBps(), 7631);
+    EXPECT_EQ(m_tester->sentBps(), 8842);
+}
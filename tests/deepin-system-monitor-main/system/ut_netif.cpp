@@ -103,9 +103,10 @@ TEST_F(UT_NetifInfo, test_updateWirelessInfo_02)
 }
 
 
-TEST_F(UT_NetifInfo, test_updateBrandInfo)
+TEST_F(UT_NetifInfo, test_updateLinkSpeed)
 {
-    m_tester->updateBrandInfo();
+    m_tester->updateLinkSpeed(100000);
+    EXPECT_EQ(m_tester->speed(), 100000u);
 }
 
 TEST_F(UT_NetifInfo, test_index)
@@ -265,3 +266,16 @@ TEST_F(UT_NetifInfo, test_addr6InfoList)
 {
     m_tester->addr6InfoList();
 }
+
+TEST_F(UT_NetifInfo, test_copy_01)
+{
+    m_tester->d->isWireless = true;
+    m_tester->d->iw_info->tx_bitrate = 8667;
+
+    // detached copy keeps wireless params
+    NetifInfo copy(*m_tester);
+    copy.set_recv_bps(1);
+    EXPECT_TRUE(copy.isWireless());
+    EXPECT_EQ(copy.txBitrate(), 866700u);
+    EXPECT_EQ(m_tester->recv_bps(), 0);
+}
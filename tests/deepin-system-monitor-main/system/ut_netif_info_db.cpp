@@ -12,6 +12,24 @@
 
 using namespace core::system;
 
+namespace {
+int g_linkSpeedCalls = 0;
+
+bool stub_linkSpeed(void *, const QByteArray &, uint &speed)
+{
+    ++g_linkSpeedCalls;
+    speed = 1000;
+    return true;
+}
+
+int g_updateLinkInfoCalls = 0;
+
+void stub_updateLinkInfo(void *, const NLLink *)
+{
+    ++g_updateLinkInfoCalls;
+}
+} // namespace
+
 class UT_NetifInfoDB: public ::testing::Test
 {
 public:
@@ -50,8 +68,56 @@ TEST_F(UT_NetifInfoDB, test_update_netif_info)
     m_tester->update_netif_info();
 }
 
+TEST_F(UT_NetifInfoDB, test_update_netif_info_02)
+{
+    if (!m_tester->m_watcher->isValid())
+        return;
+
+    Stub stub;
+    stub.set(ADDR(NetifInfo, updateLinkInfo), stub_updateLinkInfo);
+
+    // links are probed once, later updates only read counters unless link changes
+    g_updateLinkInfoCalls = 0;
+    m_tester->update_netif_info();
+    int probed = g_updateLinkInfoCalls;
+    EXPECT_EQ(probed, m_tester->m_links.size());
+    m_tester->m_watcher->takeChangedLinks();
+    m_tester->update_netif_info();
+    EXPECT_EQ(g_updateLinkInfoCalls, probed);
+
+    if (m_tester->m_links.isEmpty())
+        return;
+    m_tester->m_watcher->m_changedLinks.insert(m_tester->m_links.begin().key());
+    m_tester->update_netif_info();
+    EXPECT_EQ(g_updateLinkInfoCalls, probed + 1);
+}
+
 TEST_F(UT_NetifInfoDB, test_update)
 {
     m_tester->update();
 
 }
+
+TEST_F(UT_NetifInfoDB, test_linkSpeed_01)
+{
+    Stub stub;
+    stub.set(ADDR(Ethtool, linkSpeed), stub_linkSpeed);
+
+    LinkIterator iter = m_tester->m_netlink->linkIterator();
+    if (!iter.hasNext())
+        return;
+    auto link = iter.next();
+
+    // queried once, then cached while link state stays the same
+    g_linkSpeedCalls = 0;
+    uint speed = 0;
+    EXPECT_TRUE(m_tester->linkSpeed(link.get(), speed));
+    EXPECT_EQ(speed, 1000u);
+    EXPECT_TRUE(m_tester->linkSpeed(link.get(), speed));
+    EXPECT_EQ(g_linkSpeedCalls, 1);
+
+    // carrier flapped
+    m_tester->m_linkSpeeds[link->ifindex()].carrier_changes++;
+    EXPECT_TRUE(m_tester->linkSpeed(link.get(), speed));
+    EXPECT_EQ(g_linkSpeedCalls, 2);
+}
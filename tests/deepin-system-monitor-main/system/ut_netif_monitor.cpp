@@ -82,6 +82,86 @@ TEST_F(UT_NetifMonitor, test_startNetmonitorJob)
     EXPECT_TRUE( m_tester->m_packetMonitorThread.isRunning() == true);
 }
 
+TEST_F(UT_NetifMonitor, test_captureStat)
+{
+    capture_stat_t stat;
+    EXPECT_FALSE(m_tester->captureStat("eth0", stat));
+
+    QMap<QString, capture_stat_t> stats;
+    stats["eth0"].recv_packets = 100;
+    stats["eth0"].dropped_packets = 3;
+    m_tester->setCaptureStats(stats);
+    ASSERT_TRUE(m_tester->captureStat("eth0", stat));
+    EXPECT_EQ(stat.recv_packets, 100ull);
+    EXPECT_EQ(stat.dropped_packets, 3ull);
+    EXPECT_FALSE(m_tester->captureStat("wlan0", stat));
+}
+
+TEST_F(UT_NetifMonitor, test_mergePendingPackets)
+{
+    // 3 inbound & 2 outbound packets of inode 1, 1 inbound packet of inode 2
+    const struct {
+        ino_t ino;
+        packet_direction direction;
+        unsigned long long payload;
+    } records[] = {
+        {1, kInboundPacket, 100}, {1, kOutboundPacket, 10}, {2, kInboundPacket, 7},
+        {1, kInboundPacket, 100}, {1, kOutboundPacket, 10}, {1, kInboundPacket, 100},
+    };
+    for (const auto &rec : records) {
+        packet_payload_t *slot = m_tester->m_pendingPackets.back();
+        ASSERT_NE(slot, nullptr);
+        slot->ino = rec.ino;
+        slot->direction = rec.direction;
+        slot->payload = rec.payload;
+        m_tester->m_pendingPackets.push();
+    }
+
+    EXPECT_EQ(m_tester->mergePendingPackets(), 6);
+    EXPECT_TRUE(m_tester->m_pendingPackets.isEmpty());
+    EXPECT_TRUE(m_tester->m_batchIOStats.isEmpty());
+
+    // next batch adds to the cached stat
+    packet_payload_t *slot = m_tester->m_pendingPackets.back();
+    slot->ino = 1;
+    slot->direction = kInboundPacket;
+    slot->payload = 50;
+    m_tester->m_pendingPackets.push();
+    EXPECT_EQ(m_tester->mergePendingPackets(), 1);
+
+    SockIOStat stat;
+    ASSERT_TRUE(m_tester->getSockIOStatByInode(1, stat));
+    EXPECT_EQ(stat->rx_bytes, 350ull);
+    EXPECT_EQ(stat->rx_packets, 4ull);
+    EXPECT_EQ(stat->tx_bytes, 20ull);
+    EXPECT_EQ(stat->tx_packets, 2ull);
+
+    ASSERT_TRUE(m_tester->getSockIOStatByInode(2, stat));
+    EXPECT_EQ(stat->rx_bytes, 7ull);
+    EXPECT_EQ(stat->tx_packets, 0ull);
+    EXPECT_FALSE(m_tester->getSockIOStatByInode(3, stat));
+}
+
+TEST_F(UT_NetifMonitor, test_reportQueueDrops)
+{
+    // first drops reported right away
+    m_tester->m_pendingPackets.drop();
+    m_tester->m_pendingPackets.drop();
+    m_tester->reportQueueDrops();
+    EXPECT_EQ(m_tester->m_reportedDrops, 2ull);
+    EXPECT_NE(m_tester->m_lastDropReport, 0);
+
+    // more drops within the interval wait for the next report
+    m_tester->m_pendingPackets.drop();
+    m_tester->reportQueueDrops();
+    EXPECT_EQ(m_tester->m_reportedDrops, 2ull);
+    EXPECT_EQ(m_tester->queueDroppedPackets(), 3ull);
+
+    m_tester->m_lastDropReport -= PACKET_DROP_REPORT_INTERVAL;
+    m_tester->reportQueueDrops();
+    EXPECT_EQ(m_tester->m_reportedDrops, 3ull);
+}
+
 TEST_F(UT_NetifMonitor, test_handleNetData)
 {
 //    QTimer::singleShot(1000, this, [=]() {
@@ -15,15 +15,121 @@
 #include <pcap.h>
 #include <sys/socket.h>
 #include "system/netif_packet_parser.h"
+#include "system/netlink.h"
 #include <pcap/pcap.h>
 
 //gtest
 #include "stub.h"
 #include <gtest/gtest.h>
+#include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+
+#include <atomic>
+#include <thread>
+
+#include <net/ethernet.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
 
 using namespace core::system;
 
+namespace core {
+namespace system {
+void pcap_callback(u_char *context, const struct pcap_pkthdr *hdr, const u_char *packet);
+}
+}
+
+namespace {
+
+const in_addr kLocalAddr {htonl(0xc0a80002u)}; // 192.168.0.2
+const in_addr kRemoteAddr {htonl(0xc0a80001u)}; // 192.168.0.1
+
+// ethernet/ipv4/tcp packets with 64 bytes payload, odd packets sent by the remote end
+bool writePcapFixture(const QString &path, int nflows, int npkts)
+{
+    pcap_t *dead = pcap_open_dead(DLT_EN10MB, 65535);
+    if (!dead)
+        return false;
+    pcap_dumper_t *dumper = pcap_dump_open(dead, path.toLocal8Bit().constData());
+    if (!dumper) {
+        pcap_close(dead);
+        return false;
+    }
+
+    u_char pkt[sizeof(struct ether_header) + sizeof(struct ip) + sizeof(struct tcphdr) + 64] {};
+    auto *eth = reinterpret_cast<struct ether_header *>(pkt);
+    auto *iph = reinterpret_cast<struct ip *>(pkt + sizeof(struct ether_header));
+    auto *tcph = reinterpret_cast<struct tcphdr *>(pkt + sizeof(struct ether_header) + sizeof(struct ip));
+    eth->ether_type = htons(ETHERTYPE_IP);
+    iph->ip_v = 4;
+    iph->ip_hl = 5;
+    iph->ip_p = IPPROTO_TCP;
+    iph->ip_len = htons(uint16_t(sizeof(pkt) - sizeof(struct ether_header)));
+    tcph->th_off = 5;
+
+    struct pcap_pkthdr hdr {};
+    hdr.caplen = hdr.len = sizeof(pkt);
+    for (int i = 0; i < npkts; ++i) {
+        uint16_t lport = htons(uint16_t(40000 + i % nflows));
+        uint16_t rport = htons(443);
+        bool inbound = i & 1;
+        iph->ip_src = inbound ? kRemoteAddr : kLocalAddr;
+        iph->ip_dst = inbound ? kLocalAddr : kRemoteAddr;
+        tcph->th_sport = inbound ? rport : lport;
+        tcph->th_dport = inbound ? lport : rport;
+        hdr.ts.tv_usec = i;
+        pcap_dump(reinterpret_cast<u_char *>(dumper), &hdr, pkt);
+    }
+
+    pcap_dump_close(dumper);
+    pcap_close(dead);
+    return true;
+}
+
+// capture replaying a pcap file, as if opened on interface devName
+NetifCapture openOfflineCapture(NetifPacketCapture *job, const QString &devName, const QString &path)
+{
+    char errbuf[PCAP_ERRBUF_SIZE] {};
+    pcap_t *handle = pcap_open_offline(path.toLocal8Bit().constData(), errbuf);
+    if (!handle)
+        return {};
+
+    auto capture = NetifCapture::create();
+    capture->job = job;
+    capture->devName = devName;
+    capture->handle = handle;
+    capture->batchCount = 64;
+    capture->localAddrs.insert(AF_INET, &kLocalAddr);
+    return capture;
+}
+
+// whether a consumer waiting for monitor's packet queue is woken up by fn
+template<typename F>
+bool wokenDuring(NetifMonitor *monitor, unsigned long timeout, F fn)
+{
+    bool woken = false;
+    std::atomic_bool waiting {false};
+    std::thread consumer([&]() {
+        monitor->m_pktqLock.lock();
+        waiting = true;
+        woken = monitor->m_pktqWatcher.wait(&monitor->m_pktqLock, timeout);
+        monitor->m_pktqLock.unlock();
+    });
+    while (!waiting.load())
+        std::this_thread::yield();
+    // lock is released once consumer waits
+    monitor->m_pktqLock.lock();
+    monitor->m_pktqLock.unlock();
+
+    fn();
+    consumer.join();
+    return woken;
+}
+
+} // namespace
+
 /***************************************STUB begin*********************************************/
 
 size_t stub_strlen()
@@ -94,14 +200,6 @@ pcap_t	*stub_pcap_create_false(const char *, char *)
     return nullptr;
 }
 
-int	stub_localPendingPackets_64()
-{
-    return 65;
-}
-int	stub_localPendingPackets_255()
-{
-    return 255;
-}
 
 /***************************************STUB end**********************************************/
 
@@ -298,36 +396,422 @@ TEST_F(UT_NetifPacketCapture, test_dispatchPackets_02)
 
 TEST_F(UT_NetifPacketCapture, test_dispatchPackets_03)
 {
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), 1, 100));
+
+    NetifCapture capture = openOfflineCapture(m_tester, "eth0", fixture.fileName());
+    ASSERT_TRUE(capture);
+    m_tester->m_captures << capture;
     m_tester->go = true;
-    m_tester->m_devName = nullptr;
-    Stub stub;
-    stub.set(ADDR(PacketPayloadQueue, size), stub_localPendingPackets_64);
+    // caches are fresh, keep the test's local addresses
+    m_tester->m_lastSockStatRefresh = time(nullptr);
+    m_tester->m_lastIfAddrsRefresh = time(nullptr);
+
+    // monitor fell behind, every packet is dropped without stalling or closing capture
+    PacketPayloadSpscRing &pending = m_tester->m_netifMonitor->m_pendingPackets;
+    pending.clear();
+    while (pending.back())
+        pending.push();
+    qulonglong dropped = pending.dropped();
     m_tester->dispatchPackets();
+    EXPECT_EQ(pending.dropped() - dropped, 100ull);
+    EXPECT_EQ(pending.size(), pending.capacity());
+    EXPECT_EQ(m_tester->m_captures.size(), 1);
+
+    pending.clear();
 }
+
 TEST_F(UT_NetifPacketCapture, test_dispatchPackets_04)
 {
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), 1, 2));
+
+    NetifCapture capture = openOfflineCapture(m_tester, "eth0", fixture.fileName());
+    ASSERT_TRUE(capture);
+    auto stat = QSharedPointer<struct sock_stat_t>::create();
+    stat->ino = 1000;
+    stat->sa_family = AF_INET;
+    stat->proto = IPPROTO_TCP;
+    stat->s_addr.in4 = kLocalAddr;
+    stat->s_port = 40000;
+    stat->d_addr.in4 = kRemoteAddr;
+    stat->d_port = 443;
+    insertSockStat(m_tester->m_sockStats, stat);
+
+    NetifMonitor *monitor = m_tester->m_netifMonitor;
+    PacketPayloadSpscRing &pending = monitor->m_pendingPackets;
+    pending.clear();
+    while (pending.size() < pending.capacity() / 2 - 2) {
+        pending.back();
+        pending.push();
+    }
+
+    // consumer waiting for packets is woken up by the packet that fills half of the queue,
+    // before capture returns to its event loop
+    auto dispatchOne = [&capture]() {
+        EXPECT_EQ(pcap_dispatch(capture->handle, 1, pcap_callback, reinterpret_cast<u_char *>(capture.data())), 1);
+    };
+    EXPECT_FALSE(wokenDuring(monitor, 200, dispatchOne));
+    EXPECT_TRUE(wokenDuring(monitor, 5000, dispatchOne));
+    EXPECT_EQ(pending.size(), pending.capacity() / 2);
+
+    pcap_close(capture->handle);
+    capture->handle = nullptr;
+    pending.clear();
+}
+
+TEST_F(UT_NetifPacketCapture, test_dispatchPackets_06)
+{
+    m_tester->go = false;
+    m_tester->dispatchPackets();
+}
+
+TEST_F(UT_NetifPacketCapture, test_dispatchPackets_07)
+{
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), 64, 10000));
+
+    NetifCapture capture = openOfflineCapture(m_tester, "lo", fixture.fileName());
+    ASSERT_TRUE(capture);
+    m_tester->m_captures << capture;
     m_tester->go = true;
-    Stub stub;
-    stub.set(ADDR(PacketPayloadQueue, size), stub_localPendingPackets_64);
+
+    // backlog drained in one wakeup with growing batches
     m_tester->dispatchPackets();
+    EXPECT_GT(capture->batchCount, 64);
+    EXPECT_EQ(pcap_dispatch(capture->handle, -1, pcap_callback, reinterpret_cast<u_char *>(capture.data())), 0);
 }
 
-TEST_F(UT_NetifPacketCapture, test_dispatchPackets_05)
+TEST_F(UT_NetifPacketCapture, test_requestQuit_01)
 {
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), 64, 0));
+
+    NetifCapture capture = openOfflineCapture(m_tester, "lo", fixture.fileName());
+    ASSERT_TRUE(capture);
+    m_tester->m_captures << capture;
     m_tester->go = true;
+
+    // nothing left to dispatch, quit still closes capture through the event loop
+    m_tester->requestQuit();
+    QCoreApplication::sendPostedEvents(m_tester, QEvent::MetaCall);
+    EXPECT_FALSE(m_tester->go);
+    EXPECT_TRUE(m_tester->m_captures.isEmpty());
+    EXPECT_EQ(capture->handle, nullptr);
+
+    // no restart after quit
+    m_tester->startNetifMonitorJob();
+    EXPECT_TRUE(m_tester->m_captures.isEmpty());
+    EXPECT_FALSE(m_tester->m_tcpInfoTimer->isActive());
+}
+
+TEST_F(UT_NetifPacketCapture, test_captureDevices_01)
+{
     Stub stub;
-    stub.set(ADDR(PacketPayloadQueue, size), stub_localPendingPackets_255);
-    m_tester->dispatchPackets();
+    stub.set(ADDR(NetifPacketCapture, getCurrentDevName), stub_getCurrentDevName_true);
+    m_tester->m_devName = "eth0";
+
+    m_tester->m_captureAll = false;
+    EXPECT_EQ(m_tester->captureDevices(), QStringList() << "eth0");
+
+    // default route interface first, never loopback, capped
+    m_tester->m_captureAll = true;
+    QStringList devices = m_tester->captureDevices();
+    ASSERT_FALSE(devices.isEmpty());
+    EXPECT_EQ(devices.first(), QString("eth0"));
+    EXPECT_FALSE(devices.contains("lo"));
+    EXPECT_LE(devices.size(), 8);
 }
 
+TEST_F(UT_NetifPacketCapture, test_watchLinks_01)
+{
+    // default route interface only, links are not watched
+    m_tester->m_captureAll = false;
+    m_tester->watchLinks();
+    EXPECT_EQ(m_tester->m_linkNotifier, nullptr);
+    EXPECT_EQ(m_tester->m_linkWatcher, nullptr);
 
-TEST_F(UT_NetifPacketCapture, test_dispatchPackets_06)
+    // may fail in restricted sandbox, then nothing is watched either
+    m_tester->m_captureAll = true;
+    m_tester->watchLinks();
+    if (m_tester->m_linkWatcher && m_tester->m_linkWatcher->isValid())
+        EXPECT_NE(m_tester->m_linkNotifier, nullptr);
+    else
+        EXPECT_EQ(m_tester->m_linkNotifier, nullptr);
+
+    m_tester->m_captureAll = false;
+    m_tester->watchLinks();
+    EXPECT_EQ(m_tester->m_linkNotifier, nullptr);
+    EXPECT_EQ(m_tester->m_linkWatcher, nullptr);
+}
+
+TEST_F(UT_NetifPacketCapture, test_dispatchPackets_benchmark)
 {
-    m_tester->go = false;
-    m_tester->dispatchPackets();
+    // same traffic spread over 1 to 8 interfaces, difference is the per interface overhead
+    const int npkts = 65536;
+
+    for (int nifs = 1; nifs <= 8; nifs *= 2) {
+        QTemporaryFile fixture;
+        ASSERT_TRUE(fixture.open());
+        ASSERT_TRUE(writePcapFixture(fixture.fileName(), 64, npkts / nifs));
+
+        for (int i = 0; i < nifs; ++i) {
+            NetifCapture capture = openOfflineCapture(m_tester, QString("eth%1").arg(i), fixture.fileName());
+            ASSERT_TRUE(capture);
+            m_tester->m_captures << capture;
+        }
+        m_tester->go = true;
+        // no refresh of socket table & local addresses while measuring
+        m_tester->m_lastSockStatRefresh = m_tester->m_lastIfAddrsRefresh = time(nullptr);
+
+        QElapsedTimer timer;
+        timer.start();
+        // one wakeup per interface until all are drained
+        for (int round = 0; round < 64; ++round) {
+            m_tester->dispatchPackets();
+        }
+        qint64 ns = timer.nsecsElapsed();
+
+        qInfo() << "dispatchPackets:" << npkts << "packets on" << nifs << "interfaces in" << ns / 1000 << "us,"
+                << ns / npkts << "ns per packet";
+
+        for (const NetifCapture &capture : m_tester->m_captures) {
+            EXPECT_EQ(pcap_dispatch(capture->handle, -1, pcap_callback, reinterpret_cast<u_char *>(capture.data())), 0);
+        }
+        m_tester->closeHandle();
+        m_tester->m_netifMonitor->m_pendingPackets.clear();
+    }
 }
 
-TEST_F(UT_NetifPacketCapture, test_refreshIfAddrsHashCache)
+TEST_F(UT_NetifPacketCapture, test_refreshLocalAddrs)
 {
-    m_tester->refreshIfAddrsHashCache();
+    m_tester->refreshLocalAddrs();
+}
+
+TEST_F(UT_NetifPacketCapture, test_localAddrSet_01)
+{
+    in_addr in4 {};
+    in4.s_addr = htonl(0xc0a80002u);
+    in6_addr in6 = IN6ADDR_LOOPBACK_INIT;
+
+    LocalAddrSet addrs;
+    addrs.insert(AF_INET, &in4);
+    addrs.insert(AF_INET, &in4);
+    addrs.insert(AF_INET6, &in6);
+    EXPECT_EQ(addrs.size(), 2);
+    EXPECT_TRUE(addrs.contains(AF_INET, &in4));
+    EXPECT_TRUE(addrs.contains(AF_INET6, &in6));
+
+    in4.s_addr = htonl(0xc0a80003u);
+    EXPECT_FALSE(addrs.contains(AF_INET, &in4));
+}
+
+TEST_F(UT_NetifPacketCapture, test_diffSockBytes_01)
+{
+    SockBytesMap prev, cur;
+    prev[1] = {1000, 100, 10, 4};
+    prev[2] = {500, 500, 5, 5};
+    prev[3] = {800, 0, 8, 0};
+    // traffic on 1, segment counter wrapped around
+    cur[1] = {1600, 150, 2, 6};
+    // idle
+    cur[2] = {500, 500, 5, 5};
+    // inode reused by a new socket
+    cur[3] = {40, 10, 1, 1};
+    // new socket
+    cur[4] = {70, 30, 2, 1};
+
+    QHash<ino_t, sock_io_stat_t> deltas;
+    NetifPacketCapture::diffSockBytes(prev, cur, deltas);
+    ASSERT_EQ(deltas.size(), 3);
+    EXPECT_FALSE(deltas.contains(2));
+
+    EXPECT_EQ(deltas[1].ino, ino_t(1));
+    EXPECT_EQ(deltas[1].rx_bytes, 600ull);
+    EXPECT_EQ(deltas[1].tx_bytes, 50ull);
+    EXPECT_EQ(deltas[1].rx_packets, quint64(quint32(2 - 10)));
+    EXPECT_EQ(deltas[1].tx_packets, 2ull);
+
+    EXPECT_EQ(deltas[3].rx_bytes, 40ull);
+    EXPECT_EQ(deltas[3].tx_bytes, 10ull);
+    EXPECT_EQ(deltas[4].rx_bytes, 70ull);
+    EXPECT_EQ(deltas[4].tx_packets, 1ull);
+}
+
+TEST_F(UT_NetifPacketCapture, test_sampleTcpBytes_01)
+{
+    // first sample is only a baseline, later ones publish the difference
+    if (!m_tester->sampleTcpBytes())
+        return;
+    EXPECT_TRUE(m_tester->m_tcpBytesSampled);
+    EXPECT_TRUE(m_tester->sampleTcpBytes());
+}
+
+TEST_F(UT_NetifPacketCapture, test_spscRing_01)
+{
+    // capacity rounded up to power of two
+    PacketPayloadSpscRing ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+    EXPECT_TRUE(ring.isEmpty());
+
+    for (int i = 0; i < 8; ++i) {
+        packet_payload_t *slot = ring.back();
+        ASSERT_NE(slot, nullptr);
+        slot->ino = ino_t(i);
+        EXPECT_EQ(ring.push(), quint32(i + 1));
+    }
+    EXPECT_EQ(ring.back(), nullptr);
+    ring.drop();
+    EXPECT_EQ(ring.dropped(), 1ull);
+
+    // wrap around
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(ring.front().ino, ino_t(i));
+        ring.pop();
+    }
+    for (int i = 8; i < 11; ++i) {
+        ring.back()->ino = ino_t(i);
+        ring.push();
+    }
+    for (int i = 3; i < 11; ++i) {
+        EXPECT_EQ(ring.front().ino, ino_t(i));
+        ring.pop();
+    }
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST_F(UT_NetifPacketCapture, test_spscRing_02)
+{
+    // producer & consumer threads, every record arrives once & in order, or is counted as dropped
+    const quint32 nrecords = 1000000;
+    PacketPayloadSpscRing ring(256);
+
+    std::thread producer([&ring, nrecords]() {
+        for (quint32 i = 0; i < nrecords; ++i) {
+            packet_payload_t *slot = ring.back();
+            if (!slot) {
+                ring.drop();
+                continue;
+            }
+            slot->ino = ino_t(i);
+            slot->payload = i;
+            ring.push();
+        }
+    });
+
+    quint32 received = 0;
+    qulonglong last = 0;
+    bool ordered = true;
+    QElapsedTimer timer;
+    timer.start();
+    while (received + ring.dropped() < nrecords) {
+        if (ring.isEmpty())
+            continue;
+        const packet_payload_t &payload = ring.front();
+        ordered = ordered && (received == 0 || payload.payload > last) && payload.ino == ino_t(payload.payload);
+        last = payload.payload;
+        ring.pop();
+        ++received;
+    }
+    producer.join();
+
+    qInfo() << "spsc ring:" << received << "records received," << ring.dropped() << "dropped in"
+            << timer.elapsed() << "ms";
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(received + ring.dropped(), qulonglong(nrecords));
+}
+
+TEST_F(UT_NetifPacketCapture, test_pcap_callback_benchmark)
+{
+    const int nflows = 64;
+    const int npkts = 200000;
+
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), nflows, npkts));
+
+    // 192.168.0.2 is local, every flow is known to the socket table
+    NetifCapture capture = openOfflineCapture(m_tester, "eth0", fixture.fileName());
+    ASSERT_TRUE(capture);
+    for (int i = 0; i < nflows; ++i) {
+        auto stat = QSharedPointer<struct sock_stat_t>::create();
+        stat->ino = ino_t(1000 + i);
+        stat->sa_family = AF_INET;
+        stat->proto = IPPROTO_TCP;
+        stat->s_addr.in4 = kLocalAddr;
+        stat->s_port = uint(40000 + i);
+        stat->d_addr.in4 = kRemoteAddr;
+        stat->d_port = 443;
+        insertSockStat(m_tester->m_sockStats, stat);
+    }
+
+    PacketPayloadSpscRing &pending = m_tester->m_netifMonitor->m_pendingPackets;
+    int queued = 0;
+    int inbound = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (;;) {
+        int nr = pcap_dispatch(capture->handle, 1024, pcap_callback, reinterpret_cast<u_char *>(capture.data()));
+        if (nr <= 0)
+            break;
+        // drain monitor queue in place of monitor thread
+        while (!pending.isEmpty()) {
+            inbound += (pending.front().direction == kInboundPacket);
+            pending.pop();
+            ++queued;
+        }
+    }
+    qint64 ns = timer.nsecsElapsed();
+    pcap_close(capture->handle);
+    capture->handle = nullptr;
+
+    qInfo() << "pcap_callback:" << npkts << "packets in" << ns / 1000 << "us,"
+            << qint64(double(npkts) * 1e9 / qMax<qint64>(ns, 1)) << "pps";
+
+    EXPECT_EQ(queued, npkts);
+    EXPECT_EQ(inbound, npkts / 2);
+    EXPECT_EQ(pending.dropped(), 0ull);
+}
+
+TEST_F(UT_NetifPacketCapture, test_pcap_callback_01)
+{
+    QTemporaryFile fixture;
+    ASSERT_TRUE(fixture.open());
+    ASSERT_TRUE(writePcapFixture(fixture.fileName(), 1, 100));
+
+    NetifCapture capture = openOfflineCapture(m_tester, "eth0", fixture.fileName());
+    ASSERT_TRUE(capture);
+    auto stat = QSharedPointer<struct sock_stat_t>::create();
+    stat->ino = 1000;
+    stat->sa_family = AF_INET;
+    stat->proto = IPPROTO_TCP;
+    stat->s_addr.in4 = kLocalAddr;
+    stat->s_port = 40000;
+    stat->d_addr.in4 = kRemoteAddr;
+    stat->d_port = 443;
+    insertSockStat(m_tester->m_sockStats, stat);
+
+    // nobody drains the queue, packets beyond capacity are counted as dropped
+    PacketPayloadSpscRing &pending = m_tester->m_netifMonitor->m_pendingPackets;
+    pending.clear();
+    quint32 room = pending.capacity() - 40;
+    for (quint32 i = 0; i < room; ++i) {
+        pending.back();
+        pending.push();
+    }
+    qulonglong dropped = pending.dropped();
+    EXPECT_EQ(pcap_dispatch(capture->handle, -1, pcap_callback, reinterpret_cast<u_char *>(capture.data())), 100);
+    EXPECT_EQ(pending.size(), pending.capacity());
+    EXPECT_EQ(pending.dropped() - dropped, 60ull);
+    EXPECT_EQ(m_tester->m_netifMonitor->queueDroppedPackets(), pending.dropped());
+
+    pcap_close(capture->handle);
+    capture->handle = nullptr;
+    pending.clear();
 }
@@ -6,7 +6,11 @@
 //self
 #include "system/netif_packet_parser.h"
 #include <net/ethernet.h>
+#include <netinet/ip.h>
 #include <netinet/ip6.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
 //gtest
 #include "stub.h"
 #include <gtest/gtest.h>
@@ -124,3 +128,70 @@ TEST_F(UT_NetifPacketParser, test_parsePacket_05)
 //    stub.set(ntohs, stub_ntohs_IPV6);
 //    EXPECT_EQ(m_tester->parsePacket(&hdr, packet1, payload), false);
 }
+
+TEST_F(UT_NetifPacketParser, test_parsePacket_06)
+{
+    // tcp over ipv4, captured up to headers only
+    u_char packet[sizeof(struct ether_header) + sizeof(struct ip) + sizeof(struct tcphdr)] {};
+    auto *eth = reinterpret_cast<struct ether_header *>(packet);
+    auto *iph = reinterpret_cast<struct ip *>(packet + sizeof(struct ether_header));
+    auto *tcph = reinterpret_cast<struct tcphdr *>(packet + sizeof(struct ether_header) + sizeof(struct ip));
+    eth->ether_type = htons(ETHERTYPE_IP);
+    iph->ip_hl = 5;
+    iph->ip_p = IPPROTO_TCP;
+    iph->ip_src.s_addr = htonl(0xc0a80002u);
+    iph->ip_dst.s_addr = htonl(0xc0a80001u);
+    tcph->th_off = 5;
+    tcph->th_sport = htons(40000);
+    tcph->th_dport = htons(443);
+
+    pcap_pkthdr hdr {};
+    hdr.caplen = sizeof(packet);
+    hdr.len = 1514;
+
+    packet_payload_t payload {};
+    ASSERT_TRUE(m_tester->parsePacket(&hdr, packet, payload));
+    EXPECT_EQ(payload.sa_family, AF_INET);
+    EXPECT_EQ(payload.proto, uint(IPPROTO_TCP));
+    EXPECT_EQ(payload.s_port, 40000);
+    EXPECT_EQ(payload.d_port, 443);
+    // payload size from length on wire
+    EXPECT_EQ(payload.payload, 1514ull - sizeof(packet));
+
+    // headers cut off by snaplen
+    hdr.caplen = sizeof(packet) - 1;
+    EXPECT_FALSE(m_tester->parsePacket(&hdr, packet, payload));
+
+    // malformed header length, transport header would overlap ip header
+    hdr.caplen = sizeof(packet);
+    iph->ip_hl = 4;
+    EXPECT_FALSE(m_tester->parsePacket(&hdr, packet, payload));
+    iph->ip_hl = 0;
+    EXPECT_FALSE(m_tester->parsePacket(&hdr, packet, payload));
+}
+
+TEST_F(UT_NetifPacketParser, test_parsePacket_07)
+{
+    // udp over ipv6
+    u_char packet[sizeof(struct ether_header) + sizeof(struct ip6_hdr) + sizeof(struct udphdr)] {};
+    auto *eth = reinterpret_cast<struct ether_header *>(packet);
+    auto *ip6h = reinterpret_cast<struct ip6_hdr *>(packet + sizeof(struct ether_header));
+    auto *udph = reinterpret_cast<struct udphdr *>(packet + sizeof(struct ether_header) + sizeof(struct ip6_hdr));
+    eth->ether_type = htons(ETHERTYPE_IPV6);
+    ip6h->ip6_nxt = IPPROTO_UDP;
+    ip6h->ip6_src = in6addr_loopback;
+    ip6h->ip6_dst = in6addr_loopback;
+    udph->uh_sport = htons(5353);
+    udph->uh_dport = htons(5353);
+    udph->uh_ulen = htons(108);
+
+    pcap_pkthdr hdr {};
+    hdr.caplen = sizeof(packet);
+    hdr.len = sizeof(packet) + 100;
+
+    packet_payload_t payload {};
+    ASSERT_TRUE(m_tester->parsePacket(&hdr, packet, payload));
+    EXPECT_EQ(payload.sa_family, AF_INET6);
+    EXPECT_EQ(payload.proto, uint(IPPROTO_UDP));
+    EXPECT_EQ(payload.payload, 100ull);
+}
@@ -50,3 +50,62 @@ TEST_F(UT_Netlink, test_addrIterator)
 }
 
 
+TEST_F(UT_Netlink, test_pickDefaultRoute_01)
+{
+    QList<route_entry_t> routes;
+    EXPECT_EQ(RouteWatcher::pickDefaultRoute(routes), -1);
+
+    // lan route only
+    routes << route_entry_t {AF_INET, 24, 100, 2};
+    EXPECT_EQ(RouteWatcher::pickDefaultRoute(routes), 0);
+
+    // ipv6 default route wins over ipv4 lan route
+    routes << route_entry_t {AF_INET6, 0, 1024, 3};
+    EXPECT_EQ(RouteWatcher::pickDefaultRoute(routes), 1);
+
+    // ipv4 default routes win, lowest metric first
+    routes << route_entry_t {AF_INET, 0, 600, 4};
+    routes << route_entry_t {AF_INET, 0, 100, 5};
+    EXPECT_EQ(RouteWatcher::pickDefaultRoute(routes), 3);
+
+    // routes without output interface are skipped
+    routes << route_entry_t {AF_INET, 0, 0, 0};
+    EXPECT_EQ(RouteWatcher::pickDefaultRoute(routes), 3);
+}
+
+TEST_F(UT_Netlink, test_routeWatcher_01)
+{
+    RouteWatcher watcher;
+    if (!watcher.isValid())
+        return;
+
+    EXPECT_GE(watcher.fd(), 0);
+    // nothing pending right after the initial dump, must not block
+    watcher.handleEvents();
+    watcher.defaultDevice();
+}
+
+TEST_F(UT_Netlink, test_linkWatcher_01)
+{
+    LinkWatcher watcher;
+    if (!watcher.isValid())
+        return;
+
+    EXPECT_GE(watcher.fd(), 0);
+    // addresses of initial dump count as changed, must not block
+    watcher.handleEvents();
+    EXPECT_TRUE(watcher.takeAddrChanged());
+    EXPECT_FALSE(watcher.takeAddrChanged());
+    watcher.takeChangedLinks();
+    EXPECT_TRUE(watcher.takeChangedLinks().isEmpty());
+
+    // cached addresses are the ones a dump returns
+    int cached = 0, dumped = 0;
+    AddrIterator cachedIter = watcher.addrIterator();
+    while (cachedIter.hasNext() && cachedIter.next())
+        ++cached;
+    AddrIterator dumpIter = m_tester->addrIterator();
+    while (dumpIter.hasNext() && dumpIter.next())
+        ++dumped;
+    EXPECT_EQ(cached, dumped);
+}
@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/nl80211.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//Qt
+#include <QByteArray>
+
+//system
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/nl80211.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace core::system;
+
+namespace {
+
+const quint16 kFamilyId = 0x1c;
+
+void appendAttr(QByteArray &buf, quint16 type, const QByteArray &payload)
+{
+    struct nlattr nla {};
+    nla.nla_type = type;
+    nla.nla_len = quint16(NLA_HDRLEN + payload.size());
+    buf.append(reinterpret_cast<const char *>(&nla), NLA_HDRLEN);
+    buf.append(payload);
+    buf.append(QByteArray(NLA_ALIGN(payload.size()) - payload.size(), 0));
+}
+
+template<typename T>
+QByteArray pod(T v)
+{
+    return QByteArray(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+// generic netlink message of type with attributes
+QByteArray genlMsg(quint16 type, quint8 cmd, const QByteArray &attrs, quint16 flags = 0, quint32 seq = 1)
+{
+    QByteArray msg(int(NLMSG_LENGTH(GENL_HDRLEN)), 0);
+    msg.append(attrs);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = quint32(msg.size());
+    nlh->nlmsg_type = type;
+    nlh->nlmsg_flags = flags;
+    nlh->nlmsg_seq = seq;
+    reinterpret_cast<struct genlmsghdr *>(NLMSG_DATA(nlh))->cmd = cmd;
+    return msg;
+}
+
+QByteArray doneMsg(quint32 seq = 1)
+{
+    QByteArray msg(int(NLMSG_SPACE(sizeof(int))), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(int));
+    nlh->nlmsg_type = NLMSG_DONE;
+    nlh->nlmsg_seq = seq;
+    return msg;
+}
+
+QByteArray errorMsg(int error, quint32 seq = 1)
+{
+    QByteArray msg(int(NLMSG_SPACE(sizeof(struct nlmsgerr))), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(struct nlmsgerr));
+    nlh->nlmsg_type = NLMSG_ERROR;
+    nlh->nlmsg_seq = seq;
+    reinterpret_cast<struct nlmsgerr *>(NLMSG_DATA(nlh))->error = error;
+    return msg;
+}
+
+QByteArray familyReply(quint32 seq = 1)
+{
+    QByteArray attrs;
+    appendAttr(attrs, CTRL_ATTR_FAMILY_ID, pod<quint16>(kFamilyId));
+    appendAttr(attrs, CTRL_ATTR_FAMILY_NAME, QByteArray(NL80211_GENL_NAME, sizeof(NL80211_GENL_NAME)));
+    return genlMsg(GENL_ID_CTRL, CTRL_CMD_NEWFAMILY, attrs, 0, seq);
+}
+
+// station at -52 dBm, tx 866.7 Mbit/s VHT MCS 9, rx 54 Mbit/s legacy
+QByteArray stationReply(quint32 seq = 1)
+{
+    QByteArray txRate, rxRate, staInfo, attrs;
+    appendAttr(txRate, NL80211_RATE_INFO_BITRATE, pod<quint16>(8667));
+    appendAttr(txRate, NL80211_RATE_INFO_BITRATE32, pod<quint32>(8667));
+    appendAttr(txRate, NL80211_RATE_INFO_VHT_MCS, pod<quint8>(9));
+    appendAttr(rxRate, NL80211_RATE_INFO_BITRATE, pod<quint16>(540));
+
+    appendAttr(staInfo, NL80211_STA_INFO_SIGNAL, pod<qint8>(-52));
+    appendAttr(staInfo, NL80211_STA_INFO_TX_BITRATE | NLA_F_NESTED, txRate);
+    appendAttr(staInfo, NL80211_STA_INFO_RX_BITRATE | NLA_F_NESTED, rxRate);
+
+    appendAttr(attrs, NL80211_ATTR_IFINDEX, pod<quint32>(3));
+    appendAttr(attrs, NL80211_ATTR_STA_INFO | NLA_F_NESTED, staInfo);
+    return genlMsg(kFamilyId, NL80211_CMD_NEW_STATION, attrs, NLM_F_MULTI, seq);
+}
+
+/**
+ * Stands in for kernel on the other end of a socket pair: resolves nl80211 family,
+ * answers station dumps of ifindex 3 with stationReply, fails others with ENODEV.
+ * Family lookups fail with ENOENT while failFamily is set.
+ * Dumps of ifindex 4 fail halfway, the rest of the dump follows the error.
+ */
+class MockGenlResponder
+{
+public:
+    MockGenlResponder()
+    {
+        socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, m_fds);
+        m_thread = std::thread([this]() { run(); });
+    }
+    ~MockGenlResponder()
+    {
+        // peer end is closed by NL80211, recv returns 0 then
+        m_thread.join();
+        close(m_fds[1]);
+    }
+
+    int takeClientFd()
+    {
+        return m_fds[0];
+    }
+
+    std::atomic_int stationRequests {0};
+    std::atomic_int familyRequests {0};
+    // answer family lookups with ENOENT, as if cfg80211 was not loaded
+    std::atomic_bool failFamily {false};
+
+private:
+    void run()
+    {
+        alignas(struct nlmsghdr) char buf[1024];
+        ssize_t len;
+        while ((len = recv(m_fds[1], buf, sizeof(buf), 0)) > 0) {
+            auto *nlh = reinterpret_cast<const struct nlmsghdr *>(buf);
+            quint32 seq = nlh->nlmsg_seq;
+            QByteArray reply;
+            if (nlh->nlmsg_type == GENL_ID_CTRL) {
+                ++familyRequests;
+                reply = failFamily ? errorMsg(-ENOENT, seq) : familyReply(seq);
+            } else if (nlh->nlmsg_type == kFamilyId) {
+                ++stationRequests;
+                quint32 ifindex = 0;
+                // request attribute follows genl header
+                memcpy(&ifindex, buf + NLMSG_LENGTH(GENL_HDRLEN) + NLA_HDRLEN, sizeof(ifindex));
+                if (ifindex == 3) {
+                    reply = stationReply(seq) + doneMsg(seq);
+                } else if (ifindex == 4) {
+                    QByteArray error = errorMsg(-ENOBUFS, seq);
+                    send(m_fds[1], error.constData(), size_t(error.size()), 0);
+                    reply = stationReply(seq) + doneMsg(seq);
+                } else {
+                    reply = errorMsg(-ENODEV, seq);
+                }
+            } else {
+                reply = errorMsg(-EINVAL, seq);
+            }
+            send(m_fds[1], reply.constData(), size_t(reply.size()), 0);
+        }
+    }
+
+    int m_fds[2] {-1, -1};
+    std::thread m_thread;
+};
+
+} // namespace
+
+class UT_NL80211 : public ::testing::Test
+{
+public:
+    UT_NL80211() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new NL80211();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    NL80211 *m_tester;
+};
+
+TEST_F(UT_NL80211, initTest)
+{
+}
+
+TEST_F(UT_NL80211, test_parseFamilyMessages_01)
+{
+    QByteArray buf = familyReply();
+    quint16 familyId = 0;
+    EXPECT_EQ(NL80211::parseFamilyMessages(buf.constData(), size_t(buf.size()), 1, familyId), 1);
+    EXPECT_EQ(familyId, kFamilyId);
+
+    buf = errorMsg(-ENOENT);
+    EXPECT_EQ(NL80211::parseFamilyMessages(buf.constData(), size_t(buf.size()), 1, familyId), -1);
+}
+
+TEST_F(UT_NL80211, test_parseStationMessages_01)
+{
+    QByteArray buf = stationReply() + doneMsg();
+    station_info_t info;
+    bool found = false;
+    EXPECT_EQ(NL80211::parseStationMessages(buf.constData(), size_t(buf.size()), 1, info, found), 1);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(info.signal, -52);
+    EXPECT_EQ(info.tx_bitrate, 8667u);
+    EXPECT_EQ(info.tx_mcs, 9);
+    EXPECT_EQ(info.rx_bitrate, 540u);
+    EXPECT_EQ(info.rx_mcs, -1);
+}
+
+TEST_F(UT_NL80211, test_parseStationMessages_02)
+{
+    // not associated, empty dump
+    QByteArray buf = doneMsg();
+    station_info_t info;
+    bool found = false;
+    EXPECT_EQ(NL80211::parseStationMessages(buf.constData(), size_t(buf.size()), 1, info, found), 1);
+    EXPECT_FALSE(found);
+
+    buf = errorMsg(-ENODEV);
+    EXPECT_EQ(NL80211::parseStationMessages(buf.constData(), size_t(buf.size()), 1, info, found), -1);
+}
+
+TEST_F(UT_NL80211, test_parseStationMessages_03)
+{
+    // replies of an earlier request are skipped
+    QByteArray buf = stationReply(1) + doneMsg(1) + errorMsg(-ENODEV, 1);
+    station_info_t info;
+    bool found = false;
+    EXPECT_EQ(NL80211::parseStationMessages(buf.constData(), size_t(buf.size()), 2, info, found), 0);
+    EXPECT_FALSE(found);
+
+    buf += stationReply(2) + doneMsg(2);
+    EXPECT_EQ(NL80211::parseStationMessages(buf.constData(), size_t(buf.size()), 2, info, found), 1);
+    EXPECT_TRUE(found);
+
+    quint16 familyId = 0;
+    buf = errorMsg(-ENOENT, 1) + familyReply(2);
+    EXPECT_EQ(NL80211::parseFamilyMessages(buf.constData(), size_t(buf.size()), 2, familyId), 1);
+    EXPECT_EQ(familyId, kFamilyId);
+}
+
+TEST_F(UT_NL80211, test_station_01)
+{
+    MockGenlResponder responder;
+    NL80211 nl80211(responder.takeClientFd());
+
+    station_info_t info;
+    ASSERT_TRUE(nl80211.station(3, 1, info));
+    EXPECT_EQ(info.signal, -52);
+    EXPECT_EQ(info.tx_bitrate, 8667u);
+    EXPECT_EQ(responder.stationRequests.load(), 1);
+
+    // cached while link stays the same
+    EXPECT_TRUE(nl80211.station(3, 1, info));
+    EXPECT_EQ(responder.stationRequests.load(), 1);
+    // queried again after link changed
+    EXPECT_TRUE(nl80211.station(3, 2, info));
+    EXPECT_EQ(responder.stationRequests.load(), 2);
+
+    // not a wireless interface, negative result cached as well
+    EXPECT_FALSE(nl80211.station(2, 1, info));
+    EXPECT_FALSE(nl80211.station(2, 1, info));
+    EXPECT_EQ(responder.stationRequests.load(), 3);
+}
+
+TEST_F(UT_NL80211, test_station_02)
+{
+    MockGenlResponder responder;
+    NL80211 nl80211(responder.takeClientFd());
+
+    // dump failed halfway, its remains must not be taken as reply of next request
+    station_info_t info;
+    EXPECT_FALSE(nl80211.station(4, 1, info));
+    ASSERT_TRUE(nl80211.station(3, 1, info));
+    EXPECT_EQ(info.signal, -52);
+    EXPECT_EQ(responder.stationRequests.load(), 2);
+}
+
+TEST_F(UT_NL80211, test_station_03)
+{
+    MockGenlResponder responder;
+    responder.failFamily = true;
+    NL80211 nl80211(responder.takeClientFd());
+
+    station_info_t info;
+    EXPECT_FALSE(nl80211.station(3, 1, info));
+    EXPECT_EQ(responder.familyRequests.load(), 1);
+
+    // failed lookup is not repeated before the retry time
+    responder.failFamily = false;
+    EXPECT_FALSE(nl80211.station(3, 2, info));
+    EXPECT_EQ(responder.familyRequests.load(), 1);
+    EXPECT_EQ(responder.stationRequests.load(), 0);
+
+    // but retried after it, nl80211 works from then on
+    nl80211.m_familyRetryTs = 0;
+    ASSERT_TRUE(nl80211.station(3, 3, info));
+    EXPECT_EQ(info.signal, -52);
+    EXPECT_TRUE(nl80211.station(3, 4, info));
+    EXPECT_EQ(responder.familyRequests.load(), 2);
+}
+
+TEST_F(UT_NL80211, test_readStation_01)
+{
+    // may fail without wireless hardware or in restricted sandbox
+    station_info_t info;
+    if (m_tester->isValid() && m_tester->readStation(1, info)) {
+        EXPECT_GE(info.tx_mcs, -1);
+    }
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/pressure.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//qt
+#include <QByteArray>
+#include <QTemporaryFile>
+
+#include <unistd.h>
+
+using namespace core::system;
+
+namespace {
+
+const char kMemoryPressure[] =
+    "some avg10=1.52 avg60=0.83 avg300=0.20 total=1230000\n"
+    "full avg10=0.40 avg60=0.10 avg300=0.02 total=450000\n";
+
+// cpu pressure before linux 5.13
+const char kCPUPressure[] =
+    "some avg10=12.00 avg60=8.50 avg300=3.25 total=987654321\n";
+
+void writeFile(QTemporaryFile &file, const QByteArray &content)
+{
+    file.resize(0);
+    file.seek(0);
+    file.write(content);
+    file.flush();
+}
+
+} // namespace
+
+class UT_PressureInfo : public ::testing::Test
+{
+public:
+    UT_PressureInfo() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new PressureInfo();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    PressureInfo *m_tester;
+};
+
+TEST_F(UT_PressureInfo, initTest)
+{
+    EXPECT_EQ(m_tester->m_res[PressureInfo::kCPUPressure].path, QByteArray("/proc/pressure/cpu"));
+    EXPECT_EQ(m_tester->m_res[PressureInfo::kIOPressure].path, QByteArray("/proc/pressure/io"));
+    EXPECT_EQ(m_tester->someStall(PressureInfo::kMemoryPressure), 0.);
+}
+
+TEST_F(UT_PressureInfo, test_parse_01)
+{
+    psi_stat_t stat;
+    ASSERT_TRUE(PressureInfo::parse(kMemoryPressure, sizeof(kMemoryPressure) - 1, stat));
+    EXPECT_TRUE(stat.hasSome);
+    EXPECT_TRUE(stat.hasFull);
+    EXPECT_FLOAT_EQ(stat.some.avg10, 1.52f);
+    EXPECT_FLOAT_EQ(stat.some.avg300, 0.2f);
+    EXPECT_EQ(stat.some.total, 1230000ull);
+    EXPECT_FLOAT_EQ(stat.full.avg60, 0.1f);
+    EXPECT_EQ(stat.full.total, 450000ull);
+
+    ASSERT_TRUE(PressureInfo::parse(kCPUPressure, sizeof(kCPUPressure) - 1, stat));
+    EXPECT_FALSE(stat.hasFull);
+    EXPECT_FLOAT_EQ(stat.some.avg10, 12.f);
+    EXPECT_EQ(stat.some.total, 987654321ull);
+}
+
+TEST_F(UT_PressureInfo, test_parse_02)
+{
+    psi_stat_t stat;
+    EXPECT_FALSE(PressureInfo::parse("", 0, stat));
+
+    const char garbage[] = "some avg10=\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=1\n";
+    EXPECT_FALSE(PressureInfo::parse(garbage, sizeof(garbage) - 1, stat));
+    EXPECT_TRUE(stat.hasFull);
+}
+
+TEST_F(UT_PressureInfo, test_update_01)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    writeFile(file, kMemoryPressure);
+    m_tester->m_res[PressureInfo::kMemoryPressure].path = file.fileName().toLocal8Bit();
+    m_tester->m_res[PressureInfo::kCPUPressure].path = "/nonexistent/pressure/cpu";
+
+    // first update has nothing to compare with
+    m_tester->update();
+    EXPECT_TRUE(m_tester->available(PressureInfo::kMemoryPressure));
+    EXPECT_FALSE(m_tester->available(PressureInfo::kCPUPressure));
+    EXPECT_EQ(m_tester->stat(PressureInfo::kMemoryPressure).some.total, 1230000ull);
+    EXPECT_EQ(m_tester->someStall(PressureInfo::kMemoryPressure), 0.);
+
+    // kept open file re-read, 10s of some stall within less than that is clamped
+    usleep(10000);
+    writeFile(file, "some avg10=2.00 avg60=0.90 avg300=0.21 total=11230000\n"
+                    "full avg10=0.40 avg60=0.10 avg300=0.02 total=450000\n");
+    m_tester->update();
+    EXPECT_FLOAT_EQ(m_tester->stat(PressureInfo::kMemoryPressure).some.avg10, 2.f);
+    EXPECT_EQ(m_tester->someStall(PressureInfo::kMemoryPressure), 1.);
+    EXPECT_EQ(m_tester->fullStall(PressureInfo::kMemoryPressure), 0.);
+
+    // unreadable content, given up on
+    writeFile(file, "none\n");
+    m_tester->update();
+    EXPECT_FALSE(m_tester->available(PressureInfo::kMemoryPressure));
+}
+
+TEST_F(UT_PressureInfo, test_update_02)
+{
+    // hosts without psi have no /proc/pressure
+    m_tester->update();
+    if (!access("/proc/pressure/cpu", R_OK)) {
+        EXPECT_TRUE(m_tester->available());
+        EXPECT_TRUE(m_tester->stat(PressureInfo::kCPUPressure).hasSome);
+    } else {
+        EXPECT_FALSE(m_tester->available(PressureInfo::kCPUPressure));
+    }
+}
+
+TEST_F(UT_PressureInfo, test_cgroup_01)
+{
+    // no cgroup or gone
+    PressureInfo none(QByteArray {});
+    none.update();
+    EXPECT_FALSE(none.available());
+
+    PressureInfo gone(QByteArray("/nonexistent.slice/gone.scope"));
+    gone.update();
+    EXPECT_FALSE(gone.available());
+
+    // root cgroup is system wide
+    PressureInfo root(QByteArray("/"));
+    EXPECT_EQ(root.m_res[PressureInfo::kMemoryPressure].path, QByteArray("/proc/pressure/memory"));
+
+    EXPECT_TRUE(PressureInfo::cgroupOf(-1).isEmpty());
+    QByteArray self = PressureInfo::cgroupOf(getpid());
+    if (!self.isEmpty() && self != "/") {
+        PressureInfo cgroup(self);
+        EXPECT_TRUE(cgroup.m_res[PressureInfo::kIOPressure].path.endsWith(self + "/io.pressure"));
+    }
+}
@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/proc_stat.h"
+#include "system/cpu.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//qt
+#include <QByteArray>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QTemporaryFile>
+
+#include <memory>
+
+using namespace core::system;
+
+namespace {
+
+const char kProcStat[] =
+    "cpu  10132153 290696 3084719 46828483 16683 0 25195 0 175628 0\n"
+    "cpu0 1393280 32966 572056 13343292 6130 0 17875 0 23933 0\n"
+    "cpu2 1335753 69598 500634 13366064 2939 0 3364 0 25129 0\n"
+    "intr 199292311 0 0 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 0 0\n"
+    "ctxt 359402018\n"
+    "btime 1657689523\n"
+    "processes 1216154\n"
+    "procs_running 3\n"
+    "procs_blocked 1\n"
+    "softirq 120390225 30 37386432 36 4312052 0 0 1064399 36427489 0 41199787\n";
+
+// /proc/stat of a machine with ncpus cpus & nirqs irqs
+QByteArray makeProcStat(int ncpus, int nirqs)
+{
+    QByteArray buf;
+    buf.append("cpu  ");
+    for (int f = 0; f < 10; ++f)
+        buf.append(QByteArray::number(qulonglong(ncpus) * 1234567 * (f + 1))).append(' ');
+    buf.append('\n');
+    for (int cpu = 0; cpu < ncpus; ++cpu) {
+        buf.append("cpu").append(QByteArray::number(cpu));
+        for (int f = 0; f < 10; ++f)
+            buf.append(' ').append(QByteArray::number(qulonglong(1234567) * (f + 1) + cpu));
+        buf.append('\n');
+    }
+    buf.append("intr 987654321");
+    for (int irq = 0; irq < nirqs; ++irq)
+        buf.append(' ').append(QByteArray::number(irq * 31));
+    buf.append('\n');
+    buf.append("ctxt 123456789012\nbtime 1657689523\nprocesses 1216154\nprocs_running 17\nprocs_blocked 2\n");
+    buf.append("softirq 120390225 30 37386432 36 4312052 0 0 1064399 36427489 0 41199787\n");
+    return buf;
+}
+
+// per cpu part of the former fgets/sscanf reader, as reference
+void legacyParse(const QByteArray &content, QMap<QByteArray, CPUStat> &statDB, QMap<QByteArray, CPUUsage> &usageDB)
+{
+    for (const QByteArray &line : content.split('\n')) {
+        if (!line.startsWith("cpu") || line.startsWith("cpu "))
+            continue;
+
+        int ncpu = 0;
+        auto stat = std::make_shared<struct cpu_stat_t>();
+        int nr = sscanf(line.constData() + 3, "%d %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
+                        &ncpu, &stat->user, &stat->nice, &stat->sys, &stat->idle, &stat->iowait,
+                        &stat->hardirq, &stat->softirq, &stat->steal, &stat->guest, &stat->guest_nice);
+        if (nr != 11)
+            continue;
+
+        QByteArray cpu {"cpu"};
+        cpu.append(QByteArray::number(ncpu));
+        stat->cpu = cpu;
+        auto usage = std::make_shared<struct cpu_usage_t>();
+        usage->cpu = cpu;
+        usage->total = stat->user + stat->nice + stat->sys + stat->idle + stat->iowait + stat->hardirq + stat->softirq + stat->steal;
+        usage->idle = stat->idle + stat->iowait;
+        statDB[cpu] = stat;
+        usageDB[cpu] = usage;
+    }
+}
+
+} // namespace
+
+class UT_ProcStatReader : public ::testing::Test
+{
+public:
+    UT_ProcStatReader() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new ProcStatReader();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    ProcStatReader *m_tester;
+};
+
+TEST_F(UT_ProcStatReader, initTest)
+{
+}
+
+TEST_F(UT_ProcStatReader, test_parse_01)
+{
+    proc_stat_t stat;
+    ASSERT_TRUE(ProcStatReader::parse(kProcStat, sizeof(kProcStat) - 1, stat));
+
+    EXPECT_EQ(stat.cpu.user, 10132153ull);
+    EXPECT_EQ(stat.cpu.idle, 46828483ull);
+    EXPECT_EQ(stat.cpu.guest, 175628ull);
+    EXPECT_EQ(stat.cpu.total(), 10132153ull + 290696 + 3084719 + 46828483 + 16683 + 25195);
+    EXPECT_EQ(stat.cpu.idleTotal(), 46828483ull + 16683);
+
+    // cpu1 is offline, its slot is kept but not listed
+    ASSERT_EQ(stat.cpus.size(), 3);
+    ASSERT_EQ(stat.online, QVector<int>({0, 2}));
+    EXPECT_FALSE(stat.listed[1]);
+    EXPECT_EQ(stat.cpus[0].sys, 572056ull);
+    EXPECT_EQ(stat.cpus[2].softirq, 3364ull);
+
+    EXPECT_EQ(stat.intr, 199292311ull);
+    EXPECT_EQ(stat.ctxt, 359402018ull);
+    EXPECT_EQ(stat.btime, 1657689523);
+    EXPECT_EQ(stat.procsRunning, 3u);
+    EXPECT_EQ(stat.procsBlocked, 1u);
+}
+
+TEST_F(UT_ProcStatReader, test_parse_02)
+{
+    proc_stat_t stat;
+    ASSERT_TRUE(ProcStatReader::parse(kProcStat, sizeof(kProcStat) - 1, stat));
+
+    // cpu2 went offline, older kernel format without steal & guest columns
+    const char content[] = "cpu  4 3 2 1 0 0 0\ncpu0 4 3 2 1 0 0 0\n";
+    ASSERT_TRUE(ProcStatReader::parse(content, sizeof(content) - 1, stat));
+    EXPECT_EQ(stat.online, QVector<int>({0}));
+    EXPECT_FALSE(stat.listed[2]);
+    EXPECT_EQ(stat.cpus[0].user, 4ull);
+    EXPECT_EQ(stat.cpus[0].steal, 0ull);
+    EXPECT_EQ(stat.cpus[0].guest_nice, 0ull);
+
+    // no overall cpu line
+    const char garbage[] = "intr 1 2\nctxt 3\n";
+    EXPECT_FALSE(ProcStatReader::parse(garbage, sizeof(garbage) - 1, stat));
+}
+
+TEST_F(UT_ProcStatReader, test_read_01)
+{
+    // larger than the initial read buffer
+    QByteArray content = makeProcStat(64, 8192);
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    file.write(content);
+    file.flush();
+
+    ProcStatReader reader(file.fileName().toLocal8Bit());
+    proc_stat_t stat;
+    ASSERT_TRUE(reader.read(stat));
+    EXPECT_EQ(stat.online.size(), 64);
+    EXPECT_EQ(stat.intr, 987654321ull);
+    EXPECT_EQ(stat.procsRunning, 17u);
+
+    // kept open, read again from the start
+    ASSERT_TRUE(reader.read(stat));
+    EXPECT_EQ(stat.online.size(), 64);
+    EXPECT_EQ(stat.ctxt, 123456789012ull);
+}
+
+TEST_F(UT_ProcStatReader, test_read_02)
+{
+    ProcStatReader reader("/nonexistent/proc/stat");
+    proc_stat_t stat;
+    EXPECT_FALSE(reader.read(stat));
+
+    // the real file may not be readable in restricted sandbox
+    if (m_tester->read(stat)) {
+        EXPECT_GT(stat.cpu.total(), 0ull);
+        EXPECT_FALSE(stat.online.isEmpty());
+    }
+}
+
+TEST_F(UT_ProcStatReader, test_benchmark_001)
+{
+    const int ncpus = 256;
+    const int rounds = 1000;
+    QByteArray content = makeProcStat(ncpus, 1024);
+
+    QMap<QByteArray, CPUStat> statDB;
+    QMap<QByteArray, CPUUsage> usageDB;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < rounds; ++i)
+        legacyParse(content, statDB, usageDB);
+    qint64 legacyNs = timer.nsecsElapsed();
+
+    proc_stat_t stat;
+    timer.restart();
+    for (int i = 0; i < rounds; ++i)
+        ASSERT_TRUE(ProcStatReader::parse(content.constData(), size_t(content.size()), stat));
+    qint64 parseNs = timer.nsecsElapsed();
+
+    qInfo() << "/proc/stat of" << ncpus << "cpus: sscanf & QMap" << legacyNs / rounds / 1000 << "us, in place" << parseNs / rounds / 1000 << "us per read";
+
+    // both parsers read the same values
+    ASSERT_EQ(stat.online.size(), ncpus);
+    ASSERT_EQ(statDB.size(), ncpus);
+    for (int cpu : stat.online) {
+        QByteArray name = QByteArray("cpu").append(QByteArray::number(cpu));
+        ASSERT_TRUE(statDB.contains(name));
+        EXPECT_EQ(stat.cpus[cpu].user, statDB[name]->user);
+        EXPECT_EQ(stat.cpus[cpu].guest_nice, statDB[name]->guest_nice);
+        EXPECT_EQ(stat.cpus[cpu].total(), usageDB[name]->total);
+        EXPECT_EQ(stat.cpus[cpu].idleTotal(), usageDB[name]->idle);
+    }
+}
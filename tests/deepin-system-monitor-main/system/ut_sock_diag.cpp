@@ -0,0 +1,366 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/sock_diag.h"
+#include "system/sys_info.h"
+#include "system/packet.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+//Qt
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+#include <QDebug>
+
+//system
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/rtnetlink.h>
+#include <arpa/inet.h>
+
+using namespace core::system;
+
+namespace {
+
+struct FakeSock {
+    quint32 saddr; // network byte order
+    quint16 sport;
+    quint32 daddr; // network byte order
+    quint16 dport;
+    quint32 uid;
+    quint32 ino;
+};
+
+// sockets 10.x.y.z:40000+ -> 192.168.0.1:443, inode from 1000 on
+QVector<FakeSock> makeSocks(int n)
+{
+    QVector<FakeSock> socks;
+    socks.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        FakeSock sock;
+        sock.saddr = htonl(0x0a000000u | quint32(i >> 8));
+        sock.sport = quint16(40000 + (i & 0xff));
+        sock.daddr = htonl(0xc0a80001u);
+        sock.dport = 443;
+        sock.uid = 1000;
+        sock.ino = quint32(1000 + i);
+        socks << sock;
+    }
+    return socks;
+}
+
+void appendDiagMsg(QByteArray &buf, const FakeSock &sock, quint32 seq)
+{
+    QByteArray msg(int(NLMSG_SPACE(sizeof(struct inet_diag_msg))), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(struct inet_diag_msg));
+    nlh->nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    nlh->nlmsg_flags = NLM_F_MULTI;
+    nlh->nlmsg_seq = seq;
+
+    auto *diag = reinterpret_cast<struct inet_diag_msg *>(NLMSG_DATA(nlh));
+    diag->idiag_family = AF_INET;
+    diag->idiag_state = 1; // TCP_ESTABLISHED
+    diag->id.idiag_sport = htons(sock.sport);
+    diag->id.idiag_dport = htons(sock.dport);
+    diag->id.idiag_src[0] = sock.saddr;
+    diag->id.idiag_dst[0] = sock.daddr;
+    diag->idiag_uid = sock.uid;
+    diag->idiag_inode = sock.ino;
+    buf.append(msg);
+}
+
+// inet_diag message with INET_DIAG_INFO attribute of infolen bytes, counters at kernel tcp_info offsets
+void appendTcpInfoMsg(QByteArray &buf, const FakeSock &sock, quint64 rxBytes, quint64 txBytes, size_t infolen, quint32 seq = 1)
+{
+    const size_t msglen = NLMSG_LENGTH(sizeof(struct inet_diag_msg)) + RTA_SPACE(infolen);
+    QByteArray msg(int(NLMSG_ALIGN(msglen)), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = quint32(msglen);
+    nlh->nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    nlh->nlmsg_flags = NLM_F_MULTI;
+    nlh->nlmsg_seq = seq;
+
+    auto *diag = reinterpret_cast<struct inet_diag_msg *>(NLMSG_DATA(nlh));
+    diag->idiag_family = AF_INET;
+    diag->id.idiag_src[0] = sock.saddr;
+    diag->id.idiag_dst[0] = sock.daddr;
+    diag->idiag_inode = sock.ino;
+
+    auto *attr = reinterpret_cast<struct rtattr *>(diag + 1);
+    attr->rta_type = INET_DIAG_INFO;
+    attr->rta_len = quint16(RTA_LENGTH(infolen));
+    char *info = reinterpret_cast<char *>(RTA_DATA(attr));
+    // tcpi_bytes_acked, tcpi_bytes_received, tcpi_segs_out, tcpi_segs_in
+    if (infolen >= 136) {
+        memcpy(info + 120, &txBytes, sizeof(txBytes));
+        memcpy(info + 128, &rxBytes, sizeof(rxBytes));
+    }
+    if (infolen >= 144) {
+        quint32 segs = 3;
+        memcpy(info + 136, &segs, sizeof(segs));
+        segs = 5;
+        memcpy(info + 140, &segs, sizeof(segs));
+    }
+    buf.append(msg);
+}
+
+void appendDone(QByteArray &buf, quint32 seq)
+{
+    QByteArray msg(int(NLMSG_SPACE(sizeof(int))), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(int));
+    nlh->nlmsg_type = NLMSG_DONE;
+    nlh->nlmsg_flags = NLM_F_MULTI;
+    nlh->nlmsg_seq = seq;
+    buf.append(msg);
+}
+
+// same layout as /proc/net/tcp
+QByteArray makeProcTable(const QVector<FakeSock> &socks)
+{
+    QByteArray table("  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n");
+    int sl = 0;
+    for (const FakeSock &sock : socks) {
+        table.append(QString::asprintf("%4d: %08X:%04X %08X:%04X 01 00000000:00000000 00:00000000 00000000 %5u        0 %u 1 0000000000000000 20 4 30 10 -1\n",
+                                       sl++, sock.saddr, sock.sport, sock.daddr, sock.dport, sock.uid, sock.ino)
+                     .toLatin1());
+    }
+    return table;
+}
+
+} // namespace
+
+class UT_SockDiag : public ::testing::Test
+{
+public:
+    UT_SockDiag() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new SockDiag();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    SockDiag *m_tester;
+};
+
+TEST_F(UT_SockDiag, initTest)
+{
+}
+
+TEST_F(UT_SockDiag, test_parseMessages_001)
+{
+    QVector<FakeSock> socks = makeSocks(2);
+    socks[1].ino = 0; // waiting socket, skipped
+
+    QByteArray buf;
+    appendDiagMsg(buf, socks[0], 1);
+    appendDiagMsg(buf, socks[1], 1);
+
+    SockStatMap statMap;
+    EXPECT_EQ(SockDiag::parseMessages(buf.constData(), size_t(buf.size()), 1, IPPROTO_TCP, statMap), 0);
+    // tcp socket is indexed by both directions
+    ASSERT_EQ(statMap.size(), 2);
+
+    sock_flow_key_t key = sockFlowKey(AF_INET, IPPROTO_TCP, &socks[0].saddr, socks[0].sport, &socks[0].daddr, socks[0].dport);
+    ASSERT_TRUE(statMap.contains(key));
+    EXPECT_EQ(statMap[key]->ino, socks[0].ino);
+    EXPECT_EQ(statMap[key]->uid, socks[0].uid);
+
+    key = sockFlowKey(AF_INET, IPPROTO_TCP, &socks[0].daddr, socks[0].dport, &socks[0].saddr, socks[0].sport);
+    EXPECT_TRUE(statMap.contains(key));
+}
+
+TEST_F(UT_SockDiag, test_parseMessages_002)
+{
+    QByteArray buf;
+    appendDiagMsg(buf, makeSocks(1)[0], 1);
+    appendDone(buf, 1);
+
+    SockStatMap statMap;
+    // udp socket is indexed by its own direction only
+    EXPECT_EQ(SockDiag::parseMessages(buf.constData(), size_t(buf.size()), 1, IPPROTO_UDP, statMap), 1);
+    EXPECT_EQ(statMap.size(), 1);
+}
+
+TEST_F(UT_SockDiag, test_parseMessages_003)
+{
+    QByteArray buf(int(NLMSG_SPACE(sizeof(struct nlmsgerr))), 0);
+    auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf.data());
+    nlh->nlmsg_len = NLMSG_LENGTH(sizeof(struct nlmsgerr));
+    nlh->nlmsg_type = NLMSG_ERROR;
+    nlh->nlmsg_seq = 1;
+    reinterpret_cast<struct nlmsgerr *>(NLMSG_DATA(nlh))->error = -ENOENT;
+
+    SockStatMap statMap;
+    EXPECT_EQ(SockDiag::parseMessages(buf.constData(), size_t(buf.size()), 1, IPPROTO_UDP, statMap), -1);
+    EXPECT_TRUE(statMap.isEmpty());
+}
+
+TEST_F(UT_SockDiag, test_parseTcpInfoMessages_001)
+{
+    QVector<FakeSock> socks = makeSocks(2);
+    QByteArray buf;
+    appendTcpInfoMsg(buf, socks[0], 1000, 200, 232);
+    // kernel 4.1, no segment counters
+    appendTcpInfoMsg(buf, socks[1], 10, 20, 136);
+    appendDone(buf, 1);
+
+    SockBytesMap bytesMap;
+    EXPECT_EQ(SockDiag::parseTcpInfoMessages(buf.constData(), size_t(buf.size()), 1, bytesMap), 1);
+    ASSERT_EQ(bytesMap.size(), 2);
+
+    const sock_bytes_t &bytes = bytesMap[socks[0].ino];
+    EXPECT_EQ(bytes.rx_bytes, 1000ull);
+    EXPECT_EQ(bytes.tx_bytes, 200ull);
+    EXPECT_EQ(bytes.rx_segs, 5u);
+    EXPECT_EQ(bytes.tx_segs, 3u);
+
+    EXPECT_EQ(bytesMap[socks[1].ino].rx_bytes, 10ull);
+    EXPECT_EQ(bytesMap[socks[1].ino].rx_segs, 0u);
+}
+
+TEST_F(UT_SockDiag, test_parseTcpInfoMessages_002)
+{
+    // kernel before 4.1, tcp_info ends before byte counters
+    QByteArray buf;
+    appendTcpInfoMsg(buf, makeSocks(1)[0], 1000, 200, 104);
+
+    SockBytesMap bytesMap;
+    EXPECT_EQ(SockDiag::parseTcpInfoMessages(buf.constData(), size_t(buf.size()), 1, bytesMap), -1);
+    EXPECT_TRUE(bytesMap.isEmpty());
+}
+
+TEST_F(UT_SockDiag, test_parseMessages_004)
+{
+    // rest of dump 1 that failed halfway, queued before replies of dump 2
+    QVector<FakeSock> socks = makeSocks(3);
+    QByteArray buf;
+    appendDiagMsg(buf, socks[0], 1);
+    appendDone(buf, 1);
+    appendDiagMsg(buf, socks[1], 2);
+
+    SockStatMap statMap;
+    EXPECT_EQ(SockDiag::parseMessages(buf.constData(), size_t(buf.size()), 2, IPPROTO_UDP, statMap), 0);
+    ASSERT_EQ(statMap.size(), 1);
+    EXPECT_EQ(statMap.begin().value()->ino, socks[1].ino);
+
+    buf.clear();
+    appendDiagMsg(buf, socks[2], 2);
+    appendDone(buf, 2);
+    EXPECT_EQ(SockDiag::parseMessages(buf.constData(), size_t(buf.size()), 2, IPPROTO_UDP, statMap), 1);
+    EXPECT_EQ(statMap.size(), 2);
+}
+
+TEST_F(UT_SockDiag, test_parseTcpInfoMessages_003)
+{
+    QVector<FakeSock> socks = makeSocks(2);
+    QByteArray buf;
+    appendTcpInfoMsg(buf, socks[0], 1000, 200, 232, 1);
+    appendDone(buf, 1);
+    appendTcpInfoMsg(buf, socks[1], 10, 20, 232, 2);
+    appendDone(buf, 2);
+
+    SockBytesMap bytesMap;
+    EXPECT_EQ(SockDiag::parseTcpInfoMessages(buf.constData(), size_t(buf.size()), 2, bytesMap), 1);
+    ASSERT_EQ(bytesMap.size(), 1);
+    EXPECT_TRUE(bytesMap.contains(socks[1].ino));
+}
+
+TEST_F(UT_SockDiag, test_parseTcpInfoMessages_004)
+{
+    // local client & server talking over loopback, neither end is accounted
+    QVector<FakeSock> socks = makeSocks(3);
+    socks[0].saddr = htonl(0x7f000001u);
+    socks[0].daddr = htonl(0x7f000001u);
+    socks[1].saddr = htonl(0x7f000001u);
+    socks[1].daddr = htonl(0x7f000035u);
+    // loopback on one end only is not local traffic
+    socks[2].saddr = htonl(0x7f000001u);
+
+    QByteArray buf;
+    for (const FakeSock &sock : socks)
+        appendTcpInfoMsg(buf, sock, 1000, 200, 232);
+    appendDone(buf, 1);
+
+    SockBytesMap bytesMap;
+    EXPECT_EQ(SockDiag::parseTcpInfoMessages(buf.constData(), size_t(buf.size()), 1, bytesMap), 1);
+    ASSERT_EQ(bytesMap.size(), 1);
+    EXPECT_TRUE(bytesMap.contains(socks[2].ino));
+}
+
+TEST_F(UT_SockDiag, test_readTcpBytes_001)
+{
+    // may fail in restricted sandbox or on old kernels, tcp is captured then
+    SockBytesMap bytesMap;
+    if (m_tester->isValid() && m_tester->readTcpBytes(AF_INET, bytesMap)) {
+        for (auto it = bytesMap.cbegin(); it != bytesMap.cend(); ++it) {
+            EXPECT_NE(it.key(), ino_t(0));
+        }
+    }
+}
+
+TEST_F(UT_SockDiag, test_readSockStat_001)
+{
+    // may fail in restricted sandbox, SysInfo falls back to procfs then
+    SockStatMap statMap;
+    if (m_tester->isValid() && m_tester->readSockStat(AF_INET, IPPROTO_TCP, statMap)) {
+        for (const SockStat &stat : statMap) {
+            EXPECT_NE(stat->ino, ino_t(0));
+        }
+    }
+}
+
+TEST_F(UT_SockDiag, test_benchmark_001)
+{
+    const int nsocks = 50000;
+    QVector<FakeSock> socks = makeSocks(nsocks);
+
+    QTemporaryFile procTable;
+    ASSERT_TRUE(procTable.open());
+    procTable.write(makeProcTable(socks));
+    procTable.flush();
+
+    QByteArray diagDump;
+    for (const FakeSock &sock : socks) {
+        appendDiagMsg(diagDump, sock, 1);
+    }
+    appendDone(diagDump, 1);
+
+    QElapsedTimer timer;
+    SockStatMap procMap;
+    timer.start();
+    EXPECT_TRUE(SysInfo::readSockStatFile(AF_INET, IPPROTO_TCP, procTable.fileName().toLocal8Bit().constData(), procMap));
+    qint64 procNs = timer.nsecsElapsed();
+
+    SockStatMap diagMap;
+    timer.restart();
+    EXPECT_EQ(SockDiag::parseMessages(diagDump.constData(), size_t(diagDump.size()), 1, IPPROTO_TCP, diagMap), 1);
+    qint64 diagNs = timer.nsecsElapsed();
+
+    qInfo() << "sock stat of" << nsocks << "tcp sockets: procfs" << procNs / 1000 << "us, inet_diag" << diagNs / 1000 << "us";
+
+    // both backends index the same flows with the same inodes
+    ASSERT_EQ(procMap.size(), 2 * nsocks);
+    ASSERT_EQ(diagMap.size(), procMap.size());
+    for (auto it = procMap.cbegin(); it != procMap.cend(); ++it) {
+        ASSERT_TRUE(diagMap.contains(it.key()));
+        EXPECT_EQ(diagMap[it.key()]->ino, it.value()->ino);
+    }
+}
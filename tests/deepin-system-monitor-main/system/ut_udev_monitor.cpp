@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+//self
+#include "system/udev_monitor.h"
+#include "system/udev.h"
+
+//gtest
+#include "stub.h"
+#include <gtest/gtest.h>
+
+using namespace core::system;
+
+class UT_UDevMonitor : public ::testing::Test
+{
+public:
+    UT_UDevMonitor() : m_tester(nullptr) {}
+
+public:
+    virtual void SetUp()
+    {
+        m_tester = new UDevMonitor(&m_udev, "cpu");
+    }
+
+    virtual void TearDown()
+    {
+        if (m_tester) {
+            delete m_tester;
+            m_tester = nullptr;
+        }
+    }
+
+protected:
+    UDev m_udev;
+    UDevMonitor *m_tester;
+};
+
+TEST_F(UT_UDevMonitor, initTest)
+{
+}
+
+TEST_F(UT_UDevMonitor, test_takeEvents_01)
+{
+    // may be invalid in restricted sandbox, never blocks either way
+    m_tester->takeEvents();
+    EXPECT_FALSE(m_tester->takeEvents());
+
+    UDevMonitor invalid(nullptr, "cpu");
+    EXPECT_FALSE(invalid.isValid());
+    EXPECT_FALSE(invalid.takeEvents());
+}